@@ -8,11 +8,13 @@ settings.video_settings.full_screen = false
 settings.video_settings.screen_resx = 800
 settings.video_settings.screen_resy = 600
 settings.video_settings.smooth_graphics = true
+settings.video_settings.particle_threads = 0 -- 0: depends on the CPU cores
 settings.video_settings.ui_theme = "Royal Silk"
 
 settings.audio_settings = {}
 settings.audio_settings.music_vol = 0.7
 settings.audio_settings.sound_vol = 0.8
+settings.audio_settings.cache_size = 32
 
 settings.key_settings = {}
 settings.key_settings.up = 1073741906
@@ -39,6 +41,8 @@ settings.joystick_settings.quit = 7
 
 settings.game_options = {}
 settings.game_options.message_speed = 30 -- characters by second
+settings.game_options.update_rate = 60 -- game logic updates by second
+settings.game_options.update_interpolation = true
 
 -- Not supported yet
 settings.joystick_settings.index = 0
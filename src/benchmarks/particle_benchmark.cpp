@@ -0,0 +1,277 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ***************************************************************************
+*** \file    particle_benchmark.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Benchmark of the particle update kernels
+***
+*** Times the update of a particle system, without any video context. The
+*** program is built twice: once with the SSE kernels, and once forcing the
+*** scalar ones (particle_benchmark_scalar).
+***
+*** The particles use the keyframes of the fire circle effect, and are given
+*** random ages, so that every update also changes the keyframe of some of
+*** them and respawns the expired ones, as in a running effect.
+***
+*** Usage: particle_benchmark [number of particles] [number of updates]
+*** **************************************************************************/
+
+#include "engine/video/particle_update.h"
+
+#include <cfloat>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace vt_mode_manager;
+
+//! \brief The lifetime of the particles, in seconds, as in fire_circle.lua.
+const float PARTICLE_LIFETIME = 4.0f;
+
+/** \brief Returns the keyframes of data/visuals/particle_effects/fire_circle.lua.
+*** Its second keyframe is reached during the particles lifetime, so that the
+*** keyframe changes are timed along with the update kernels.
+**/
+static std::vector<ParticleKeyframe> GetFireCircleKeyframes()
+{
+    std::vector<ParticleKeyframe> keyframes(3);
+
+    keyframes[0].color = vt_video::Color(1.0f, 0.0f, 0.0f, 0.7f);
+    keyframes[0].rotation_speed = 100.0f;
+    keyframes[0].time = 0.0f;
+
+    keyframes[1].color = vt_video::Color(1.0f, 0.2f, 0.2f, 1.0f);
+    keyframes[1].rotation_speed = 2.0f;
+    keyframes[1].time = 0.1f;
+
+    keyframes[2].color = vt_video::Color(1.0f, 0.0f, 0.0f, 0.0f);
+    keyframes[2].rotation_speed = 2.0f;
+    keyframes[2].time = 1.0f;
+
+    for(size_t k = 0; k < keyframes.size(); ++k) {
+        keyframes[k].size = vt_common::Position2D(1.0f, 0.6f);
+        keyframes[k].color_variation = vt_video::Color(0.2f, 0.2f, 0.2f, 0.0f);
+    }
+    return keyframes;
+}
+
+//! \brief The keyframes and the random variations of the benchmarked particles.
+class ParticleKeyframes
+{
+public:
+    ParticleKeyframes() :
+        keyframes(GetFireCircleKeyframes()),
+        random(42)
+    {}
+
+    std::vector<ParticleKeyframe> keyframes;
+
+    std::minstd_rand random;
+
+    //! \brief Returns a random number within [-variation, variation].
+    float RandomVariation(float variation) {
+        if(variation == 0.0f)
+            return 0.0f;
+        return std::uniform_real_distribution<float>(-variation, variation)(random);
+    }
+
+    //! \brief Returns the keyframe a particle is on, from its time.
+    size_t FindKeyframe(const ParticleArrays &p, size_t i) const {
+        float scaled_time = p.time[i] / p.lifetime[i];
+        size_t k;
+        for(k = 0; k < keyframes.size(); ++k) {
+            if(keyframes[k].time > scaled_time)
+                break;
+        }
+        return (k > 0) ? k - 1 : 0;
+    }
+
+    //! \brief Same as ParticleSystem::_SetParticleKeyframe().
+    void SetParticleKeyframe(ParticleArrays &p, size_t i, size_t keyframe, bool inherit_variations);
+};
+
+//! \brief Writes the keyframed values and variations in the order of the particle arrays.
+static void GetKeyframeValues(const ParticleKeyframe &keyframe, float *values, float *variations)
+{
+    values[PARTICLE_ROTATION_SPEED] = keyframe.rotation_speed;
+    variations[PARTICLE_ROTATION_SPEED] = keyframe.rotation_speed_variation;
+    values[PARTICLE_SIZE_X] = keyframe.size.x;
+    variations[PARTICLE_SIZE_X] = keyframe.size_variation.x;
+    values[PARTICLE_SIZE_Y] = keyframe.size.y;
+    variations[PARTICLE_SIZE_Y] = keyframe.size_variation.y;
+    for(int32_t c = 0; c < 4; ++c) {
+        values[PARTICLE_COLOR_RED + c] = keyframe.color[c];
+        variations[PARTICLE_COLOR_RED + c] = keyframe.color_variation[c];
+    }
+}
+
+void ParticleKeyframes::SetParticleKeyframe(ParticleArrays &p, size_t i, size_t keyframe, bool inherit_variations)
+{
+    float values[PARTICLE_KEYFRAMED_PROPERTIES];
+    float variations[PARTICLE_KEYFRAMED_PROPERTIES];
+    GetKeyframeValues(keyframes[keyframe], values, variations);
+
+    p.keyframe[i] = static_cast<uint32_t>(keyframe);
+    p.keyframe_start[i] = keyframes[keyframe].time * p.lifetime[i];
+
+    if(keyframe + 1 >= keyframes.size()) {
+        for(size_t k = 0; k < PARTICLE_KEYFRAMED_PROPERTIES; ++k) {
+            p.keyframe_from[k][i] = values[k];
+            p.keyframe_to[k][i] = values[k];
+        }
+        p.keyframe_scale[i] = 0.0f;
+        p.keyframe_end[i] = FLT_MAX;
+        return;
+    }
+
+    for(size_t k = 0; k < PARTICLE_KEYFRAMED_PROPERTIES; ++k) {
+        if(inherit_variations)
+            p.keyframe_from[k][i] = p.keyframe_to[k][i];
+        else
+            p.keyframe_from[k][i] = values[k] + RandomVariation(variations[k]);
+    }
+
+    const ParticleKeyframe &next_keyframe = keyframes[keyframe + 1];
+    GetKeyframeValues(next_keyframe, values, variations);
+    for(size_t k = 0; k < PARTICLE_KEYFRAMED_PROPERTIES; ++k)
+        p.keyframe_to[k][i] = values[k] + RandomVariation(variations[k]);
+
+    float duration = (next_keyframe.time - keyframes[keyframe].time) * p.lifetime[i];
+    p.keyframe_scale[i] = (duration > 0.0f) ? 1.0f / duration : 0.0f;
+    p.keyframe_end[i] = next_keyframe.time * p.lifetime[i];
+}
+
+//! \brief Fills the particles with random properties, at random ages.
+static void FillParticles(ParticleArrays &particles, size_t count, ParticleKeyframes &keyframes)
+{
+    std::minstd_rand &random = keyframes.random;
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_real_distribution<float> signed_unit(-1.0f, 1.0f);
+
+    particles.Resize(count);
+    for(size_t i = 0; i < count; ++i) {
+        particles.pos_x[i] = 512.0f + 100.0f * signed_unit(random);
+        particles.pos_y[i] = 384.0f + 100.0f * signed_unit(random);
+        particles.velocity_x[i] = 50.0f * signed_unit(random);
+        particles.velocity_y[i] = 50.0f * signed_unit(random);
+        particles.acceleration_y[i] = 20.0f;
+        particles.wind_velocity_x[i] = 5.0f * unit(random);
+        particles.rotation_direction[i] = signed_unit(random) < 0.0f ? -1.0f : 1.0f;
+        particles.lifetime[i] = PARTICLE_LIFETIME;
+        particles.time[i] = PARTICLE_LIFETIME * unit(random);
+        particles.wave_length_coefficient[i] = 6.28f;
+        particles.wave_half_amplitude[i] = 10.0f * unit(random);
+        particles.tangential_acceleration[i] = 5.0f * signed_unit(random);
+        particles.radial_acceleration[i] = 200.0f;
+        particles.damping[i] = 0.9f + 0.1f * unit(random);
+
+        keyframes.SetParticleKeyframe(particles, i, keyframes.FindKeyframe(particles, i), false);
+    }
+}
+
+//! \brief The number of keyframe changes and respawns done during the timed updates.
+struct UpdateCounts {
+    size_t keyframes_reached = 0;
+    size_t respawns = 0;
+};
+
+/** \brief Updates the particles once, like ParticleSystem::Update() does.
+*** The expired particles are respawned, as with a continuous emitter.
+**/
+static void UpdateParticles(ParticleArrays &particles, size_t count, float frame_time,
+                            const ParticleMotion &motion, ParticleKeyframes &keyframes,
+                            UpdateCounts &counts)
+{
+    // Same passes as ParticleSystem::_UpdateParticles().
+    for(size_t j = FindNextKeyframeReached(particles, 0, count); j < count;
+            j = FindNextKeyframeReached(particles, j + 1, count)) {
+        size_t current_keyframe = keyframes.FindKeyframe(particles, j);
+        keyframes.SetParticleKeyframe(particles, j, current_keyframe,
+                                      current_keyframe == particles.keyframe[j] + 1);
+        ++counts.keyframes_reached;
+    }
+    UpdateParticleMotion(particles, count, frame_time, motion);
+
+    // Same as ParticleSystem::_KillParticles(), only keeping the particle properties.
+    for(size_t j = 0; j < count; ++j) {
+        if(particles.time[j] > particles.lifetime[j]) {
+            particles.time[j] = 0.0f;
+            keyframes.SetParticleKeyframe(particles, j, 0, false);
+            ++counts.respawns;
+        }
+    }
+}
+
+//! \brief Returns the average duration of an update, in milliseconds.
+static double TimeUpdates(const char *name, ParticleArrays &particles, size_t count, uint32_t updates,
+                          const ParticleMotion &motion, ParticleKeyframes &keyframes)
+{
+    const float frame_time = 1.0f / 60.0f;
+    UpdateCounts counts;
+
+    // Warm up the caches first.
+    for(uint32_t i = 0; i < 10; ++i)
+        UpdateParticles(particles, count, frame_time, motion, keyframes, counts);
+
+    counts = UpdateCounts();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < updates; ++i)
+        UpdateParticles(particles, count, frame_time, motion, keyframes, counts);
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    // Use the results, so that the updates can't be optimized away.
+    if(particles.pos_x[count / 2] != particles.pos_x[count / 2])
+        std::cout << "Unexpected particle state" << std::endl;
+
+    std::cout << name << ": " << counts.keyframes_reached / updates << " keyframe changes and "
+              << counts.respawns / updates << " respawns per update" << std::endl;
+    return std::chrono::duration<double, std::milli>(end - start).count() / updates;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t count = (argc > 1) ? static_cast<size_t>(std::atol(argv[1])) : 100000;
+    uint32_t updates = (argc > 2) ? static_cast<uint32_t>(std::atol(argv[2])) : 200;
+    if(count == 0 || updates == 0) {
+        std::cerr << "Usage: " << argv[0] << " [number of particles] [number of updates]" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Particle update kernels: " << (IsParticleUpdateVectorized() ? "SSE" : "scalar") << std::endl
+              << count << " particles, " << updates << " updates" << std::endl;
+
+    ParticleKeyframes keyframes;
+    ParticleArrays particles;
+
+    // The common case: only keyframes, accelerations and a constant damping.
+    ParticleMotion basic_motion;
+    basic_motion.damping = 0.95f;
+    FillParticles(particles, count, keyframes);
+    double basic_time = TimeUpdates("Basic motion", particles, count, updates, basic_motion, keyframes);
+
+    // Every motion, including the scalar ones.
+    ParticleMotion full_motion;
+    full_motion.wave_motion_used = true;
+    full_motion.radial_used = true;
+    full_motion.tangential_used = true;
+    full_motion.attractor = vt_common::Position2D(512.0f, 384.0f);
+    full_motion.attractor_falloff = 0.001f;
+    full_motion.damping_variation_used = true;
+    FillParticles(particles, count, keyframes);
+    double full_time = TimeUpdates("Every motion", particles, count, updates, full_motion, keyframes);
+
+    std::cout << "Basic motion: " << basic_time << " ms per update, "
+              << basic_time * 1000000.0 / count << " ns per particle" << std::endl
+              << "Every motion: " << full_time << " ms per update, "
+              << full_time * 1000000.0 / count << " ns per particle" << std::endl;
+    return 0;
+}
@@ -0,0 +1,144 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ***************************************************************************
+*** \file    path_finder_benchmark.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Benchmark of the map path search
+***
+*** Times the A* path search used by ObjectSupervisor::FindPath(), without any
+*** map mode. The collision grid is a fixed town-like map of 256x192 collision
+*** grid elements, that is 128x96 tiles: houses on a grid of streets, with
+*** trees in between. The nodes are tested with a sprite collision rectangle,
+*** like FindPath() does.
+***
+*** Usage: path_finder_benchmark [number of searches]
+*** **************************************************************************/
+
+#include "modes/map/map_collision_grid.h"
+#include "modes/map/map_path_finder.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+using namespace vt_map::private_map;
+
+const uint32_t GRID_WIDTH = 256;
+const uint32_t GRID_HEIGHT = 192;
+
+//! \brief The size of the street blocks, each holding one house.
+const uint32_t BLOCK_WIDTH = 32;
+const uint32_t BLOCK_HEIGHT = 24;
+
+//! \brief Builds the town collision grid, always the same one.
+static void BuildTown(CollisionGrid &grid)
+{
+    std::minstd_rand random(1);
+    grid.Resize(GRID_WIDTH, GRID_HEIGHT);
+
+    // The map borders.
+    grid.SetArea(0, 0, GRID_WIDTH - 1, 1);
+    grid.SetArea(0, GRID_HEIGHT - 2, GRID_WIDTH - 1, GRID_HEIGHT - 1);
+    grid.SetArea(0, 0, 1, GRID_HEIGHT - 1);
+    grid.SetArea(GRID_WIDTH - 2, 0, GRID_WIDTH - 1, GRID_HEIGHT - 1);
+
+    // One house per block, leaving streets of at least 4 elements around it.
+    for(uint32_t block_y = 0; block_y < GRID_HEIGHT; block_y += BLOCK_HEIGHT) {
+        for(uint32_t block_x = 0; block_x < GRID_WIDTH; block_x += BLOCK_WIDTH) {
+            int32_t width = 10 + random() % (BLOCK_WIDTH - 18);
+            int32_t height = 8 + random() % (BLOCK_HEIGHT - 16);
+            int32_t left = block_x + 4 + random() % (BLOCK_WIDTH - 8 - width);
+            int32_t top = block_y + 4 + random() % (BLOCK_HEIGHT - 8 - height);
+            grid.SetArea(left, top, left + width - 1, top + height - 1);
+        }
+    }
+
+    // The trees and fences, which may block some streets.
+    for(uint32_t i = 0; i < 300; ++i) {
+        int32_t x = random() % GRID_WIDTH;
+        int32_t y = random() % GRID_HEIGHT;
+        grid.SetArea(x, y, x + 1, y + 1);
+    }
+}
+
+//! \brief Tells whether a sprite standing at the given grid position collides with the town.
+static bool IsBlocked(const CollisionGrid &grid, int32_t x, int32_t y)
+{
+    // A sprite collision rectangle: one element on each side, and two elements high.
+    if(x < 1 || y < 2 || x + 1 >= static_cast<int32_t>(GRID_WIDTH))
+        return true;
+    return grid.IsAreaSet(x - 1, y - 2, x + 1, y);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t searches = (argc > 1) ? static_cast<uint32_t>(std::atol(argv[1])) : 500;
+    if(searches == 0) {
+        std::cerr << "Usage: " << argv[0] << " [number of searches]" << std::endl;
+        return 1;
+    }
+
+    CollisionGrid grid;
+    BuildTown(grid);
+
+    PathFinder path_finder;
+    path_finder.Initialize(GRID_WIDTH, GRID_HEIGHT);
+    PathFinder::NodeCostFunction node_cost = [&grid](int32_t x, int32_t y) -> int32_t {
+        return IsBlocked(grid, x, y) ? PATH_NODE_BLOCKED : 0;
+    };
+
+    // The same walkable source and destination pairs on every run.
+    std::minstd_rand random(42);
+    std::vector<int32_t> positions;
+    while(positions.size() < searches * 4) {
+        int32_t x = random() % GRID_WIDTH;
+        int32_t y = random() % GRID_HEIGHT;
+        if(!IsBlocked(grid, x, y)) {
+            positions.push_back(x);
+            positions.push_back(y);
+        }
+    }
+
+    std::cout << "Path search on a " << GRID_WIDTH << "x" << GRID_HEIGHT << " collision grid, "
+              << searches << " searches" << std::endl;
+
+    std::vector<uint32_t> path;
+    uint32_t paths_found = 0;
+    uint64_t path_length = 0;
+    uint64_t expanded_nodes = 0;
+    double longest_time = 0.0;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < searches; ++i) {
+        const int32_t *pair = &positions[i * 4];
+
+        std::chrono::steady_clock::time_point search_start = std::chrono::steady_clock::now();
+        if(path_finder.FindPath(pair[0], pair[1], pair[2], pair[3], node_cost, 0, path)) {
+            ++paths_found;
+            path_length += path.size();
+        }
+        std::chrono::steady_clock::time_point search_end = std::chrono::steady_clock::now();
+
+        expanded_nodes += path_finder.GetNumberOfExpandedNodes();
+        double search_time = std::chrono::duration<double, std::milli>(search_end - search_start).count();
+        if(search_time > longest_time)
+            longest_time = search_time;
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    double total_time = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::cout << paths_found << " paths found, " << (paths_found > 0 ? path_length / paths_found : 0)
+              << " nodes long on average" << std::endl
+              << "Average search: " << total_time / searches << " ms, "
+              << expanded_nodes / searches << " nodes expanded" << std::endl
+              << "Longest search: " << longest_time << " ms" << std::endl;
+    return 0;
+}
@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ***************************************************************************
+*** \file    rectangle_packer_check.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Check of the space recovered by the texture sheet packer
+***
+*** Fills a 512x512 sheet with small random images, frees all of them but one,
+*** and then checks that a large image fits again, as when a texture sheet
+*** is reused after a mode change. The removals are done one at a time and
+*** in one batch, as VariableTexSheet does both. It also prints the time
+*** taken by the removals.
+***
+*** Returns a non-zero value when the check fails.
+*** **************************************************************************/
+
+#include "engine/video/rectangle_packer.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+using namespace vt_video::private_video;
+
+const uint32_t SHEET_SIZE = 512;
+const uint32_t NUMBER_RECTS = 219;
+
+//! \brief Fills the packer with random rectangles, and returns them.
+static std::vector<PackedRect> FillPacker(RectanglePacker &packer, std::minstd_rand &random)
+{
+    std::uniform_int_distribution<uint32_t> size(8, 67);
+
+    // The rectangles which don't fit anymore are skipped, so that the sheet ends up full.
+    std::vector<PackedRect> rects;
+    for(uint32_t attempt = 0; attempt < 10 * NUMBER_RECTS && rects.size() < NUMBER_RECTS; ++attempt) {
+        uint32_t width = size(random);
+        uint32_t height = size(random);
+        uint32_t x, y;
+        if(packer.Insert(width, height, x, y))
+            rects.push_back(PackedRect(x, y, width, height));
+    }
+    return rects;
+}
+
+//! \brief Checks that a large rectangle can be inserted, once all the rectangles but one are removed.
+static bool CheckRemoval(bool batch_removal)
+{
+    std::minstd_rand random(42);
+    RectanglePacker packer(SHEET_SIZE, SHEET_SIZE);
+    std::vector<PackedRect> rects = FillPacker(packer, random);
+    std::cout << (batch_removal ? "Batch removal: " : "Single removals: ")
+              << rects.size() << " rectangles inserted, ";
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if(batch_removal) {
+        packer.Remove(std::vector<PackedRect>(rects.begin() + 1, rects.end()));
+    }
+    else {
+        for(uint32_t i = 1; i < rects.size(); ++i)
+            packer.Remove(rects[i]);
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    std::cout << packer.GetNumberFreeRects() << " free rectangles left, largest area "
+              << packer.GetLargestFreeArea() << " pixels, removed in "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+
+    // Only the first rectangle is used, so half of the sheet is free in one piece at least.
+    uint32_t x, y;
+    if(!packer.Insert(SHEET_SIZE / 2, SHEET_SIZE / 2, x, y)) {
+        std::cerr << "The freed space wasn't recovered: a " << SHEET_SIZE / 2 << "x"
+                  << SHEET_SIZE / 2 << " rectangle doesn't fit" << std::endl;
+        return false;
+    }
+
+    // Once everything is removed, the whole sheet is free again.
+    packer.Remove(rects[0]);
+    packer.Remove(PackedRect(x, y, SHEET_SIZE / 2, SHEET_SIZE / 2));
+    if(packer.GetNumberFreeRects() != 1 || packer.GetLargestFreeArea() != SHEET_SIZE * SHEET_SIZE) {
+        std::cerr << "The sheet isn't entirely free once every rectangle is removed" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    bool success = CheckRemoval(false);
+    success = CheckRemoval(true) && success;
+    return success ? 0 : 1;
+}
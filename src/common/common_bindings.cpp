@@ -374,6 +374,10 @@ void BindCommonCode()
             .def("DoesEventExist", &GameEvents::DoesEventExist)
             .def("GetEventValue", &GameEvents::GetEventValue)
             .def("SetEventValue", &GameEvents::SetEventValue)
+            .def("GetEventHandle", &GameEvents::GetEventHandle)
+            .def("DoesEventExistFromHandle", &GameEvents::DoesEventExistFromHandle)
+            .def("GetEventValueFromHandle", &GameEvents::GetEventValueFromHandle)
+            .def("SetEventValueFromHandle", &GameEvents::SetEventValueFromHandle)
         ];
 
         luabind::module(vt_script::ScriptManager->GetGlobalState(), "vt_global")
@@ -144,7 +144,7 @@ GlobalActor &GlobalActor::operator=(const GlobalActor &copy)
 
     // Copy all attack points
     for(uint32_t i = 0; i < copy._attack_points.size(); ++i) {
-        _attack_points.push_back(new GlobalAttackPoint(*_attack_points[i]));
+        _attack_points.push_back(new GlobalAttackPoint(*copy._attack_points[i]));
         _attack_points[i]->SetActorOwner(this);
     }
 
@@ -14,6 +14,7 @@
 #include "common/global/global.h"
 #include "common/global/objects/global_armor.h"
 #include "common/global/objects/global_weapon.h"
+#include "common/global/save/save_game_file.h"
 
 #include "script/script_read.h"
 #include "utils/utils_files.h"
@@ -469,104 +470,145 @@ bool GlobalCharacter::LoadCharacter(ReadScriptDescriptor& file)
     return true;
 }
 
-bool GlobalCharacter::SaveCharacter(WriteScriptDescriptor& file)
+bool GlobalCharacter::LoadCharacter(SaveGameReader& file)
 {
-    if(!file.IsFileOpen()) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "the file provided in the function argument was not open" << std::endl;
-        return false;
+    // Gets whether the character is currently enabled
+    Enable(file.ReadBool());
+
+    // Read in all of the character's stats data
+    SetExperienceLevel(file.ReadUInt32());
+    _unspent_experience_points = file.ReadUInt32();
+    SetTotalExperiencePoints(file.ReadUInt32());
+    _experience_for_next_level = file.ReadInt32();
+
+    SetMaxHitPoints(file.ReadUInt32());
+    SetHitPoints(file.ReadUInt32());
+    SetMaxSkillPoints(file.ReadUInt32());
+    SetSkillPoints(file.ReadUInt32());
+
+    SetPhysAtk(file.ReadUInt32());
+    SetMagAtk(file.ReadUInt32());
+    SetPhysDef(file.ReadUInt32());
+    SetMagDef(file.ReadUInt32());
+    SetStamina(file.ReadUInt32());
+    SetEvade(file.ReadFloat());
+
+    // Read the character's equipment: the weapon, then the head, torso, arm and leg armors.
+    uint32_t equip_id = file.ReadUInt32();
+    if(equip_id != 0)
+        EquipWeapon(std::make_shared<GlobalWeapon>(equip_id));
+
+    for(uint32_t i = 0; i < 4; ++i) {
+        equip_id = file.ReadUInt32();
+        if(equip_id != 0)
+            EquipArmor(std::make_shared<GlobalArmor>(equip_id));
     }
 
-    file.WriteLine("\t[" + NumberToString(GetID()) + "] = {");
+    // Read the character's skills and pass those onto the character object
+    std::vector<uint32_t> skill_ids;
+    file.ReadUIntVector(skill_ids);
+    for(uint32_t i = 0; i < skill_ids.size(); i++) {
+        AddSkill(skill_ids[i]);
+    }
 
+    // Read the character's obtained skill nodes
+    ResetObtainedSkillNodes();
+    std::vector<uint32_t> skill_node_ids;
+    file.ReadUIntVector(skill_node_ids);
+    SetObtainedSkillNodes(skill_node_ids);
+
+    // Read the current skill node location
+    uint32_t current_character_location = file.ReadUInt32();
+    if (current_character_location != std::numeric_limits<uint32_t>::max()) {
+        SetSkillNodeLocation(current_character_location);
+
+        if (!IsSkillNodeObtained(current_character_location)) {
+            _obtained_skill_nodes.push_back(current_character_location);
+        }
+    }
+
+    // Read the character's active status effects data
+    ResetActiveStatusEffects();
+    uint32_t status_effects_number = file.ReadUInt32();
+    for(uint32_t i = 0; i < status_effects_number && !file.IsErrorDetected(); ++i) {
+        int32_t status_effect = file.ReadInt32();
+        int32_t intensity = file.ReadInt32();
+        uint32_t duration = file.ReadUInt32();
+        uint32_t elapsed_time = file.ReadUInt32();
+
+        // Check the status effect and intensity validity
+        if (status_effect <= (int32_t)GLOBAL_STATUS_INVALID || status_effect >= (int32_t)GLOBAL_STATUS_TOTAL)
+            continue;
+        if (intensity <= GLOBAL_INTENSITY_INVALID || intensity >= GLOBAL_INTENSITY_TOTAL)
+            continue;
+
+        SetActiveStatusEffect((GLOBAL_STATUS)status_effect,
+                              (GLOBAL_INTENSITY)intensity,
+                              duration, elapsed_time);
+    }
+
+    return !file.IsErrorDetected();
+}
+
+bool GlobalCharacter::SaveCharacter(SaveGameWriter& file)
+{
     // Store whether the character is available
-    file.WriteLine("\t\tenabled = " + std::string(IsEnabled() ? "true" : "false") + ",");
+    file.WriteBool(IsEnabled());
 
     // Write out the character's stats
-    file.WriteLine("\t\texperience_level = " + NumberToString(GetExperienceLevel()) + ",");
-    file.WriteLine("\t\tunspent_experience_points = " + NumberToString(GetUnspentExperiencePoints()) + ", ");
-    file.WriteLine("\t\ttotal_experience_points = " + NumberToString(GetTotalExperiencePoints()) + ",");
-    file.WriteLine("\t\texperience_points_next = " + NumberToString(GetExperienceForNextLevel()) + ", ");
+    file.WriteUInt32(GetExperienceLevel());
+    file.WriteUInt32(GetUnspentExperiencePoints());
+    file.WriteUInt32(GetTotalExperiencePoints());
+    file.WriteInt32(GetExperienceForNextLevel());
 
     // The values stored are the unmodified ones.
-    file.WriteLine("\t\tmax_hit_points = " + NumberToString(GetMaxHitPoints()) + ",");
-    file.WriteLine("\t\thit_points = " + NumberToString(GetHitPoints()) + ",");
-    file.WriteLine("\t\tmax_skill_points = " + NumberToString(GetMaxSkillPoints()) + ",");
-    file.WriteLine("\t\tskill_points = " + NumberToString(GetSkillPoints()) + ",");
-
-    file.WriteLine("\t\tphys_atk = " + NumberToString(GetPhysAtkBase()) + ",");
-    file.WriteLine("\t\tmag_atk = " + NumberToString(GetMagAtkBase()) + ",");
-    file.WriteLine("\t\tphys_def = " + NumberToString(GetPhysDefBase()) + ",");
-    file.WriteLine("\t\tmag_def = " + NumberToString(GetMagDefBase()) + ",");
-    file.WriteLine("\t\tstamina = " + NumberToString(GetStaminaBase()) + ",");
-    file.WriteLine("\t\tevade = " + NumberToString(GetEvadeBase()) + ",");
+    file.WriteUInt32(GetMaxHitPoints());
+    file.WriteUInt32(GetHitPoints());
+    file.WriteUInt32(GetMaxSkillPoints());
+    file.WriteUInt32(GetSkillPoints());
+
+    file.WriteUInt32(GetPhysAtkBase());
+    file.WriteUInt32(GetMagAtkBase());
+    file.WriteUInt32(GetPhysDefBase());
+    file.WriteUInt32(GetMagDefBase());
+    file.WriteUInt32(GetStaminaBase());
+    file.WriteFloat(GetEvadeBase());
 
     // Write out the character's equipment
-    uint32_t weapon_id = GetEquippedWeapon() ? GetEquippedWeapon()->GetID() : 0;
-    uint32_t head_id = GetEquippedArmor(GLOBAL_OBJECT_HEAD_ARMOR) ? GetEquippedArmor(GLOBAL_OBJECT_HEAD_ARMOR)->GetID() : 0;
-    uint32_t torso_id = GetEquippedArmor(GLOBAL_OBJECT_TORSO_ARMOR) ? GetEquippedArmor(GLOBAL_OBJECT_TORSO_ARMOR)->GetID() : 0;
-    uint32_t arm_id = GetEquippedArmor(GLOBAL_OBJECT_ARM_ARMOR) ? GetEquippedArmor(GLOBAL_OBJECT_ARM_ARMOR)->GetID() : 0;
-    uint32_t leg_id = GetEquippedArmor(GLOBAL_OBJECT_LEG_ARMOR) ? GetEquippedArmor(GLOBAL_OBJECT_LEG_ARMOR)->GetID() : 0;
-
-    file.InsertNewLine();
-    file.WriteLine("\t\tequipment = {");
-    file.WriteLine("\t\t\tweapon = " + NumberToString(weapon_id) + ",");
-    file.WriteLine("\t\t\thead_armor = " + NumberToString(head_id) + ",");
-    file.WriteLine("\t\t\ttorso_armor = " + NumberToString(torso_id) + ",");
-    file.WriteLine("\t\t\tarm_armor = " + NumberToString(arm_id) + ",");
-    file.WriteLine("\t\t\tleg_armor = " + NumberToString(leg_id));
-    file.WriteLine("\t\t},");
+    file.WriteUInt32(GetEquippedWeapon() ? GetEquippedWeapon()->GetID() : 0);
+    const GLOBAL_OBJECT armor_types[] = { GLOBAL_OBJECT_HEAD_ARMOR, GLOBAL_OBJECT_TORSO_ARMOR,
+                                          GLOBAL_OBJECT_ARM_ARMOR, GLOBAL_OBJECT_LEG_ARMOR };
+    for(uint32_t i = 0; i < 4; ++i) {
+        std::shared_ptr<GlobalArmor> armor = GetEquippedArmor(armor_types[i]);
+        file.WriteUInt32(armor ? armor->GetID() : 0);
+    }
 
     // Write out the character's permanent skills.
     // The equipment skills will be reloaded through equipment.
-    file.InsertNewLine();
-    file.WriteLine("\t\tskills = {");
-    const std::vector<uint32_t>& skill_vector = GetPermanentSkills();
-    for(uint32_t i = 0; i < skill_vector.size(); i++) {
-        uint32_t skill_id = skill_vector.at(i);
-
-        if(i == 0)
-            file.WriteLine("\t\t\t", false);
-        else
-            file.WriteLine(", ", false);
-        file.WriteLine(NumberToString(skill_id), false);
-    }
-    file.WriteLine("\n\t\t},");
+    file.WriteUIntVector(GetPermanentSkills());
 
     // Write out the character's obtained skill nodes.
-    file.InsertNewLine();
-    file.WriteLine("\t\tobtained_skill_nodes = {");
-    const std::vector<uint32_t>& skill_nodes = GetObtainedSkillNodes();
-    for(uint32_t i = 0; i < skill_nodes.size(); i++) {
-        uint32_t skill_node = skill_nodes.at(i);
-
-        if(i == 0)
-            file.WriteLine("\t\t\t", false);
-        else
-            file.WriteLine(", ", false);
-        bool newline = (i > 0) && !(i % 10);
-        file.WriteLine(NumberToString(skill_node), newline);
-    }
-    file.WriteLine("\n\t\t},");
-    file.WriteLine("\t\tcurrent_skill_node = " + NumberToString(GetSkillNodeLocation()) + ",");
+    file.WriteUIntVector(GetObtainedSkillNodes());
+    file.WriteUInt32(GetSkillNodeLocation());
 
     // Writes active status effects at the time of the save
-    file.InsertNewLine();
-    file.WriteLine("\t\tactive_status_effects = {");
+    uint32_t active_effects = 0;
     for(uint32_t i = 0; i < _active_status_effects.size(); ++i) {
-        const ActiveStatusEffect& effect = _active_status_effects.at(i);
+        if (_active_status_effects[i].IsActive())
+            ++active_effects;
+    }
+
+    file.WriteUInt32(active_effects);
+    for(uint32_t i = 0; i < _active_status_effects.size(); ++i) {
+        const ActiveStatusEffect& effect = _active_status_effects[i];
         if (!effect.IsActive())
             continue;
 
-        std::string effect_str = "\t\t\t[" + NumberToString((int32_t)effect.GetEffect()) + "] = { ";
-        effect_str += "intensity = " + NumberToString((int32_t)effect.GetIntensity()) + ", ";
-        effect_str += "duration = " + NumberToString((int32_t)effect.GetEffectTime()) + ", ";
-        effect_str += "elapsed_time = " + NumberToString((int32_t)effect.GetElapsedTime()) + "},";
-
-        file.WriteLine(effect_str);
+        file.WriteInt32(effect.GetEffect());
+        file.WriteInt32(effect.GetIntensity());
+        file.WriteUInt32(effect.GetEffectTime());
+        file.WriteUInt32(effect.GetElapsedTime());
     }
-    file.WriteLine("\n\t\t}");
-
-    file.WriteLine("\t},");
     return true;
 }
 
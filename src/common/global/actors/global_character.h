@@ -22,7 +22,6 @@
 
 namespace vt_script {
 class ReadScriptDescriptor;
-class WriteScriptDescriptor;
 }
 
 namespace vt_global
@@ -30,6 +29,8 @@ namespace vt_global
 
 class GlobalArmor;
 class GlobalWeapon;
+class SaveGameReader;
+class SaveGameWriter;
 
 /** \name Game Character IDs
 *** \brief Integers that are used for identification of characters
@@ -72,11 +73,17 @@ public:
     **/
     bool LoadCharacter(vt_script::ReadScriptDescriptor& file);
 
+    /** \brief Loads character data from a binary saved game, written by SaveCharacter().
+    *** \param file The save game being read, positioned at the character data.
+    *** \returns Whether the character was successfully loaded.
+    **/
+    bool LoadCharacter(SaveGameReader& file);
+
     /** \brief Writes character data to the saved game file
-    *** \param file A reference to the open and valid file where to write the character data
+    *** \param file The save game being written
     *** \returns Whether the character could successfully be saved to the save file.
     **/
-    bool SaveCharacter(vt_script::WriteScriptDescriptor& file);
+    bool SaveCharacter(SaveGameWriter& file);
 
     //! \brief Tells whether a character is in the visible game formation
     void Enable(bool enable) {
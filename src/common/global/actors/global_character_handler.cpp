@@ -200,25 +200,49 @@ bool CharacterHandler::LoadCharacters(vt_script::ReadScriptDescriptor& file)
     return true;
 }
 
-void CharacterHandler::SaveCharacters(vt_script::WriteScriptDescriptor& file)
+bool CharacterHandler::LoadCharacters(SaveGameReader& file)
 {
-    file.InsertNewLine();
-    file.WriteLine("characters = {");
-    // First save the order of the characters in the party
-    file.WriteLine("\t[\"order\"] = {");
-    for(uint32_t i = 0; i < _ordered_characters.size(); ++i) {
-        if(i == 0)
-            file.WriteLine("\t\t" + NumberToString(_ordered_characters[i]->GetID()), false);
-        else
-            file.WriteLine(", " + NumberToString(_ordered_characters[i]->GetID()), false);
+    // Load characters into the party in the correct order
+    std::vector<uint32_t> char_ids;
+    file.ReadUIntVector(char_ids);
+
+    if (char_ids.empty()) {
+        PRINT_ERROR << "No valid characters id in " << file.GetFilename() << std::endl;
+        return false;
+    }
+
+    for(uint32_t i = 0; i < char_ids.size(); ++i) {
+        uint32_t id = char_ids[i];
+        GlobalCharacter* character = new GlobalCharacter(id, false);
+        if (character->LoadCharacter(file)) {
+            AddCharacter(character);
+        }
+        else {
+            delete character;
+            PRINT_ERROR << "Invalid character id " << id << " in " << file.GetFilename() << std::endl;
+            return false;
+        }
+    }
+
+    if (_characters.empty()) {
+        PRINT_ERROR << "No characters were added by save game file: " << file.GetFilename() << std::endl;
+        return false;
     }
-    file.WriteLine("\n\t},"); // order
+    return true;
+}
+
+void CharacterHandler::SaveCharacters(SaveGameWriter& file)
+{
+    // First save the order of the characters in the party
+    std::vector<uint32_t> char_ids;
+    for(uint32_t i = 0; i < _ordered_characters.size(); ++i)
+        char_ids.push_back(_ordered_characters[i]->GetID());
+    file.WriteUIntVector(char_ids);
 
     // Now save each individual character's data
     for(uint32_t i = 0; i < _ordered_characters.size(); ++i) {
         _ordered_characters[i]->SaveCharacter(file);
     }
-    file.WriteLine("},"); // characters
 }
 
 } // namespace vt_global
@@ -13,8 +13,9 @@
 
 #include "global_party.h"
 
+#include "common/global/save/save_game_file.h"
+
 #include "script/script_read.h"
-#include "script/script_write.h"
 
 #include <map>
 
@@ -102,7 +103,8 @@ public:
     void ClearAllData();
 
     bool LoadCharacters(vt_script::ReadScriptDescriptor& file);
-    void SaveCharacters(vt_script::WriteScriptDescriptor& file);
+    bool LoadCharacters(SaveGameReader& file);
+    void SaveCharacters(SaveGameWriter& file);
 
 private:
     /** \brief A map containing all characters that the player has discovered
@@ -26,18 +26,41 @@ namespace vt_global
 
 extern bool GLOBAL_DEBUG;
 
-GlobalEnemy::GlobalEnemy(uint32_t id) :
+GlobalEnemy::GlobalEnemy() :
     GlobalActor(),
     _experience_points(0),
     _sprite_width(0),
     _sprite_height(0),
     _drunes_dropped(0)
+{
+}
+
+GlobalEnemy::GlobalEnemy(uint32_t id) :
+    GlobalEnemy()
+{
+    const GlobalEnemy* prototype = GlobalManager->GetPrototypeHandler().GetEnemy(id);
+    if(prototype == nullptr) {
+        _id = id;
+        return;
+    }
+
+    *this = *prototype;
+
+    // stats and skills.
+    _Initialize();
+
+    _CalculateAttackRatings();
+    _CalculateDefenseRatings();
+    _CalculateEvadeRatings();
+}
+
+bool GlobalEnemy::_LoadDefinition(uint32_t id)
 {
     _id = id;
 
     if(_id == 0) {
         PRINT_ERROR << "invalid id for loading enemy data: " << _id << std::endl;
-        return;
+        return false;
     }
 
     // Open the script file and table that store the enemy data
@@ -46,7 +69,7 @@ GlobalEnemy::GlobalEnemy(uint32_t id) :
     if (!enemy_data.OpenTable(_id)) {
         PRINT_ERROR << "Failed to open the enemies[" << _id << "] table in: "
             << enemy_data.GetFilename() << std::endl;
-        return;
+        return false;
     }
 
     // Load the enemy's name and sprite data
@@ -158,12 +181,7 @@ GlobalEnemy::GlobalEnemy(uint32_t id) :
                       << std::endl << enemy_data.GetErrorMessages() << std::endl;
     }
 
-    // stats and skills.
-    _Initialize();
-
-    _CalculateAttackRatings();
-    _CalculateDefenseRatings();
-    _CalculateEvadeRatings();
+    return true;
 }
 
 bool GlobalEnemy::AddSkill(uint32_t skill_id)
@@ -54,6 +54,10 @@ enum GLOBAL_ENEMY_HURT {
 class GlobalEnemy : public GlobalActor
 {
 public:
+    /** \param id The enemy id in the enemies definition script.
+    *** \note The enemy is copied from its prototype, @see PrototypeHandler,
+    *** and then gets its own randomized stats.
+    **/
     explicit GlobalEnemy(uint32_t id);
     virtual ~GlobalEnemy() override
     {
@@ -139,6 +143,18 @@ protected:
     *** \note Certain enemies can skip the stat randomization step.
     **/
     void _Initialize();
+
+private:
+    friend class PrototypeHandler;
+
+    //! \brief Creates an empty enemy, used to load the enemy prototypes.
+    GlobalEnemy();
+
+    /** \brief Reads the enemy definition from the enemies script.
+    *** The stats aren't randomized and the skills aren't added to the prototypes.
+    *** \return whether the definition could be read.
+    **/
+    bool _LoadDefinition(uint32_t id);
 }; // class GlobalEnemy : public GlobalActor
 
 } // namespace vt_global
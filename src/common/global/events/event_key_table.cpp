@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "event_key_table.h"
+
+namespace vt_global
+{
+
+//! \brief The initial number of hash table slots.
+static const uint32_t EVENT_KEY_TABLE_MIN_SLOTS = 256;
+
+uint32_t EventKeyTable::Find(uint32_t scope, const std::string& name) const
+{
+    if (_slots.empty())
+        return INVALID_EVENT_KEY;
+
+    return _slots[_FindSlot(scope, name, _Hash(scope, name))];
+}
+
+uint32_t EventKeyTable::Insert(uint32_t scope, const std::string& name)
+{
+    // Keep at most half of the slots used, so that the probing stays short.
+    if ((_keys.size() + 1) * 2 > _slots.size())
+        _Grow();
+
+    uint32_t hash = _Hash(scope, name);
+    uint32_t slot = _FindSlot(scope, name, hash);
+    if (_slots[slot] != INVALID_EVENT_KEY)
+        return _slots[slot];
+
+    Key key;
+    key.scope = scope;
+    key.hash = hash;
+    key.name = name;
+    _keys.push_back(key);
+
+    uint32_t id = static_cast<uint32_t>(_keys.size() - 1);
+    _slots[slot] = id;
+    return id;
+}
+
+uint32_t EventKeyTable::_Hash(uint32_t scope, const std::string& name)
+{
+    // FNV-1a, starting with the scope bytes.
+    uint32_t hash = 2166136261u;
+    for (uint32_t i = 0; i < sizeof(scope); ++i) {
+        hash ^= (scope >> (8 * i)) & 0xff;
+        hash *= 16777619u;
+    }
+    for (size_t i = 0; i < name.size(); ++i) {
+        hash ^= static_cast<uint8_t>(name[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+uint32_t EventKeyTable::_FindSlot(uint32_t scope, const std::string& name, uint32_t hash) const
+{
+    const uint32_t mask = static_cast<uint32_t>(_slots.size()) - 1;
+    uint32_t slot = hash & mask;
+    while (_slots[slot] != INVALID_EVENT_KEY) {
+        const Key& key = _keys[_slots[slot]];
+        if (key.hash == hash && key.scope == scope && key.name == name)
+            break;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void EventKeyTable::_Grow()
+{
+    uint32_t slots_number = _slots.empty() ? EVENT_KEY_TABLE_MIN_SLOTS
+                                           : static_cast<uint32_t>(_slots.size()) * 2;
+    _slots.assign(slots_number, INVALID_EVENT_KEY);
+
+    const uint32_t mask = slots_number - 1;
+    for (uint32_t id = 0; id < _keys.size(); ++id) {
+        uint32_t slot = _keys[id].hash & mask;
+        while (_slots[slot] != INVALID_EVENT_KEY)
+            slot = (slot + 1) & mask;
+        _slots[slot] = id;
+    }
+}
+
+} // namespace vt_global
@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __EVENT_KEY_TABLE_HEADER__
+#define __EVENT_KEY_TABLE_HEADER__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vt_global
+{
+
+//! \brief The id given when a key isn't in the table.
+const uint32_t INVALID_EVENT_KEY = 0xFFFFFFFF;
+
+/** ****************************************************************************
+*** \brief Interns the event keys, giving each of them a stable id.
+***
+*** A key is a name within a scope: the scope of an event name is the id of its
+*** group name, while group names use no scope. The ids are given in insertion
+*** order and never change, so that they can be used as indices.
+***
+*** The ids are found through an open addressing hash table with linear probing,
+*** and each key hash is kept so that the probing only compares the names of
+*** keys having the same hash.
+*** ***************************************************************************/
+class EventKeyTable
+{
+public:
+    EventKeyTable()
+    {}
+
+    //! \brief Returns the id of the given key, or INVALID_EVENT_KEY when it isn't in the table.
+    uint32_t Find(uint32_t scope, const std::string& name) const;
+
+    //! \brief Returns the id of the given key, adding it to the table when needed.
+    uint32_t Insert(uint32_t scope, const std::string& name);
+
+    //! \brief Returns the number of keys in the table, which is also the next id given.
+    uint32_t GetSize() const {
+        return static_cast<uint32_t>(_keys.size());
+    }
+
+    const std::string& GetName(uint32_t id) const {
+        return _keys[id].name;
+    }
+
+    uint32_t GetScope(uint32_t id) const {
+        return _keys[id].scope;
+    }
+
+private:
+    struct Key {
+        uint32_t scope;
+        uint32_t hash;
+        std::string name;
+    };
+
+    //! \brief The interned keys, indexed by id.
+    std::vector<Key> _keys;
+
+    //! \brief The hash table slots, holding key ids. Its size is always a power of two.
+    std::vector<uint32_t> _slots;
+
+    static uint32_t _Hash(uint32_t scope, const std::string& name);
+
+    //! \brief Returns the slot holding the given key, or the empty slot where it would be.
+    uint32_t _FindSlot(uint32_t scope, const std::string& name, uint32_t hash) const;
+
+    //! \brief Doubles the number of slots, and inserts the keys again.
+    void _Grow();
+};
+
+} // namespace vt_global
+
+#endif // __EVENT_KEY_TABLE_HEADER__
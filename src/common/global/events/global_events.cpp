@@ -10,12 +10,17 @@
 
 #include "global_events.h"
 
+#include <algorithm>
+
 using namespace vt_utils;
 using namespace vt_script;
 
 namespace vt_global
 {
 
+//! \brief The scope of the group names in their key table.
+static const uint32_t EVENT_GROUP_SCOPE = 0;
+
 GameEvents::GameEvents()
 {
 }
@@ -27,93 +32,84 @@ GameEvents::~GameEvents()
 
 void GameEvents::Clear()
 {
-    // Delete all event groups
-    for(std::map<std::string, GlobalEventGroup *>::iterator it = _event_groups.begin(); it != _event_groups.end(); ++it) {
-        delete(it->second);
-    }
-    _event_groups.clear();
+    // The keys are kept, so that the handles given stay valid.
+    for(uint32_t i = 0; i < _events.size(); ++i)
+        _events[i] = EventValue();
 }
 
 bool GameEvents::DoesEventExist(const std::string& group_name, const std::string& event_name) const
 {
-    std::map<std::string, GlobalEventGroup *>::const_iterator group_iter = _event_groups.find(group_name);
-    if(group_iter == _event_groups.end())
-        return false;
-
-    std::map<std::string, int32_t>::const_iterator event_iter = group_iter->second->GetEvents().find(event_name);
-    if(event_iter == group_iter->second->GetEvents().end())
-        return false;
-
-    return true;
+    return DoesEventExistFromHandle(_FindEventKey(group_name, event_name));
 }
 
 int32_t GameEvents::GetEventValue(const std::string& group_name, const std::string& event_name) const
 {
-    std::map<std::string, GlobalEventGroup *>::const_iterator group_iter = _event_groups.find(group_name);
-    if(group_iter == _event_groups.end())
-        return 0;
-
-    std::map<std::string, int32_t>::const_iterator event_iter = group_iter->second->GetEvents().find(event_name);
-    if(event_iter == group_iter->second->GetEvents().end())
-        return 0;
-
-    return event_iter->second;
+    return GetEventValueFromHandle(_FindEventKey(group_name, event_name));
 }
 
 void GameEvents::SetEventValue(const std::string& group_name,
                                const std::string& event_name,
                                int32_t event_value)
 {
-    GlobalEventGroup* geg = nullptr;
-    std::map<std::string, GlobalEventGroup *>::const_iterator group_iter = _event_groups.find(group_name);
-    if(group_iter == _event_groups.end()) {
-        geg = new GlobalEventGroup(group_name);
-        _event_groups.insert(std::make_pair(group_name, geg));
-    } else {
-        geg = group_iter->second;
-    }
+    SetEventValueFromHandle(GetEventHandle(group_name, event_name), event_value);
+}
 
-    geg->SetEvent(event_name, event_value);
+uint32_t GameEvents::GetEventHandle(const std::string& group_name, const std::string& event_name)
+{
+    uint32_t group_id = _group_names.Insert(EVENT_GROUP_SCOPE, group_name);
+    uint32_t event_handle = _event_keys.Insert(group_id, event_name);
+    if (event_handle >= _events.size())
+        _events.resize(event_handle + 1);
+    return event_handle;
 }
 
-void GameEvents::SaveEvents(WriteScriptDescriptor& file)
+void GameEvents::SetEventValueFromHandle(uint32_t event_handle, int32_t event_value)
 {
-    if(file.IsFileOpen() == false) {
-        PRINT_WARNING << "the file provided in the function argument was not open" << std::endl;
+    if (event_handle >= _events.size()) {
+        PRINT_WARNING << "Invalid event handle: " << event_handle << std::endl;
         return;
     }
 
-    file.InsertNewLine();
-    file.WriteLine("event_groups = {");
-    for(auto it = _event_groups.begin(); it != _event_groups.end(); ++it) {
-        GlobalEventGroup* event_group = it->second;
-
-        file.WriteLine("\t" + event_group->GetGroupName() + " = {");
-
-        uint32_t i = 0;
-        for(auto it = event_group->GetEvents().begin(); it != event_group->GetEvents().end(); ++it) {
-            if(it == event_group->GetEvents().begin())
-                file.WriteLine("\t\t", false);
-            else
-                file.WriteLine(", ", false);
-
-            // Add a new line every 4 entries for better readability and debugging
-            if ((i > 0) && !(i % 4)) {
-                file.InsertNewLine();
-                file.WriteLine("\t\t", false);
-            }
+    _events[event_handle].value = event_value;
+    _events[event_handle].exists = true;
+}
 
-            file.WriteLine("[\"" + it->first + "\"] = " + NumberToString(it->second), false);
+void GameEvents::SaveEvents(SaveGameWriter& file)
+{
+    // Sort the events, so that the output doesn't depend on when they were first used.
+    std::vector<uint32_t> event_ids;
+    for(uint32_t i = 0; i < _events.size(); ++i) {
+        if (_events[i].exists)
+            event_ids.push_back(i);
+    }
+    std::sort(event_ids.begin(), event_ids.end(), [this](uint32_t first, uint32_t second) {
+        uint32_t first_group = _event_keys.GetScope(first);
+        uint32_t second_group = _event_keys.GetScope(second);
+        if (first_group != second_group)
+            return _group_names.GetName(first_group) < _group_names.GetName(second_group);
+        return _event_keys.GetName(first) < _event_keys.GetName(second);
+    });
+
+    uint32_t groups_number = 0;
+    for(uint32_t i = 0; i < event_ids.size(); ++i) {
+        if (i == 0 || _event_keys.GetScope(event_ids[i]) != _event_keys.GetScope(event_ids[i - 1]))
+            ++groups_number;
+    }
 
-            ++i;
+    file.WriteUInt32(groups_number);
+    for(uint32_t i = 0; i < event_ids.size();) {
+        uint32_t group_id = _event_keys.GetScope(event_ids[i]);
+        uint32_t group_end = i;
+        while (group_end < event_ids.size() && _event_keys.GetScope(event_ids[group_end]) == group_id)
+            ++group_end;
+
+        file.WriteString(_group_names.GetName(group_id));
+        file.WriteUInt32(group_end - i);
+        for(; i < group_end; ++i) {
+            file.WriteString(_event_keys.GetName(event_ids[i]));
+            file.WriteInt32(_events[event_ids[i]].value);
         }
-        file.WriteLine("\n\t},");
-
     }
-
-    file.WriteLine("},"); // event_groups
-    file.InsertNewLine();
-
 }
 
 void GameEvents::LoadEvents(ReadScriptDescriptor& file)
@@ -130,16 +126,12 @@ void GameEvents::LoadEvents(ReadScriptDescriptor& file)
     file.ReadTableKeys(group_names);
     for(uint32_t i = 0; i < group_names.size(); i++) {
         std::string group_name = group_names[i];
-        _AddNewEventGroup(group_name);
-        // new_group is guaranteed not to be nullptr
-        GlobalEventGroup* new_group = _GetEventGroup(group_name);
-
         std::vector<std::string> event_names;
 
         if (file.OpenTable(group_name)) {
             file.ReadTableKeys(event_names);
             for(uint32_t i = 0; i < event_names.size(); i++) {
-                new_group->AddNewEvent(event_names[i], file.ReadInt(event_names[i]));
+                SetEventValue(group_name, event_names[i], file.ReadInt(event_names[i]));
             }
             file.CloseTable();
         }
@@ -151,26 +143,27 @@ void GameEvents::LoadEvents(ReadScriptDescriptor& file)
     file.CloseTable(); // event_groups
 }
 
-void GameEvents::_AddNewEventGroup(const std::string& group_name)
+void GameEvents::LoadEvents(SaveGameReader& file)
 {
-    if(_DoesEventGroupExist(group_name)) {
-        PRINT_WARNING << "failed because there was already an event group that existed for "
-                      << "the requested group name: " << group_name << std::endl;
-        return;
+    uint32_t groups_number = file.ReadUInt32();
+    for(uint32_t i = 0; i < groups_number && !file.IsErrorDetected(); ++i) {
+        std::string group_name = file.ReadString();
+
+        uint32_t events_number = file.ReadUInt32();
+        for(uint32_t j = 0; j < events_number && !file.IsErrorDetected(); ++j) {
+            std::string event_name = file.ReadString();
+            SetEventValue(group_name, event_name, file.ReadInt32());
+        }
     }
-
-    GlobalEventGroup* geg = new GlobalEventGroup(group_name);
-    _event_groups.insert(std::make_pair(group_name, geg));
 }
 
-GlobalEventGroup* GameEvents::_GetEventGroup(const std::string& group_name) const
+uint32_t GameEvents::_FindEventKey(const std::string& group_name, const std::string& event_name) const
 {
-    std::map<std::string, GlobalEventGroup *>::const_iterator group_iter = _event_groups.find(group_name);
-    if(group_iter == _event_groups.end()) {
-        PRINT_WARNING << "could not find any event group by the requested name: " << group_name << std::endl;
-        return nullptr;
-    }
-    return (group_iter->second);
+    uint32_t group_id = _group_names.Find(EVENT_GROUP_SCOPE, group_name);
+    if (group_id == INVALID_EVENT_KEY)
+        return INVALID_EVENT_KEY;
+
+    return _event_keys.Find(group_id, event_name);
 }
 
 } // namespace vt_global
@@ -11,10 +11,11 @@
 #ifndef __GLOBAL_EVENTS_HEADER__
 #define __GLOBAL_EVENTS_HEADER__
 
+#include "common/global/save/save_game_file.h"
+
 #include "script/script_read.h"
-#include "script/script_write.h"
 
-#include "global_event_group.h"
+#include "event_key_table.h"
 
 //! \brief All calls to global code are wrapped inside this namespace.
 namespace vt_global
@@ -28,7 +29,7 @@ public:
     GameEvents();
     ~GameEvents();
 
-    //! \brief Deletes all data.
+    //! \brief Deletes all the events. The event handles stay valid.
     void Clear();
 
     /** \brief Determines if an event of a given name exists within a given group
@@ -53,45 +54,68 @@ public:
     **/
     void SetEventValue(const std::string& group_name, const std::string& event_name, int32_t event_value);
 
-    /** \brief A helper function to GameGlobal::SaveGame() that writes a group of event data to the saved game file
-    *** \param file A reference to the open and valid file where to write the event data
-    *** This method will need to be called once for each GlobalEventGroup contained by this class.
+    /** \brief Returns a handle to the given event, used to query or change its value
+    *** without looking up its group and event names again.
+    *** The handle stays valid for the whole game session, even after loading another game.
+    *** \note The event isn't created by this call: it exists once its value is set.
     **/
-    void SaveEvents(vt_script::WriteScriptDescriptor& file);
+    uint32_t GetEventHandle(const std::string& group_name, const std::string& event_name);
+
+    //! \brief Tells whether the event of the given handle was set.
+    bool DoesEventExistFromHandle(uint32_t event_handle) const {
+        return event_handle < _events.size() && _events[event_handle].exists;
+    }
+
+    //! \brief Returns the value of the event of the given handle, or 0 if it was not set.
+    int32_t GetEventValueFromHandle(uint32_t event_handle) const {
+        return event_handle < _events.size() ? _events[event_handle].value : 0;
+    }
+
+    //! \brief Sets the value of the event of the given handle.
+    void SetEventValueFromHandle(uint32_t event_handle, int32_t event_value);
+
+    /** \brief A helper function to GameGlobal::SaveGame() that writes every event group to the saved game file
+    *** \param file A reference to the save game being written
+    *** The groups and their events are written ordered by name.
+    **/
+    void SaveEvents(SaveGameWriter& file);
 
     /** \brief A helper function to GameGlobal::LoadGame() that loads a group of game events from a saved game file
     *** \param file A reference to the open and valid file from where to read the event data from
     **/
     void LoadEvents(vt_script::ReadScriptDescriptor& file);
 
+    //! \brief Loads the game events from a binary saved game, written by SaveEvents().
+    void LoadEvents(SaveGameReader& file);
+
 private:
-    /** \brief Queries whether or not an event group of a given name exists
-    *** \param group_name The name of the event group to check for
-    *** \return True if the event group name was found, false if it was not
+    //! \brief The value of an event, indexed by the event key id.
+    struct EventValue {
+        EventValue():
+            value(0),
+            exists(false)
+        {}
+
+        int32_t value;
+
+        //! \brief Whether the value was set. The keys are never removed, unlike the events.
+        bool exists;
+    };
+
+    /** \brief The interned group names.
+    *** Events are stored in groups, a typical event group representing all of the events
+    *** that occured on a particular map.
     **/
-    bool _DoesEventGroupExist(const std::string& group_name) const {
-        return (_event_groups.find(group_name) != _event_groups.end());
-    }
+    EventKeyTable _group_names;
 
-    /** \brief Adds a new event group for the class to manage
-    *** \param group_name The name of the new event group to add
-    *** \note If an event group  by the given name already exists, the function will abort
-    *** and not add the new event group. Otherwise, this class will automatically construct
-    *** a new event group of the given name and place it in its map of event groups.
-    **/
-    void _AddNewEventGroup(const std::string& group_name);
+    //! \brief The interned event names, scoped by their group name id.
+    EventKeyTable _event_keys;
 
-    /** \brief Returns a pointer to an event group of the specified name
-    *** \param group_name The name of the event group to retreive
-    *** \return A pointer to the GlobalEventGroup that represents the event group, or nullptr if no event group
-    *** of the specified name was found.
-    **/
-    GlobalEventGroup* _GetEventGroup(const std::string& group_name) const;
+    //! \brief The event values, indexed by event key id, which is also the event handle.
+    std::vector<EventValue> _events;
 
-    /** \brief The container which stores all of the groups of events that have occured in the game
-    *** The name of each GlobalEventGroup object serves as its key in this map data structure.
-    **/
-    std::map<std::string, GlobalEventGroup*> _event_groups;
+    //! \brief Returns the key id of the given event, or INVALID_EVENT_KEY if it was never used.
+    uint32_t _FindEventKey(const std::string& group_name, const std::string& event_name) const;
 };
 
 } // namespace vt_global
@@ -61,6 +61,9 @@ bool GameGlobal::SingletonInitialize()
 }
 
 void GameGlobal::_CloseGlobalScripts() {
+    // The prototypes are read again from the scripts once reopened.
+    _prototype_handler.Clear();
+
     // Close all persistent script files
     _global_script.CloseFile();
 
@@ -193,8 +196,7 @@ bool GameGlobal::AutoSave(const std::string& map_data_file,
     if (GetGameSlotId() == std::numeric_limits<uint32_t>::max())
         return false;
 
-    std::ostringstream filename;
-    filename << GetUserDataPath() + "saved_game_" << GetGameSlotId() << "_autosave.lua";
+    std::string filename = GetSaveGameFilename(GetGameSlotId(), true);
 
     // Make the map location known globally to other code that may need to know this information
     std::string previous_map_data = _map_data_handler.GetMapDataFilename();
@@ -205,13 +207,17 @@ bool GameGlobal::AutoSave(const std::string& map_data_file,
     _map_data_handler.SetMapScriptFilename(map_script_file);
     _map_data_handler.SetSaveStamina(stamina);
 
-    bool save_completed = SaveGame(filename.str(), GetGameSlotId(), x_position, y_position);
+    // Snapshot the game state now, and let the save thread write it.
+    SaveGamePreview preview;
+    SaveGameWriter file;
+    _WriteSaveGame(preview, file, x_position, y_position);
+    _save_thread.QueueSave(filename, GetGameSlotId(), preview, file);
 
     // Restore previous map data
     _map_data_handler.SetMapDataFilename(previous_map_data);
     _map_data_handler.SetMapScriptFilename(previous_map_script);
 
-    return save_completed;
+    return true;
 }
 
 bool GameGlobal::SaveGame(const std::string& filename,
@@ -222,20 +228,44 @@ bool GameGlobal::SaveGame(const std::string& filename,
     if (slot_id >= SystemManager->GetGameSaveSlots())
         return false;
 
-    WriteScriptDescriptor file;
-    if(file.OpenFile(filename) == false) {
+    SaveGamePreview preview;
+    SaveGameWriter file;
+    _WriteSaveGame(preview, file, x_position, y_position);
+    if (!file.SaveFile(filename, preview))
         return false;
-    }
 
-    // Open the save_game1 table
-    file.WriteLine("save_game1 = {");
+    // Store the game slot the game is coming from.
+    _game_slot_id = slot_id;
 
-    // Save simple play data
-    file.InsertNewLine();
-    file.WriteLine("play_hours = " + NumberToString(SystemManager->GetPlayHours()) + ",");
-    file.WriteLine("play_minutes = " + NumberToString(SystemManager->GetPlayMinutes()) + ",");
-    file.WriteLine("play_seconds = " + NumberToString(SystemManager->GetPlaySeconds()) + ",");
-    file.WriteLine("drunes = " + NumberToString(_drunes) + ",");
+    return true;
+}
+
+void GameGlobal::_WriteSaveGame(SaveGamePreview& preview, SaveGameWriter& file,
+                                uint32_t x_position, uint32_t y_position)
+{
+    // The header data, shown in the save menu.
+    preview.play_hours = SystemManager->GetPlayHours();
+    preview.play_minutes = SystemManager->GetPlayMinutes();
+    preview.play_seconds = SystemManager->GetPlaySeconds();
+    preview.drunes = _drunes;
+    preview.map_data_filename = _map_data_handler.GetMapDataFilename();
+    preview.map_script_filename = _map_data_handler.GetMapScriptFilename();
+
+    std::vector<GlobalCharacter*>* characters = _character_handler.GetOrderedCharacters();
+    for(uint32_t i = 0; i < characters->size() && i < SAVE_GAME_PREVIEW_CHARACTERS; ++i) {
+        GlobalCharacter* character = characters->at(i);
+        SaveCharacterPreview character_preview;
+        character_preview.id = character->GetID();
+        character_preview.experience_level = character->GetExperienceLevel();
+        character_preview.total_experience_points = character->GetTotalExperiencePoints();
+        character_preview.unspent_experience_points = character->GetUnspentExperiencePoints();
+        character_preview.experience_points_next = character->GetExperienceForNextLevel();
+        character_preview.max_hit_points = character->GetMaxHitPoints();
+        character_preview.hit_points = character->GetHitPoints();
+        character_preview.max_skill_points = character->GetMaxSkillPoints();
+        character_preview.skill_points = character->GetSkillPoints();
+        preview.characters.push_back(character_preview);
+    }
 
     _map_data_handler.Save(file, x_position, y_position);
 
@@ -250,17 +280,16 @@ bool GameGlobal::SaveGame(const std::string& filename,
     _worldmap_handler.SaveWorldMap(file);
 
     _shop_data_handler.SaveShopData(file);
+}
 
-    if(file.IsErrorDetected()) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "One or more errors occurred while writing the save game file - they are listed below:" << std::endl
-            << file.GetErrorMessages() << std::endl;
-        file.ClearErrors();
-    }
-
-    file.InsertNewLine();
-    file.WriteLine("} -- save_game1"); //save_game1
+bool GameGlobal::LoadGame(const std::string &filename, uint32_t slot_id)
+{
+    // Make sure a pending autosave of the slot is written first.
+    _save_thread.WaitForCompletion();
 
-    file.CloseFile();
+    bool game_loaded = IsBinarySaveGame(filename) ? _LoadBinaryGame(filename) : _LoadLuaGame(filename);
+    if (!game_loaded)
+        return false;
 
     // Store the game slot the game is coming from.
     _game_slot_id = slot_id;
@@ -268,7 +297,49 @@ bool GameGlobal::SaveGame(const std::string& filename,
     return true;
 }
 
-bool GameGlobal::LoadGame(const std::string &filename, uint32_t slot_id)
+bool GameGlobal::LoadGamePreview(const std::string &filename, SaveGamePreview& preview)
+{
+    if (IsBinarySaveGame(filename))
+        return SaveGameReader::ReadPreview(filename, preview);
+
+    return _LoadLuaGamePreview(filename, preview);
+}
+
+bool GameGlobal::_LoadBinaryGame(const std::string &filename)
+{
+    SaveGameReader file;
+    if (!file.OpenFile(filename))
+        return false;
+
+    ClearAllData();
+
+    const SaveGamePreview& preview = file.GetPreview();
+    SystemManager->SetPlayTime(preview.play_hours, preview.play_minutes, preview.play_seconds);
+    _drunes = preview.drunes;
+
+    _map_data_handler.Load(file);
+
+    _inventory_handler.LoadInventory(file);
+
+    _character_handler.LoadCharacters(file);
+
+    _game_events.LoadEvents(file);
+
+    _game_quests.LoadQuests(file);
+
+    _worldmap_handler.LoadWorldMap(file);
+
+    _shop_data_handler.LoadShopData(file);
+
+    if (file.IsErrorDetected()) {
+        PRINT_ERROR << "The save game file is truncated or corrupted: " << filename << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool GameGlobal::_LoadLuaGame(const std::string &filename)
 {
     ReadScriptDescriptor file;
     if(!file.OpenFile(filename))
@@ -315,8 +386,80 @@ bool GameGlobal::LoadGame(const std::string &filename, uint32_t slot_id)
 
     file.CloseFile();
 
-    // Store the game slot the game is coming from.
-    _game_slot_id = slot_id;
+    return true;
+}
+
+bool GameGlobal::_LoadLuaGamePreview(const std::string &filename, SaveGamePreview& preview)
+{
+    ReadScriptDescriptor file;
+
+    // Clear out the save data namespace to avoid loading false information
+    // when dealing with a save game that has an invalid namespace
+    ScriptManager->DropGlobalTable("save_game1");
+
+    if(!file.OpenFile(filename))
+        return false;
+
+    if(!file.DoesTableExist("save_game1")) {
+        file.CloseFile();
+        return false;
+    }
+
+    // open the namespace that the save game is encapsulated in.
+    file.OpenTable("save_game1");
+
+    preview.map_script_filename = file.ReadString("map_script_filename");
+    preview.map_data_filename = file.ReadString("map_data_filename");
+
+    preview.play_hours = file.ReadUInt("play_hours");
+    preview.play_minutes = file.ReadUInt("play_minutes");
+    preview.play_seconds = file.ReadUInt("play_seconds");
+    preview.drunes = file.ReadUInt("drunes");
+
+    if(!file.DoesTableExist("characters")) {
+        file.CloseTable(); // save_game1
+        file.CloseFile();
+        return false;
+    }
+
+    // Read characters table content
+    file.OpenTable("characters");
+    std::vector<uint32_t> char_ids;
+    file.ReadUIntVector("order", char_ids);
+
+    // Loads only up to the first four slots (Visible battle characters)
+    for(uint32_t i = 0; i < char_ids.size() && i < SAVE_GAME_PREVIEW_CHARACTERS; ++i) {
+        if (!file.DoesTableExist(char_ids[i]))
+            continue;
+
+        file.OpenTable(char_ids[i]);
+
+        SaveCharacterPreview character;
+        character.id = char_ids[i];
+        character.experience_level = file.ReadUInt("experience_level");
+        character.total_experience_points = file.ReadUInt("total_experience_points");
+        character.unspent_experience_points = file.ReadUInt("unspent_experience_points");
+        character.experience_points_next = file.ReadInt("experience_points_next");
+
+        character.max_hit_points = file.ReadUInt("max_hit_points");
+        character.hit_points = file.ReadUInt("hit_points");
+        character.max_skill_points = file.ReadUInt("max_skill_points");
+        character.skill_points = file.ReadUInt("skill_points");
+        preview.characters.push_back(character);
+
+        file.CloseTable(); // character id
+    }
+    file.CloseTable(); // characters
+
+    // Report any errors detected from the previous read operations
+    if(file.IsErrorDetected()) {
+        PRINT_WARNING << "One or more errors occurred while reading the save game file - they are listed below:"
+            << std::endl << file.GetErrorMessages() << std::endl;
+            file.ClearErrors();
+    }
+
+    file.CloseTable(); // save_game1
+    file.CloseFile();
 
     return true;
 }
@@ -14,7 +14,6 @@
 #include "utils/utils_strings.h"
 
 #include "script/script_read.h"
-#include "script/script_write.h"
 
 #include "media/global_media.h"
 #include "media/battle_media.h"
@@ -36,6 +35,9 @@
 #include "maps/map_data_handler.h"
 #include "shop/shop_data_handler.h"
 #include "emotes/emote_handler.h"
+#include "prototypes/prototype_handler.h"
+#include "save/save_game_file.h"
+#include "save/save_game_thread.h"
 
 //! \brief All calls to global code are wrapped inside this namespace.
 namespace vt_global
@@ -92,6 +94,13 @@ public:
     **/
     bool LoadGame(const std::string &filename, uint32_t slot_id);
 
+    /** \brief Reads the data shown in the save menu from a saved game file, without loading the game
+    *** \param filename The filename of the saved game file, either binary or Lua
+    *** \param preview Where to store the save game data
+    *** \return False if the file isn't a valid saved game
+    **/
+    bool LoadGamePreview(const std::string &filename, SaveGamePreview& preview);
+
     /** \brief Saves all global data to a saved game file
     *** \param filename The filename of the saved game file where to write the data to
     *** \param slot_id The game slot id used for the save menu.
@@ -100,11 +109,37 @@ public:
     **/
     bool SaveGame(const std::string &filename, uint32_t slot_id, uint32_t x_position = 0, uint32_t y_position = 0);
 
-    //! \brief Attempts an autosave on the current slot, using given map and location.
+    /** \brief Attempts an autosave on the current slot, using given map and location.
+    *** The game state is copied right away, but the file is written in the background.
+    *** \return False if no save slot was chosen yet.
+    **/
     bool AutoSave(const std::string& map_data_file, const std::string& map_script_file,
                   uint32_t stamina,
                   uint32_t x_position = 0, uint32_t y_position = 0);
 
+    //! \brief Tells whether an autosave of the given slot is still being written.
+    bool IsAutoSaving(uint32_t slot_id) {
+        return _save_thread.IsSaving(slot_id);
+    }
+
+    //! \brief Blocks until the autosaves are written.
+    void WaitForAutoSaves() {
+        _save_thread.WaitForCompletion();
+    }
+
+    //! \brief Calls the autosave completion callback for the autosaves written since the last call.
+    //! Called once per frame by the mode manager.
+    void UpdateAutoSaves() {
+        _save_thread.UpdateCompletedSaves();
+    }
+
+    /** \brief Sets the function called once an autosave is written, on the main thread.
+    *** Its parameters are the save slot id and whether the autosave succeeded.
+    **/
+    void SetAutoSaveCallback(const SaveGameCallback& callback) {
+        _save_thread.SetCompletionCallback(callback);
+    }
+
     //! \brief Gets the last load/save position.
     uint32_t GetGameSlotId() const {
         return _game_slot_id;
@@ -210,6 +245,11 @@ public:
         return _emote_handler;
     }
 
+    //! \brief Get a reference to the objects, skills and enemies prototypes.
+    PrototypeHandler& GetPrototypeHandler() {
+        return _prototype_handler;
+    }
+
     //! \brief Gives access to global media files.
     //! Note: The reference is passed non const to be able to give modifiable references
     //! and pointers.
@@ -257,6 +297,11 @@ private:
 
     EmoteHandler _emote_handler;
 
+    PrototypeHandler _prototype_handler;
+
+    //! \brief Writes the autosaves in the background.
+    SaveGameThread _save_thread;
+
     //! \brief member storing all the common media files.
     GlobalMedia _global_media;
 
@@ -304,6 +349,19 @@ private:
 
     //! \brief Unloads every persistent scripts by closing their files.
     void _CloseGlobalScripts();
+
+    //! \brief Fills the save game header data and body from the current game state.
+    void _WriteSaveGame(SaveGamePreview& preview, SaveGameWriter& file,
+                        uint32_t x_position, uint32_t y_position);
+
+    //! \brief Loads a binary saved game, written by SaveGame().
+    bool _LoadBinaryGame(const std::string &filename);
+
+    //! \brief Loads a saved game written as a Lua script by the previous game versions.
+    bool _LoadLuaGame(const std::string &filename);
+
+    //! \brief Reads the save menu data from a saved game written as a Lua script.
+    bool _LoadLuaGamePreview(const std::string &filename, SaveGamePreview& preview);
 };
 
 } // namespace vt_global
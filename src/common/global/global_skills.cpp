@@ -38,8 +38,8 @@ namespace vt_global
 
 //using namespace private_global;
 
-GlobalSkill::GlobalSkill(uint32_t id) :
-    _id(id),
+GlobalSkill::GlobalSkill() :
+    _id(0),
     _show_skill_notice(false),
     _type(GLOBAL_SKILL_INVALID),
     _sp_required(0),
@@ -47,6 +47,23 @@ GlobalSkill::GlobalSkill(uint32_t id) :
     _cooldown_time(0),
     _target_type(GLOBAL_TARGET_INVALID)
 {
+}
+
+GlobalSkill::GlobalSkill(uint32_t id) :
+    GlobalSkill()
+{
+    const GlobalSkill* prototype = GlobalManager->GetPrototypeHandler().GetSkill(id);
+    if(prototype == nullptr)
+        return;
+
+    // The assignment keeps the skill notice setting, unlike the copy constructor.
+    *this = *prototype;
+}
+
+bool GlobalSkill::_LoadDefinition(uint32_t id)
+{
+    _id = id;
+
     // A pointer to the skill script which will be used to load this skill
     ReadScriptDescriptor *skill_script = nullptr;
 
@@ -65,14 +82,14 @@ GlobalSkill::GlobalSkill(uint32_t id) :
     } else {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "constructor received an invalid id argument: " << id << std::endl;
         _id = 0; // Indicate that this skill is invalid
-        return;
+        return false;
     }
 
     // Load the skill properties from the script
     if(!skill_script->DoesTableExist(_id)) {
         PRINT_WARNING << "No valid data for skill in definition file: " << _id << std::endl;
         _id = 0; // Indicate that this skill is invalid
-        return;
+        return false;
     }
 
     skill_script->OpenTable(_id);
@@ -113,6 +130,8 @@ GlobalSkill::GlobalSkill(uint32_t id) :
                       << std::endl << skill_script->GetErrorMessages() << std::endl;
         _id = 0; // Indicate that this skill is invalid
     }
+
+    return IsValid();
 }
 
 GlobalSkill::GlobalSkill(const GlobalSkill& copy):
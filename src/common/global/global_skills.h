@@ -79,7 +79,9 @@ const uint32_t MAX_BARE_HANDS_SKILL_ID = 40000;
 class GlobalSkill
 {
 public:
-    //! \param id The identification number of the skill to construct
+    /** \param id The identification number of the skill to construct
+    *** \note The skill is copied from its prototype, @see PrototypeHandler.
+    **/
     explicit GlobalSkill(uint32_t id);
 
     ~GlobalSkill()
@@ -184,6 +186,16 @@ public:
     //@}
 
 private:
+    friend class PrototypeHandler;
+
+    //! \brief Creates an empty skill, used to load the skill prototypes.
+    GlobalSkill();
+
+    /** \brief Reads the skill definition from the script matching its type.
+    *** \return whether the definition is valid.
+    **/
+    bool _LoadDefinition(uint32_t id);
+
     //! \brief The unique identifier number of the skill.
     uint32_t _id;
 
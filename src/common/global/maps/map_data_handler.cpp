@@ -81,32 +81,53 @@ bool MapDataHandler::Load(vt_script::ReadScriptDescriptor& file)
     return true;
 }
 
-bool MapDataHandler::Save(vt_script::WriteScriptDescriptor& file,
-                          uint32_t x_position,
-                          uint32_t y_position)
+bool MapDataHandler::Load(SaveGameReader& file)
 {
-    if(!file.IsFileOpen()) {
-        return false;
+    Clear();
+
+    _map_data_filename = file.ReadString();
+    _map_script_filename = file.ReadString();
+
+    // Loads saved position, if any
+    _x_save_map_position = file.ReadUInt32();
+    _y_save_map_position = file.ReadUInt32();
+
+    _save_stamina = file.ReadUInt32();
+
+    // Load home map data, if any
+    if (file.ReadBool()) {
+        std::string home_map_data = file.ReadString();
+        std::string home_map_script = file.ReadString();
+        uint32_t x_pos = file.ReadUInt32();
+        uint32_t y_pos = file.ReadUInt32();
+
+        _home_map = vt_map::MapLocation(home_map_data,
+                                        home_map_script,
+                                        x_pos, y_pos);
     }
 
-    file.InsertNewLine();
-    file.WriteLine("map_data_filename = \"" + _map_data_filename + "\",");
-    file.WriteLine("map_script_filename = \"" + _map_script_filename + "\",");
+    return !file.IsErrorDetected();
+}
+
+bool MapDataHandler::Save(SaveGameWriter& file,
+                          uint32_t x_position,
+                          uint32_t y_position)
+{
+    file.WriteString(_map_data_filename);
+    file.WriteString(_map_script_filename);
     //! \note Coords are in map tiles
-    file.WriteLine("location_x = " + NumberToString(x_position) + ",");
-    file.WriteLine("location_y = " + NumberToString(y_position) + ",");
-    file.WriteLine("stamina = " + NumberToString(_save_stamina) + ",");
+    file.WriteUInt32(x_position);
+    file.WriteUInt32(y_position);
+    file.WriteUInt32(_save_stamina);
 
     // Save latest home map data, if any.
+    file.WriteBool(_home_map.IsValid());
     if (_home_map.IsValid()) {
-        file.InsertNewLine();
-        file.WriteLine("home_map = {");
-        file.WriteLine("\tmap_data_filename = \"" + _home_map.GetMapDataFilename() + "\",");
-        file.WriteLine("\tmap_script_filename = \"" + _home_map.GetMapDataFilename() + "\",");
+        file.WriteString(_home_map.GetMapDataFilename());
+        file.WriteString(_home_map.GetMapScriptFilename());
         //! \note Coords are in map tiles
-        file.WriteLine("\tlocation_x = " + NumberToString(_home_map.GetMapPosition().x) + ",");
-        file.WriteLine("\tlocation_y = " + NumberToString(_home_map.GetMapPosition().y) + ",");
-        file.WriteLine("},");
+        file.WriteUInt32(static_cast<uint32_t>(_home_map.GetMapPosition().x));
+        file.WriteUInt32(static_cast<uint32_t>(_home_map.GetMapPosition().y));
     }
     return true;
 }
@@ -13,7 +13,8 @@
 
 #include "utils/ustring.h"
 #include "script/script_read.h"
-#include "script/script_write.h"
+
+#include "common/global/save/save_game_file.h"
 
 #include "modes/map/map_location.h"
 #include "engine/video/image.h"
@@ -32,11 +33,14 @@ public:
     //! \brief Clears data about encountered maps
     void Clear();
 
-    //! \brief Loads game map related data
+    //! \brief Loads game map related data from a Lua save game
     bool Load(vt_script::ReadScriptDescriptor& file);
 
+    //! \brief Loads game map related data from a binary save game
+    bool Load(SaveGameReader& file);
+
     //! \brief Saves map related data in file
-    bool Save(vt_script::WriteScriptDescriptor& file,
+    bool Save(SaveGameWriter& file,
               uint32_t x_position,
               uint32_t y_position);
 
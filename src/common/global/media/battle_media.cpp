@@ -25,39 +25,75 @@ const std::string DEFAULT_VICTORY_MUSIC  = "data/music/Fanfare.ogg";
 const std::string DEFAULT_DEFEAT_MUSIC   = "data/music/Battle_lost-OGA-Mumu.ogg";
 //@}
 
+// Filenames of the battle images
+//@{
+const std::string DEFAULT_BACKGROUND_IMAGE       = "data/battles/battle_scenes/desert_cave/desert_cave.png";
+const std::string STAMINA_ICON_SELECTED_IMAGE    = "data/gui/battle/stamina_icon_selected.png";
+const std::string ATTACK_POINT_INDICATOR_IMAGE   = "data/gui/battle/attack_point_target.png";
+const std::string STAMINA_METER_IMAGE            = "data/gui/battle/stamina_bar.png";
+const std::string ACTOR_SELECTION_IMAGE          = "data/gui/battle/character_selector.png";
+const std::string CHARACTER_SELECTED_IMAGE       = "data/gui/battle/battle_character_selection.png";
+const std::string CHARACTER_COMMAND_IMAGE        = "data/gui/battle/battle_character_command.png";
+const std::string BOTTOM_MENU_IMAGE              = "data/gui/battle/battle_bottom_menu.png";
+const std::string CHARACTER_ACTION_BUTTONS_IMAGE = "data/gui/battle/battle_command_buttons.png";
+const std::string TARGET_TYPE_ICONS_IMAGE        = "data/skills/targets.png";
+const std::string STUNNED_ICON_IMAGE             = "data/entities/emotes/zzz.png";
+const std::string ESCAPE_ICON_IMAGE              = "data/gui/battle/escape.png";
+const std::string AUTO_BATTLE_ICON_IMAGE         = "data/gui/battle/auto_battle.png";
+//@}
+
 void BattleMedia::Initialize()
 {
-    if(!background_image.Load("data/battles/battle_scenes/desert_cave/desert_cave.png"))
+    // Decode the image files in the background while the first ones are being loaded.
+    const std::string* image_filenames[] = {
+        &DEFAULT_BACKGROUND_IMAGE,
+        &STAMINA_ICON_SELECTED_IMAGE,
+        &ATTACK_POINT_INDICATOR_IMAGE,
+        &STAMINA_METER_IMAGE,
+        &ACTOR_SELECTION_IMAGE,
+        &CHARACTER_SELECTED_IMAGE,
+        &CHARACTER_COMMAND_IMAGE,
+        &BOTTOM_MENU_IMAGE,
+        &CHARACTER_ACTION_BUTTONS_IMAGE,
+        &TARGET_TYPE_ICONS_IMAGE,
+        &STUNNED_ICON_IMAGE,
+        &ESCAPE_ICON_IMAGE,
+        &AUTO_BATTLE_ICON_IMAGE
+    };
+    for(const std::string* image_filename : image_filenames)
+        vt_video::ImageDescriptor::PrefetchImage(*image_filename);
+
+    if(!background_image.Load(DEFAULT_BACKGROUND_IMAGE))
         PRINT_ERROR << "Failed to load default background image" << std::endl;
 
-    if(stamina_icon_selected.Load("data/gui/battle/stamina_icon_selected.png") == false)
+    if(stamina_icon_selected.Load(STAMINA_ICON_SELECTED_IMAGE) == false)
         PRINT_ERROR << "Failed to load stamina icon selected image" << std::endl;
 
     attack_point_indicator.SetDimensions(16.0f, 16.0f);
-    if(attack_point_indicator.LoadFromFrameGrid("data/gui/battle/attack_point_target.png",
+    if(attack_point_indicator.LoadFromFrameGrid(ATTACK_POINT_INDICATOR_IMAGE,
             std::vector<uint32_t>(4, 100), 1, 4) == false)
         PRINT_ERROR << "Failed to load attack point indicator." << std::endl;
 
-    if(stamina_meter.Load("data/gui/battle/stamina_bar.png") == false)
+    if(stamina_meter.Load(STAMINA_METER_IMAGE) == false)
         PRINT_ERROR << "Failed to load time meter." << std::endl;
 
-    if(actor_selection_image.Load("data/gui/battle/character_selector.png") == false)
+    if(actor_selection_image.Load(ACTOR_SELECTION_IMAGE) == false)
         PRINT_ERROR << "Unable to load player selector image" << std::endl;
 
-    if(character_selected_highlight.Load("data/gui/battle/battle_character_selection.png") == false)
+    if(character_selected_highlight.Load(CHARACTER_SELECTED_IMAGE) == false)
         PRINT_ERROR << "Failed to load character selection highlight image" << std::endl;
 
-    if(character_command_highlight.Load("data/gui/battle/battle_character_command.png") == false)
+    if(character_command_highlight.Load(CHARACTER_COMMAND_IMAGE) == false)
         PRINT_ERROR << "Failed to load character command highlight image" << std::endl;
 
-    if(bottom_menu_image.Load("data/gui/battle/battle_bottom_menu.png") == false)
+    if(bottom_menu_image.Load(BOTTOM_MENU_IMAGE) == false)
         PRINT_ERROR << "Failed to load bottom menu image" << std::endl;
 
     if(vt_video::ImageDescriptor::LoadMultiImageFromElementGrid(character_action_buttons,
-                                                                "data/gui/battle/battle_command_buttons.png", 2, 5) == false)
+                                                                CHARACTER_ACTION_BUTTONS_IMAGE, 2, 5) == false)
         PRINT_ERROR << "Failed to load character action buttons" << std::endl;
 
-    if(vt_video::ImageDescriptor::LoadMultiImageFromElementGrid(_target_type_icons, "data/skills/targets.png", 1, 8) == false)
+    if(vt_video::ImageDescriptor::LoadMultiImageFromElementGrid(_target_type_icons, TARGET_TYPE_ICONS_IMAGE, 1, 8) == false)
         PRINT_ERROR << "Failed to load character action buttons" << std::endl;
 
     // Set the default battle music.
@@ -73,26 +109,42 @@ void BattleMedia::Initialize()
     if(!vt_audio::AudioManager->LoadMusic(DEFAULT_DEFEAT_MUSIC))
         PRINT_WARNING << "Failed to load defeat music file: " << DEFAULT_DEFEAT_MUSIC << std::endl;
 
-    if(!_stunned_icon.Load("data/entities/emotes/zzz.png"))
+    if(!_stunned_icon.Load(STUNNED_ICON_IMAGE))
         PRINT_WARNING << "Failed to load stunned icon" << std::endl;
 
-    if(!_escape_icon.Load("data/gui/battle/escape.png"))
+    if(!_escape_icon.Load(ESCAPE_ICON_IMAGE))
         PRINT_WARNING << "Failed to load escape icon image" << std::endl;
 
-    if(!_auto_battle_icon.Load("data/gui/battle/auto_battle.png"))
+    if(!_auto_battle_icon.Load(AUTO_BATTLE_ICON_IMAGE))
         PRINT_WARNING << "Failed to load auto-battle icon image" << std::endl;
 }
 
 void BattleMedia::Update()
 {
+    LoadPendingBackgroundImage();
+
     attack_point_indicator.Update();
 }
 
 void BattleMedia::SetBackgroundImage(const std::string& filename)
 {
-    if(background_image.Load(filename) == false) {
-        PRINT_WARNING << "Failed to load background image: " << filename << std::endl;
-    }
+    // The image file is decoded in the background during the battle transition,
+    // and is actually loaded on the next battle update or draw.
+    _background_image_filename = filename;
+    vt_video::ImageDescriptor::PrefetchImage(filename);
+}
+
+void BattleMedia::LoadPendingBackgroundImage()
+{
+    if(_background_image_filename.empty())
+        return;
+
+    if(background_image.Load(_background_image_filename) == false)
+        PRINT_WARNING << "Failed to load background image: " << _background_image_filename << std::endl;
+    _background_image_filename.clear();
+
+    // The pixels are copied into the texture sheet right away, so that the background is drawn.
+    background_image.WaitForPixels();
 }
 
 void BattleMedia::SetBattleMusic(const std::string& filename)
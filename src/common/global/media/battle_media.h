@@ -47,9 +47,15 @@ public:
 
     /** \brief Sets the background image for the battle
     *** \param filename The filename of the new background image to load
+    *** \note The image is loaded on the next call to Update() or LoadPendingBackgroundImage().
     **/
     void SetBackgroundImage(const std::string& filename);
 
+    /** \brief Loads the background image set by SetBackgroundImage(), if not done yet.
+    *** Called before drawing the background, so that it is drawn from the first battle frame.
+    **/
+    void LoadPendingBackgroundImage();
+
     /** \brief Sets the battle music to use
     *** \param filename The full filename of the music to play
     **/
@@ -154,6 +160,9 @@ private:
 
     //! \brief The escape icon.
     vt_video::StillImage _escape_icon;
+
+    //! \brief The background image file to load on the next update, if any.
+    std::string _background_image_filename;
 }; // class BattleMedia
 
 } // namespace vt_global
@@ -18,15 +18,36 @@ using namespace vt_script;
 namespace vt_global
 {
 
+GlobalArmor::GlobalArmor() :
+    GlobalObject(),
+    _physical_defense(0),
+    _magical_defense(0),
+    _usable_by(0)
+{
+}
+
 GlobalArmor::GlobalArmor(uint32_t id, uint32_t count) :
-    GlobalObject(id, count)
+    GlobalArmor()
 {
-    if((_id <= MAX_WEAPON_ID) || (_id > MAX_LEG_ARMOR_ID)) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid id in constructor: " << _id << std::endl;
+    const GlobalArmor* prototype = GlobalManager->GetPrototypeHandler().GetArmor(id);
+    if(prototype == nullptr) {
         _InvalidateObject();
         return;
     }
 
+    *this = *prototype;
+    _count = count;
+}
+
+bool GlobalArmor::_LoadDefinition(uint32_t id)
+{
+    _id = id;
+    if((_id <= MAX_WEAPON_ID) || (_id > MAX_LEG_ARMOR_ID)) {
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid id: " << _id << std::endl;
+        _InvalidateObject();
+        return false;
+    }
+
     // Figure out the appropriate script reference to grab based on the id value
     ReadScriptDescriptor* script_file = nullptr;
     InventoryHandler& inventory = GlobalManager->GetInventoryHandler();
@@ -46,13 +67,13 @@ GlobalArmor::GlobalArmor(uint32_t id, uint32_t count) :
     default:
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "could not determine armor type: " << _id << std::endl;
         _InvalidateObject();
-        return;
+        return false;
     }
 
     if(script_file->DoesTableExist(_id) == false) {
         PRINT_WARNING << "no valid data for armor in definition file: " << _id << std::endl;
         _InvalidateObject();
-        return;
+        return false;
     }
 
     // Load the armor data from the script
@@ -81,6 +102,8 @@ GlobalArmor::GlobalArmor(uint32_t id, uint32_t count) :
                       << std::endl << script_file->GetErrorMessages() << std::endl;
         _InvalidateObject();
     }
+
+    return IsValid();
 }
 
 GLOBAL_OBJECT GlobalArmor::GetObjectType() const
@@ -37,6 +37,7 @@ class GlobalSpirit;
 class GlobalArmor : public GlobalObject
 {
 public:
+    //! \note The armor is copied from its prototype, @see PrototypeHandler.
     explicit GlobalArmor(uint32_t id, uint32_t count = 1);
     virtual ~GlobalArmor() override
     {
@@ -67,6 +68,16 @@ public:
     }
 
 private:
+    friend class PrototypeHandler;
+
+    //! \brief Creates an empty armor, used to load the armor prototypes.
+    GlobalArmor();
+
+    /** \brief Reads the armor definition from the script matching its type.
+    *** \return whether the definition is valid.
+    **/
+    bool _LoadDefinition(uint32_t id);
+
     //! \brief The amount of physical defense that the armor provides
     uint32_t _physical_defense;
 
@@ -352,18 +352,21 @@ void InventoryHandler::DecrementItemCount(uint32_t obj_id, uint32_t count)
         RemoveFromInventory(obj_id);
 }
 
-void InventoryHandler::SaveInventory(vt_script::WriteScriptDescriptor& file)
+//! \brief The number of inventory types in save games: items, weapons, the four armor types and spirits.
+static const uint32_t SAVED_INVENTORY_TYPES = 7;
+
+void InventoryHandler::SaveInventory(SaveGameWriter& file)
 {
     // Save the inventory (object id + object count pairs)
     // NOTE: This does not save any weapons/armor that are equipped on the characters. That data
     // is stored alongside the character data when it is saved
-    _SaveInventory(file, "items", _inventory_items);
-    _SaveInventory(file, "weapons", _inventory_weapons);
-    _SaveInventory(file, "head_armor", _inventory_head_armors);
-    _SaveInventory(file, "torso_armor", _inventory_torso_armors);
-    _SaveInventory(file, "arm_armor", _inventory_arm_armors);
-    _SaveInventory(file, "leg_armor", _inventory_leg_armors);
-    _SaveInventory(file, "spirits", _inventory_spirits);
+    _SaveInventory(file, _inventory_items);
+    _SaveInventory(file, _inventory_weapons);
+    _SaveInventory(file, _inventory_head_armors);
+    _SaveInventory(file, _inventory_torso_armors);
+    _SaveInventory(file, _inventory_arm_armors);
+    _SaveInventory(file, _inventory_leg_armors);
+    _SaveInventory(file, _inventory_spirits);
 }
 
 void InventoryHandler::LoadInventory(vt_script::ReadScriptDescriptor& file)
@@ -379,6 +382,21 @@ void InventoryHandler::LoadInventory(vt_script::ReadScriptDescriptor& file)
     _LoadInventory(file, "spirits");
 }
 
+void InventoryHandler::LoadInventory(SaveGameReader& file)
+{
+    ClearAllData();
+
+    // The objects are added depending on their id, so the inventory types
+    // only need to be read in turn.
+    for (uint32_t i = 0; i < SAVED_INVENTORY_TYPES; ++i) {
+        uint32_t objects_number = file.ReadUInt32();
+        for (uint32_t j = 0; j < objects_number && !file.IsErrorDetected(); ++j) {
+            uint32_t object_id = file.ReadUInt32();
+            AddToInventory(object_id, file.ReadUInt32());
+        }
+    }
+}
+
 void InventoryHandler::_LoadInventory(ReadScriptDescriptor& file, const std::string& category_name)
 {
     if(file.IsFileOpen() == false) {
@@ -16,7 +16,7 @@
 #include "global_spirit.h"
 #include "global_weapon.h"
 
-#include "script/script_write.h"
+#include "common/global/save/save_game_file.h"
 
 namespace vt_global
 {
@@ -109,7 +109,8 @@ public:
     }
 
     void LoadInventory(vt_script::ReadScriptDescriptor& file);
-    void SaveInventory(vt_script::WriteScriptDescriptor& file);
+    void LoadInventory(SaveGameReader& file);
+    void SaveInventory(SaveGameWriter& file);
 
     std::map<uint32_t, std::shared_ptr<GlobalObject>>& GetInventory() {
         return _inventory;
@@ -225,13 +226,11 @@ private:
     template <class T> std::shared_ptr<T> _GetFromInventory(uint32_t obj_id, const std::vector<std::shared_ptr<T>>& inv);
 
     /** \brief A helper function to GameGlobal::SaveGame() that stores the contents of a type of inventory to the saved game file
-    *** \param file A reference to the open and valid file where to write the inventory list
-    *** \param category_name The name under which this set of inventory data should be categorized (ie "items", "weapons", etc)
+    *** \param file The save game being written
     *** \param inv A reference to the inventory vector to store
     *** \note The class type T must be a derived class of GlobalObject
     **/
-    template <class T> void _SaveInventory(vt_script::WriteScriptDescriptor& file,
-                                           const std::string& category_name,
+    template <class T> void _SaveInventory(SaveGameWriter& file,
                                            const std::vector<std::shared_ptr<T>>& inv);
 
     /** \brief A helper function to GameGlobal::LoadGame() that restores the contents of the inventory from a saved game file
@@ -272,40 +271,24 @@ template <class T> std::shared_ptr<T> InventoryHandler::_GetFromInventory(uint32
     return nullptr;
 }
 
-template <class T> void InventoryHandler::_SaveInventory(vt_script::WriteScriptDescriptor& file,
-                                                         const std::string& category_name,
+template <class T> void InventoryHandler::_SaveInventory(SaveGameWriter& file,
                                                          const std::vector<std::shared_ptr<T>>& inv)
 {
-    if (file.IsFileOpen() == false) {
-        PRINT_WARNING << "failed because the argument file was not open" << std::endl;
-        return;
+    // Don't save inventory items with 0 count
+    uint32_t saved_objects = 0;
+    for (uint32_t i = 0; i < inv.size(); ++i) {
+        if (inv[i]->GetCount() != 0)
+            ++saved_objects;
     }
 
-    file.InsertNewLine();
-    file.WriteLine(category_name + " = {");
-
-    for (uint32_t i = 0; i < inv.size(); i++) {
-        // Don't save inventory items with 0 count
+    file.WriteUInt32(saved_objects);
+    for (uint32_t i = 0; i < inv.size(); ++i) {
         if (inv[i]->GetCount() == 0)
             continue;
 
-        if (i == 0)
-            file.WriteLine("\t", false);
-        else
-            file.WriteLine(", ", false);
-
-        // Add a new line every 10 entries for better readability and debugging
-        if ((i > 0) && !(i % 10)) {
-            file.InsertNewLine();
-            file.WriteLine("\t", false);
-        }
-
-        file.WriteLine("[" + vt_utils::NumberToString(inv[i]->GetID()) + "] = " +
-                       vt_utils::NumberToString(inv[i]->GetCount()), false);
+        file.WriteUInt32(inv[i]->GetID());
+        file.WriteUInt32(inv[i]->GetCount());
     }
-
-    file.InsertNewLine();
-    file.WriteLine("},");
 }
 
 } // namespace vt_global
@@ -17,23 +17,41 @@ using namespace vt_script;
 namespace vt_global
 {
 
-GlobalItem::GlobalItem(uint32_t id, uint32_t count) :
-    GlobalObject(id, count),
+GlobalItem::GlobalItem() :
+    GlobalObject(),
     _target_type(GLOBAL_TARGET_INVALID),
     _warmup_time(0),
     _cooldown_time(0)
 {
-    if(_id == 0 || (_id > MAX_ITEM_ID && (_id <= MAX_SPIRIT_ID && _id > MAX_KEY_ITEM_ID))) {
-        PRINT_WARNING << "invalid id in constructor: " << _id << std::endl;
+}
+
+GlobalItem::GlobalItem(uint32_t id, uint32_t count) :
+    GlobalItem()
+{
+    const GlobalItem* prototype = GlobalManager->GetPrototypeHandler().GetItem(id);
+    if(prototype == nullptr) {
         _InvalidateObject();
         return;
     }
 
+    *this = *prototype;
+    _count = count;
+}
+
+bool GlobalItem::_LoadDefinition(uint32_t id)
+{
+    _id = id;
+    if(_id == 0 || (_id > MAX_ITEM_ID && (_id <= MAX_SPIRIT_ID && _id > MAX_KEY_ITEM_ID))) {
+        PRINT_WARNING << "invalid id: " << _id << std::endl;
+        _InvalidateObject();
+        return false;
+    }
+
     ReadScriptDescriptor& script_file = GlobalManager->GetInventoryHandler().GetItemsScript();
     if(script_file.DoesTableExist(_id) == false) {
         PRINT_WARNING << "no valid data for item in definition file: " << _id << std::endl;
         _InvalidateObject();
-        return;
+        return false;
     }
 
     // Load the item data from the script
@@ -67,6 +85,8 @@ GlobalItem::GlobalItem(uint32_t id, uint32_t count) :
                         << std::endl << script_file.GetErrorMessages() << std::endl;
         _InvalidateObject();
     }
+
+    return IsValid();
 }
 
 GlobalItem::GlobalItem(const GlobalItem &copy) :
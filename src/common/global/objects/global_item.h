@@ -46,6 +46,7 @@ class GlobalItem : public GlobalObject
 public:
     /** \param id The unique ID number of the item
     *** \param count The number of items to initialize this class object as representing (default value == 1)
+    *** \note The item is copied from its prototype, @see PrototypeHandler.
     **/
     explicit GlobalItem(uint32_t id, uint32_t count = 1);
     virtual ~GlobalItem() override
@@ -111,6 +112,16 @@ public:
     //@}
 
 private:
+    friend class PrototypeHandler;
+
+    //! \brief Creates an empty item, used to load the item prototypes.
+    GlobalItem();
+
+    /** \brief Reads the item definition from the items script.
+    *** \return whether the definition is valid.
+    **/
+    bool _LoadDefinition(uint32_t id);
+
     //! \brief The type of target for the item
     GLOBAL_TARGET _target_type;
 
@@ -19,19 +19,32 @@ namespace vt_global
 {
 
 GlobalSpirit::GlobalSpirit(uint32_t id, uint32_t count) :
-    GlobalObject(id, count)
+    GlobalSpirit()
 {
-    if((_id <= MAX_LEG_ARMOR_ID) || (_id > MAX_SPIRIT_ID)) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid id in constructor: " << _id << std::endl;
+    const GlobalSpirit* prototype = GlobalManager->GetPrototypeHandler().GetSpirit(id);
+    if(prototype == nullptr) {
         _InvalidateObject();
         return;
     }
 
+    *this = *prototype;
+    _count = count;
+}
+
+bool GlobalSpirit::_LoadDefinition(uint32_t id)
+{
+    _id = id;
+    if((_id <= MAX_LEG_ARMOR_ID) || (_id > MAX_SPIRIT_ID)) {
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid id: " << _id << std::endl;
+        _InvalidateObject();
+        return false;
+    }
+
     ReadScriptDescriptor& script_file = GlobalManager->GetInventoryHandler().GetSpiritsScript();
     if (script_file.DoesTableExist(_id) == false) {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "No valid data for spirit id: " << _id << std::endl;
         _InvalidateObject();
-        return;
+        return false;
     }
 
     // Load the spirit data from the script
@@ -45,6 +58,8 @@ GlobalSpirit::GlobalSpirit(uint32_t id, uint32_t count) :
 
         _InvalidateObject();
     }
+
+    return IsValid();
 }
 
 } // namespace vt_global
@@ -27,6 +27,7 @@ namespace vt_global
 class GlobalSpirit : public GlobalObject
 {
 public:
+    //! \note The spirit is copied from its prototype, @see PrototypeHandler.
     explicit GlobalSpirit(uint32_t id, uint32_t count = 1);
     virtual ~GlobalSpirit() override
     {
@@ -35,6 +36,20 @@ public:
     GLOBAL_OBJECT GetObjectType() const override {
         return GLOBAL_OBJECT_SPIRIT;
     }
+
+private:
+    friend class PrototypeHandler;
+
+    //! \brief Creates an empty spirit, used to load the spirit prototypes.
+    GlobalSpirit() :
+        GlobalObject()
+    {
+    }
+
+    /** \brief Reads the spirit definition from the spirits script.
+    *** \return whether the definition is valid.
+    **/
+    bool _LoadDefinition(uint32_t id);
 }; // class GlobalSpirit : public GlobalObject
 
 } // namespace vt_global
@@ -20,20 +20,41 @@ using namespace vt_utils;
 namespace vt_global
 {
 
+GlobalWeapon::GlobalWeapon() :
+    GlobalObject(),
+    _physical_attack(0),
+    _magical_attack(0),
+    _usable_by(0)
+{
+}
+
 GlobalWeapon::GlobalWeapon(uint32_t id, uint32_t count) :
-    GlobalObject(id, count)
+    GlobalWeapon()
 {
-    if((_id <= MAX_ITEM_ID) || (_id > MAX_WEAPON_ID)) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid id in constructor: " << _id << std::endl;
+    const GlobalWeapon* prototype = GlobalManager->GetPrototypeHandler().GetWeapon(id);
+    if(prototype == nullptr) {
         _InvalidateObject();
         return;
     }
 
+    *this = *prototype;
+    _count = count;
+}
+
+bool GlobalWeapon::_LoadDefinition(uint32_t id)
+{
+    _id = id;
+    if((_id <= MAX_ITEM_ID) || (_id > MAX_WEAPON_ID)) {
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid id: " << _id << std::endl;
+        _InvalidateObject();
+        return false;
+    }
+
     ReadScriptDescriptor& script_file = GlobalManager->GetInventoryHandler().GetWeaponsScript();
     if(script_file.DoesTableExist(_id) == false) {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "no valid data for weapon in definition file: " << _id << std::endl;
         _InvalidateObject();
-        return;
+        return false;
     }
 
     // Load the weapon data from the script
@@ -71,6 +92,8 @@ GlobalWeapon::GlobalWeapon(uint32_t id, uint32_t count) :
         }
         _InvalidateObject();
     }
+
+    return IsValid();
 }
 
 const std::string& GlobalWeapon::GetWeaponAnimationFile(uint32_t character_id, const std::string& animation_alias)
@@ -38,6 +38,7 @@ class GlobalWeapon : public GlobalObject
 public:
     /** \param id The unique ID number of the weapon
     *** \param count The number of weapons to initialize this class object as representing (default value == 1)
+    *** \note The weapon is copied from its prototype, @see PrototypeHandler.
     **/
     explicit GlobalWeapon(uint32_t id, uint32_t count = 1);
     virtual ~GlobalWeapon() override
@@ -81,6 +82,16 @@ public:
     //@}
 
 private:
+    friend class PrototypeHandler;
+
+    //! \brief Creates an empty weapon, used to load the weapon prototypes.
+    GlobalWeapon();
+
+    /** \brief Reads the weapon definition from the weapons script.
+    *** \return whether the definition is valid.
+    **/
+    bool _LoadDefinition(uint32_t id);
+
     //! \brief The battle image animation file used to display the weapon ammo.
     std::string _ammo_animation_file;
 
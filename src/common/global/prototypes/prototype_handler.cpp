@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "prototype_handler.h"
+
+#include "common/global/objects/global_item.h"
+#include "common/global/objects/global_weapon.h"
+#include "common/global/objects/global_armor.h"
+#include "common/global/objects/global_spirit.h"
+#include "common/global/actors/global_enemy.h"
+#include "common/global/global_skills.h"
+
+#include "utils/utils_common.h"
+
+namespace vt_global
+{
+
+extern bool GLOBAL_DEBUG;
+
+PrototypeHandler::PrototypeHandler() :
+    _table_opens(0),
+    _prototype_copies(0)
+{
+}
+
+PrototypeHandler::~PrototypeHandler()
+{
+    Clear();
+}
+
+void PrototypeHandler::Clear()
+{
+    _ClearPrototypes(_items);
+    _ClearPrototypes(_weapons);
+    _ClearPrototypes(_armors);
+    _ClearPrototypes(_spirits);
+    _ClearPrototypes(_skills);
+    _ClearPrototypes(_enemies);
+}
+
+const GlobalItem* PrototypeHandler::GetItem(uint32_t id)
+{
+    return _GetPrototype(_items, id);
+}
+
+const GlobalWeapon* PrototypeHandler::GetWeapon(uint32_t id)
+{
+    return _GetPrototype(_weapons, id);
+}
+
+const GlobalArmor* PrototypeHandler::GetArmor(uint32_t id)
+{
+    return _GetPrototype(_armors, id);
+}
+
+const GlobalSpirit* PrototypeHandler::GetSpirit(uint32_t id)
+{
+    return _GetPrototype(_spirits, id);
+}
+
+const GlobalSkill* PrototypeHandler::GetSkill(uint32_t id)
+{
+    return _GetPrototype(_skills, id);
+}
+
+const GlobalEnemy* PrototypeHandler::GetEnemy(uint32_t id)
+{
+    return _GetPrototype(_enemies, id);
+}
+
+void PrototypeHandler::PrintStatistics(uint8_t game_type)
+{
+    IF_PRINT_DEBUG(GLOBAL_DEBUG) << "Game mode type " << static_cast<uint32_t>(game_type) << ": "
+                                 << _table_opens << " definition table(s) opened in the Lua scripts, "
+                                 << _prototype_copies << " prototype(s) copied" << std::endl;
+    _table_opens = 0;
+    _prototype_copies = 0;
+}
+
+template <class T>
+const T* PrototypeHandler::_GetPrototype(std::map<uint32_t, T*>& prototypes, uint32_t id)
+{
+    typename std::map<uint32_t, T*>::const_iterator it = prototypes.find(id);
+    if (it == prototypes.end()) {
+        // Read the definition once, and remember the invalid ones too.
+        T* prototype = new T();
+        ++_table_opens;
+        if (!prototype->_LoadDefinition(id)) {
+            delete prototype;
+            prototype = nullptr;
+        }
+        it = prototypes.insert(std::make_pair(id, prototype)).first;
+    }
+
+    if (it->second != nullptr)
+        ++_prototype_copies;
+    return it->second;
+}
+
+template <class T>
+void PrototypeHandler::_ClearPrototypes(std::map<uint32_t, T*>& prototypes)
+{
+    typename std::map<uint32_t, T*>::iterator it = prototypes.begin();
+    for (; it != prototypes.end(); ++it)
+        delete it->second;
+    prototypes.clear();
+}
+
+PrototypeHandler::PrototypeHandler(const PrototypeHandler&)
+{
+    throw vt_utils::Exception("Not Implemented!", __FILE__, __LINE__, __FUNCTION__);
+}
+
+PrototypeHandler& PrototypeHandler::operator=(const PrototypeHandler&)
+{
+    throw vt_utils::Exception("Not Implemented!", __FILE__, __LINE__, __FUNCTION__);
+    return *this;
+}
+
+} // namespace vt_global
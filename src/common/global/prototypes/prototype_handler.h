@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __GLOBAL_PROTOTYPE_HANDLER_HEADER__
+#define __GLOBAL_PROTOTYPE_HANDLER_HEADER__
+
+#include <cstdint>
+#include <map>
+
+namespace vt_global
+{
+
+class GlobalItem;
+class GlobalWeapon;
+class GlobalArmor;
+class GlobalSpirit;
+class GlobalSkill;
+class GlobalEnemy;
+
+/** ****************************************************************************
+*** \brief Keeps the objects, skills and enemies definitions read from the Lua files.
+***
+*** Each definition is read once from its Lua table, the first time it is needed,
+*** and kept as an immutable prototype. The objects, skills and enemies created
+*** with an id are then copied from their prototype, without reading the scripts
+*** again. The prototypes are cleared when the global scripts are reloaded, e.g.
+*** when the language changes.
+*** ***************************************************************************/
+class PrototypeHandler
+{
+public:
+    PrototypeHandler();
+    ~PrototypeHandler();
+
+    //! \brief Deletes every prototype, so that they are read again from the scripts.
+    void Clear();
+
+    /** \name Prototype access functions
+    *** \return The prototype matching the id, or nullptr if the definition is invalid.
+    *** Don't delete it!
+    **/
+    //@{
+    const GlobalItem* GetItem(uint32_t id);
+    const GlobalWeapon* GetWeapon(uint32_t id);
+    const GlobalArmor* GetArmor(uint32_t id);
+    const GlobalSpirit* GetSpirit(uint32_t id);
+    const GlobalSkill* GetSkill(uint32_t id);
+    const GlobalEnemy* GetEnemy(uint32_t id);
+    //@}
+
+    /** \brief Prints the number of definition tables read from the scripts and of
+    *** prototype copies since the last call, and resets these counts.
+    *** \param game_type The type of the game mode that was active.
+    **/
+    void PrintStatistics(uint8_t game_type);
+
+private:
+    //! \brief The prototypes, by id. nullptr is stored for the invalid definitions.
+    std::map<uint32_t, GlobalItem*> _items;
+    std::map<uint32_t, GlobalWeapon*> _weapons;
+    std::map<uint32_t, GlobalArmor*> _armors;
+    std::map<uint32_t, GlobalSpirit*> _spirits;
+    std::map<uint32_t, GlobalSkill*> _skills;
+    std::map<uint32_t, GlobalEnemy*> _enemies;
+
+    //! \brief The number of definition tables opened in the scripts since the last statistics.
+    uint32_t _table_opens;
+
+    //! \brief The number of prototypes handed out since the last statistics.
+    uint32_t _prototype_copies;
+
+    /** \brief Returns the prototype matching the id, reading it from the scripts if needed.
+    *** The type must have a private default constructor, and a _LoadDefinition(id) method
+    *** telling whether the definition is valid.
+    **/
+    template <class T>
+    const T* _GetPrototype(std::map<uint32_t, T*>& prototypes, uint32_t id);
+
+    //! \brief Deletes the prototypes of the given container.
+    template <class T>
+    static void _ClearPrototypes(std::map<uint32_t, T*>& prototypes);
+
+    PrototypeHandler(const PrototypeHandler& copy);
+    PrototypeHandler& operator=(const PrototypeHandler& copy);
+};
+
+} // namespace vt_global
+
+#endif // __GLOBAL_PROTOTYPE_HANDLER_HEADER__
@@ -204,39 +204,40 @@ void GameQuests::LoadQuests(ReadScriptDescriptor& file)
     file.CloseTable();
 }
 
-void GameQuests::SaveQuests(WriteScriptDescriptor& file)
+void GameQuests::LoadQuests(SaveGameReader& file)
 {
-    if(file.IsFileOpen() == false)
-    {
-        PRINT_WARNING << "the file provided in the function argument was not open" << std::endl;
-        return;
+    uint32_t quests_number = file.ReadUInt32();
+    for(uint32_t i = 0; i < quests_number && !file.IsErrorDetected(); ++i) {
+        std::string quest_id = file.ReadString();
+        uint32_t quest_log_number = file.ReadUInt32();
+        bool is_read = file.ReadBool();
+
+        if(!_AddQuestLog(quest_id, quest_log_number, is_read))
+        {
+            PRINT_WARNING << "save file has duplicate quest log id entries" << std::endl;
+            return;
+        }
     }
+}
 
-    file.WriteLine("quest_log = {");
+void GameQuests::SaveQuests(SaveGameWriter& file)
+{
+    std::vector<const QuestLogEntry*> quest_log_entries;
     for(auto itr = _quest_log_entries.begin(); itr != _quest_log_entries.end(); ++itr) {
-
-        const QuestLogEntry* quest_log_entry = itr->second;
-
-        if(quest_log_entry == nullptr)
+        if(itr->second == nullptr)
         {
             PRINT_WARNING << "SaveQuests function received a nullptr quest log entry pointer argument" << std::endl;
-            return;
+            continue;
         }
-
-        // Start writting
-        file.WriteLine("\t" + quest_log_entry->GetQuestId() + " = {", false);
-        // Write the quest log number. this is written as a string
-        // because loading needs a uniform type of data in the array
-        file.WriteLine("\"" + NumberToString(quest_log_entry->GetQuestLogNumber()) + "\", ", false);
-        // Write the "false" or "true" string if this entry has been read or not
-        const std::string is_read(quest_log_entry->IsRead() ? "true" : "false");
-        file.WriteLine("\"" + is_read + "\"", false);
-        // End writing
-        file.WriteLine("},");
+        quest_log_entries.push_back(itr->second);
     }
 
-    file.WriteLine("},");
-    file.InsertNewLine();
+    file.WriteUInt32(static_cast<uint32_t>(quest_log_entries.size()));
+    for(uint32_t i = 0; i < quest_log_entries.size(); ++i) {
+        file.WriteString(quest_log_entries[i]->GetQuestId());
+        file.WriteUInt32(quest_log_entries[i]->GetQuestLogNumber());
+        file.WriteBool(quest_log_entries[i]->IsRead());
+    }
 }
 
 bool GameQuests::_AddQuestLog(const std::string& quest_id,
@@ -14,8 +14,9 @@
 #include "quest_log_entry.h"
 #include "quest_log_info.h"
 
+#include "common/global/save/save_game_file.h"
+
 #include "script/script_read.h"
-#include "script/script_write.h"
 
 #include <string>
 #include <vector>
@@ -78,10 +79,13 @@ public:
     **/
     void LoadQuests(vt_script::ReadScriptDescriptor &file);
 
+    //! \brief Loads the quest log entries from a binary saved game, written by SaveQuests().
+    void LoadQuests(SaveGameReader& file);
+
     /** \brief Helper function that saves the Quest Log entries. this is called from SaveGame()
-    *** \param file Reference to open and valid file set for writting the data
+    *** \param file Reference to the save game being written
     **/
-    void SaveQuests(vt_script::WriteScriptDescriptor& file);
+    void SaveQuests(SaveGameWriter& file);
 
 private:
     /** \brief The container which stores the quest log entries in the game. the quest log key
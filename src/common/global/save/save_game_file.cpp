@@ -0,0 +1,385 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    save_game_file.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the binary save game files.
+*** ***************************************************************************/
+
+#include "save_game_file.h"
+
+#include "common/app_settings.h"
+
+#include "utils/utils_common.h"
+#include "utils/utils_files.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#   include <io.h>
+#   include <windows.h>
+#else
+#   include <unistd.h>
+#endif
+
+namespace vt_global
+{
+
+extern bool GLOBAL_DEBUG;
+
+//! \brief The string starting every binary save game.
+static const char SAVE_GAME_MAGIC[] = "VTSAVEGM";
+static const size_t SAVE_GAME_MAGIC_SIZE = 8;
+
+//! \brief The size of the magic string, version and header size.
+static const size_t SAVE_GAME_HEADER_START_SIZE = SAVE_GAME_MAGIC_SIZE + 2 * sizeof(uint32_t);
+
+//! \brief The maximum header size accepted, so that corrupted files are rejected right away.
+static const size_t SAVE_GAME_MAX_HEADER_SIZE = 64 * 1024;
+
+//! \brief Reads a little endian value.
+static uint32_t _DecodeUInt32(const uint8_t* data)
+{
+    return static_cast<uint32_t>(data[0])
+        | (static_cast<uint32_t>(data[1]) << 8)
+        | (static_cast<uint32_t>(data[2]) << 16)
+        | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+//! \brief Builds a save game filename, with the given extension.
+static std::string _BuildSaveGameFilename(uint32_t slot_id, bool autosave, const std::string& extension)
+{
+    std::ostringstream filename;
+    filename << vt_common::GetUserDataPath() + "saved_game_" << slot_id;
+    if (autosave)
+        filename << "_autosave";
+    filename << extension;
+    return filename.str();
+}
+
+/** \brief Writes the header and body in a temporary file, flushed to the disk,
+*** which then replaces the given file. This way, a crash while saving leaves
+*** the previous save game untouched.
+**/
+static bool _WriteFileAtomically(const std::string& filename,
+                                 const std::vector<uint8_t>& header,
+                                 const std::vector<uint8_t>& body)
+{
+    const std::string temp_filename = filename + ".tmp";
+    FILE* file = fopen(temp_filename.c_str(), "wb");
+    if (!file) {
+        PRINT_WARNING << "Couldn't open the save game file for writing: " << temp_filename << std::endl;
+        return false;
+    }
+
+    bool written = fwrite(&header[0], 1, header.size(), file) == header.size();
+    if (written && !body.empty())
+        written = fwrite(&body[0], 1, body.size(), file) == body.size();
+    written = written && fflush(file) == 0;
+#ifdef _WIN32
+    written = written && _commit(_fileno(file)) == 0;
+#else
+    written = written && fsync(fileno(file)) == 0;
+#endif
+    written = (fclose(file) == 0) && written;
+
+    if (!written) {
+        PRINT_WARNING << "Couldn't write the save game file: " << temp_filename << std::endl;
+        remove(temp_filename.c_str());
+        return false;
+    }
+
+#ifdef _WIN32
+    bool renamed = MoveFileExA(temp_filename.c_str(), filename.c_str(),
+                               MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    bool renamed = rename(temp_filename.c_str(), filename.c_str()) == 0;
+#endif
+    if (!renamed) {
+        PRINT_WARNING << "Couldn't replace the save game file: " << filename << std::endl;
+        remove(temp_filename.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::string GetSaveGameFilename(uint32_t slot_id, bool autosave)
+{
+    return _BuildSaveGameFilename(slot_id, autosave, ".sav");
+}
+
+std::string FindSaveGameFilename(uint32_t slot_id, bool autosave)
+{
+    std::string filename = GetSaveGameFilename(slot_id, autosave);
+    if (vt_utils::DoesFileExist(filename))
+        return filename;
+
+    // Fall back to the save games written before the binary format.
+    std::string lua_filename = _BuildSaveGameFilename(slot_id, autosave, ".lua");
+    if (vt_utils::DoesFileExist(lua_filename))
+        return lua_filename;
+
+    return filename;
+}
+
+bool IsBinarySaveGame(const std::string& filename)
+{
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    char magic[SAVE_GAME_MAGIC_SIZE];
+    if (!file.read(magic, SAVE_GAME_MAGIC_SIZE))
+        return false;
+
+    return std::memcmp(magic, SAVE_GAME_MAGIC, SAVE_GAME_MAGIC_SIZE) == 0;
+}
+
+void SaveGameWriter::WriteUInt32(uint32_t value)
+{
+    _data.push_back(static_cast<uint8_t>(value & 0xff));
+    _data.push_back(static_cast<uint8_t>((value >> 8) & 0xff));
+    _data.push_back(static_cast<uint8_t>((value >> 16) & 0xff));
+    _data.push_back(static_cast<uint8_t>((value >> 24) & 0xff));
+}
+
+void SaveGameWriter::WriteFloat(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    WriteUInt32(bits);
+}
+
+void SaveGameWriter::WriteString(const std::string& value)
+{
+    WriteUInt32(static_cast<uint32_t>(value.size()));
+    _data.insert(_data.end(), value.begin(), value.end());
+}
+
+void SaveGameWriter::WriteUIntVector(const std::vector<uint32_t>& values)
+{
+    WriteUInt32(static_cast<uint32_t>(values.size()));
+    for (uint32_t i = 0; i < values.size(); ++i)
+        WriteUInt32(values[i]);
+}
+
+bool SaveGameWriter::SaveFile(const std::string& filename, const SaveGamePreview& preview) const
+{
+    SaveGameWriter header;
+    header._data.insert(header._data.end(), SAVE_GAME_MAGIC, SAVE_GAME_MAGIC + SAVE_GAME_MAGIC_SIZE);
+    header.WriteUInt32(SAVE_GAME_VERSION);
+    // The header size, set once the preview is written.
+    header.WriteUInt32(0);
+
+    header.WriteUInt8(preview.play_hours);
+    header.WriteUInt8(preview.play_minutes);
+    header.WriteUInt8(preview.play_seconds);
+    header.WriteUInt32(preview.drunes);
+    header.WriteString(preview.map_data_filename);
+    header.WriteString(preview.map_script_filename);
+
+    uint32_t characters_count = std::min(static_cast<uint32_t>(preview.characters.size()),
+                                         SAVE_GAME_PREVIEW_CHARACTERS);
+    header.WriteUInt8(static_cast<uint8_t>(characters_count));
+    for (uint32_t i = 0; i < characters_count; ++i) {
+        const SaveCharacterPreview& character = preview.characters[i];
+        header.WriteUInt32(character.id);
+        header.WriteUInt32(character.experience_level);
+        header.WriteUInt32(character.total_experience_points);
+        header.WriteUInt32(character.unspent_experience_points);
+        header.WriteInt32(character.experience_points_next);
+        header.WriteUInt32(character.max_hit_points);
+        header.WriteUInt32(character.hit_points);
+        header.WriteUInt32(character.max_skill_points);
+        header.WriteUInt32(character.skill_points);
+    }
+
+    uint32_t header_size = static_cast<uint32_t>(header._data.size());
+    for (uint32_t i = 0; i < sizeof(uint32_t); ++i)
+        header._data[SAVE_GAME_MAGIC_SIZE + sizeof(uint32_t) + i] = static_cast<uint8_t>((header_size >> (8 * i)) & 0xff);
+
+    return _WriteFileAtomically(filename, header._data, _data);
+}
+
+bool SaveGameReader::OpenFile(const std::string& filename)
+{
+    _filename = filename;
+    _data.clear();
+    _position = 0;
+    _error = false;
+    _preview = SaveGamePreview();
+
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    if (!file) {
+        PRINT_WARNING << "Couldn't open the save game file: " << filename << std::endl;
+        return false;
+    }
+
+    file.seekg(0, std::ios::end);
+    std::streamoff size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    if (size <= 0) {
+        PRINT_WARNING << "Empty save game file: " << filename << std::endl;
+        return false;
+    }
+
+    _data.resize(static_cast<size_t>(size));
+    if (!file.read(reinterpret_cast<char*>(&_data[0]), size)) {
+        PRINT_WARNING << "Couldn't read the save game file: " << filename << std::endl;
+        return false;
+    }
+
+    return _ReadHeader();
+}
+
+bool SaveGameReader::ReadPreview(const std::string& filename, SaveGamePreview& preview)
+{
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    if (!file)
+        return false;
+
+    // Only read the header, the body isn't needed.
+    SaveGameReader reader;
+    reader._filename = filename;
+    reader._data.resize(SAVE_GAME_HEADER_START_SIZE);
+    if (!file.read(reinterpret_cast<char*>(&reader._data[0]), SAVE_GAME_HEADER_START_SIZE))
+        return false;
+
+    uint32_t header_size = _DecodeUInt32(&reader._data[SAVE_GAME_MAGIC_SIZE + sizeof(uint32_t)]);
+    if (header_size > SAVE_GAME_MAX_HEADER_SIZE)
+        return false;
+    if (header_size > SAVE_GAME_HEADER_START_SIZE) {
+        reader._data.resize(header_size);
+        if (!file.read(reinterpret_cast<char*>(&reader._data[SAVE_GAME_HEADER_START_SIZE]),
+                       header_size - SAVE_GAME_HEADER_START_SIZE))
+            return false;
+    }
+
+    if (!reader._ReadHeader())
+        return false;
+
+    preview = reader._preview;
+    return true;
+}
+
+uint8_t SaveGameReader::ReadUInt8()
+{
+    if (!_CanRead(1))
+        return 0;
+    return _data[_position++];
+}
+
+bool SaveGameReader::ReadBool()
+{
+    return ReadUInt8() != 0;
+}
+
+uint32_t SaveGameReader::ReadUInt32()
+{
+    if (!_CanRead(sizeof(uint32_t)))
+        return 0;
+
+    uint32_t value = _DecodeUInt32(&_data[_position]);
+    _position += sizeof(uint32_t);
+    return value;
+}
+
+float SaveGameReader::ReadFloat()
+{
+    uint32_t bits = ReadUInt32();
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::string SaveGameReader::ReadString()
+{
+    uint32_t size = ReadUInt32();
+    if (!_CanRead(size))
+        return std::string();
+
+    std::string value(reinterpret_cast<const char*>(&_data[_position]), size);
+    _position += size;
+    return value;
+}
+
+void SaveGameReader::ReadUIntVector(std::vector<uint32_t>& values)
+{
+    values.clear();
+    uint32_t size = ReadUInt32();
+    // Each value takes 4 bytes, which avoids reserving anything for a corrupted size.
+    if (!_CanRead(static_cast<size_t>(size) * sizeof(uint32_t)))
+        return;
+
+    values.reserve(size);
+    for (uint32_t i = 0; i < size; ++i)
+        values.push_back(ReadUInt32());
+}
+
+bool SaveGameReader::_ReadHeader()
+{
+    if (_data.size() < SAVE_GAME_HEADER_START_SIZE ||
+            std::memcmp(&_data[0], SAVE_GAME_MAGIC, SAVE_GAME_MAGIC_SIZE) != 0) {
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "Not a binary save game: " << _filename << std::endl;
+        return false;
+    }
+    _position = SAVE_GAME_MAGIC_SIZE;
+
+    _version = ReadUInt32();
+    if (_version == 0 || _version > SAVE_GAME_VERSION) {
+        PRINT_WARNING << "Unsupported save game version " << _version << " in: " << _filename << std::endl;
+        return false;
+    }
+
+    uint32_t header_size = ReadUInt32();
+
+    _preview.play_hours = ReadUInt8();
+    _preview.play_minutes = ReadUInt8();
+    _preview.play_seconds = ReadUInt8();
+    _preview.drunes = ReadUInt32();
+    _preview.map_data_filename = ReadString();
+    _preview.map_script_filename = ReadString();
+
+    uint32_t characters_count = ReadUInt8();
+    for (uint32_t i = 0; i < characters_count && !_error; ++i) {
+        SaveCharacterPreview character;
+        character.id = ReadUInt32();
+        character.experience_level = ReadUInt32();
+        character.total_experience_points = ReadUInt32();
+        character.unspent_experience_points = ReadUInt32();
+        character.experience_points_next = ReadInt32();
+        character.max_hit_points = ReadUInt32();
+        character.hit_points = ReadUInt32();
+        character.max_skill_points = ReadUInt32();
+        character.skill_points = ReadUInt32();
+        _preview.characters.push_back(character);
+    }
+
+    if (_error || _position > header_size || header_size > _data.size()) {
+        PRINT_WARNING << "Invalid save game header in: " << _filename << std::endl;
+        return false;
+    }
+
+    // The body starts right after the header, whatever the preview fields read.
+    _position = header_size;
+    return true;
+}
+
+bool SaveGameReader::_CanRead(size_t size)
+{
+    if (_error || _data.size() - _position < size) {
+        _error = true;
+        return false;
+    }
+    return true;
+}
+
+} // namespace vt_global
@@ -0,0 +1,219 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    save_game_file.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the binary save game files.
+***
+*** A save game file starts with a small header: a magic string, the format
+*** version, the header size and the preview fields shown in the save menu
+*** (play time, drunes, location and first party members). The body follows,
+*** written in order by the global data handlers.
+***
+*** All the values are stored in little endian, and the strings are preceded
+*** by their length. The older save games written as Lua scripts are still
+*** loaded, and replaced by binary ones when saving again.
+*** ***************************************************************************/
+
+#ifndef __SAVE_GAME_FILE_HEADER__
+#define __SAVE_GAME_FILE_HEADER__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vt_global
+{
+
+//! \brief The binary save game format version. Increase it when the body layout changes.
+const uint32_t SAVE_GAME_VERSION = 1;
+
+//! \brief The number of party members kept in the save game previews.
+const uint32_t SAVE_GAME_PREVIEW_CHARACTERS = 4;
+
+//! \brief The stats of a party member shown in the save menu.
+struct SaveCharacterPreview {
+    SaveCharacterPreview():
+        id(0),
+        experience_level(0),
+        total_experience_points(0),
+        unspent_experience_points(0),
+        experience_points_next(0),
+        max_hit_points(0),
+        hit_points(0),
+        max_skill_points(0),
+        skill_points(0)
+    {}
+
+    uint32_t id;
+    uint32_t experience_level;
+    uint32_t total_experience_points;
+    uint32_t unspent_experience_points;
+    int32_t experience_points_next;
+    uint32_t max_hit_points;
+    uint32_t hit_points;
+    uint32_t max_skill_points;
+    uint32_t skill_points;
+};
+
+//! \brief The save game data shown in the save menu, stored in the file header.
+struct SaveGamePreview {
+    SaveGamePreview():
+        play_hours(0),
+        play_minutes(0),
+        play_seconds(0),
+        drunes(0)
+    {}
+
+    uint8_t play_hours;
+    uint8_t play_minutes;
+    uint8_t play_seconds;
+    uint32_t drunes;
+
+    std::string map_data_filename;
+    std::string map_script_filename;
+
+    //! \brief The first party members, in party order.
+    std::vector<SaveCharacterPreview> characters;
+};
+
+/** \brief Gives the filename of a save game slot, as written by the game.
+*** \param autosave Whether to give the slot autosave filename.
+**/
+std::string GetSaveGameFilename(uint32_t slot_id, bool autosave = false);
+
+/** \brief Gives the filename of the existing save game of a slot.
+*** \return The binary save game filename, unless only a Lua save game exists for the slot.
+**/
+std::string FindSaveGameFilename(uint32_t slot_id, bool autosave = false);
+
+//! \brief Tells whether the file is a binary save game, rather than a Lua one.
+bool IsBinarySaveGame(const std::string& filename);
+
+/** ****************************************************************************
+*** \brief Writes a binary save game in memory, before saving it in a file.
+*** ***************************************************************************/
+class SaveGameWriter
+{
+public:
+    SaveGameWriter()
+    {}
+
+    void WriteUInt8(uint8_t value) {
+        _data.push_back(value);
+    }
+
+    void WriteBool(bool value) {
+        _data.push_back(value ? 1 : 0);
+    }
+
+    void WriteUInt32(uint32_t value);
+
+    void WriteInt32(int32_t value) {
+        WriteUInt32(static_cast<uint32_t>(value));
+    }
+
+    void WriteFloat(float value);
+
+    void WriteString(const std::string& value);
+
+    //! \brief Writes the number of values, followed by the values.
+    void WriteUIntVector(const std::vector<uint32_t>& values);
+
+    /** \brief Writes the header followed by the data written so far in the file.
+    *** The file is written under a temporary name, flushed to the disk and then renamed,
+    *** so that the previous file is kept whenever the write fails.
+    *** \return false if the file couldn't be written.
+    **/
+    bool SaveFile(const std::string& filename, const SaveGamePreview& preview) const;
+
+private:
+    //! \brief The data written.
+    std::vector<uint8_t> _data;
+};
+
+/** ****************************************************************************
+*** \brief Reads a binary save game.
+***
+*** Reading past the end of the file sets the error flag, and gives zero values
+*** and empty strings.
+*** ***************************************************************************/
+class SaveGameReader
+{
+public:
+    SaveGameReader():
+        _version(0),
+        _position(0),
+        _error(false)
+    {}
+
+    /** \brief Reads the whole file, and checks its header.
+    *** \return false if the file couldn't be read, or isn't a supported save game.
+    **/
+    bool OpenFile(const std::string& filename);
+
+    /** \brief Reads only the header of a save game file.
+    *** \return false if the file couldn't be read, or isn't a supported save game.
+    **/
+    static bool ReadPreview(const std::string& filename, SaveGamePreview& preview);
+
+    const std::string& GetFilename() const {
+        return _filename;
+    }
+
+    //! \brief The format version of the file read.
+    uint32_t GetVersion() const {
+        return _version;
+    }
+
+    const SaveGamePreview& GetPreview() const {
+        return _preview;
+    }
+
+    uint8_t ReadUInt8();
+    bool ReadBool();
+    uint32_t ReadUInt32();
+
+    int32_t ReadInt32() {
+        return static_cast<int32_t>(ReadUInt32());
+    }
+
+    float ReadFloat();
+    std::string ReadString();
+    void ReadUIntVector(std::vector<uint32_t>& values);
+
+    //! \brief Tells whether a read went past the end of the file.
+    bool IsErrorDetected() const {
+        return _error;
+    }
+
+private:
+    std::string _filename;
+
+    uint32_t _version;
+
+    SaveGamePreview _preview;
+
+    //! \brief The file data, and the position of the next value to read.
+    std::vector<uint8_t> _data;
+    size_t _position;
+
+    bool _error;
+
+    //! \brief Checks the header at the beginning of the data, and reads the preview.
+    bool _ReadHeader();
+
+    //! \brief Tells whether the given number of bytes can be read, and sets the error flag otherwise.
+    bool _CanRead(size_t size);
+};
+
+} // namespace vt_global
+
+#endif // __SAVE_GAME_FILE_HEADER__
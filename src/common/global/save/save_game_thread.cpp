@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    save_game_thread.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the save games written in the background.
+*** ***************************************************************************/
+
+#include "save_game_thread.h"
+
+#include "utils/utils_common.h"
+#include "utils/exception.h"
+
+namespace vt_global
+{
+
+extern bool GLOBAL_DEBUG;
+
+SaveGameThread::SaveGameThread() :
+    _stop(false)
+{
+}
+
+SaveGameThread::~SaveGameThread()
+{
+    if (!_thread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _work_condition.notify_one();
+    _thread.join();
+}
+
+void SaveGameThread::QueueSave(const std::string& filename, uint32_t slot_id,
+                               const SaveGamePreview& preview, SaveGameWriter& data)
+{
+    SaveJob job;
+    job.filename = filename;
+    job.slot_id = slot_id;
+    job.preview = preview;
+    job.data = std::move(data);
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _jobs.push_back(std::move(job));
+    }
+
+    if (!_thread.joinable())
+        _thread = std::thread(&SaveGameThread::_Work, this);
+    _work_condition.notify_one();
+}
+
+bool SaveGameThread::IsSaving(uint32_t slot_id)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (uint32_t i = 0; i < _jobs.size(); ++i) {
+        if (_jobs[i].slot_id == slot_id)
+            return true;
+    }
+    return false;
+}
+
+void SaveGameThread::WaitForCompletion()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_jobs.empty())
+        _done_condition.wait(lock);
+}
+
+void SaveGameThread::UpdateCompletedSaves()
+{
+    std::vector<SaveResult> results;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_results.empty())
+            return;
+        results.swap(_results);
+    }
+
+    if (!_completion_callback)
+        return;
+
+    for (uint32_t i = 0; i < results.size(); ++i)
+        _completion_callback(results[i].slot_id, results[i].success);
+}
+
+void SaveGameThread::_Work()
+{
+    while (true) {
+        const SaveJob* job = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (!_stop && _jobs.empty())
+                _work_condition.wait(lock);
+
+            if (_jobs.empty())
+                return;
+
+            // The front job stays queued while written, so that IsSaving() reports it.
+            // Only this thread pops jobs, so the reference stays valid.
+            job = &_jobs.front();
+        }
+
+        bool success = job->data.SaveFile(job->filename, job->preview);
+        IF_PRINT_DEBUG(GLOBAL_DEBUG) << "Save game written in the background: " << job->filename
+                                     << (success ? "" : " (failed)") << std::endl;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            SaveResult result;
+            result.slot_id = job->slot_id;
+            result.success = success;
+            _results.push_back(result);
+            _jobs.pop_front();
+        }
+        _done_condition.notify_all();
+    }
+}
+
+SaveGameThread::SaveGameThread(const SaveGameThread&)
+{
+    throw vt_utils::Exception("Not Implemented!", __FILE__, __LINE__, __FUNCTION__);
+}
+
+SaveGameThread& SaveGameThread::operator=(const SaveGameThread&)
+{
+    throw vt_utils::Exception("Not Implemented!", __FILE__, __LINE__, __FUNCTION__);
+    return *this;
+}
+
+} // namespace vt_global
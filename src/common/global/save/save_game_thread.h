@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2018 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    save_game_thread.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the save games written in the background.
+***
+*** The game state is serialized on the main thread into a SaveGameWriter, which
+*** is then handed over to a thread writing it to the disk, so that autosaving
+*** on map transitions doesn't stall the game.
+*** ***************************************************************************/
+
+#ifndef __SAVE_GAME_THREAD_HEADER__
+#define __SAVE_GAME_THREAD_HEADER__
+
+#include "save_game_file.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace vt_global
+{
+
+/** \brief The function called once a save game was written.
+*** Its parameters are the save slot id and whether the file was successfully written.
+**/
+typedef std::function<void(uint32_t, bool)> SaveGameCallback;
+
+/** ****************************************************************************
+*** \brief Writes save games to the disk using a background thread.
+***
+*** The thread is started with the first queued save game. The completion
+*** callback is only ever called from the main thread, by UpdateCompletedSaves().
+*** ***************************************************************************/
+class SaveGameThread
+{
+public:
+    SaveGameThread();
+
+    //! \brief Writes the remaining queued save games, and stops the thread.
+    ~SaveGameThread();
+
+    /** \brief Queues a save game to be written by the thread.
+    *** \param data The save game body. Its content is moved into the queue.
+    **/
+    void QueueSave(const std::string& filename, uint32_t slot_id,
+                   const SaveGamePreview& preview, SaveGameWriter& data);
+
+    //! \brief Tells whether a save game of the given slot is queued or being written.
+    bool IsSaving(uint32_t slot_id);
+
+    //! \brief Blocks until every queued save game is written.
+    void WaitForCompletion();
+
+    //! \brief Calls the completion callback for the save games written since the last call.
+    void UpdateCompletedSaves();
+
+    //! \brief Sets the function called once a save game is written. An empty function removes it.
+    void SetCompletionCallback(const SaveGameCallback& callback) {
+        _completion_callback = callback;
+    }
+
+private:
+    //! \brief A queued save game.
+    struct SaveJob {
+        std::string filename;
+        uint32_t slot_id;
+        SaveGamePreview preview;
+        SaveGameWriter data;
+    };
+
+    //! \brief A written save game, waiting for its completion callback.
+    struct SaveResult {
+        uint32_t slot_id;
+        bool success;
+    };
+
+    //! \brief The thread main function.
+    void _Work();
+
+    std::thread _thread;
+
+    //! \brief Protects the members below.
+    std::mutex _mutex;
+
+    //! \brief Notified when a save game is queued, or when the thread must stop.
+    std::condition_variable _work_condition;
+
+    //! \brief Notified when a save game is written.
+    std::condition_variable _done_condition;
+
+    //! \brief The save games waiting to be written. The front one is being written.
+    std::deque<SaveJob> _jobs;
+
+    //! \brief The save games written, waiting for their completion callback.
+    std::vector<SaveResult> _results;
+
+    //! \brief Tells the thread to stop once the queue is empty.
+    bool _stop;
+
+    //! \brief Only used from the main thread.
+    SaveGameCallback _completion_callback;
+
+    SaveGameThread(const SaveGameThread& copy);
+    SaveGameThread& operator=(const SaveGameThread& copy);
+}; // class SaveGameThread
+
+} // namespace vt_global
+
+#endif // __SAVE_GAME_THREAD_HEADER__
@@ -84,48 +84,47 @@ void ShopDataHandler::LoadShopData(vt_script::ReadScriptDescriptor& file)
     file.CloseTable(); // shop_data
 }
 
-void ShopDataHandler::SaveShopData(vt_script::WriteScriptDescriptor& file)
+//! \brief Reads the item counts of a shop, written by _SaveItemCounts().
+static void _LoadItemCounts(SaveGameReader& file, std::map<uint32_t, uint32_t>& item_counts)
 {
-    if(!file.IsFileOpen()) {
-        PRINT_WARNING << "The file was not open: " << file.GetFilename() << std::endl;
-        return;
+    uint32_t items_number = file.ReadUInt32();
+    for (uint32_t i = 0; i < items_number && !file.IsErrorDetected(); ++i) {
+        uint32_t item_id = file.ReadUInt32();
+        item_counts[item_id] = file.ReadUInt32();
     }
+}
 
-    file.WriteLine("shop_data = {");
-    file.InsertNewLine();
-
-    auto it = _shop_data.begin();
-    auto it_end = _shop_data.end();
-    for (; it != it_end; ++it) {
-        std::string shop_id = it->first;
-        const ShopData& shop_data = it->second;
+//! \brief Writes the number of items, followed by the item ids and counts.
+static void _SaveItemCounts(SaveGameWriter& file, const std::map<uint32_t, uint32_t>& item_counts)
+{
+    file.WriteUInt32(static_cast<uint32_t>(item_counts.size()));
+    for (auto it = item_counts.begin(); it != item_counts.end(); ++it) {
+        file.WriteUInt32(it->first);
+        file.WriteUInt32(it->second);
+    }
+}
 
-        file.WriteLine("\t[\"" + shop_id + "\"] = {");
+void ShopDataHandler::LoadShopData(SaveGameReader& file)
+{
+    uint32_t shops_number = file.ReadUInt32();
+    for (uint32_t i = 0; i < shops_number && !file.IsErrorDetected(); ++i) {
+        std::string shop_id = file.ReadString();
 
-        file.WriteLine("\t\tavailable_buy = {");
-        auto it2 = shop_data._available_buy.begin();
-        auto it2_end = shop_data._available_buy.end();
-        for(; it2 != it2_end; ++it2) {
-            std::string item_id = NumberToString(it2->first);
-            std::string count = NumberToString(it2->second);
-            file.WriteLine("\t\t\t[\"" + item_id + "\"] = " + count + ",");
-        }
-        file.WriteLine("\t\t},");
-
-        file.WriteLine("\t\tavailable_trade = {");
-        auto it3 = shop_data._available_trade.begin();
-        auto it3_end = shop_data._available_trade.end();
-        for(; it3 != it3_end; ++it3) {
-            std::string item_id = NumberToString(it3->first);
-            std::string count = NumberToString(it3->second);
-            file.WriteLine("\t\t\t[\"" + item_id + "\"] = " + count + ",");
-        }
-        file.WriteLine("\t\t}");
+        ShopData shop_data;
+        _LoadItemCounts(file, shop_data._available_buy);
+        _LoadItemCounts(file, shop_data._available_trade);
+        _shop_data[shop_id] = shop_data;
+    }
+}
 
-        file.WriteLine("\t},");
+void ShopDataHandler::SaveShopData(SaveGameWriter& file)
+{
+    file.WriteUInt32(static_cast<uint32_t>(_shop_data.size()));
+    for (auto it = _shop_data.begin(); it != _shop_data.end(); ++it) {
+        file.WriteString(it->first);
+        _SaveItemCounts(file, it->second._available_buy);
+        _SaveItemCounts(file, it->second._available_trade);
     }
-    file.WriteLine("},"); // Close the shop_data table
-    file.InsertNewLine();
 }
 
 } // namespace vt_global
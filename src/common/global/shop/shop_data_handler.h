@@ -13,8 +13,9 @@
 
 #include "shop_data.h"
 
+#include "common/global/save/save_game_file.h"
+
 #include "script/script_read.h"
-#include "script/script_write.h"
 
 #include <string>
 #include <map>
@@ -46,10 +47,13 @@ public:
     **/
     void LoadShopData(vt_script::ReadScriptDescriptor& file);
 
+    //! \brief Load shop data from a binary save game, written by SaveShopData().
+    void LoadShopData(SaveGameReader& file);
+
     /** \brief saves the shop data information. this is called from SaveGame()
-    *** \param file Reference to open and valid file for writting the data
+    *** \param file Reference to the save game being written
     **/
-    void SaveShopData(vt_script::WriteScriptDescriptor& file);
+    void SaveShopData(SaveGameWriter& file);
 
 private:
     //! \brief A map of the curent shop data.
@@ -150,31 +150,28 @@ void WorldMapHandler::LoadWorldMap(vt_script::ReadScriptDescriptor& file)
     file.CloseTable(); // worldmap
 }
 
-void WorldMapHandler::SaveWorldMap(vt_script::WriteScriptDescriptor& file)
+void WorldMapHandler::LoadWorldMap(SaveGameReader& file)
 {
-    if(!file.IsFileOpen()) {
-        PRINT_WARNING << "The file provided in the function argument was not open" << std::endl;
-        return;
-    }
+    SetWorldMapImage(file.ReadString());
 
-    // Write the 'worldmap' table
-    file.WriteLine("worldmap = {");
+    uint32_t locations_number = file.ReadUInt32();
+    for(uint32_t i = 0; i < locations_number && !file.IsErrorDetected(); ++i)
+        ShowWorldLocation(file.ReadString());
+
+    std::string current_location = file.ReadString();
+    if (!current_location.empty())
+        SetCurrentLocationId(current_location);
+}
 
-    // Write the world map filename
-    file.WriteLine("\tworld_map_file = \"" + GetWorldMapImageFilename() + "\",");
-    file.InsertNewLine();
+void WorldMapHandler::SaveWorldMap(SaveGameWriter& file)
+{
+    file.WriteString(GetWorldMapImageFilename());
 
-    // Write the viewable locations
-    file.WriteLine("\tviewable_locations = {");
+    file.WriteUInt32(static_cast<uint32_t>(_viewable_world_locations.size()));
     for(uint32_t i = 0; i < _viewable_world_locations.size(); ++i)
-        file.WriteLine("\t\t\"" + _viewable_world_locations[i]+"\",");
-    file.WriteLine("\t},");
-    file.InsertNewLine();
-
-    file.WriteLine("\tcurrent_location = \"" + GetCurrentLocationId() + "\"");
+        file.WriteString(_viewable_world_locations[i]);
 
-    file.WriteLine("},"); // close the main table
-    file.InsertNewLine();
+    file.WriteString(GetCurrentLocationId());
 }
 
 } // namespace vt_global
@@ -13,8 +13,9 @@
 
 #include "worldmap_location.h"
 
+#include "common/global/save/save_game_file.h"
+
 #include "script/script_read.h"
-#include "script/script_write.h"
 
 #include <string>
 #include <vector>
@@ -105,9 +106,12 @@ public:
     //! \param file Reference to an open file for reading save game data
     void LoadWorldMap(vt_script::ReadScriptDescriptor& file);
 
+    //! \brief Load world map and viewable information from a binary save game, written by SaveWorldMap()
+    void LoadWorldMap(SaveGameReader& file);
+
     //! \brief saves the world map information. this is called from SaveGame()
-    //! \param file Reference to open and valid file for writting the data
-    void SaveWorldMap(vt_script::WriteScriptDescriptor& file);
+    //! \param file Reference to the save game being written
+    void SaveWorldMap(SaveGameWriter& file);
 
 private:
     //! \brief The current graphical world map. If the filename is empty,
@@ -247,7 +247,7 @@ void TextBox::_ReformatText()
     }
     else {
         // Get the wrapped text lines
-        _text = TextManager->WrapText(_text_save, fp->ttf_font, _width);
+        _text = TextManager->WrapText(_text_save, fp, _width);
 
         // Compute the number of chars
         const size_t temp_length = _text_save.length();
@@ -338,7 +338,6 @@ float TextBox::_CalculateTextHeight()
 void TextBox::_DrawTextLines(float text_x, float text_y, ScreenRect scissor_rect)
 {
     FontProperties* fp = _text_style.GetFontProperties();
-    TTF_Font* ttf_font = fp->ttf_font;
     int32_t num_chars_drawn = 0;
 
     // Calculate the fraction of the text to display
@@ -351,7 +350,7 @@ void TextBox::_DrawTextLines(float text_x, float text_y, ScreenRect scissor_rect
     // Iterate through the loop for every line of text and draw it
     for(int32_t line = 0; line < static_cast<int32_t>(_text.size()); ++line) {
         // (1): Calculate the x draw offset for this line and move to that position
-        float line_width = static_cast<float>(TextManager->CalculateTextWidth(ttf_font, _text[line]));
+        float line_width = static_cast<float>(TextManager->CalculateTextWidth(fp, _text[line]));
         int32_t x_align = VideoManager->_ConvertXAlign(_text_xalign);
         float x_offset = text_x + ((x_align + 1) * line_width) * 0.5f * VideoManager->_current_context.coordinate_system.GetHorizontalDirection();
 
@@ -411,7 +410,7 @@ void TextBox::_DrawTextLines(float text_x, float text_y, ScreenRect scissor_rect
                     current_color[3] *= cur_percent;
                     _text_style.SetColor(current_color);
 
-                    VideoManager->MoveRelative(static_cast<float>(TextManager->CalculateTextWidth(ttf_font, substring)), 0.0f);
+                    VideoManager->MoveRelative(static_cast<float>(TextManager->CalculateTextWidth(fp, substring)), 0.0f);
                     TextManager->Draw(_text[line].substr(num_completed_chars, 1), _text_style);
                     _text_style.SetColor(saved_color);
                 }
@@ -467,7 +466,7 @@ void TextBox::_DrawTextLines(float text_x, float text_y, ScreenRect scissor_rect
                 // Create a rectangle for the current character, in window coordinates
                 int32_t char_x, char_y, char_w, char_h;
                 char_x = static_cast<int32_t>(x_offset + VideoManager->_current_context.coordinate_system.GetHorizontalDirection()
-                                            * TextManager->CalculateTextWidth(ttf_font, substring));
+                                            * TextManager->CalculateTextWidth(fp, substring));
                 char_y = static_cast<int32_t>(text_y - VideoManager->_current_context.coordinate_system.GetVerticalDirection()
                                             * (fp->height + fp->descent));
 
@@ -477,13 +476,13 @@ void TextBox::_DrawTextLines(float text_x, float text_y, ScreenRect scissor_rect
                 if(VideoManager->_current_context.coordinate_system.GetVerticalDirection() < 0.0f)
                     char_x = static_cast<int32_t>(VideoManager->_current_context.coordinate_system.GetLeft()) - char_x;
 
-                char_w = TextManager->CalculateTextWidth(ttf_font, cur_char_string);
+                char_w = TextManager->CalculateTextWidth(fp, cur_char_string);
                 char_h = fp->height;
 
                 // Multiply the width by percentage done to determine the scissoring dimensions
                 char_w = static_cast<int32_t>(cur_percent * char_w);
                 VideoManager->MoveRelative(VideoManager->_current_context.coordinate_system.GetHorizontalDirection()
-                                           * TextManager->CalculateTextWidth(ttf_font, substring), 0.0f);
+                                           * TextManager->CalculateTextWidth(fp, substring), 0.0f);
 
                 // Construct the scissor rectangle using the character dimensions and draw the revealing character.
                 VideoManager->PushState();
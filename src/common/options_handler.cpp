@@ -20,6 +20,7 @@
 #include "engine/system.h"
 #include "engine/input.h"
 #include "engine/audio/audio.h"
+#include "engine/video/particle_worker_pool.h"
 #include "script/script_write.h"
 
 #include "engine/mode_manager.h"
@@ -1308,6 +1309,11 @@ bool GameOptionsMenuHandler::_SaveSettingsFile(const std::string& filename)
     settings_lua.WriteBool("full_screen", VideoManager->IsFullscreen());
     settings_lua.WriteComment("Get the desired VSync mode. 0: No VSync, 1: VSync, 2: Swap Tearing");
     settings_lua.WriteUInt("vsync_mode", VideoManager->GetVSyncMode());
+    std::stringstream particle_threads_text("");
+    particle_threads_text << "Number of threads updating the particle effects [0-"
+                          << vt_mode_manager::MAX_PARTICLE_THREADS << "]. 0: Depends on the CPU cores (Default: 0)";
+    settings_lua.WriteComment(particle_threads_text.str());
+    settings_lua.WriteUInt("particle_threads", VideoManager->GetParticleThreadCount());
     settings_lua.WriteComment("The UI Theme to load.");
     settings_lua.WriteString("ui_theme", GUIManager->GetDefaultMenuSkinId());
     settings_lua.EndTable(); // video_settings
@@ -1319,6 +1325,8 @@ bool GameOptionsMenuHandler::_SaveSettingsFile(const std::string& filename)
     settings_lua.WriteComment("Music and sounds volumes: [0.0 - 1.0]");
     settings_lua.WriteFloat("music_vol", AudioManager->GetMusicVolume());
     settings_lua.WriteFloat("sound_vol", AudioManager->GetSoundVolume());
+    settings_lua.WriteComment("The memory budget of the audio cache, in megabytes");
+    settings_lua.WriteUInt("cache_size", AudioManager->GetCacheBudget() / (1024 * 1024));
     settings_lua.EndTable(); // audio_settings
 
     // input
@@ -1378,6 +1386,13 @@ bool GameOptionsMenuHandler::_SaveSettingsFile(const std::string& filename)
     settings_lua.WriteInt("message_speed", SystemManager->GetMessageSpeed());
     settings_lua.WriteComment("Sets whether each character will remember their previous action in battle. (Default: 'true')");
     settings_lua.WriteBool("battle_target_cursor_memory", SystemManager->GetBattleTargetMemory());
+    std::stringstream update_rate_text("");
+    update_rate_text << "Number of game logic updates per second [1-N] (Default: "
+                     << vt_system::DEFAULT_UPDATE_RATE << ")";
+    settings_lua.WriteComment(update_rate_text.str());
+    settings_lua.WriteUInt("update_rate", SystemManager->GetUpdateRate());
+    settings_lua.WriteComment("Sets whether moving objects are drawn between their game logic updates, for a smoother movement. (Default: 'true')");
+    settings_lua.WriteBool("update_interpolation", SystemManager->IsUpdateInterpolationEnabled());
     settings_lua.EndTable(); // game_options
 
     settings_lua.EndTable(); // settings
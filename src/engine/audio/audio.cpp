@@ -25,6 +25,7 @@
 
 #include "engine/system.h"
 #include "engine/mode_manager.h"
+#include "engine/profiler.h"
 
 #include "utils/utils_strings.h"
 #include "utils/utils_files.h"
@@ -46,7 +47,13 @@ AudioEngine::AudioEngine() :
     _device(0),
     _context(0),
     _max_sources(MAX_DEFAULT_AUDIO_SOURCES),
-    _active_music(nullptr)
+    _active_music(nullptr),
+    _cache_size(0),
+    _cache_budget(DEFAULT_AUDIO_CACHE_SIZE * 1024 * 1024),
+    _cache_hits(0),
+    _cache_misses(0),
+    _shared_buffer_hits(0),
+    _shared_buffer_misses(0)
 {}
 
 bool AudioEngine::SingletonInitialize()
@@ -150,11 +157,15 @@ AudioEngine::~AudioEngine()
     if(!AUDIO_ENABLE)
         return;
 
+    // The remaining streams are freed below, along with the sources they use.
+    _streamer.StopThread();
+
     // Delete all entries in the sound cache
     for(std::map<std::string, private_audio::AudioCacheElement>::iterator i = _audio_cache.begin(); i != _audio_cache.end(); ++i) {
         delete i->second.audio;
     }
     _audio_cache.clear();
+    _cache_size = 0;
 
     // Delete all audio sources
     for(std::vector<AudioSource *>::iterator i = _audio_sources.begin(); i != _audio_sources.end(); ++i) {
@@ -199,6 +210,13 @@ AudioEngine::~AudioEngine()
         }
     }
 
+    // The buffers are released by their descriptors, so none should be left.
+    for(std::map<std::string, SharedAudioBuffer>::iterator it = _shared_buffers.begin(); it != _shared_buffers.end(); ++it) {
+        IF_PRINT_WARNING(AUDIO_DEBUG) << "This audio buffer was never released: " << it->first << std::endl;
+        delete it->second.buffer;
+    }
+    _shared_buffers.clear();
+
     alcMakeContextCurrent(0);
     alcDestroyContext(_context);
     alcCloseDevice(_device);
@@ -206,6 +224,8 @@ AudioEngine::~AudioEngine()
 
 void AudioEngine::Update()
 {
+    PROFILE_ZONE("AudioManager::Update");
+
     if(!AUDIO_ENABLE)
         return;
 
@@ -395,6 +415,8 @@ void AudioEngine::PlaySound(const std::string &filename)
         } else {
             element = _audio_cache.find(filename);
         }
+    } else {
+        ++_cache_hits;
     }
 
     element->second.audio->Play();
@@ -417,6 +439,8 @@ void AudioEngine::PlayMusic(const std::string &filename)
         } else {
             element = _audio_cache.find(filename);
         }
+    } else {
+        ++_cache_hits;
     }
 
     // Special case: the music descriptor object must be taken back:
@@ -504,6 +528,7 @@ void AudioEngine::RemoveGameModeOwner(vt_mode_manager::GameMode* gm)
     for(; it != _audio_cache.end();) {
         // If the audio buffers are erased, we can remove the descriptor from the cache.
         if(it->second.audio->RemoveGameModeOwner(gm)) {
+            _cache_size -= it->second.size;
             delete it->second.audio;
             // Make sure the iterator doesn't get flawed after erase.
             _audio_cache.erase(it++);
@@ -529,7 +554,7 @@ const std::string AudioEngine::CreateALErrorString()
     case AL_OUT_OF_MEMORY:
         return "AL_OUT_OF_MEMORY";
     default:
-        return ("Unknown AL error code: " + NumberToString(_al_error_code));
+        return ("Unknown AL error code: " + NumberToString(_al_error_code.load()));
     }
 }
 
@@ -585,6 +610,34 @@ void AudioEngine::DEBUG_PrintInfo()
         PRINT_WARNING << c[0];
         c++;
     }
+    PRINT_WARNING << std::endl;
+
+    uint32_t cache_requests = _cache_hits + _cache_misses;
+    PRINT_WARNING << "Audio cache entries:         " << _audio_cache.size() << std::endl;
+    PRINT_WARNING << "Audio cache resident memory: " << _cache_size / 1024 << " KB / "
+                  << _cache_budget / 1024 << " KB" << std::endl;
+    PRINT_WARNING << "Audio cache hits / misses:   " << _cache_hits << " / " << _cache_misses;
+    if(cache_requests > 0)
+        PRINT_WARNING << " (" << (_cache_hits * 100 / cache_requests) << "% hits)";
+    PRINT_WARNING << std::endl;
+
+    uint32_t shared_buffers_size = 0;
+    for(std::map<std::string, SharedAudioBuffer>::const_iterator it = _shared_buffers.begin(); it != _shared_buffers.end(); ++it)
+        shared_buffers_size += it->second.size;
+
+    uint32_t buffer_requests = _shared_buffer_hits + _shared_buffer_misses;
+    PRINT_WARNING << "Shared audio buffers:        " << _shared_buffers.size() << " ("
+                  << shared_buffers_size / 1024 << " KB)" << std::endl;
+    PRINT_WARNING << "Shared buffer hits / misses: " << _shared_buffer_hits << " / " << _shared_buffer_misses;
+    if(buffer_requests > 0)
+        PRINT_WARNING << " (" << (_shared_buffer_hits * 100 / buffer_requests) << "% hits)";
+    PRINT_WARNING << std::endl;
+}
+
+void AudioEngine::SetCacheBudget(uint32_t budget)
+{
+    _cache_budget = budget;
+    _EvictCachedAudio(0);
 }
 
 private_audio::AudioSource* AudioEngine::_AcquireAudioSource()
@@ -614,6 +667,7 @@ bool AudioEngine::_LoadAudio(const std::string &filename, bool is_music, vt_mode
 
     std::map<std::string, private_audio::AudioCacheElement>::iterator it = _audio_cache.find(filename);
     if(it != _audio_cache.end()) {
+        ++_cache_hits;
 
         if (gm)
             it->second.audio->AddGameModeOwner(gm);
@@ -621,6 +675,7 @@ bool AudioEngine::_LoadAudio(const std::string &filename, bool is_music, vt_mode
         // Return a success since basically everything will keep on working as expected.
         return true;
     }
+    ++_cache_misses;
 
     // Creates the new audio object and adds its potential game mode owner.
     AudioDescriptor* audio = nullptr;
@@ -639,8 +694,75 @@ bool AudioEngine::_LoadAudio(const std::string &filename, bool is_music, vt_mode
         return false;
     }
 
-    _audio_cache.insert(std::make_pair(filename, AudioCacheElement(SDL_GetTicks(), audio)));
+    // Make room for the new audio before caching it, so that it can't be evicted right away.
+    uint32_t data_size = audio->GetDataMemorySize();
+    _EvictCachedAudio(data_size);
+
+    _audio_cache.insert(std::make_pair(filename, AudioCacheElement(SDL_GetTicks(), audio, data_size)));
+    _cache_size += data_size;
     return true;
 }
 
+void AudioEngine::_EvictCachedAudio(uint32_t data_size)
+{
+    while(!_audio_cache.empty() && _cache_size + data_size > _cache_budget) {
+        // Find the least recently used audio that can be freed.
+        std::map<std::string, AudioCacheElement>::iterator lru = _audio_cache.end();
+        for(std::map<std::string, AudioCacheElement>::iterator it = _audio_cache.begin(); it != _audio_cache.end(); ++it) {
+            AudioDescriptor *audio = it->second.audio;
+            if(!audio->GetGameModeOwners()->empty() || audio == _active_music)
+                continue;
+
+            AUDIO_STATE state = audio->GetState();
+            if(state != AUDIO_STATE_STOPPED && state != AUDIO_STATE_UNLOADED)
+                continue;
+
+            if(lru == _audio_cache.end() || it->second.last_update_time < lru->second.last_update_time)
+                lru = it;
+        }
+
+        // Everything left is in use: the budget is exceeded until some audio is released.
+        if(lru == _audio_cache.end())
+            return;
+
+        IF_PRINT_DEBUG(AUDIO_DEBUG) << "Evicting audio from the cache: " << lru->first << std::endl;
+        _cache_size -= lru->second.size;
+        delete lru->second.audio;
+        _audio_cache.erase(lru);
+    }
+}
+
+AudioBuffer *AudioEngine::_RetainSharedBuffer(const std::string &filename)
+{
+    std::map<std::string, SharedAudioBuffer>::iterator it = _shared_buffers.find(filename);
+    if(it == _shared_buffers.end()) {
+        ++_shared_buffer_misses;
+        return nullptr;
+    }
+
+    ++_shared_buffer_hits;
+    ++it->second.reference_count;
+    return it->second.buffer;
+}
+
+void AudioEngine::_AddSharedBuffer(const std::string &filename, AudioBuffer *buffer, uint32_t size)
+{
+    _shared_buffers.insert(std::make_pair(filename, SharedAudioBuffer(buffer, size)));
+}
+
+void AudioEngine::_ReleaseSharedBuffer(const std::string &filename)
+{
+    std::map<std::string, SharedAudioBuffer>::iterator it = _shared_buffers.find(filename);
+    if(it == _shared_buffers.end()) {
+        IF_PRINT_WARNING(AUDIO_DEBUG) << "released an audio buffer that wasn't shared: " << filename << std::endl;
+        return;
+    }
+
+    if(--it->second.reference_count > 0)
+        return;
+
+    delete it->second.buffer;
+    _shared_buffers.erase(it);
+}
+
 } // namespace vt_audio
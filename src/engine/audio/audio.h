@@ -29,7 +29,9 @@
 
 #include "audio_descriptor.h"
 #include "audio_effects.h"
+#include "audio_streamer.h"
 
+#include <atomic>
 #include <map>
 
 //! \brief All related audio engine code is wrapped within this namespace
@@ -53,20 +55,45 @@ namespace private_audio
 //! \brief The maximum default number of audio sources that the engine tries to create
 const uint16_t MAX_DEFAULT_AUDIO_SOURCES = 64;
 
+//! \brief The default memory budget of the audio cache, in megabytes
+const uint32_t DEFAULT_AUDIO_CACHE_SIZE = 32;
+
 
 
 //! \brief A container class for an element of the LRU audio cache managed by the AudioEngine class
 class AudioCacheElement
 {
 public:
-    AudioCacheElement(uint32_t time, AudioDescriptor *aud) :
-        last_update_time(time), audio(aud) {}
+    AudioCacheElement(uint32_t time, AudioDescriptor *aud, uint32_t data_size) :
+        last_update_time(time), audio(aud), size(data_size) {}
 
     //! \brief Retains the time that the audio was last updated through any operation
     uint32_t last_update_time;
 
     //! \brief A pointer to the audio descriptor described by the cache element
     AudioDescriptor *audio;
+
+    //! \brief The audio data memory held by the descriptor when it was cached, in bytes
+    uint32_t size;
+};
+
+
+
+//! \brief A decoded OpenAL buffer shared by every static audio descriptor of the same file
+class SharedAudioBuffer
+{
+public:
+    SharedAudioBuffer(AudioBuffer *buf, uint32_t data_size) :
+        buffer(buf), size(data_size), reference_count(1) {}
+
+    //! \brief The OpenAL buffer containing the whole decoded file
+    AudioBuffer *buffer;
+
+    //! \brief The decoded data size, in bytes
+    uint32_t size;
+
+    //! \brief The number of audio descriptors using the buffer
+    uint32_t reference_count;
 };
 
 } // namespace private_audio
@@ -324,6 +351,18 @@ public:
     const std::string CreateALCErrorString();
     //@}
 
+    //! \brief Returns the memory budget of the audio cache, in bytes
+    uint32_t GetCacheBudget() const {
+        return _cache_budget;
+    }
+
+    /** \brief Sets the memory budget of the audio cache
+    *** \param budget The maximum audio data memory, in bytes, held by the cached audio.
+    *** Least recently used entries are evicted when the budget is exceeded, as long as they
+    *** are neither owned by a game mode nor playing.
+    **/
+    void SetCacheBudget(uint32_t budget);
+
     //! \brief Prints information about the audio properties and settings of the user's machine
     void DEBUG_PrintInfo();
 
@@ -346,8 +385,8 @@ private:
     //! \brief The current OpenAL context that the audio engine is using
     ALCcontext *_context;
 
-    //! \brief Holds the most recently fetched OpenAL error code
-    ALenum _al_error_code;
+    //! \brief Holds the most recently fetched OpenAL error code, also checked by the streaming thread
+    std::atomic<ALenum> _al_error_code;
 
     //! \brief Holds the most recently fetched OpenAL context error code
     ALCenum _alc_error_code;
@@ -368,6 +407,9 @@ private:
     //! \brief Contains all available audio sources
     std::vector<private_audio::AudioSource *> _audio_sources;
 
+    //! \brief The thread refilling the streaming buffers of the streamed audio descriptors
+    private_audio::AudioStreamer _streamer;
+
     /** \brief Lists of pointers to all audio descriptor objects which have been created by the user
     *** These lists are kept so that when the global sound or music volume levels are changed, all
     *** sound and music objects will also have their volumes updated.
@@ -391,6 +433,30 @@ private:
     **/
     std::map<std::string, private_audio::AudioCacheElement> _audio_cache;
 
+    //! \brief The audio data memory held by the cached audio, in bytes
+    uint32_t _cache_size;
+
+    //! \brief The maximum audio data memory the cached audio should hold, in bytes
+    uint32_t _cache_budget;
+
+    //! \brief The number of cache requests that found, or not, the audio already loaded
+    //@{
+    uint32_t _cache_hits;
+    uint32_t _cache_misses;
+    //@}
+
+    /** \brief The decoded buffers of the static audio, using the filename as key
+    *** The buffers are shared among all the descriptors of a same file, cached or not,
+    *** and are freed along with the last descriptor using them.
+    **/
+    std::map<std::string, private_audio::SharedAudioBuffer> _shared_buffers;
+
+    //! \brief The number of static audio loads that reused, or not, an already decoded buffer
+    //@{
+    uint32_t _shared_buffer_hits;
+    uint32_t _shared_buffer_misses;
+    //@}
+
     /** \brief Acquires an available audio source that may be used
     *** \return A pointer to the available source, or nullptr if no available source could be found
     **/
@@ -405,6 +471,23 @@ private:
     **/
     bool _LoadAudio(const std::string &filename, bool is_music, vt_mode_manager::GameMode *gm = nullptr);
 
+    /** \brief Evicts the least recently used audio from the cache until the new data fits in the budget
+    *** \param data_size The size of the audio data about to be cached, in bytes
+    *** Only the audio that is neither owned by a game mode nor playing is evicted.
+    **/
+    void _EvictCachedAudio(uint32_t data_size);
+
+    /** \brief Returns the shared decoded buffer of a file, or nullptr if it isn't loaded yet
+    *** The buffer reference count is increased when found.
+    **/
+    private_audio::AudioBuffer *_RetainSharedBuffer(const std::string &filename);
+
+    //! \brief Adds a newly decoded buffer, used by one descriptor, to the shared buffers
+    void _AddSharedBuffer(const std::string &filename, private_audio::AudioBuffer *buffer, uint32_t size);
+
+    //! \brief Decreases the reference count of a shared buffer, freeing it when it reaches zero
+    void _ReleaseSharedBuffer(const std::string &filename);
+
 }; // class AudioEngine : public vt_utils::Singleton<AudioEngine>
 
 } // namespace vt_audio
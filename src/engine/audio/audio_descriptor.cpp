@@ -119,7 +119,13 @@ AudioDescriptor::AudioDescriptor() :
     _volume(1.0f),
     _fade_effect_time(0.0f),
     _original_volume(0.0f),
-    _stream_buffer_size(0)
+    _stream_buffer_size(0),
+    _streaming(false),
+    _stream_play_requests(0),
+    _stream_playing(false),
+    _stream_play_count(0),
+    _stream_finished_play(0),
+    _stream_position(0)
 {
     _position[0] = 0.0f;
     _position[1] = 0.0f;
@@ -144,7 +150,13 @@ AudioDescriptor::AudioDescriptor(const AudioDescriptor &copy) :
     _volume(copy._volume),
     _fade_effect_time(copy._fade_effect_time),
     _original_volume(copy._original_volume),
-    _stream_buffer_size(0)
+    _stream_buffer_size(0),
+    _streaming(false),
+    _stream_play_requests(0),
+    _stream_playing(false),
+    _stream_play_count(0),
+    _stream_finished_play(0),
+    _stream_position(0)
 {
     _position[0] = 0.0f;
     _position[1] = 0.0f;
@@ -211,22 +223,26 @@ bool AudioDescriptor::LoadAudio(const std::string &filename, AUDIO_LOAD load_typ
 
     // Load the audio data depending upon the load type requested
     if(load_type == AUDIO_LOAD_STATIC) {
-        // For static sounds just 1 buffer is needed. We create it as an array here, so that
-        // later we can delete it with a call of delete[], similar to the streaming cases
-        _buffer = new AudioBuffer[1];
-
-        // Create space in memory for the audio data to be read and passed to the OpenAL buffer
-        _data = new uint8_t[_input->GetDataSize()];
-        bool all_data_read = false;
-        if(_input->Read(_data, _input->GetTotalNumberSamples(), all_data_read) != _input->GetTotalNumberSamples()) {
-            IF_PRINT_WARNING(AUDIO_DEBUG) << "failed to read entire audio data stream for file: " << filename << std::endl;
-            return false;
-        }
+        // For static sounds just 1 buffer is needed, shared with the other descriptors of the same file.
+        // The file is thus only decoded when no other descriptor already did it.
+        _buffer = AudioManager->_RetainSharedBuffer(_input->GetFilename());
+        if(_buffer == nullptr) {
+            // Create space in memory for the audio data to be read and passed to the OpenAL buffer
+            _data = new uint8_t[_input->GetDataSize()];
+            bool all_data_read = false;
+            if(_input->Read(_data, _input->GetTotalNumberSamples(), all_data_read) != _input->GetTotalNumberSamples()) {
+                IF_PRINT_WARNING(AUDIO_DEBUG) << "failed to read entire audio data stream for file: " << filename << std::endl;
+                return false;
+            }
 
-        // Pass the buffer data to the OpenAL buffer
-        _buffer->FillBuffer(_data, _format, _input->GetDataSize(), _input->GetSamplesPerSecond());
-        delete[] _data;
-        _data = nullptr;
+            // Pass the buffer data to the OpenAL buffer
+            _buffer = new AudioBuffer();
+            _buffer->FillBuffer(_data, _format, _input->GetDataSize(), _input->GetSamplesPerSecond());
+            delete[] _data;
+            _data = nullptr;
+
+            AudioManager->_AddSharedBuffer(_input->GetFilename(), _buffer, _input->GetDataSize());
+        }
 
         // Attempt to acquire a source for the new audio to use
         _AcquireSource();
@@ -287,6 +303,10 @@ void AudioDescriptor::FreeAudio()
     // First, remove any effects.
     RemoveEffects();
 
+    // The stream must be taken back from the streaming thread before being freed.
+    if(_streaming)
+        _StopStreaming();
+
     if(_source != nullptr)
         Stop();
 
@@ -300,7 +320,11 @@ void AudioDescriptor::FreeAudio()
     }
 
     if(_buffer != nullptr) {
-        delete[] _buffer;
+        // Static audio buffers are shared among the descriptors of a same file.
+        if(_stream == nullptr)
+            AudioManager->_ReleaseSharedBuffer(_input->GetFilename());
+        else
+            delete[] _buffer;
         _buffer = nullptr;
     }
 
@@ -334,12 +358,14 @@ bool AudioDescriptor::Play()
             IF_PRINT_WARNING(AUDIO_DEBUG) << "did not have access to valid AudioSource" << std::endl;
             return false;
         }
-        _SetSourceProperties();
     }
 
-    if(_stream && _stream->GetEndOfStream()) {
-        _stream->Seek(_offset);
-        _PrepareStreamingBuffers();
+    // The streaming thread starts the source, rewinding the stream first if it reached its end.
+    if(_streaming) {
+        ++_stream_play_requests;
+        AudioManager->_streamer.PushCommand(this, STREAM_COMMAND_PLAY, _offset);
+        _state = AUDIO_STATE_PLAYING;
+        return true;
     }
 
     // Temp: Checks if there is already an AL error in the buffer. If it is, print error and clear buffer.
@@ -365,6 +391,12 @@ void AudioDescriptor::Stop()
         return;
     }
 
+    if(_streaming) {
+        AudioManager->_streamer.PushCommand(this, STREAM_COMMAND_STOP);
+        _state = AUDIO_STATE_STOPPED;
+        return;
+    }
+
     // Temp: Checks if there is already an AL error in the buffer. If it is, print error and clear buffer.
     if(AudioManager->CheckALError()) {
         IF_PRINT_WARNING(AUDIO_DEBUG) << "audio error occured some time before stopping source: " << AudioManager->CreateALErrorString() << std::endl;
@@ -387,6 +419,12 @@ void AudioDescriptor::Pause()
         return;
     }
 
+    if(_streaming) {
+        AudioManager->_streamer.PushCommand(this, STREAM_COMMAND_PAUSE);
+        _state = AUDIO_STATE_PAUSED;
+        return;
+    }
+
     alSourcePause(_source->source);
     if(AudioManager->CheckALError()) {
         IF_PRINT_WARNING(AUDIO_DEBUG) << "pausing the source failed: " << AudioManager->CreateALErrorString() << std::endl;
@@ -409,6 +447,11 @@ void AudioDescriptor::Rewind()
         return;
     }
 
+    if(_streaming) {
+        AudioManager->_streamer.PushCommand(this, STREAM_COMMAND_REWIND);
+        return;
+    }
+
     alSourceRewind(_source->source);
     if(AudioManager->CheckALError()) {
         IF_PRINT_WARNING(AUDIO_DEBUG) << "rewinding the source failed: " << AudioManager->CreateALErrorString() << std::endl;
@@ -421,7 +464,9 @@ void AudioDescriptor::SetLooping(bool loop)
         return;
 
     _looping = loop;
-    if(_stream != nullptr) {
+    if(_streaming) {
+        AudioManager->_streamer.PushCommand(this, STREAM_COMMAND_SET_LOOPING, _looping ? 1 : 0);
+    } else if(_stream != nullptr) {
         _stream->SetLooping(_looping);
     } else if(_source != nullptr) {
         if(_looping)
@@ -437,7 +482,11 @@ void AudioDescriptor::SetLoopStart(uint32_t loop_start)
         IF_PRINT_WARNING(AUDIO_DEBUG) << "the audio data was not loaded with streaming properties, this operation is not permitted" << std::endl;
         return;
     }
-    _stream->SetLoopStart(loop_start);
+
+    if(_streaming)
+        AudioManager->_streamer.PushCommand(this, STREAM_COMMAND_SET_LOOP_START, loop_start);
+    else
+        _stream->SetLoopStart(loop_start);
 }
 
 void AudioDescriptor::SetLoopEnd(uint32_t loop_end)
@@ -446,7 +495,11 @@ void AudioDescriptor::SetLoopEnd(uint32_t loop_end)
         IF_PRINT_WARNING(AUDIO_DEBUG) << "the audio data was not loaded with streaming properties, this operation is not permitted" << std::endl;
         return;
     }
-    _stream->SetLoopEnd(loop_end);
+
+    if(_streaming)
+        AudioManager->_streamer.PushCommand(this, STREAM_COMMAND_SET_LOOP_END, loop_end);
+    else
+        _stream->SetLoopEnd(loop_end);
 }
 
 void AudioDescriptor::SeekSample(uint32_t sample)
@@ -460,9 +513,10 @@ void AudioDescriptor::SeekSample(uint32_t sample)
 
     _offset = sample;
 
-    if(_stream) {
+    if(_streaming) {
+        AudioManager->_streamer.PushCommand(this, STREAM_COMMAND_SEEK, _offset);
+    } else if(_stream) {
         _stream->Seek(_offset);
-        _PrepareStreamingBuffers();
     } else if(_source != nullptr) {
         alSourcei(_source->source, AL_SAMPLE_OFFSET, _offset);
         if(AudioManager->CheckALError()) {
@@ -473,7 +527,9 @@ void AudioDescriptor::SeekSample(uint32_t sample)
 
 uint32_t AudioDescriptor::GetCurrentSampleNumber() const
 {
-    if(_stream) {
+    if(_streaming) {
+        return _stream_position;
+    } else if(_stream) {
         return _stream->GetCurrentSamplePosition();
     } else if(_source != nullptr) {
         int32_t sample = 0;
@@ -505,9 +561,10 @@ void AudioDescriptor::SeekSecond(float second)
     }
 
     _offset = pos;
-    if(_stream) {
+    if(_streaming) {
+        AudioManager->_streamer.PushCommand(this, STREAM_COMMAND_SEEK, _offset);
+    } else if(_stream) {
         _stream->Seek(_offset);
-        _PrepareStreamingBuffers();
     } else if(_source != nullptr) {
         alSourcei(_source->source, AL_SEC_OFFSET, _offset);
         if(AudioManager->CheckALError()) {
@@ -516,6 +573,18 @@ void AudioDescriptor::SeekSecond(float second)
     }
 }
 
+uint32_t AudioDescriptor::GetDataMemorySize() const
+{
+    if(_input == nullptr)
+        return 0;
+
+    // Streamed audio only holds its streaming buffers and the data they are filled from.
+    if(_stream != nullptr)
+        return (NUMBER_STREAMING_BUFFERS + 1) * _stream_buffer_size * _input->GetSampleSize();
+
+    return _input->GetDataSize();
+}
+
 void AudioDescriptor::SetPosition(const ALfloat position[ALFLOAT3D])
 {
     if(_format != AL_FORMAT_MONO8 && _format != AL_FORMAT_MONO16) {
@@ -731,6 +800,11 @@ void AudioDescriptor::_Update()
     // If the descriptor no longer has a source, we can stop
     if(!_source) {
         _state = AUDIO_STATE_STOPPED;
+    } else if(_streaming) {
+        // The streaming thread tells when the stream played until its end,
+        // as the source may not be started yet or be restarted after running out of data.
+        if(_stream_finished_play == _stream_play_requests)
+            _state = AUDIO_STATE_STOPPED;
     } else {
         ALint source_state;
         alGetSourcei(_source->source, AL_SOURCE_STATE, &source_state);
@@ -757,22 +831,13 @@ void AudioDescriptor::_Update()
             ++it;
         }
     }
+} // void AudioDescriptor::_Update()
 
-    // Only streaming audio that is being played requires periodic updates
-    if(!_stream)
-        return;
-
-    ALint queued = 0;
-    alGetSourcei(_source->source, AL_BUFFERS_QUEUED, &queued);
-    if(AudioManager->CheckALError()) {
-        IF_PRINT_WARNING(AUDIO_DEBUG) << "getting queued sources failed: " << AudioManager->CreateALErrorString() << std::endl;
-    }
 
-    // If there are no more buffers and the end of stream was reached, stop the sound
-    if(queued != 0 && _stream->GetEndOfStream()) {
-        _state = AUDIO_STATE_STOPPED;
+void AudioDescriptor::_UpdateStream()
+{
+    if(!_stream_playing)
         return;
-    }
 
     ALint buffers_processed = 0;
     alGetSourcei(_source->source, AL_BUFFERS_PROCESSED, &buffers_processed);
@@ -780,14 +845,17 @@ void AudioDescriptor::_Update()
         IF_PRINT_WARNING(AUDIO_DEBUG) << "getting processed sources failed: " << AudioManager->CreateALErrorString() << std::endl;
     }
 
-    // If any buffers have finished playing, attempt to refill them
-    if(buffers_processed > 0) {
+    // Refill every buffer that finished playing
+    for(ALint i = 0; i < buffers_processed; ++i) {
         ALuint buffer_finished;
         alSourceUnqueueBuffers(_source->source, 1, &buffer_finished);
         if(AudioManager->CheckALError()) {
             IF_PRINT_WARNING(AUDIO_DEBUG) << "unqueuing a source failed: " << AudioManager->CreateALErrorString() << std::endl;
         }
 
+        if(_stream->GetEndOfStream())
+            continue;
+
         uint32_t size = _stream->FillBuffer(_data, _stream_buffer_size);
         if(size > 0) {  // Make sure that there is data available to fill
             alBufferData(buffer_finished, _format, _data, size * _input->GetSampleSize(), _input->GetSamplesPerSecond());
@@ -799,19 +867,104 @@ void AudioDescriptor::_Update()
                 IF_PRINT_WARNING(AUDIO_DEBUG) << "queueing a source failed: " << AudioManager->CreateALErrorString() << std::endl;
             }
         }
+    }
+    _stream_position = _stream->GetCurrentSamplePosition();
 
-        // This ensures that if a streaming audio piece is stopped because the buffers ran out
-        // of audio data for the source to play, the audio will be automatically replayed again.
-        ALint state;
-        alGetSourcei(_source->source, AL_SOURCE_STATE, &state);
-        if(state != AL_PLAYING) {
-            alSourcePlay(_source->source);
-            if(AudioManager->CheckALError()) {
-                IF_PRINT_WARNING(AUDIO_DEBUG) << "playing a source failed: " << AudioManager->CreateALErrorString() << std::endl;
-            }
+    ALint state;
+    alGetSourcei(_source->source, AL_SOURCE_STATE, &state);
+    if(state == AL_PLAYING)
+        return;
+
+    // Once every buffer was played after the end of the stream, the audio is over.
+    ALint queued = 0;
+    alGetSourcei(_source->source, AL_BUFFERS_QUEUED, &queued);
+    if(queued == 0) {
+        _stream_playing = false;
+        _stream_finished_play = _stream_play_count;
+        return;
+    }
+
+    // This ensures that if a streaming audio piece is stopped because the buffers ran out
+    // of audio data for the source to play, the audio will be automatically replayed again.
+    alSourcePlay(_source->source);
+    if(AudioManager->CheckALError()) {
+        IF_PRINT_WARNING(AUDIO_DEBUG) << "playing a source failed: " << AudioManager->CreateALErrorString() << std::endl;
+    }
+}
+
+void AudioDescriptor::_ApplyStreamCommand(STREAM_COMMAND command, uint32_t value)
+{
+    switch(command) {
+    case STREAM_COMMAND_PLAY:
+        ++_stream_play_count;
+        if(_stream->GetEndOfStream()) {
+            _stream->Seek(value);
+            _PrepareStreamingBuffers();
+        }
+
+        alSourcePlay(_source->source);
+        if(AudioManager->CheckALError()) {
+            IF_PRINT_WARNING(AUDIO_DEBUG) << "playing the source failed: " << AudioManager->CreateALErrorString() << std::endl;
+        }
+        _stream_playing = true;
+        break;
+    case STREAM_COMMAND_PAUSE:
+        alSourcePause(_source->source);
+        if(AudioManager->CheckALError()) {
+            IF_PRINT_WARNING(AUDIO_DEBUG) << "pausing the source failed: " << AudioManager->CreateALErrorString() << std::endl;
+        }
+        _stream_playing = false;
+        break;
+    case STREAM_COMMAND_STOP:
+        alSourceStop(_source->source);
+        if(AudioManager->CheckALError()) {
+            IF_PRINT_WARNING(AUDIO_DEBUG) << "stopping the source failed: " << AudioManager->CreateALErrorString() << std::endl;
         }
+        _stream_playing = false;
+        break;
+    case STREAM_COMMAND_REWIND:
+        alSourceRewind(_source->source);
+        if(AudioManager->CheckALError()) {
+            IF_PRINT_WARNING(AUDIO_DEBUG) << "rewinding the source failed: " << AudioManager->CreateALErrorString() << std::endl;
+        }
+        break;
+    case STREAM_COMMAND_SEEK:
+        _stream->Seek(value);
+        _PrepareStreamingBuffers();
+        break;
+    case STREAM_COMMAND_SET_LOOPING:
+        _stream->SetLooping(value != 0);
+        break;
+    case STREAM_COMMAND_SET_LOOP_START:
+        _stream->SetLoopStart(value);
+        break;
+    case STREAM_COMMAND_SET_LOOP_END:
+        _stream->SetLoopEnd(value);
+        break;
+    default:
+        IF_PRINT_WARNING(AUDIO_DEBUG) << "unknown stream command: " << command << std::endl;
+        break;
     }
-} // void AudioDescriptor::_Update()
+}
+
+void AudioDescriptor::_StartStreaming()
+{
+    _PrepareStreamingBuffers();
+
+    _stream_play_requests = 0;
+    _stream_playing = false;
+    _stream_play_count = 0;
+    _stream_finished_play = 0;
+
+    _streaming = true;
+    AudioManager->_streamer.AddStream(this);
+}
+
+void AudioDescriptor::_StopStreaming()
+{
+    AudioManager->_streamer.RemoveStream(this);
+    _streaming = false;
+}
 
 
 void AudioDescriptor::_HandleFadeStates()
@@ -887,7 +1040,7 @@ void AudioDescriptor::_AcquireSource()
     if(_stream == nullptr)
         alSourcei(_source->source, AL_BUFFER, _buffer->buffer);
     else
-        _PrepareStreamingBuffers();
+        _StartStreaming();
 }
 
 
@@ -938,16 +1091,15 @@ void AudioDescriptor::_PrepareStreamingBuffers()
         return;
     }
 
-    bool was_playing = false;
     if(AudioManager->CheckALError()) {
         IF_PRINT_WARNING(AUDIO_DEBUG) << "OpenAL error detected: " << AudioManager->CreateALErrorString() << std::endl;
     }
 
-    // Stop the audio if it is playing and detatch the buffer from the source
-    if(_state == AUDIO_STATE_PLAYING) {
-        was_playing = true;
-        Stop();
-    }
+    // Stop the audio if it is playing and detatch the buffer from the source.
+    // The audio state isn't changed, as this can be called from the streaming thread.
+    ALint state = AL_STOPPED;
+    alGetSourcei(_source->source, AL_SOURCE_STATE, &state);
+    alSourceStop(_source->source);
     alSourcei(_source->source, AL_BUFFER, 0);
 
     // Fill each buffer with audio data
@@ -955,17 +1107,17 @@ void AudioDescriptor::_PrepareStreamingBuffers()
         uint32_t read = _stream->FillBuffer(_data, _stream_buffer_size);
         if(read > 0) {
             _buffer[i].FillBuffer(_data, _format, read * _input->GetSampleSize(), _input->GetSamplesPerSecond());
-            if(_source != nullptr)
-                alSourceQueueBuffers(_source->source, 1, &_buffer[i].buffer);
+            alSourceQueueBuffers(_source->source, 1, &_buffer[i].buffer);
         }
     }
+    _stream_position = _stream->GetCurrentSamplePosition();
 
     if(AudioManager->CheckALError()) {
         IF_PRINT_WARNING(AUDIO_DEBUG) << "failed to fill all buffers: " << AudioManager->CreateALErrorString() << std::endl;
     }
 
-    if(was_playing) {
-        Play();
+    if(state == AL_PLAYING) {
+        alSourcePlay(_source->source);
     }
 }
 
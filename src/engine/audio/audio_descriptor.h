@@ -27,6 +27,7 @@
 #include "audio_input.h"
 #include "audio_stream.h"
 #include "audio_effects.h"
+#include "audio_streamer.h"
 
 // OpenAL includes
 #ifdef __APPLE__
@@ -37,6 +38,7 @@
 #include "alc.h"
 #endif
 
+#include <atomic>
 #include <vector>
 
 namespace vt_mode_manager {
@@ -82,6 +84,7 @@ namespace private_audio
 {
 
 class AudioEffect;
+class AudioStreamer;
 
 //! \brief The default buffer size (in bytes) for streaming buffers
 const uint32_t DEFAULT_BUFFER_SIZE = 8192;
@@ -206,6 +209,7 @@ public:
 class AudioDescriptor
 {
     friend class AudioEngine;
+    friend class private_audio::AudioStreamer;
 
 public:
     AudioDescriptor();
@@ -300,6 +304,12 @@ public:
     //! \brief Gets the current sample number (track offset)
     uint32_t GetCurrentSampleNumber() const;
 
+    /** \brief Returns the audio data memory held by the descriptor, in bytes
+    *** For static audio, this is the size of the decoded buffer, which may be shared
+    *** with other descriptors of the same file.
+    **/
+    uint32_t GetDataMemorySize() const;
+
     //! \brief Returns the volume level for this audio
     float GetVolume() const {
         return _volume;
@@ -384,7 +394,10 @@ protected:
     //! \brief The current state of the audio (playing, stopped, etc.)
     AUDIO_STATE _state;
 
-    //! \brief A pointer to the buffer(s) being used by the audio (1 buffer for static sounds, 2 for streamed ones)
+    /** \brief A pointer to the buffer(s) being used by the audio
+    *** Static audio uses 1 buffer shared with every descriptor of the same file, owned by the audio engine.
+    *** Streamed audio uses NUMBER_STREAMING_BUFFERS buffers of its own.
+    **/
     private_audio::AudioBuffer *_buffer;
 
     //! \brief A pointer to the source object being used by the audio
@@ -426,6 +439,27 @@ protected:
     //! \brief Size of the streaming buffer, if the audio was loaded for streaming
     uint32_t _stream_buffer_size;
 
+    /** \brief Tells whether the stream is handled by the streaming thread
+    *** While true, the stream, input, buffers and data belong to the streaming thread,
+    *** and the main thread only sends it commands.
+    **/
+    bool _streaming;
+
+    //! \brief The number of play commands sent to the streaming thread
+    uint32_t _stream_play_requests;
+
+    //! \brief Tells whether the stream should be playing. Only used by the streaming thread.
+    bool _stream_playing;
+
+    //! \brief The number of play commands applied. Only used by the streaming thread.
+    uint32_t _stream_play_count;
+
+    //! \brief The play command count when the stream last played until its end, set by the streaming thread
+    std::atomic<uint32_t> _stream_finished_play;
+
+    //! \brief The stream read position, in samples, set by the streaming thread
+    std::atomic<uint32_t> _stream_position;
+
     //! \brief The 3D orientation properties of the audio
     //@{
     ALfloat _position[ALFLOAT3D];
@@ -454,12 +488,27 @@ protected:
     void _SetVolumeControl(float volume);
 
 private:
-    /** \brief Updates the audio during playback
-    *** This function is only useful for streaming audio that is currently in the play state. If either of these two
-    *** conditions are not met, the function will return since it has nothing to do.
+    /** \brief Updates the audio state, fading and effects during playback
+    *** The streaming buffers are refilled by the streaming thread, independently of this function.
     **/
     void _Update();
 
+    /** \brief Refills and queues the processed streaming buffers
+    *** Called by the streaming thread. It also restarts the source when it ran out of data.
+    **/
+    void _UpdateStream();
+
+    /** \brief Applies a command sent by the main thread
+    *** Called by the streaming thread, before the streams are updated.
+    **/
+    void _ApplyStreamCommand(private_audio::STREAM_COMMAND command, uint32_t value);
+
+    //! \brief Prepares the streaming buffers and hands the stream over to the streaming thread.
+    void _StartStreaming();
+
+    //! \brief Takes the stream back from the streaming thread.
+    void _StopStreaming();
+
     //! \brief Handles the fading states volumes update.
     void _HandleFadeStates();
 
@@ -479,7 +528,8 @@ private:
 
     /** \brief Prepares streaming buffers when a new source is acquired or after a seeking operation.
     *** This is a special case, since the already queued buffers must be unqueued, and the new
-    *** ones must be refilled. This function should only be called for streaming audio.
+    *** ones must be refilled. This function should only be called for streaming audio, by the
+    *** streaming thread once the stream was handed over to it.
     **/
     void _PrepareStreamingBuffers();
 }; // class AudioDescriptor
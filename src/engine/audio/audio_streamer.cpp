@@ -0,0 +1,151 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    audio_streamer.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the audio streaming thread.
+*** ***************************************************************************/
+
+#include "audio_streamer.h"
+
+#include "audio_descriptor.h"
+
+#include "utils/utils_common.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace vt_audio
+{
+
+extern bool AUDIO_DEBUG;
+
+namespace private_audio
+{
+
+AudioStreamer::AudioStreamer() :
+    _stop(false)
+{
+}
+
+AudioStreamer::~AudioStreamer()
+{
+    StopThread();
+}
+
+void AudioStreamer::AddStream(AudioDescriptor* audio)
+{
+    if (!_thread.joinable() && !_stop)
+        _StartThread();
+
+    std::lock_guard<std::mutex> lock(_streams_mutex);
+    if (std::find(_streams.begin(), _streams.end(), audio) == _streams.end())
+        _streams.push_back(audio);
+}
+
+void AudioStreamer::RemoveStream(AudioDescriptor* audio)
+{
+    // Waits for the streaming thread to be done with the streams.
+    std::lock_guard<std::mutex> streams_lock(_streams_mutex);
+
+    std::vector<AudioDescriptor*>::iterator it = std::find(_streams.begin(), _streams.end(), audio);
+    if (it != _streams.end())
+        _streams.erase(it);
+
+    std::lock_guard<std::mutex> lock(_commands_mutex);
+    for (std::vector<StreamCommand>::iterator it = _commands.begin(); it != _commands.end();) {
+        if (it->audio == audio)
+            it = _commands.erase(it);
+        else
+            ++it;
+    }
+}
+
+void AudioStreamer::PushCommand(AudioDescriptor* audio, STREAM_COMMAND command, uint32_t value)
+{
+    StreamCommand stream_command;
+    stream_command.audio = audio;
+    stream_command.command = command;
+    stream_command.value = value;
+
+    {
+        std::lock_guard<std::mutex> lock(_commands_mutex);
+        _commands.push_back(stream_command);
+    }
+    _commands_condition.notify_one();
+}
+
+void AudioStreamer::StopThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(_commands_mutex);
+        _stop = true;
+    }
+
+    if (!_thread.joinable())
+        return;
+
+    _commands_condition.notify_one();
+    _thread.join();
+}
+
+void AudioStreamer::_StartThread()
+{
+    _thread = std::thread(&AudioStreamer::_StreamAudio, this);
+
+    IF_PRINT_DEBUG(AUDIO_DEBUG) << "Started the audio streaming thread" << std::endl;
+}
+
+void AudioStreamer::_StreamAudio()
+{
+    std::vector<StreamCommand> commands;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_commands_mutex);
+            if (!_stop && _commands.empty())
+                _commands_condition.wait_for(lock, std::chrono::milliseconds(AUDIO_STREAMING_INTERVAL));
+
+            if (_stop)
+                return;
+        }
+
+        std::lock_guard<std::mutex> streams_lock(_streams_mutex);
+
+        // The commands are taken while holding the streams lock, so that a stream
+        // can't be removed between the moment its commands are taken and applied.
+        {
+            std::lock_guard<std::mutex> lock(_commands_mutex);
+            commands.swap(_commands);
+        }
+
+        for (uint32_t i = 0; i < commands.size(); ++i)
+            commands[i].audio->_ApplyStreamCommand(commands[i].command, commands[i].value);
+        commands.clear();
+
+        for (uint32_t i = 0; i < _streams.size(); ++i)
+            _streams[i]->_UpdateStream();
+    }
+}
+
+AudioStreamer::AudioStreamer(const AudioStreamer&)
+{
+    throw vt_utils::Exception("Not Implemented!", __FILE__, __LINE__, __FUNCTION__);
+}
+
+AudioStreamer& AudioStreamer::operator=(const AudioStreamer&)
+{
+    throw vt_utils::Exception("Not Implemented!", __FILE__, __LINE__, __FUNCTION__);
+    return *this;
+}
+
+} // namespace private_audio
+
+} // namespace vt_audio
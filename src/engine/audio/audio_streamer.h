@@ -0,0 +1,129 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    audio_streamer.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the audio streaming thread.
+***
+*** Streamed audio is decoded and queued to OpenAL by a dedicated thread, which
+*** keeps the streaming buffers filled independently of the frame rate. Once an
+*** audio descriptor is streamed, its stream, input and buffers belong to that
+*** thread: the main thread only sends it commands (play, stop, seek, ...)
+*** through a queue.
+*** ***************************************************************************/
+
+#ifndef __AUDIO_STREAMER_HEADER__
+#define __AUDIO_STREAMER_HEADER__
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vt_audio
+{
+
+class AudioDescriptor;
+
+namespace private_audio
+{
+
+//! \brief The maximum time between two refills of the streaming buffers, in milliseconds.
+const uint32_t AUDIO_STREAMING_INTERVAL = 10;
+
+//! \brief The operations the main thread can request on streamed audio.
+enum STREAM_COMMAND {
+    STREAM_COMMAND_PLAY,
+    STREAM_COMMAND_PAUSE,
+    STREAM_COMMAND_STOP,
+    STREAM_COMMAND_REWIND,
+    STREAM_COMMAND_SEEK,
+    STREAM_COMMAND_SET_LOOPING,
+    STREAM_COMMAND_SET_LOOP_START,
+    STREAM_COMMAND_SET_LOOP_END
+};
+
+/** ****************************************************************************
+*** \brief A thread refilling the buffers of every streamed audio descriptor.
+***
+*** The thread is only started with the first stream added.
+*** ***************************************************************************/
+class AudioStreamer
+{
+public:
+    AudioStreamer();
+
+    ~AudioStreamer();
+
+    /** \brief Hands a stream over to the streaming thread.
+    *** \param audio The audio descriptor, with a source and its streaming buffers prepared.
+    **/
+    void AddStream(AudioDescriptor* audio);
+
+    /** \brief Takes a stream back from the streaming thread.
+    *** Once done, the streaming thread won't touch the audio descriptor anymore,
+    *** and its pending commands are forgotten.
+    **/
+    void RemoveStream(AudioDescriptor* audio);
+
+    /** \brief Queues a command for a stream.
+    *** \param value The command argument, e.g. the sample position to seek to.
+    *** The commands are applied in order, as soon as the streaming thread wakes up.
+    **/
+    void PushCommand(AudioDescriptor* audio, STREAM_COMMAND command, uint32_t value = 0);
+
+    //! \brief Stops the streaming thread. The streams aren't updated anymore afterwards.
+    void StopThread();
+
+private:
+    //! \brief A command sent to a stream.
+    struct StreamCommand {
+        AudioDescriptor* audio;
+        STREAM_COMMAND command;
+        uint32_t value;
+    };
+
+    //! \brief Starts the streaming thread.
+    void _StartThread();
+
+    //! \brief The streaming thread main function.
+    void _StreamAudio();
+
+    //! \brief The streaming thread.
+    std::thread _thread;
+
+    //! \brief Held by the streaming thread while it updates the streams.
+    std::mutex _streams_mutex;
+
+    //! \brief The audio descriptors being streamed.
+    std::vector<AudioDescriptor*> _streams;
+
+    //! \brief Protects the commands and the stop flag.
+    std::mutex _commands_mutex;
+
+    //! \brief Notified when a command is queued or when the thread must stop.
+    std::condition_variable _commands_condition;
+
+    //! \brief The commands not applied yet, in request order.
+    std::vector<StreamCommand> _commands;
+
+    //! \brief Tells the streaming thread to stop.
+    bool _stop;
+
+    AudioStreamer(const AudioStreamer& copy);
+    AudioStreamer& operator=(const AudioStreamer& copy);
+}; // class AudioStreamer
+
+} // namespace private_audio
+
+} // namespace vt_audio
+
+#endif // __AUDIO_STREAMER_HEADER__
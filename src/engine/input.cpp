@@ -21,6 +21,7 @@
 #include "script/script_read.h"
 #include "engine/mode_manager.h"
 #include "engine/system.h"
+#include "engine/profiler.h"
 
 #include "modes/mode_help_window.h"
 
@@ -339,6 +340,25 @@ void InputEngine::_KeyEventHandler(SDL_KeyboardEvent &key_event)
                 return;
             }
 #endif
+#ifdef PROFILER
+            else if(key_event.keysym.sym == SDLK_p) {
+                // Toggle the profiler overlay and frame recording
+                ProfilerManager->ToggleOverlay();
+                return;
+            } else if(key_event.keysym.sym == SDLK_o) {
+                // Save the recorded frames as a Chrome trace
+                static uint32_t i = 1;
+                std::string path = "";
+                while(true) {
+                    path = GetUserDataPath() + "profile_" + NumberToString<uint32_t>(i) + ".json";
+                    if(!DoesFileExist(path))
+                        break;
+                    i++;
+                }
+                ProfilerManager->DumpChromeTrace(path);
+                return;
+            }
+#endif
 
             //return;
         } // endif CTRL pressed
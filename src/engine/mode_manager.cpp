@@ -18,12 +18,15 @@
 #include "mode_manager.h"
 
 #include "system.h"
+#include "profiler.h"
 
 #include "engine/video/video.h"
 #include "engine/audio/audio.h"
 
 #include "modes/mode_help_window.h"
 
+#include "common/global/global.h"
+
 using namespace vt_utils;
 using namespace vt_system;
 using namespace vt_video;
@@ -269,6 +272,8 @@ GameMode *ModeEngine::Get(uint32_t index)
 // Checks if any game modes need to be pushed or popped off the stack, then updates the top stack mode.
 void ModeEngine::Update()
 {
+    PROFILE_ZONE("ModeManager::Update");
+
     // Check whether the fade out is done.
     if(_fade_out && VideoManager->IsLastFadeTransitional() &&
             !VideoManager->IsFading()) {
@@ -278,6 +283,10 @@ void ModeEngine::Update()
 
     // If a Push() or Pop() function was called, we need to adjust the state of the game stack.
     if(_fade_out_finished && _state_change) {
+        // Report the definitions read from the scripts while the current mode was active.
+        if(vt_global::GlobalManager && !_game_stack.empty())
+            vt_global::GlobalManager->GetPrototypeHandler().PrintStatistics(_game_stack.back()->GetGameType());
+
         // Pop however many game modes we need to from the top of the stack
         while(_pop_count != 0) {
             if(_game_stack.empty()) {
@@ -328,6 +337,10 @@ void ModeEngine::Update()
         SystemManager->InitializeUpdateTimer();
     } // if (_state_change)
 
+    // Report the autosaves written in the background since the last frame.
+    if(vt_global::GlobalManager)
+        vt_global::GlobalManager->UpdateAutoSaves();
+
     // Call the Update function on the top stack mode (the active game mode)
     if(!_game_stack.empty())
         _game_stack.back()->Update();
@@ -336,6 +349,8 @@ void ModeEngine::Update()
 
 void ModeEngine::Draw()
 {
+    PROFILE_ZONE("ModeManager::Draw");
+
     if(_game_stack.empty())
         return;
 
@@ -0,0 +1,420 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    profiler.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the frame profiler.
+*** ***************************************************************************/
+
+#include "engine/profiler.h"
+
+#include "engine/system.h"
+#include "engine/video/video.h"
+
+#include "utils/utils_strings.h"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+using namespace vt_utils;
+using namespace vt_video;
+
+namespace vt_system
+{
+
+ProfilerEngine* ProfilerManager = nullptr;
+
+//! \brief How much the last frame counts in the averaged timings.
+const float PROFILER_AVERAGE_WEIGHT = 0.05f;
+
+// -----------------------------------------------------------------------------
+// ProfileZone class
+// -----------------------------------------------------------------------------
+
+ProfileZone::ProfileZone(const char* name) :
+    _event(ProfilerManager ? ProfilerManager->BeginZone(name) : -1)
+{
+}
+
+ProfileZone::~ProfileZone()
+{
+    if (_event >= 0 && ProfilerManager)
+        ProfilerManager->EndZone(_event);
+}
+
+// -----------------------------------------------------------------------------
+// ProfilerEngine class
+// -----------------------------------------------------------------------------
+
+ProfilerEngine::ProfilerEngine() :
+    _enabled(false),
+    _frequency(1),
+    _in_frame(false),
+    _depth(0),
+    _frame_number(0),
+    _average_frame_time(0.0f),
+    _average_gpu_time(0.0f),
+    _last_overlay_refresh(0),
+    _overlay_text(nullptr),
+    _gpu_timing_supported(false),
+    _gpu_queries_created(false),
+    _current_gpu_query(0)
+{
+    for (uint32_t i = 0; i < PROFILER_GPU_QUERIES; ++i) {
+        _gpu_queries[i] = 0;
+        _gpu_query_pending[i] = false;
+        _gpu_query_frame[i] = 0;
+    }
+}
+
+ProfilerEngine::~ProfilerEngine()
+{
+    _DeleteGPUQueries();
+
+    delete _overlay_text;
+}
+
+bool ProfilerEngine::SingletonInitialize()
+{
+    _main_thread = std::this_thread::get_id();
+    _frequency = SDL_GetPerformanceFrequency();
+    return true;
+}
+
+void ProfilerEngine::ToggleOverlay()
+{
+    // Applied on the next frame, as the current one is being recorded.
+    _enabled = !_enabled;
+}
+
+void ProfilerEngine::BeginFrame()
+{
+    if (!_enabled) {
+        if (_in_frame)
+            EndFrame();
+
+        // Forget the recorded frames, so that a later dump doesn't mix both sessions.
+        if (_gpu_queries_created) {
+            _DeleteGPUQueries();
+            _frames.clear();
+            _zone_stats.clear();
+            _average_frame_time = 0.0f;
+            _average_gpu_time = 0.0f;
+        }
+        return;
+    }
+
+    // Loop iterations without drawing, e.g. while waiting for the next update, are part of the next frame.
+    if (_in_frame)
+        return;
+
+    if (!_gpu_queries_created)
+        _CreateGPUQueries();
+
+    _current_frame.number = _frame_number++;
+    _current_frame.start = SDL_GetPerformanceCounter();
+    _current_frame.end = _current_frame.start;
+    _current_frame.gpu_time = 0;
+    _current_frame.events.clear();
+    _depth = 0;
+    _in_frame = true;
+
+    if (_gpu_timing_supported) {
+        // Reuse the oldest query, waiting for its result if the GPU is that late.
+        if (_gpu_query_pending[_current_gpu_query])
+            _ReadGPUQuery(_current_gpu_query, true);
+
+        glBeginQuery(GL_TIME_ELAPSED, _gpu_queries[_current_gpu_query]);
+        _gpu_query_frame[_current_gpu_query] = _current_frame.number;
+    }
+}
+
+void ProfilerEngine::EndFrame()
+{
+    if (!_in_frame)
+        return;
+
+    _in_frame = false;
+    _current_frame.end = SDL_GetPerformanceCounter();
+
+    if (_gpu_timing_supported) {
+        glEndQuery(GL_TIME_ELAPSED);
+        _gpu_query_pending[_current_gpu_query] = true;
+        _current_gpu_query = (_current_gpu_query + 1) % PROFILER_GPU_QUERIES;
+    }
+
+    _frames.push_back(_current_frame);
+    if (_frames.size() > PROFILER_TRACE_FRAMES)
+        _frames.pop_front();
+
+    // Collect the GPU times of the previous frames already measured.
+    for (uint32_t i = 0; i < PROFILER_GPU_QUERIES; ++i) {
+        if (_gpu_query_pending[i])
+            _ReadGPUQuery(i, false);
+    }
+
+    _UpdateStatistics(_frames.back());
+
+    uint64_t refresh_time = _frequency * PROFILER_OVERLAY_REFRESH_TIME / 1000;
+    if (_current_frame.end - _last_overlay_refresh >= refresh_time) {
+        _RefreshOverlayText();
+        _last_overlay_refresh = _current_frame.end;
+    }
+}
+
+int32_t ProfilerEngine::BeginZone(const char* name)
+{
+    if (!_in_frame || std::this_thread::get_id() != _main_thread)
+        return -1;
+
+    ZoneEvent event;
+    event.name = name;
+    event.depth = _depth++;
+    event.start = SDL_GetPerformanceCounter();
+    event.end = event.start;
+    _current_frame.events.push_back(event);
+
+    return static_cast<int32_t>(_current_frame.events.size()) - 1;
+}
+
+void ProfilerEngine::EndZone(int32_t event)
+{
+    // The zone may have begun before the frame ended.
+    if (!_in_frame || static_cast<uint32_t>(event) >= _current_frame.events.size())
+        return;
+
+    _current_frame.events[event].end = SDL_GetPerformanceCounter();
+    if (_depth > 0)
+        --_depth;
+}
+
+void ProfilerEngine::DrawOverlay()
+{
+    if (!_enabled)
+        return;
+
+    if (!_overlay_text) {
+        // Created when first needed, to permit getting the text style correctly.
+        _overlay_text = new TextImage("", TextStyle("text18", Color::white));
+        _RefreshOverlayText();
+    }
+
+    VideoManager->PushState();
+    VideoManager->SetStandardCoordSys();
+    VideoManager->SetDrawFlags(VIDEO_X_LEFT, VIDEO_Y_TOP, VIDEO_X_NOFLIP, VIDEO_Y_NOFLIP,
+                               VIDEO_BLEND, 0);
+    VideoManager->Move(10.0f, 10.0f);
+    VideoManager->DrawRectangle(_overlay_text->GetWidth() + 20.0f, _overlay_text->GetHeight() + 20.0f,
+                                Color(0.0f, 0.0f, 0.0f, 0.6f));
+    VideoManager->Move(20.0f, 20.0f);
+    _overlay_text->Draw();
+    VideoManager->PopState();
+}
+
+bool ProfilerEngine::DumpChromeTrace(const std::string& filename)
+{
+    if (_frames.empty()) {
+        IF_PRINT_WARNING(SYSTEM_DEBUG) << "no frame recorded, enable the profiler overlay first" << std::endl;
+        return false;
+    }
+
+    std::ofstream file(filename.c_str());
+    if (!file) {
+        PRINT_WARNING << "Couldn't open the trace file: " << filename << std::endl;
+        return false;
+    }
+
+    // The timestamps are given in microseconds, from the first recorded frame.
+    const uint64_t origin = _frames.front().start;
+    const double to_microseconds = 1000000.0 / static_cast<double>(_frequency);
+
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::endl;
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Main thread\"}}," << std::endl;
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}";
+
+    for (std::deque<FrameRecord>::const_iterator it = _frames.begin(); it != _frames.end(); ++it) {
+        const FrameRecord& frame = *it;
+        const double frame_start = (frame.start - origin) * to_microseconds;
+
+        file << "," << std::endl << "{\"name\":\"Frame " << frame.number
+             << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << frame_start
+             << ",\"dur\":" << (frame.end - frame.start) * to_microseconds << "}";
+
+        for (uint32_t i = 0; i < frame.events.size(); ++i) {
+            const ZoneEvent& event = frame.events[i];
+            file << "," << std::endl << "{\"name\":\"" << event.name
+                 << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << (event.start - origin) * to_microseconds
+                 << ",\"dur\":" << (event.end - event.start) * to_microseconds << "}";
+        }
+
+        // The GPU work is only known in duration: it is shown from the frame start.
+        if (frame.gpu_time > 0) {
+            file << "," << std::endl << "{\"name\":\"GPU frame " << frame.number
+                 << "\",\"ph\":\"X\",\"pid\":1,\"tid\":2,\"ts\":" << frame_start
+                 << ",\"dur\":" << frame.gpu_time / 1000.0 << "}";
+        }
+    }
+
+    file << std::endl << "]}" << std::endl;
+
+    if (!file) {
+        PRINT_WARNING << "Couldn't write the trace file: " << filename << std::endl;
+        return false;
+    }
+
+    IF_PRINT_DEBUG(SYSTEM_DEBUG) << "Saved " << _frames.size() << " profiled frames in: " << filename << std::endl;
+    return true;
+}
+
+void ProfilerEngine::_CreateGPUQueries()
+{
+    _gpu_queries_created = true;
+
+    // Timer queries are core since OpenGL 3.3.
+#ifdef __APPLE__
+    _gpu_timing_supported = false;
+#else
+    _gpu_timing_supported = GLEW_VERSION_3_3 || GLEW_ARB_timer_query;
+#endif
+
+    if (!_gpu_timing_supported) {
+        IF_PRINT_WARNING(SYSTEM_DEBUG) << "OpenGL timer queries unsupported, the GPU time won't be measured" << std::endl;
+        return;
+    }
+
+    glGenQueries(PROFILER_GPU_QUERIES, _gpu_queries);
+    for (uint32_t i = 0; i < PROFILER_GPU_QUERIES; ++i)
+        _gpu_query_pending[i] = false;
+    _current_gpu_query = 0;
+}
+
+void ProfilerEngine::_DeleteGPUQueries()
+{
+    if (_gpu_timing_supported)
+        glDeleteQueries(PROFILER_GPU_QUERIES, _gpu_queries);
+
+    _gpu_timing_supported = false;
+    _gpu_queries_created = false;
+}
+
+void ProfilerEngine::_ReadGPUQuery(uint32_t query, bool wait)
+{
+    if (!wait) {
+        GLint available = 0;
+        glGetQueryObjectiv(_gpu_queries[query], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            return;
+    }
+
+    GLuint64 gpu_time = 0;
+    glGetQueryObjectui64v(_gpu_queries[query], GL_QUERY_RESULT, &gpu_time);
+    _gpu_query_pending[query] = false;
+
+    float gpu_time_ms = static_cast<float>(gpu_time) / 1000000.0f;
+    if (_average_gpu_time == 0.0f)
+        _average_gpu_time = gpu_time_ms;
+    else
+        _average_gpu_time += (gpu_time_ms - _average_gpu_time) * PROFILER_AVERAGE_WEIGHT;
+
+    // Store the time in the measured frame, if still recorded.
+    for (std::deque<FrameRecord>::reverse_iterator it = _frames.rbegin(); it != _frames.rend(); ++it) {
+        if (it->number == _gpu_query_frame[query]) {
+            it->gpu_time = gpu_time;
+            break;
+        }
+    }
+}
+
+void ProfilerEngine::_UpdateStatistics(const FrameRecord& frame)
+{
+    float frame_time = _ToMilliseconds(frame.start, frame.end);
+    if (_average_frame_time == 0.0f)
+        _average_frame_time = frame_time;
+    else
+        _average_frame_time += (frame_time - _average_frame_time) * PROFILER_AVERAGE_WEIGHT;
+
+    for (uint32_t i = 0; i < _zone_stats.size(); ++i) {
+        _zone_stats[i].frame_time = 0.0f;
+        _zone_stats[i].frame_calls = 0;
+    }
+
+    // Sum the time spent in each zone, which may be entered several times per frame.
+    for (uint32_t i = 0; i < frame.events.size(); ++i) {
+        const ZoneEvent& event = frame.events[i];
+
+        ZoneStats* stats = nullptr;
+        for (uint32_t j = 0; j < _zone_stats.size(); ++j) {
+            if (_zone_stats[j].name == event.name) {
+                stats = &_zone_stats[j];
+                break;
+            }
+        }
+        if (stats == nullptr) {
+            ZoneStats new_stats;
+            new_stats.name = event.name;
+            new_stats.average_time = 0.0f;
+            new_stats.frame_time = 0.0f;
+            new_stats.frame_calls = 0;
+            _zone_stats.push_back(new_stats);
+            stats = &_zone_stats.back();
+        }
+
+        stats->frame_time += _ToMilliseconds(event.start, event.end);
+        ++stats->frame_calls;
+    }
+
+    for (uint32_t i = 0; i < _zone_stats.size(); ++i)
+        _zone_stats[i].average_time += (_zone_stats[i].frame_time - _zone_stats[i].average_time) * PROFILER_AVERAGE_WEIGHT;
+}
+
+void ProfilerEngine::_RefreshOverlayText()
+{
+    if (!_overlay_text)
+        return;
+
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(2);
+    text << "CPU frame: " << _average_frame_time << " ms";
+    if (_gpu_timing_supported)
+        text << " - GPU frame: " << _average_gpu_time << " ms";
+    else
+        text << " - GPU frame: n/a";
+
+    // List the zones as nested in the last frame, once each.
+    if (!_frames.empty()) {
+        const std::vector<ZoneEvent>& events = _frames.back().events;
+        std::vector<const char*> listed_zones;
+        for (uint32_t i = 0; i < events.size(); ++i) {
+            bool listed = false;
+            for (uint32_t j = 0; j < listed_zones.size() && !listed; ++j)
+                listed = (std::string(listed_zones[j]) == events[i].name);
+            if (listed)
+                continue;
+            listed_zones.push_back(events[i].name);
+
+            for (uint32_t j = 0; j < _zone_stats.size(); ++j) {
+                if (_zone_stats[j].name != events[i].name)
+                    continue;
+
+                text << std::endl << std::string(2 * (events[i].depth + 1), ' ')
+                     << _zone_stats[j].name << ": " << _zone_stats[j].average_time << " ms";
+                if (_zone_stats[j].frame_calls > 1)
+                    text << " (x" << _zone_stats[j].frame_calls << ")";
+                break;
+            }
+        }
+    }
+
+    _overlay_text->SetText(text.str());
+}
+
+} // namespace vt_system
@@ -0,0 +1,252 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    profiler.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the frame profiler.
+***
+*** The profiler measures the time spent in scoped zones of the main thread,
+*** declared with the PROFILE_ZONE() macro, and the GPU time of each frame using
+*** OpenGL timer queries. The zones are only compiled in when the game is built
+*** with the PROFILER option.
+***
+*** Once enabled, the averaged timings are shown in an overlay, and the last
+*** recorded frames can be saved in the Chrome trace event format, to be opened
+*** with chrome://tracing or any compatible viewer.
+*** ***************************************************************************/
+
+#ifndef __PROFILER_HEADER__
+#define __PROFILER_HEADER__
+
+#include "utils/singleton.h"
+#include "utils/gl_include.h"
+
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef PROFILER
+#   define PROFILE_ZONE_NAME_CONCAT(prefix, line) prefix##line
+#   define PROFILE_ZONE_NAME(prefix, line) PROFILE_ZONE_NAME_CONCAT(prefix, line)
+    //! \brief Measures the time spent until the end of the current scope, under the given name.
+#   define PROFILE_ZONE(name) vt_system::ProfileZone PROFILE_ZONE_NAME(_profile_zone_, __LINE__)(name)
+#else
+#   define PROFILE_ZONE(name)
+#endif
+
+namespace vt_video
+{
+class TextImage;
+}
+
+namespace vt_system
+{
+
+class ProfilerEngine;
+
+//! \brief The singleton pointer responsible for profiling the frames.
+extern ProfilerEngine* ProfilerManager;
+
+//! \brief The number of frames kept for the Chrome trace dumps.
+const uint32_t PROFILER_TRACE_FRAMES = 300;
+
+//! \brief The number of GPU timer queries used in turn, so that their results are read without stalling.
+const uint32_t PROFILER_GPU_QUERIES = 4;
+
+//! \brief The time between two refreshes of the overlay text, in milliseconds.
+const uint32_t PROFILER_OVERLAY_REFRESH_TIME = 250;
+
+/** ****************************************************************************
+*** \brief Profiles the enclosing scope.
+***
+*** \note Use the PROFILE_ZONE() macro rather than this class, so that the zones
+*** are compiled out when the profiler isn't built. Zones are only measured on
+*** the main thread.
+*** ***************************************************************************/
+class ProfileZone
+{
+public:
+    //! \param name The zone name. It must be a string literal.
+    explicit ProfileZone(const char* name);
+
+    ~ProfileZone();
+
+private:
+    //! \brief The zone event index in the current frame, or -1 when not recorded.
+    int32_t _event;
+};
+
+/** ****************************************************************************
+*** \brief Records the main thread zones and the GPU time of each frame.
+***
+*** \note This class is a singleton.
+*** ***************************************************************************/
+class ProfilerEngine : public vt_utils::Singleton<ProfilerEngine>
+{
+    friend class vt_utils::Singleton<ProfilerEngine>;
+
+public:
+    ~ProfilerEngine();
+
+    bool SingletonInitialize();
+
+    /** \brief Starts recording a new frame. Called at the beginning of each main loop iteration.
+    *** If the previous iteration didn't draw anything, the frame already recorded goes on.
+    **/
+    void BeginFrame();
+
+    //! \brief Ends the frame recording. Called just before swapping the window buffers.
+    void EndFrame();
+
+    /** \brief Starts measuring a zone.
+    *** \return The zone event index, or -1 if the zone isn't recorded.
+    **/
+    int32_t BeginZone(const char* name);
+
+    //! \brief Ends the measure of the given zone event.
+    void EndZone(int32_t event);
+
+    //! \brief Draws the averaged frame and zone timings, when the overlay is shown.
+    void DrawOverlay();
+
+    //! \brief Shows or hides the overlay. The frames are only recorded while it is shown.
+    void ToggleOverlay();
+
+    bool IsOverlayShown() const {
+        return _enabled;
+    }
+
+    /** \brief Saves the recorded frames in the Chrome trace event format.
+    *** \param filename The JSON file to write.
+    *** \return false if there was nothing recorded or the file couldn't be written.
+    **/
+    bool DumpChromeTrace(const std::string& filename);
+
+private:
+    ProfilerEngine();
+
+    //! \brief A zone measured during a frame.
+    struct ZoneEvent {
+        const char* name;
+        //! \brief The number of zones enclosing this one.
+        uint32_t depth;
+        //! \brief The performance counter values at the zone start and end.
+        uint64_t start;
+        uint64_t end;
+    };
+
+    //! \brief The timings of a recorded frame.
+    struct FrameRecord {
+        FrameRecord():
+            number(0),
+            start(0),
+            end(0),
+            gpu_time(0)
+        {}
+
+        uint32_t number;
+        uint64_t start;
+        uint64_t end;
+        //! \brief The GPU time spent on the frame in nanoseconds, or 0 if unknown.
+        uint64_t gpu_time;
+        std::vector<ZoneEvent> events;
+    };
+
+    //! \brief The timings of a zone, averaged over the frames.
+    struct ZoneStats {
+        std::string name;
+        //! \brief The average time spent in the zone per frame, in milliseconds.
+        float average_time;
+        //! \brief The time spent in the zone during the last frame, in milliseconds.
+        float frame_time;
+        //! \brief The number of times the zone was entered during the last frame.
+        uint32_t frame_calls;
+    };
+
+    //! \brief Whether the frames are recorded and the overlay shown.
+    bool _enabled;
+
+    //! \brief The only thread whose zones are measured.
+    std::thread::id _main_thread;
+
+    //! \brief The performance counter frequency.
+    uint64_t _frequency;
+
+    //! \brief Whether a frame is being recorded.
+    bool _in_frame;
+
+    //! \brief The frame being recorded.
+    FrameRecord _current_frame;
+
+    //! \brief The number of zones currently entered.
+    uint32_t _depth;
+
+    //! \brief The number given to the next frame.
+    uint32_t _frame_number;
+
+    //! \brief The last recorded frames, from the oldest to the newest.
+    std::deque<FrameRecord> _frames;
+
+    //! \brief The averaged frame CPU and GPU times, in milliseconds.
+    float _average_frame_time;
+    float _average_gpu_time;
+
+    //! \brief The averaged zone timings.
+    std::vector<ZoneStats> _zone_stats;
+
+    //! \brief The performance counter value when the overlay text was last refreshed.
+    uint64_t _last_overlay_refresh;
+
+    //! \brief The overlay text.
+    vt_video::TextImage* _overlay_text;
+
+    //! \brief Whether the OpenGL timer queries are supported, and created.
+    bool _gpu_timing_supported;
+    bool _gpu_queries_created;
+
+    //! \brief The OpenGL timer queries, used in turn.
+    GLuint _gpu_queries[PROFILER_GPU_QUERIES];
+
+    //! \brief Whether each query awaits its result.
+    bool _gpu_query_pending[PROFILER_GPU_QUERIES];
+
+    //! \brief The frame number measured by each query.
+    uint32_t _gpu_query_frame[PROFILER_GPU_QUERIES];
+
+    //! \brief The query used for the current frame.
+    uint32_t _current_gpu_query;
+
+    //! \brief Creates the timer queries, if supported.
+    void _CreateGPUQueries();
+
+    //! \brief Frees the timer queries.
+    void _DeleteGPUQueries();
+
+    /** \brief Reads the result of a timer query.
+    *** \param wait Whether to wait for the result if not available yet.
+    **/
+    void _ReadGPUQuery(uint32_t query, bool wait);
+
+    //! \brief Adds the last frame timings to the averaged statistics.
+    void _UpdateStatistics(const FrameRecord& frame);
+
+    //! \brief Rebuilds the overlay text from the averaged statistics.
+    void _RefreshOverlayText();
+
+    //! \brief Returns the duration between two performance counter values, in milliseconds.
+    float _ToMilliseconds(uint64_t start, uint64_t end) const {
+        return static_cast<float>(end - start) * 1000.0f / static_cast<float>(_frequency);
+    }
+}; // class ProfilerEngine : public vt_utils::Singleton<ProfilerEngine>
+
+} // namespace vt_system
+
+#endif // __PROFILER_HEADER__
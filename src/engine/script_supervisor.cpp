@@ -16,6 +16,7 @@
 #include "engine/script_supervisor.h"
 
 #include "engine/mode_manager.h"
+#include "engine/profiler.h"
 
 using namespace vt_video;
 using namespace vt_script;
@@ -108,6 +109,8 @@ void ScriptSupervisor::Restart()
 
 void ScriptSupervisor::Update()
 {
+    PROFILE_ZONE("ScriptSupervisor::Update");
+
     // Updates custom scripts
     for(uint32_t i = 0; i < _update_functions.size(); ++i)
         ReadScriptDescriptor::RunScriptObject(_update_functions[i]);
@@ -356,8 +356,14 @@ void SystemTimer::_UpdateTimer(uint32_t time)
 // -----------------------------------------------------------------------------
 
 SystemEngine::SystemEngine():
-    _last_update(0),
+    _last_frame_counter(0),
+    _update_accumulator(0),
     _update_time(1), // Set to 1 to avoid hanging the system.
+    _update_count(0),
+    _update_rate(DEFAULT_UPDATE_RATE),
+    _update_time_remainder(0),
+    _update_interpolation(true),
+    _interpolation_factor(1.0f),
     _hours_played(0),
     _minutes_played(0),
     _seconds_played(0),
@@ -551,7 +557,8 @@ bool SystemEngine::SingletonInitialize()
 
 void SystemEngine::InitializeTimers()
 {
-    _last_update = SDL_GetTicks();
+    _last_frame_counter = SDL_GetPerformanceCounter();
+    _update_accumulator = 0;
     _update_time = 1; // Set to non-zero, otherwise bad things may happen...
     _hours_played = 0;
     _minutes_played = 0;
@@ -562,10 +569,57 @@ void SystemEngine::InitializeTimers()
 
 void SystemEngine::InitializeUpdateTimer()
 {
-    _last_update = SDL_GetTicks();
+    // Forget the time spent loading the mode, rather than catching it up.
+    _last_frame_counter = SDL_GetPerformanceCounter();
+    _update_accumulator = 0;
     _update_time = 1;
 }
 
+void SystemEngine::SetUpdateRate(uint32_t update_rate)
+{
+    if(update_rate == 0) {
+        IF_PRINT_WARNING(SYSTEM_DEBUG) << "invalid update rate, using the default one instead" << std::endl;
+        update_rate = DEFAULT_UPDATE_RATE;
+    }
+
+    _update_rate = update_rate;
+    _update_time_remainder = 0;
+}
+
+uint32_t SystemEngine::UpdateFrameTimer()
+{
+    uint64_t counter = SDL_GetPerformanceCounter();
+    _update_accumulator += counter - _last_frame_counter;
+    _last_frame_counter = counter;
+
+    uint64_t update_duration = SDL_GetPerformanceFrequency() / _update_rate;
+    uint64_t updates = _update_accumulator / update_duration;
+
+    // Past the catch-up limit, the remaining time is dropped: the game slows down instead.
+    if(updates > MAX_CATCH_UP_UPDATES) {
+        updates = MAX_CATCH_UP_UPDATES;
+        _update_accumulator %= update_duration;
+    }
+    else {
+        _update_accumulator -= updates * update_duration;
+    }
+
+    _interpolation_factor = static_cast<float>(_update_accumulator) / static_cast<float>(update_duration);
+
+    return static_cast<uint32_t>(updates);
+}
+
+uint32_t SystemEngine::GetTimeUntilNextUpdate() const
+{
+    uint64_t frequency = SDL_GetPerformanceFrequency();
+    uint64_t update_duration = frequency / _update_rate;
+    uint64_t elapsed = _update_accumulator + SDL_GetPerformanceCounter() - _last_frame_counter;
+    if(elapsed >= update_duration)
+        return 0;
+
+    return static_cast<uint32_t>((update_duration - elapsed) * 1000 / frequency);
+}
+
 void SystemEngine::AddAutoTimer(SystemTimer *timer)
 {
     if(timer == nullptr) {
@@ -599,10 +653,12 @@ void SystemEngine::RemoveAutoTimer(SystemTimer *timer)
 
 void SystemEngine::UpdateTimers()
 {
-    // Update the update game timer
-    uint32_t tmp = _last_update;
-    _last_update = SDL_GetTicks();
-    _update_time = _last_update - tmp;
+    // Each update lasts 1000 / _update_rate milliseconds. The fractions of milliseconds
+    // are carried over, so that the updates of a second add up to 1000 milliseconds.
+    ++_update_count;
+    _update_time_remainder += 1000;
+    _update_time = _update_time_remainder / _update_rate;
+    _update_time_remainder %= _update_rate;
 
     // Update the game play timer
     _milliseconds_played += _update_time;
@@ -69,6 +69,14 @@ const int32_t SYSTEM_TIMER_NO_LOOPS = 0;
 **/
 const int32_t SYSTEM_TIMER_INFINITE_LOOP = -1;
 
+//! \brief The default number of game logic updates per second.
+const uint32_t DEFAULT_UPDATE_RATE = 60;
+
+/** \brief The maximum number of game logic updates run before drawing a frame
+*** When the game can't keep up, it slows down rather than stop drawing while catching up.
+**/
+const uint32_t MAX_CATCH_UP_UPDATES = 5;
+
 //! \brief All of the possible states which a SystemTimer classs object may be in
 enum SYSTEM_TIMER_STATE {
     SYSTEM_TIMER_INVALID  = -1,
@@ -458,8 +466,14 @@ public:
     **/
     void RemoveAutoTimer(SystemTimer *timer);
 
-    /** \brief Updates the game timer variables.
-    *** This function should only be called <b>once</b> for each cycle through the main game loop. Since
+    /** \brief Measures the time elapsed since the last frame.
+    *** \return The number of fixed game logic updates to run before drawing the next frame.
+    *** This function should only be called <b>once</b> for each frame drawn, in main.cpp.
+    **/
+    uint32_t UpdateFrameTimer();
+
+    /** \brief Advances the game timer variables by one fixed update.
+    *** This function should only be called <b>once</b> for each game logic update. Since
     *** it is called inside the loop in main.cpp, you should have no reason to call this function anywhere
     *** else.
     **/
@@ -484,6 +498,44 @@ public:
         return _update_time;
     }
 
+    //! \brief Returns the number of game logic updates done since the game started.
+    uint32_t GetUpdateCount() const {
+        return _update_count;
+    }
+
+    //! \brief Returns the number of game logic updates per second.
+    uint32_t GetUpdateRate() const {
+        return _update_rate;
+    }
+
+    /** \brief Sets the number of game logic updates per second.
+    *** Each update then lasts 1000 / update_rate milliseconds, the remainders being carried
+    *** over to the next updates.
+    **/
+    void SetUpdateRate(uint32_t update_rate);
+
+    /** \brief Returns how far the drawn frame is between the last two game logic updates.
+    *** \return A value from 0.0f (previous update) to 1.0f (last update), or always 1.0f
+    *** when the interpolation is disabled.
+    ***
+    *** Game modes may use it to draw moving objects between their previous and current positions,
+    *** so that the movement remains smooth when more frames than updates are drawn.
+    **/
+    float GetUpdateInterpolation() const {
+        return _update_interpolation ? _interpolation_factor : 1.0f;
+    }
+
+    bool IsUpdateInterpolationEnabled() const {
+        return _update_interpolation;
+    }
+
+    void SetUpdateInterpolation(bool interpolation) {
+        _update_interpolation = interpolation;
+    }
+
+    //! \brief Returns the time left before the next game logic update is due, in milliseconds.
+    uint32_t GetTimeUntilNextUpdate() const;
+
     /** \brief Sets the play time of a game instance
     *** \param h The amount of hours to set.
     *** \param m The amount of minutes to set.
@@ -610,12 +662,30 @@ public:
 private:
     SystemEngine();
 
-    //! \brief The last time that the UpdateTimers function was called, in milliseconds.
-    uint32_t _last_update;
+    //! \brief The performance counter value when the UpdateFrameTimer function was last called.
+    uint64_t _last_frame_counter;
+
+    //! \brief The elapsed time not simulated by the game logic updates yet, in performance counter units.
+    uint64_t _update_accumulator;
 
     //! \brief The number of milliseconds that have transpired on the last timer update.
     uint32_t _update_time;
 
+    //! \brief The number of game logic updates done since the game started.
+    uint32_t _update_count;
+
+    //! \brief The number of game logic updates per second.
+    uint32_t _update_rate;
+
+    //! \brief The update milliseconds not accounted yet, in 1/_update_rate milliseconds.
+    uint32_t _update_time_remainder;
+
+    //! \brief Tells whether moving objects should be drawn between their last two updated positions.
+    bool _update_interpolation;
+
+    //! \brief The part of the next update already elapsed when the frame is drawn, from 0.0f to 1.0f.
+    float _interpolation_factor;
+
     /** \name Play time members
     *** \brief Timers that retain the total amount of time that the user has been playing
     *** When the player starts a new game or loads an existing game, these timers are reset.
@@ -0,0 +1,50 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    gl_debug.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the OpenGL debug mode.
+***
+*** Querying glGetError() forces a synchronisation with the driver, so the
+*** checks done in the draw path are only compiled in when the game is built
+*** with the DEBUG_GL option, and only run when the --gl-debug command line
+*** switch is given.
+*** ***************************************************************************/
+
+#ifndef __GL_DEBUG_HEADER__
+#define __GL_DEBUG_HEADER__
+
+#include "utils/gl_include.h"
+
+namespace vt_video
+{
+
+//! \brief Enables the OpenGL error checks done after each draw path call.
+//! \note Only has an effect when the game is built with the DEBUG_GL option.
+extern bool GL_DEBUG;
+
+namespace gl
+{
+
+//! \brief Returns glGetError() in OpenGL debug mode, and GL_NO_ERROR otherwise.
+inline GLenum GetDebugError()
+{
+#ifdef DEBUG_GL
+    if (GL_DEBUG)
+        return glGetError();
+#endif
+    return GL_NO_ERROR;
+}
+
+} // namespace gl
+
+} // namespace vt_video
+
+#endif // __GL_DEBUG_HEADER__
@@ -15,6 +15,8 @@
 
 #include "gl_particle_system.h"
 
+#include "gl_debug.h"
+
 #include "utils/exception.h"
 #include "utils/utils_strings.h"
 #include "utils/utils_common.h"
@@ -43,12 +45,16 @@ const unsigned COLORS_PER_VERTEX = 4;
 
 ParticleSystem::ParticleSystem() :
     _number_of_indices(0),
+    _index_capacity(0),
+    _number_of_mapped_particles(0),
     _vao(0),
     _vertex_position_buffer(0),
     _vertex_texture_coordinate_buffer(0),
     _vertex_color_buffer(0),
     _index_buffer(0)
 {
+    _mapped_buffers[0] = _mapped_buffers[1] = _mapped_buffers[2] = false;
+
     bool errors = false;
 
     // Create the vertex array object.
@@ -293,144 +299,136 @@ void ParticleSystem::Draw()
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
-void ParticleSystem::Draw(float* vertex_positions,
-                          float* vertex_texture_coordinates,
-                          float* vertex_colors,
-                          unsigned number_of_vertices)
+bool ParticleSystem::MapBuffers(unsigned number_of_particles,
+                                float** vertex_positions,
+                                float** vertex_texture_coordinates,
+                                float** vertex_colors)
 {
-    bool errors = false;
+    assert(number_of_particles > 0);
 
-    assert(vertex_positions != nullptr);
-    assert(vertex_texture_coordinates != nullptr);
-    assert(vertex_colors != nullptr);
-    assert(number_of_vertices % VERTICES_PER_PARTICLE == 0);
-
-    // Bind the vertex position buffer.
-    glBindBuffer(GL_ARRAY_BUFFER, _vertex_position_buffer);
+    if (!_ReserveIndices(number_of_particles))
+        return false;
 
-    // Update the vertex position data.
-    if (!errors) {
-        glBufferData(GL_ARRAY_BUFFER,
-                     number_of_vertices * POSITIONS_PER_VERTEX * sizeof(float),
-                     vertex_positions,
-                     GL_DYNAMIC_DRAW);
+    const GLuint buffers[] = { _vertex_position_buffer, _vertex_texture_coordinate_buffer, _vertex_color_buffer };
+    const unsigned floats_per_vertex[] = { POSITIONS_PER_VERTEX, TEXTURE_COORDINATES_PER_VERTEX, COLORS_PER_VERTEX };
+    float** mapped_data[] = { vertex_positions, vertex_texture_coordinates, vertex_colors };
 
-        GLenum error = glGetError();
-        if (error != GL_NO_ERROR) {
+    bool errors = false;
+    for (unsigned i = 0; i < 3 && !errors; ++i) {
+        _mapped_buffers[i] = false;
+        if (mapped_data[i] == nullptr)
+            continue;
+
+        *mapped_data[i] = _MapBuffer(buffers[i], number_of_particles * VERTICES_PER_PARTICLE
+                                                 * floats_per_vertex[i] * sizeof(float));
+        if (*mapped_data[i] == nullptr) {
             errors = true;
-            PRINT_ERROR << "Failed to update the vertex position data. VAO ID: " <<
+            PRINT_ERROR << "Failed to map a particle vertex buffer. VAO ID: " <<
                            vt_utils::NumberToString(_vao) << " Buffer ID: " <<
-                           vt_utils::NumberToString(_vertex_position_buffer) <<
+                           vt_utils::NumberToString(buffers[i]) <<
                            std::endl;
-            assert(error == GL_NO_ERROR);
+        }
+        else {
+            _mapped_buffers[i] = true;
         }
     }
 
-    // Bind the vertex texture coordinate buffer.
-    if (!errors) {
-        glBindBuffer(GL_ARRAY_BUFFER, _vertex_texture_coordinate_buffer);
-    }
-
-    // Update the vertex texture coordinate data.
-    if (!errors) {
-        glBufferData(GL_ARRAY_BUFFER,
-                     number_of_vertices * TEXTURE_COORDINATES_PER_VERTEX * sizeof(float),
-                     vertex_texture_coordinates,
-                     GL_DYNAMIC_DRAW);
+    if (errors) {
+        // Release the buffers already mapped.
+        for (unsigned i = 0; i < 3; ++i) {
+            if (!_mapped_buffers[i])
+                continue;
 
-        GLenum error = glGetError();
-        if (error != GL_NO_ERROR) {
-            errors = true;
-            PRINT_ERROR << "Failed to update the vertex texture coordinate data. VAO ID: " <<
-                           vt_utils::NumberToString(_vao) << " Buffer ID: " <<
-                           vt_utils::NumberToString(_vertex_texture_coordinate_buffer) <<
-                           std::endl;
-            assert(error == GL_NO_ERROR);
+            glBindBuffer(GL_ARRAY_BUFFER, buffers[i]);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            _mapped_buffers[i] = false;
         }
     }
 
-    // Bind the vertex color buffer.
-    if (!errors) {
-        glBindBuffer(GL_ARRAY_BUFFER, _vertex_color_buffer);
-    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-    // Update the vertex color data.
-    if (!errors) {
-        glBufferData(GL_ARRAY_BUFFER,
-                     number_of_vertices * COLORS_PER_VERTEX * sizeof(float),
-                     vertex_colors,
-                     GL_DYNAMIC_DRAW);
+    _number_of_mapped_particles = errors ? 0 : number_of_particles;
+    return !errors;
+}
 
-        GLenum error = glGetError();
-        if (error != GL_NO_ERROR) {
+void ParticleSystem::DrawMappedBuffers()
+{
+    const GLuint buffers[] = { _vertex_position_buffer, _vertex_texture_coordinate_buffer, _vertex_color_buffer };
+
+    bool errors = false;
+    for (unsigned i = 0; i < 3; ++i) {
+        if (!_mapped_buffers[i])
+            continue;
+
+        glBindBuffer(GL_ARRAY_BUFFER, buffers[i]);
+
+        // The content is lost when the buffer got corrupted, e.g. by a screen mode change.
+        if (glUnmapBuffer(GL_ARRAY_BUFFER) == GL_FALSE)
             errors = true;
-            PRINT_ERROR << "Failed to update the vertex color data. VAO ID: " <<
-                           vt_utils::NumberToString(_vao) << " Buffer ID: " <<
-                           vt_utils::NumberToString(_vertex_color_buffer) <<
-                           std::endl;
-            assert(error == GL_NO_ERROR);
-        }
+        _mapped_buffers[i] = false;
     }
 
-    // Create the index buffer's data.
-    std::vector<unsigned> indices;
-    indices.reserve(number_of_vertices / VERTICES_PER_PARTICLE * INDICES_PER_PARTICLE);
-    if (!errors) {
-        // For each particle...
-        unsigned number_of_particles = number_of_vertices / VERTICES_PER_PARTICLE;
-        for (unsigned i = 0; i < number_of_particles; ++i)
-        {
-            // Compute the starting index of the particle.
-            unsigned index = i * VERTICES_PER_PARTICLE;
-
-            //
-            // Store the particle's indices.
-            //
-
-            // Triangle one.
-            indices.push_back(index + 0);
-            indices.push_back(index + 1);
-            indices.push_back(index + 2);
-
-            // Triangle two.
-            indices.push_back(index + 0);
-            indices.push_back(index + 2);
-            indices.push_back(index + 3);
-        }
-    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-    // Bind the index buffer.
-    if (!errors) {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _index_buffer);
-    }
+    if (errors || _number_of_mapped_particles == 0)
+        return;
 
-    // Update the index data.
-    if (!errors) {
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                     indices.size() * sizeof(unsigned),
-                     &indices.front(),
-                     GL_DYNAMIC_DRAW);
-        _number_of_indices = indices.size();
+    _number_of_indices = _number_of_mapped_particles * INDICES_PER_PARTICLE;
+    Draw();
+}
 
-        GLenum error = glGetError();
-        if (error != GL_NO_ERROR) {
-            errors = true;
-            PRINT_ERROR << "Failed to update the index data. VAO ID: " <<
-                           vt_utils::NumberToString(_vao) << " Buffer ID: " <<
-                           vt_utils::NumberToString(_index_buffer) <<
-                           std::endl;
-            assert(error == GL_NO_ERROR);
-        }
+float* ParticleSystem::_MapBuffer(GLuint buffer, size_t size)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+    // Orphan the previous content, so that the driver doesn't wait for the pending draws using it.
+    glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW);
+
+    return static_cast<float*>(glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY));
+}
+
+bool ParticleSystem::_ReserveIndices(unsigned number_of_particles)
+{
+    // The indices are the same for every draw: they are only regenerated when more particles are drawn.
+    if (number_of_particles <= _index_capacity)
+        return true;
+
+    std::vector<unsigned> indices;
+    indices.reserve(number_of_particles * INDICES_PER_PARTICLE);
+    for (unsigned i = 0; i < number_of_particles; ++i) {
+        // Compute the starting index of the particle.
+        unsigned index = i * VERTICES_PER_PARTICLE;
+
+        // Triangle one.
+        indices.push_back(index + 0);
+        indices.push_back(index + 1);
+        indices.push_back(index + 2);
+
+        // Triangle two.
+        indices.push_back(index + 0);
+        indices.push_back(index + 2);
+        indices.push_back(index + 3);
     }
 
-    // Unbind the buffers from the pipeline.
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _index_buffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                 indices.size() * sizeof(unsigned),
+                 &indices.front(),
+                 GL_STATIC_DRAW);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
-    // Draw the particle system.
-    if (!errors) {
-        Draw();
+    GLenum error = GetDebugError();
+    if (error != GL_NO_ERROR) {
+        PRINT_ERROR << "Failed to update the index data. VAO ID: " <<
+                       vt_utils::NumberToString(_vao) << " Buffer ID: " <<
+                       vt_utils::NumberToString(_index_buffer) <<
+                       std::endl;
+        assert(error == GL_NO_ERROR);
+        return false;
     }
+
+    _index_capacity = number_of_particles;
+    return true;
 }
 
 ParticleSystem::ParticleSystem(const ParticleSystem&)
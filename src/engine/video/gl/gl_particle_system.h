@@ -35,11 +35,23 @@ public:
     //! \brief Draws all sprites in a particle system.
     void Draw();
 
-    //! \brief Draws all sprites in a particle system.
-    void Draw(float* vertex_positions,
-              float* vertex_texture_coordinates,
-              float* vertex_colors,
-              unsigned number_of_vertices);
+    /** \brief Maps the vertex buffers, so that the particle vertices are written straight into them.
+    *** \param number_of_particles The number of particles to draw.
+    *** \param vertex_positions Receives the buffer of 4 * 3 floats per particle,
+    *** or nullptr to keep the positions of the previous draw.
+    *** \param vertex_texture_coordinates Receives the buffer of 4 * 2 floats per particle,
+    *** or nullptr to keep the texture coordinates of the previous draw.
+    *** \param vertex_colors Receives the buffer of 4 * 4 floats per particle,
+    *** or nullptr to keep the colors of the previous draw.
+    *** \return false if a buffer couldn't be mapped. Nothing is mapped then.
+    **/
+    bool MapBuffers(unsigned number_of_particles,
+                    float** vertex_positions,
+                    float** vertex_texture_coordinates,
+                    float** vertex_colors);
+
+    //! \brief Unmaps the vertex buffers and draws the particles written in them.
+    void DrawMappedBuffers();
 
 private:
     //! \brief The copy constructor and assignment operator are hidden by design
@@ -47,8 +59,23 @@ private:
     ParticleSystem(const ParticleSystem& particle_system);
     ParticleSystem& operator=(const ParticleSystem& particle_system);
 
+    //! \brief Maps a vertex buffer, after orphaning its previous content.
+    float* _MapBuffer(GLuint buffer, size_t size);
+
+    //! \brief Makes the index buffer big enough for the given number of particles.
+    bool _ReserveIndices(unsigned number_of_particles);
+
     size_t _number_of_indices;
 
+    //! \brief The number of particles the index buffer can draw.
+    unsigned _index_capacity;
+
+    //! \brief The number of particles written in the mapped buffers.
+    unsigned _number_of_mapped_particles;
+
+    //! \brief Whether each vertex buffer (positions, texture coordinates, colors) is currently mapped.
+    bool _mapped_buffers[3];
+
     GLuint _vao;
     GLuint _vertex_position_buffer;
     GLuint _vertex_texture_coordinate_buffer;
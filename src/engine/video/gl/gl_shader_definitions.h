@@ -122,7 +122,6 @@ namespace shader_definitions
         "}\n";
 
     const char SPRITE_GRAYSCALE_FRAGMENT[] =
-        "\n"
         "#version 110\n"
         "\n"
         "//\n"
@@ -156,6 +155,40 @@ namespace shader_definitions
         "        gl_FragColor.b = sum;\n"
         "}\n";
 
+    const char SPRITE_BLUR_FRAGMENT[] =
+        "#version 110\n"
+        "\n"
+        "//\n"
+        "// Samples a texture with a 9-tap gaussian filter along one axis.\n"
+        "// Two passes, one per axis, blur the texture in both directions.\n"
+        "//\n"
+        "\n"
+        "uniform vec4 u_Color;\n"
+        "uniform sampler2D u_Texture;\n"
+        "\n"
+        "// The texture coordinates offset between two taps, in xy.\n"
+        "uniform vec4 u_BlurStep;\n"
+        "\n"
+        "// The texture coordinates the taps are clamped to: left, top, right, bottom.\n"
+        "uniform vec4 u_BlurBounds;\n"
+        "\n"
+        "vec4 BlurTap(float offset)\n"
+        "{\n"
+        "        vec2 coordinates = gl_TexCoord[0].xy + u_BlurStep.xy * offset;\n"
+        "        return texture2D(u_Texture, clamp(coordinates, u_BlurBounds.xy, u_BlurBounds.zw));\n"
+        "}\n"
+        "\n"
+        "void main(void)\n"
+        "{\n"
+        "        gl_FragColor  = BlurTap(0.0) * 0.2270270270;\n"
+        "        gl_FragColor += (BlurTap(1.0) + BlurTap(-1.0)) * 0.1945945946;\n"
+        "        gl_FragColor += (BlurTap(2.0) + BlurTap(-2.0)) * 0.1216216216;\n"
+        "        gl_FragColor += (BlurTap(3.0) + BlurTap(-3.0)) * 0.0540540541;\n"
+        "        gl_FragColor += (BlurTap(4.0) + BlurTap(-4.0)) * 0.0162162162;\n"
+        "        gl_FragColor *= gl_Color;\n"
+        "        gl_FragColor *= u_Color;\n"
+        "}\n";
+
 } // namespace shader_definition
 
 } // namespace gl
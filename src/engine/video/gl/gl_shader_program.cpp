@@ -15,6 +15,7 @@
 
 #include "gl_shader_program.h"
 
+#include "gl_debug.h"
 #include "gl_shader.h"
 
 #include "utils/utils_common.h"
@@ -29,6 +30,14 @@ namespace vt_video
 namespace gl
 {
 
+//! \brief The names of the common uniforms, in the uniforms::Uniforms order.
+static const char* UNIFORM_NAMES[uniforms::Count] = {
+    "u_Model",
+    "u_View",
+    "u_Projection",
+    "u_Color"
+};
+
 ShaderProgram::ShaderProgram(const Shader* vertex_shader,
                              const Shader* fragment_shader,
                              const std::vector<std::string>& attributes) :
@@ -38,6 +47,11 @@ ShaderProgram::ShaderProgram(const Shader* vertex_shader,
 {
     bool errors = false;
 
+    for (uint32_t i = 0; i < uniforms::Count; ++i) {
+        _uniform_locations[i] = -1;
+        _uniform_values_valid[i] = false;
+    }
+
     assert(_vertex_shader != nullptr);
     assert(_fragment_shader != nullptr);
 
@@ -127,9 +141,12 @@ ShaderProgram::ShaderProgram(const Shader* vertex_shader,
     GLint is_linked = -1;
     glGetProgramiv(_program, GL_LINK_STATUS, &is_linked);
 
-    // Return if linkage went well
-    if (is_linked != 0)
+    // Resolve the common uniform locations and return if linkage went well.
+    if (is_linked != 0) {
+        for (uint32_t i = 0; i < uniforms::Count; ++i)
+            _uniform_locations[i] = glGetUniformLocation(_program, UNIFORM_NAMES[i]);
         return;
+    }
 
     // Retrieve the linker output.
     GLint length = 0;
@@ -168,7 +185,7 @@ bool ShaderProgram::Load()
 
     glUseProgram(_program);
 
-    GLenum error = glGetError();
+    GLenum error = GetDebugError();
     if (error != GL_NO_ERROR) {
         result = false;
         PRINT_ERROR << "Failed to load the shader program. Shader Program ID: " <<
@@ -187,7 +204,7 @@ bool ShaderProgram::UpdateUniform(const std::string& uniform, float value)
     GLint location = glGetUniformLocation(_program, uniform.c_str());
     glUniform1f(location, value);
 
-    GLenum error = glGetError();
+    GLenum error = GetDebugError();
     if (error != GL_NO_ERROR) {
         result = false;
         PRINT_ERROR << "Failed to update the shader program uniform. Shader Program ID: " <<
@@ -206,7 +223,7 @@ bool ShaderProgram::UpdateUniform(const std::string& uniform, int32_t value)
     GLint location = glGetUniformLocation(_program, uniform.c_str());
     glUniform1i(location, value);
 
-    GLenum error = glGetError();
+    GLenum error = GetDebugError();
     if (error != GL_NO_ERROR) {
         result = false;
         PRINT_ERROR << "Failed to update the shader program uniform. Shader Program ID: " <<
@@ -222,6 +239,12 @@ bool ShaderProgram::UpdateUniform(const std::string& uniform, const float* data,
 {
     bool result = false;
 
+    // Keep the cached values of the common uniforms in sync.
+    for (uint32_t i = 0; i < uniforms::Count; ++i) {
+        if (uniform == UNIFORM_NAMES[i])
+            _uniform_values_valid[i] = false;
+    }
+
     GLint location = glGetUniformLocation(_program, uniform.c_str());
 
     // This function currently only supports matrices and vectors.
@@ -241,7 +264,7 @@ bool ShaderProgram::UpdateUniform(const std::string& uniform, const float* data,
         }
     }
 
-    GLenum error = glGetError();
+    GLenum error = GetDebugError();
     if (error != GL_NO_ERROR) {
         result = false;
         PRINT_ERROR << "Failed to update the shader program uniform. Shader Program ID: " <<
@@ -253,6 +276,50 @@ bool ShaderProgram::UpdateUniform(const std::string& uniform, const float* data,
     return result;
 }
 
+bool ShaderProgram::UpdateUniform(uniforms::Uniforms uniform, const float* data, uint32_t length)
+{
+    assert(uniform >= 0 && uniform < uniforms::Count);
+
+    // This function currently only supports matrices and vectors.
+    assert(data != nullptr && (length == 4 || length == 16));
+    if (data == nullptr || (length != 4 && length != 16))
+        return false;
+
+    // The program doesn't use this uniform.
+    GLint location = _uniform_locations[uniform];
+    if (location == -1)
+        return true;
+
+    // Skip redundant uploads.
+    float* cached_value = _uniform_values[uniform];
+    if (_uniform_values_valid[uniform] && memcmp(cached_value, data, length * sizeof(float)) == 0)
+        return true;
+
+    if (length == 4) {
+        // The vector case.
+        glUniform4f(location, data[0], data[1], data[2], data[3]);
+    }
+    else {
+        // The matrix case.
+        glUniformMatrix4fv(location, 1, true, data);
+    }
+
+    GLenum error = GetDebugError();
+    if (error != GL_NO_ERROR) {
+        _uniform_values_valid[uniform] = false;
+        PRINT_ERROR << "Failed to update the shader program uniform. Shader Program ID: " <<
+                       vt_utils::NumberToString(_program) << " Uniform Name: " << UNIFORM_NAMES[uniform] <<
+                       std::endl;
+        assert(error == GL_NO_ERROR);
+        return false;
+    }
+
+    memcpy(cached_value, data, length * sizeof(float));
+    _uniform_values_valid[uniform] = true;
+
+    return true;
+}
+
 ShaderProgram::ShaderProgram(const ShaderProgram&)
 {
     throw vt_utils::Exception("Not Implemented!",
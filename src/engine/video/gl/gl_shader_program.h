@@ -29,6 +29,22 @@ namespace gl
 // Forward declarations.
 class Shader;
 
+namespace uniforms
+{
+
+//! \brief The uniforms common to all the shader programs.
+//! Their locations are resolved once, when the program is linked.
+enum Uniforms
+{
+    Model = 0,
+    View,
+    Projection,
+    Color,
+    Count
+};
+
+} // namespace uniforms
+
 //! \brief A class for an OpenGL shader program.
 class ShaderProgram
 {
@@ -44,9 +60,28 @@ public:
     bool UpdateUniform(const std::string& uniform, int32_t value);
     bool UpdateUniform(const std::string& uniform, const float* data, uint32_t length);
 
+    /** \brief Updates one of the common uniforms using its cached location.
+    *** \param uniform The uniform to update.
+    *** \param data The vector (length 4) or matrix (length 16) values.
+    *** \param length The number of values.
+    *** \return false if the upload failed.
+    *** \note The value is only sent to OpenGL when it differs from the last one uploaded.
+    *** The program must be the one in use.
+    **/
+    bool UpdateUniform(uniforms::Uniforms uniform, const float* data, uint32_t length);
+
 private:
     GLuint _program;
 
+    //! \brief The locations of the common uniforms, or -1 when the program doesn't use them.
+    GLint _uniform_locations[uniforms::Count];
+
+    //! \brief The last values uploaded for the common uniforms.
+    float _uniform_values[uniforms::Count][16];
+
+    //! \brief Tells whether the matching _uniform_values entry holds the uniform's current value.
+    bool _uniform_values_valid[uniforms::Count];
+
     const Shader* _vertex_shader;
     const Shader* _fragment_shader;
 
@@ -15,6 +15,8 @@
 
 #include "gl_sprite.h"
 
+#include "gl_debug.h"
+
 #include "utils/utils_common.h"
 #include "utils/exception.h"
 #include "utils/utils_strings.h"
@@ -349,7 +351,7 @@ void Sprite::Draw(float* vertex_positions,
     // Update the vertex position data.
     glBufferSubData(GL_ARRAY_BUFFER, 0, VERTICES_PER_SPRITE * POSITIONS_PER_VERTEX * sizeof(float), vertex_positions);
 
-    GLenum error = glGetError();
+    GLenum error = GetDebugError();
     if (error != GL_NO_ERROR) {
         errors = true;
         PRINT_ERROR << "Failed to update the vertex position data. VAO ID: " <<
@@ -368,7 +370,7 @@ void Sprite::Draw(float* vertex_positions,
     if (!errors) {
         glBufferSubData(GL_ARRAY_BUFFER, 0, VERTICES_PER_SPRITE * TEXTURE_COORDINATES_PER_VERTEX * sizeof(float), vertex_texture_coordinates);
 
-        GLenum error = glGetError();
+        GLenum error = GetDebugError();
         if (error != GL_NO_ERROR) {
             errors = true;
             PRINT_ERROR << "Failed to update the vertex texture coordinate data. VAO ID: " <<
@@ -388,7 +390,7 @@ void Sprite::Draw(float* vertex_positions,
     if (!errors) {
         glBufferSubData(GL_ARRAY_BUFFER, 0, VERTICES_PER_SPRITE * COLORS_PER_VERTEX * sizeof(float), vertex_colors);
 
-        GLenum error = glGetError();
+        GLenum error = GetDebugError();
         if (error != GL_NO_ERROR) {
             errors = true;
             PRINT_ERROR << "Failed to update the vertex color data. VAO ID: " <<
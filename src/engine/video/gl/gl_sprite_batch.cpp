@@ -0,0 +1,329 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    gl_sprite_batch.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for batching sprites into a streaming vertex buffer.
+*** ***************************************************************************/
+
+#include "gl_sprite_batch.h"
+
+#include "gl_debug.h"
+#include "gl_transform.h"
+#include "gl_vector.h"
+
+#include "utils/utils_common.h"
+#include "utils/exception.h"
+#include "utils/utils_strings.h"
+
+#include <cassert>
+
+#ifdef __APPLE__
+#   define glBindVertexArray    glBindVertexArrayAPPLE
+#   define glGenVertexArrays    glGenVertexArraysAPPLE
+#   define glGenerateMipmap     glGenerateMipmapEXT
+#   define glDeleteVertexArrays glDeleteVertexArraysAPPLE
+#endif
+
+namespace vt_video
+{
+namespace gl
+{
+
+//
+// Constants.
+//
+
+//! \brief The maximum number of sprites drawn by a single flush.
+const unsigned SPRITES_PER_BATCH = 2048;
+
+//! \brief The number of sprites the streaming vertex buffer can hold before being orphaned.
+const unsigned SPRITES_PER_BUFFER = SPRITES_PER_BATCH * 8;
+
+const unsigned VERTICES_PER_SPRITE = 4;
+const unsigned INDICES_PER_SPRITE = 6;
+const unsigned POSITIONS_PER_VERTEX = 3;
+const unsigned TEXTURE_COORDINATES_PER_VERTEX = 2;
+const unsigned COLORS_PER_VERTEX = 4;
+const unsigned FLOATS_PER_VERTEX = POSITIONS_PER_VERTEX + TEXTURE_COORDINATES_PER_VERTEX + COLORS_PER_VERTEX;
+const unsigned FLOATS_PER_SPRITE = VERTICES_PER_SPRITE * FLOATS_PER_VERTEX;
+
+const GLsizei VERTEX_STRIDE = FLOATS_PER_VERTEX * sizeof(float);
+const GLsizeiptr BUFFER_SIZE = SPRITES_PER_BUFFER * FLOATS_PER_SPRITE * sizeof(float);
+
+SpriteBatch::SpriteBatch() :
+    _vao(0),
+    _vertex_buffer(0),
+    _index_buffer(0),
+    _number_of_sprites(0),
+    _buffer_offset(0),
+    _number_of_flushes(0),
+    _number_of_sprites_drawn(0)
+{
+    bool errors = false;
+
+    _vertices.resize(SPRITES_PER_BATCH * FLOATS_PER_SPRITE);
+
+    // The indices of two triangles per sprite.
+    // They never change, as the sprites are always stored in the same order.
+    std::vector<GLushort> indices(SPRITES_PER_BATCH * INDICES_PER_SPRITE);
+    for (unsigned i = 0; i < SPRITES_PER_BATCH; ++i) {
+        GLushort first_vertex = static_cast<GLushort>(i * VERTICES_PER_SPRITE);
+
+        // Triangle One.
+        indices[(i * INDICES_PER_SPRITE) + 0] = first_vertex + 0;
+        indices[(i * INDICES_PER_SPRITE) + 1] = first_vertex + 1;
+        indices[(i * INDICES_PER_SPRITE) + 2] = first_vertex + 2;
+
+        // Triangle Two.
+        indices[(i * INDICES_PER_SPRITE) + 3] = first_vertex + 0;
+        indices[(i * INDICES_PER_SPRITE) + 4] = first_vertex + 2;
+        indices[(i * INDICES_PER_SPRITE) + 5] = first_vertex + 3;
+    }
+
+    // Create the vertex array object.
+    if (!errors) {
+        GLuint arrays[1] = { 0 };
+        glGenVertexArrays(1, arrays);
+
+        GLenum error = glGetError();
+        if (error != GL_NO_ERROR) {
+            errors = true;
+            PRINT_ERROR << "Failed to create the vertex array object." << std::endl;
+            assert(error == GL_NO_ERROR);
+        } else {
+            // Store the result.
+            _vao = arrays[0];
+        }
+    }
+
+    // Bind the vertex array object.
+    if (!errors) {
+        glBindVertexArray(_vao);
+    }
+
+    // Create the vertex buffer objects.
+    if (!errors) {
+        GLuint buffers[2] = { 0 };
+        glGenBuffers(2, buffers);
+
+        GLenum error = glGetError();
+        if (error != GL_NO_ERROR) {
+            errors = true;
+            PRINT_ERROR << "Failed to create the vertex array object's vertex and index buffers. VAO ID: " <<
+                           vt_utils::NumberToString(_vao) <<
+                           std::endl;
+            assert(error == GL_NO_ERROR);
+        } else {
+            // Store the results.
+            _vertex_buffer = buffers[0];
+            _index_buffer = buffers[1];
+        }
+    }
+
+    // Bind the vertex buffer.
+    if (!errors) {
+        glBindBuffer(GL_ARRAY_BUFFER, _vertex_buffer);
+    }
+
+    // Allocate the streaming vertex buffer storage.
+    if (!errors) {
+        glBufferData(GL_ARRAY_BUFFER, BUFFER_SIZE, nullptr, GL_STREAM_DRAW);
+
+        GLenum error = glGetError();
+        if (error != GL_NO_ERROR) {
+            errors = true;
+            PRINT_ERROR << "Failed to allocate the vertex buffer storage. VAO ID: " <<
+                           vt_utils::NumberToString(_vao) << " Buffer ID: " <<
+                           vt_utils::NumberToString(_vertex_buffer) <<
+                           std::endl;
+            assert(error == GL_NO_ERROR);
+        }
+    }
+
+    // Enable the vertex position, texture coordinate and color attribute indices.
+    // Their pointers are set at each flush, as the written buffer region moves.
+    if (!errors) {
+        glEnableVertexAttribArray(0);
+        glEnableVertexAttribArray(1);
+        glEnableVertexAttribArray(2);
+    }
+
+    // Bind the index buffer.
+    if (!errors) {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _index_buffer);
+    }
+
+    // Set up the index data.
+    if (!errors) {
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLushort), &indices[0], GL_STATIC_DRAW);
+
+        GLenum error = glGetError();
+        if (error != GL_NO_ERROR) {
+            PRINT_ERROR << "Failed to store the index data. VAO ID: " <<
+                           vt_utils::NumberToString(_vao) << " Buffer ID: " <<
+                           vt_utils::NumberToString(_index_buffer) <<
+                           std::endl;
+            assert(error == GL_NO_ERROR);
+        }
+    }
+
+    // Unbind the vertex array object from the pipeline.
+    glBindVertexArray(0);
+
+    // Unbind the active buffers from the pipeline.
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+SpriteBatch::~SpriteBatch()
+{
+    if (_vao != 0) {
+        const GLuint arrays[] = { _vao };
+        glDeleteVertexArrays(1, arrays);
+        _vao = 0;
+    }
+
+    if (_vertex_buffer != 0) {
+        const GLuint buffers[] = { _vertex_buffer };
+        glDeleteBuffers(1, buffers);
+        _vertex_buffer = 0;
+    }
+
+    if (_index_buffer != 0) {
+        const GLuint buffers[] = { _index_buffer };
+        glDeleteBuffers(1, buffers);
+        _index_buffer = 0;
+    }
+}
+
+bool SpriteBatch::IsFull() const
+{
+    return _number_of_sprites >= SPRITES_PER_BATCH;
+}
+
+void SpriteBatch::AddSprite(const Transform& transform,
+                            const float* vertex_positions,
+                            const float* vertex_texture_coordinates,
+                            const float* vertex_colors,
+                            const float* color)
+{
+    assert(vertex_positions != nullptr);
+    assert(vertex_texture_coordinates != nullptr);
+    assert(vertex_colors != nullptr);
+    assert(color != nullptr);
+    assert(!IsFull());
+
+    float* vertex = &_vertices[_number_of_sprites * FLOATS_PER_SPRITE];
+
+    for (unsigned i = 0; i < VERTICES_PER_SPRITE; ++i) {
+        const float* position = vertex_positions + (i * POSITIONS_PER_VERTEX);
+        const float* texture_coordinates = vertex_texture_coordinates + (i * TEXTURE_COORDINATES_PER_VERTEX);
+        const float* vertex_color = vertex_colors + (i * COLORS_PER_VERTEX);
+
+        // The model transform is applied here, so that sprites
+        // drawn at different places can share the same draw call.
+        Vector4f transformed = transform * Vector4f(position[0], position[1], position[2], 1.0f);
+        vertex[0] = transformed._x;
+        vertex[1] = transformed._y;
+        vertex[2] = transformed._z;
+
+        vertex[3] = texture_coordinates[0];
+        vertex[4] = texture_coordinates[1];
+
+        // The same goes for the modulation color.
+        vertex[5] = vertex_color[0] * color[0];
+        vertex[6] = vertex_color[1] * color[1];
+        vertex[7] = vertex_color[2] * color[2];
+        vertex[8] = vertex_color[3] * color[3];
+
+        vertex += FLOATS_PER_VERTEX;
+    }
+
+    ++_number_of_sprites;
+}
+
+void SpriteBatch::Flush()
+{
+    if (_number_of_sprites == 0)
+        return;
+
+    // Bind the vertex array object.
+    glBindVertexArray(_vao);
+
+    // Bind the vertex buffer.
+    glBindBuffer(GL_ARRAY_BUFFER, _vertex_buffer);
+
+    // When the end of the buffer is reached, orphan its storage
+    // so that the driver doesn't wait for the sprites still being drawn.
+    if (_buffer_offset + _number_of_sprites > SPRITES_PER_BUFFER) {
+        glBufferData(GL_ARRAY_BUFFER, BUFFER_SIZE, nullptr, GL_STREAM_DRAW);
+        _buffer_offset = 0;
+    }
+
+    // Upload the pending sprites after the previously drawn ones.
+    size_t byte_offset = _buffer_offset * FLOATS_PER_SPRITE * sizeof(float);
+    glBufferSubData(GL_ARRAY_BUFFER, byte_offset,
+                    _number_of_sprites * FLOATS_PER_SPRITE * sizeof(float),
+                    &_vertices[0]);
+
+    GLenum error = GetDebugError();
+    if (error != GL_NO_ERROR) {
+        PRINT_ERROR << "Failed to update the vertex data. VAO ID: " <<
+                       vt_utils::NumberToString(_vao) << " Buffer ID: " <<
+                       vt_utils::NumberToString(_vertex_buffer) <<
+                       std::endl;
+        assert(error == GL_NO_ERROR);
+    } else {
+        // Point the vertex position, texture coordinate and color attributes
+        // to the region just written.
+        const char* base = reinterpret_cast<const char*>(byte_offset);
+        glVertexAttribPointer(0, POSITIONS_PER_VERTEX, GL_FLOAT, false, VERTEX_STRIDE,
+                              base);
+        glVertexAttribPointer(1, TEXTURE_COORDINATES_PER_VERTEX, GL_FLOAT, false, VERTEX_STRIDE,
+                              base + (POSITIONS_PER_VERTEX * sizeof(float)));
+        glVertexAttribPointer(2, COLORS_PER_VERTEX, GL_FLOAT, false, VERTEX_STRIDE,
+                              base + ((POSITIONS_PER_VERTEX + TEXTURE_COORDINATES_PER_VERTEX) * sizeof(float)));
+
+        // Bind the index buffer.
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _index_buffer);
+
+        // Draw the sprites.
+        glDrawElements(GL_TRIANGLES, _number_of_sprites * INDICES_PER_SPRITE, GL_UNSIGNED_SHORT, nullptr);
+
+        ++_number_of_flushes;
+        _number_of_sprites_drawn += _number_of_sprites;
+        _buffer_offset += _number_of_sprites;
+    }
+
+    // Unbind the vertex array object from the pipeline.
+    glBindVertexArray(0);
+
+    // Unbind the active buffers from the pipeline.
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    _number_of_sprites = 0;
+}
+
+SpriteBatch::SpriteBatch(const SpriteBatch&)
+{
+    throw vt_utils::Exception("Not Implemented!", __FILE__, __LINE__, __FUNCTION__);
+}
+
+SpriteBatch& SpriteBatch::operator=(const SpriteBatch&)
+{
+    throw vt_utils::Exception("Not Implemented!", __FILE__, __LINE__, __FUNCTION__);
+    return *this;
+}
+
+} // namespace gl
+
+} // namespace vt_video
@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    gl_sprite_batch.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for batching sprites into a streaming vertex buffer.
+***
+*** The sprite batch accumulates quads sharing the same OpenGL state
+*** (shader program, texture, blending and scissoring) and draws them all
+*** with a single draw call when that state is about to change.
+***
+*** The batch itself doesn't track the OpenGL state: the video engine flushes
+*** it before any state change affecting the pending sprites.
+*** ***************************************************************************/
+
+#ifndef __GL_SPRITE_BATCH_HEADER__
+#define __GL_SPRITE_BATCH_HEADER__
+
+#include "utils/gl_include.h"
+
+#include <vector>
+
+namespace vt_video
+{
+namespace gl
+{
+
+// Forward declarations.
+class Transform;
+
+//! \brief A class for drawing many sprites with a single draw call.
+class SpriteBatch
+{
+public:
+    SpriteBatch();
+    ~SpriteBatch();
+
+    /** \brief Queues a sprite in the batch.
+    *** \param transform The model transform applied to the vertex positions.
+    *** \param vertex_positions The 4 vertex positions (x, y, z).
+    *** \param vertex_texture_coordinates The 4 vertex texture coordinates (u, v).
+    *** \param vertex_colors The 4 vertex colors (r, g, b, a).
+    *** \param color A color (r, g, b, a) modulating every vertex color.
+    *** \note The batch must not be full. Flush it first otherwise.
+    **/
+    void AddSprite(const Transform& transform,
+                   const float* vertex_positions,
+                   const float* vertex_texture_coordinates,
+                   const float* vertex_colors,
+                   const float* color);
+
+    //! \brief Draws the queued sprites using the current OpenGL state, and empties the batch.
+    void Flush();
+
+    //! \brief Tells whether no sprites are waiting to be drawn.
+    bool IsEmpty() const {
+        return _number_of_sprites == 0;
+    }
+
+    //! \brief Tells whether the batch can't accept any more sprites before being flushed.
+    bool IsFull() const;
+
+    //! \brief Returns the number of draw calls issued since the last statistics reset.
+    unsigned GetNumberOfFlushes() const {
+        return _number_of_flushes;
+    }
+
+    //! \brief Returns the number of sprites drawn since the last statistics reset.
+    unsigned GetNumberOfSpritesDrawn() const {
+        return _number_of_sprites_drawn;
+    }
+
+    //! \brief Resets the flush and drawn sprite counters.
+    void ResetStatistics() {
+        _number_of_flushes = 0;
+        _number_of_sprites_drawn = 0;
+    }
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design
+    //! to cause compilation errors when attempting to copy or assign this class.
+    SpriteBatch(const SpriteBatch& sprite_batch);
+    SpriteBatch& operator=(const SpriteBatch& sprite_batch);
+
+    GLuint _vao;
+    GLuint _vertex_buffer;
+    GLuint _index_buffer;
+
+    //! \brief The interleaved vertex data of the pending sprites.
+    std::vector<float> _vertices;
+
+    //! \brief The number of pending sprites.
+    unsigned _number_of_sprites;
+
+    //! \brief The sprite offset where the next flush will write into the vertex buffer.
+    unsigned _buffer_offset;
+
+    //! \brief Statistics: The number of flushes and sprites drawn.
+    unsigned _number_of_flushes;
+    unsigned _number_of_sprites_drawn;
+};
+
+} // namespace gl
+
+} // namespace vt_video
+
+#endif // __GL_SPRITE_BATCH_HEADER__
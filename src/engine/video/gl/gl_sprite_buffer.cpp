@@ -0,0 +1,267 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    gl_sprite_buffer.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for a fixed set of sprites stored on the GPU.
+*** ***************************************************************************/
+
+#include "gl_sprite_buffer.h"
+
+#include "gl_debug.h"
+
+#include "utils/utils_common.h"
+#include "utils/exception.h"
+#include "utils/utils_strings.h"
+
+#include <cassert>
+
+#ifdef __APPLE__
+#   define glBindVertexArray    glBindVertexArrayAPPLE
+#   define glGenVertexArrays    glGenVertexArraysAPPLE
+#   define glGenerateMipmap     glGenerateMipmapEXT
+#   define glDeleteVertexArrays glDeleteVertexArraysAPPLE
+#endif
+
+namespace vt_video
+{
+namespace gl
+{
+
+//
+// Constants.
+//
+
+const unsigned VERTICES_PER_SPRITE = 4;
+const unsigned INDICES_PER_SPRITE = 6;
+const unsigned POSITIONS_PER_VERTEX = 3;
+const unsigned TEXTURE_COORDINATES_PER_VERTEX = 2;
+const unsigned COLORS_PER_VERTEX = 4;
+
+//! \brief Stores the given data into a buffer, and points the attribute index to it.
+//! \return false if the data couldn't be stored.
+static bool SetupAttributeBuffer(GLuint vao, GLuint buffer, GLuint index, GLint size,
+                                 const std::vector<float>& data, GLenum usage)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(float), &data[0], usage);
+
+    GLenum error = glGetError();
+    if (error != GL_NO_ERROR) {
+        PRINT_ERROR << "Failed to store the vertex data. VAO ID: " <<
+                       vt_utils::NumberToString(vao) << " Buffer ID: " <<
+                       vt_utils::NumberToString(buffer) <<
+                       std::endl;
+        assert(error == GL_NO_ERROR);
+        return false;
+    }
+
+    glVertexAttribPointer(index, size, GL_FLOAT, false, 0, nullptr);
+    glEnableVertexAttribArray(index);
+    return true;
+}
+
+SpriteBuffer::SpriteBuffer(const std::vector<float>& vertex_positions,
+                           const std::vector<float>& vertex_texture_coordinates,
+                           const std::vector<float>& vertex_colors) :
+    _vao(0),
+    _vertex_position_buffer(0),
+    _vertex_texture_coordinate_buffer(0),
+    _vertex_color_buffer(0),
+    _index_buffer(0),
+    _number_of_sprites(vertex_positions.size() / (VERTICES_PER_SPRITE * POSITIONS_PER_VERTEX))
+{
+    bool errors = false;
+
+    assert(_number_of_sprites > 0 && _number_of_sprites <= MAX_SPRITES);
+    assert(vertex_texture_coordinates.size() == _number_of_sprites * VERTICES_PER_SPRITE * TEXTURE_COORDINATES_PER_VERTEX);
+    assert(vertex_colors.size() == _number_of_sprites * VERTICES_PER_SPRITE * COLORS_PER_VERTEX);
+
+    // The indices of two triangles per sprite.
+    std::vector<GLushort> indices(_number_of_sprites * INDICES_PER_SPRITE);
+    for (unsigned i = 0; i < _number_of_sprites; ++i) {
+        GLushort first_vertex = static_cast<GLushort>(i * VERTICES_PER_SPRITE);
+
+        // Triangle One.
+        indices[(i * INDICES_PER_SPRITE) + 0] = first_vertex + 0;
+        indices[(i * INDICES_PER_SPRITE) + 1] = first_vertex + 1;
+        indices[(i * INDICES_PER_SPRITE) + 2] = first_vertex + 2;
+
+        // Triangle Two.
+        indices[(i * INDICES_PER_SPRITE) + 3] = first_vertex + 0;
+        indices[(i * INDICES_PER_SPRITE) + 4] = first_vertex + 2;
+        indices[(i * INDICES_PER_SPRITE) + 5] = first_vertex + 3;
+    }
+
+    // Create the vertex array object.
+    if (!errors) {
+        GLuint arrays[1] = { 0 };
+        glGenVertexArrays(1, arrays);
+
+        GLenum error = glGetError();
+        if (error != GL_NO_ERROR) {
+            errors = true;
+            PRINT_ERROR << "Failed to create the vertex array object." << std::endl;
+            assert(error == GL_NO_ERROR);
+        } else {
+            // Store the result.
+            _vao = arrays[0];
+        }
+    }
+
+    // Bind the vertex array object.
+    if (!errors) {
+        glBindVertexArray(_vao);
+    }
+
+    // Create the vertex buffer objects.
+    if (!errors) {
+        GLuint buffers[4] = { 0 };
+        glGenBuffers(4, buffers);
+
+        GLenum error = glGetError();
+        if (error != GL_NO_ERROR) {
+            errors = true;
+            PRINT_ERROR << "Failed to create the vertex array object's position, texture coordinate, color, and index buffers. VAO ID: " <<
+                           vt_utils::NumberToString(_vao) <<
+                           std::endl;
+            assert(error == GL_NO_ERROR);
+        } else {
+            // Store the results.
+            _vertex_position_buffer = buffers[0];
+            _vertex_texture_coordinate_buffer = buffers[1];
+            _vertex_color_buffer = buffers[2];
+            _index_buffer = buffers[3];
+        }
+    }
+
+    // Store the vertex position data into slot 0.
+    if (!errors) {
+        errors = !SetupAttributeBuffer(_vao, _vertex_position_buffer, 0, POSITIONS_PER_VERTEX,
+                                       vertex_positions, GL_STATIC_DRAW);
+    }
+
+    // Store the vertex texture coordinate data into slot 1.
+    // They are updated when animated sprites change their frames.
+    if (!errors) {
+        errors = !SetupAttributeBuffer(_vao, _vertex_texture_coordinate_buffer, 1, TEXTURE_COORDINATES_PER_VERTEX,
+                                       vertex_texture_coordinates, GL_DYNAMIC_DRAW);
+    }
+
+    // Store the vertex color data into slot 2.
+    if (!errors) {
+        errors = !SetupAttributeBuffer(_vao, _vertex_color_buffer, 2, COLORS_PER_VERTEX,
+                                       vertex_colors, GL_STATIC_DRAW);
+    }
+
+    // Bind the index buffer.
+    if (!errors) {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _index_buffer);
+    }
+
+    // Set up the index data.
+    if (!errors) {
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLushort), &indices[0], GL_STATIC_DRAW);
+
+        GLenum error = glGetError();
+        if (error != GL_NO_ERROR) {
+            PRINT_ERROR << "Failed to store the index data. VAO ID: " <<
+                           vt_utils::NumberToString(_vao) << " Buffer ID: " <<
+                           vt_utils::NumberToString(_index_buffer) <<
+                           std::endl;
+            assert(error == GL_NO_ERROR);
+        }
+    }
+
+    // Unbind the vertex array object from the pipeline.
+    glBindVertexArray(0);
+
+    // Unbind the active buffers from the pipeline.
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+SpriteBuffer::~SpriteBuffer()
+{
+    if (_vao != 0) {
+        const GLuint arrays[] = { _vao };
+        glDeleteVertexArrays(1, arrays);
+        _vao = 0;
+    }
+
+    const GLuint buffers[] = {
+        _vertex_position_buffer,
+        _vertex_texture_coordinate_buffer,
+        _vertex_color_buffer,
+        _index_buffer
+    };
+    glDeleteBuffers(4, buffers);
+
+    _vertex_position_buffer = 0;
+    _vertex_texture_coordinate_buffer = 0;
+    _vertex_color_buffer = 0;
+    _index_buffer = 0;
+}
+
+void SpriteBuffer::UpdateTextureCoordinates(const std::vector<float>& vertex_texture_coordinates)
+{
+    assert(vertex_texture_coordinates.size() == _number_of_sprites * VERTICES_PER_SPRITE * TEXTURE_COORDINATES_PER_VERTEX);
+
+    // Bind the vertex texture coordinate buffer.
+    glBindBuffer(GL_ARRAY_BUFFER, _vertex_texture_coordinate_buffer);
+
+    // Update the vertex texture coordinate data.
+    glBufferSubData(GL_ARRAY_BUFFER, 0, vertex_texture_coordinates.size() * sizeof(float), &vertex_texture_coordinates[0]);
+
+    GLenum error = GetDebugError();
+    if (error != GL_NO_ERROR) {
+        PRINT_ERROR << "Failed to update the vertex texture coordinate data. VAO ID: " <<
+                       vt_utils::NumberToString(_vao) << " Buffer ID: " <<
+                       vt_utils::NumberToString(_vertex_texture_coordinate_buffer) <<
+                       std::endl;
+        assert(error == GL_NO_ERROR);
+    }
+
+    // Unbind the buffer from the pipeline.
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void SpriteBuffer::Draw(unsigned first_sprite, unsigned number_of_sprites) const
+{
+    assert(first_sprite + number_of_sprites <= _number_of_sprites);
+    if (number_of_sprites == 0)
+        return;
+
+    // Bind the vertex array object.
+    glBindVertexArray(_vao);
+
+    // Draw the sprites.
+    size_t index_offset = first_sprite * INDICES_PER_SPRITE * sizeof(GLushort);
+    glDrawElements(GL_TRIANGLES, number_of_sprites * INDICES_PER_SPRITE, GL_UNSIGNED_SHORT,
+                   reinterpret_cast<const GLvoid*>(index_offset));
+
+    // Unbind the vertex array object from the pipeline.
+    glBindVertexArray(0);
+}
+
+SpriteBuffer::SpriteBuffer(const SpriteBuffer&)
+{
+    throw vt_utils::Exception("Not Implemented!", __FILE__, __LINE__, __FUNCTION__);
+}
+
+SpriteBuffer& SpriteBuffer::operator=(const SpriteBuffer&)
+{
+    throw vt_utils::Exception("Not Implemented!", __FILE__, __LINE__, __FUNCTION__);
+    return *this;
+}
+
+} // namespace gl
+
+} // namespace vt_video
@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    gl_sprite_buffer.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for a fixed set of sprites stored on the GPU.
+***
+*** Unlike the sprite batch, the vertex positions and colors are uploaded once.
+*** Only the texture coordinates can be updated afterwards, e.g.: to animate
+*** some of the sprites.
+*** ***************************************************************************/
+
+#ifndef __GL_SPRITE_BUFFER_HEADER__
+#define __GL_SPRITE_BUFFER_HEADER__
+
+#include "utils/gl_include.h"
+
+#include <vector>
+
+namespace vt_video
+{
+namespace gl
+{
+
+//! \brief A class for drawing a fixed set of sprites stored in vertex buffers.
+class SpriteBuffer
+{
+public:
+    /** \param vertex_positions The 4 vertex positions (x, y, z) of each sprite.
+    *** \param vertex_texture_coordinates The 4 vertex texture coordinates (u, v) of each sprite.
+    *** \param vertex_colors The 4 vertex colors (r, g, b, a) of each sprite.
+    **/
+    SpriteBuffer(const std::vector<float>& vertex_positions,
+                 const std::vector<float>& vertex_texture_coordinates,
+                 const std::vector<float>& vertex_colors);
+    ~SpriteBuffer();
+
+    //! \brief Replaces the texture coordinates of all the sprites.
+    void UpdateTextureCoordinates(const std::vector<float>& vertex_texture_coordinates);
+
+    //! \brief Draws a range of sprites.
+    void Draw(unsigned first_sprite, unsigned number_of_sprites) const;
+
+    //! \brief Returns the number of sprites stored.
+    unsigned GetNumberOfSprites() const {
+        return _number_of_sprites;
+    }
+
+    //! \brief The maximum number of sprites a buffer can store.
+    static const unsigned MAX_SPRITES = 16384;
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design
+    //! to cause compilation errors when attempting to copy or assign this class.
+    SpriteBuffer(const SpriteBuffer& sprite_buffer);
+    SpriteBuffer& operator=(const SpriteBuffer& sprite_buffer);
+
+    GLuint _vao;
+    GLuint _vertex_position_buffer;
+    GLuint _vertex_texture_coordinate_buffer;
+    GLuint _vertex_color_buffer;
+    GLuint _index_buffer;
+
+    unsigned _number_of_sprites;
+};
+
+} // namespace gl
+
+} // namespace vt_video
+
+#endif // __GL_SPRITE_BUFFER_HEADER__
@@ -143,6 +143,14 @@ void Transform::Apply(float* buffer) const
     memcpy(buffer, _row3, sizeof(_row3));
 }
 
+bool Transform::operator==(const Transform& transform) const
+{
+    return memcmp(_row0, transform._row0, sizeof(_row0)) == 0 &&
+           memcmp(_row1, transform._row1, sizeof(_row1)) == 0 &&
+           memcmp(_row2, transform._row2, sizeof(_row2)) == 0 &&
+           memcmp(_row3, transform._row3, sizeof(_row3)) == 0;
+}
+
 void Transform::_Multiply(const Transform& transform)
 {
     // Allocate space for the result.
@@ -59,6 +59,12 @@ public:
     //! \brief Applies the transform to the buffer.  The buffer must have at least 16 elements!
     void Apply(float* buffer) const;
 
+    //! \brief Comparison operators.
+    bool operator==(const Transform& transform) const;
+    bool operator!=(const Transform& transform) const {
+        return !(*this == transform);
+    }
+
 private:
     //! \brief A helper function to multiply transforms.
     void _Multiply(const Transform& transform);
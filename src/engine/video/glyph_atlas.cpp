@@ -0,0 +1,238 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    glyph_atlas.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the font glyph atlases
+***
+*** \note Normally the int data type should not be used in the game code,
+*** however it is used in this file as the SDL_ttf library requests integer
+*** arguments.
+*** ***************************************************************************/
+
+#include "glyph_atlas.h"
+
+#include "texture_controller.h"
+#include "video.h"
+
+#include "utils/utils_common.h"
+
+#include <algorithm>
+
+#ifdef __APPLE__
+#   include <SDL_ttf.h>
+#else
+#   include <SDL2/SDL_ttf.h>
+#endif
+
+namespace vt_video
+{
+
+namespace private_video
+{
+
+GlyphAtlas::GlyphAtlas(TTF_Font* ttf_font) :
+    _ttf_font(ttf_font),
+    _use_kerning(TTF_GetFontKerning(ttf_font) != 0)
+{
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+    for (uint32_t i = 0; i < _sheets.size(); ++i)
+        TextureManager->_RemoveSheet(_sheets[i]);
+
+    for (std::map<uint16_t, Glyph*>::iterator it = _glyphs.begin(); it != _glyphs.end(); ++it)
+        delete it->second;
+
+    TTF_CloseFont(_ttf_font);
+}
+
+void GlyphAtlas::LayoutText(const uint16_t* text, size_t length, TextLine& line)
+{
+    line.glyphs.clear();
+    line.width = _LayoutText(text, length, &line.glyphs);
+}
+
+int32_t GlyphAtlas::_LayoutText(const uint16_t* text, size_t length, std::vector<GlyphQuad>* glyphs)
+{
+    // This follows the way TTF_SizeUNICODE() measures a string,
+    // so that both the text width and look remain unchanged.
+    int32_t pen_x = 0;
+    int32_t min_x = 0;
+    int32_t max_x = 0;
+
+    for (size_t i = 0; i < length; ++i) {
+        const Glyph* glyph = _GetGlyph(text[i]);
+
+        if (i > 0)
+            pen_x += _GetKerning(text[i - 1], text[i]);
+
+        min_x = std::min(min_x, pen_x + glyph->min_x);
+        max_x = std::max(max_x, pen_x + std::max(glyph->advance, glyph->max_x));
+
+        if (glyphs != nullptr && glyph->texture_sheet != nullptr) {
+            GlyphQuad quad;
+            quad.glyph = glyph;
+            quad.x = pen_x;
+            glyphs->push_back(quad);
+        }
+
+        pen_x += glyph->advance;
+    }
+
+    // Glyphs starting before the pen, like an italic 'j', shift the whole line to the right.
+    if (glyphs != nullptr && min_x < 0) {
+        for (uint32_t i = 0; i < glyphs->size(); ++i)
+            (*glyphs)[i].x -= min_x;
+    }
+
+    return max_x - min_x;
+}
+
+const Glyph* GlyphAtlas::_GetGlyph(uint16_t character)
+{
+    std::map<uint16_t, Glyph*>::iterator it = _glyphs.find(character);
+    if (it != _glyphs.end())
+        return it->second;
+
+    // Glyphs failing to render are kept as well, so that it is only attempted once.
+    Glyph* glyph = new Glyph();
+    _RenderGlyph(character, glyph);
+    _glyphs[character] = glyph;
+    return glyph;
+}
+
+int32_t GlyphAtlas::_GetKerning(uint16_t previous_character, uint16_t character)
+{
+    if (!_use_kerning)
+        return 0;
+
+    uint32_t key = (static_cast<uint32_t>(previous_character) << 16) | character;
+    std::map<uint32_t, int32_t>::iterator it = _kernings.find(key);
+    if (it != _kernings.end())
+        return it->second;
+
+#if SDL_VERSIONNUM(SDL_TTF_MAJOR_VERSION, SDL_TTF_MINOR_VERSION, SDL_TTF_PATCHLEVEL) >= SDL_VERSIONNUM(2, 0, 14)
+    int32_t kerning = TTF_GetFontKerningSizeGlyphs(_ttf_font, previous_character, character);
+#else
+    // TTF_GlyphIsProvided() returns the glyph index in the font.
+    int32_t kerning = TTF_GetFontKerningSize(_ttf_font,
+                                             TTF_GlyphIsProvided(_ttf_font, previous_character),
+                                             TTF_GlyphIsProvided(_ttf_font, character));
+#endif
+
+    _kernings[key] = kerning;
+    return kerning;
+}
+
+void GlyphAtlas::_RenderGlyph(uint16_t character, Glyph* glyph)
+{
+    int min_x = 0;
+    int max_x = 0;
+    int min_y = 0;
+    int max_y = 0;
+    int advance = 0;
+    if (TTF_GlyphMetrics(_ttf_font, character, &min_x, &max_x, &min_y, &max_y, &advance) != 0) {
+        IF_PRINT_WARNING(VIDEO_DEBUG) << "call to TTF_GlyphMetrics() failed for character: "
+                                      << character << std::endl;
+        return;
+    }
+
+    glyph->min_x = min_x;
+    glyph->max_x = max_x;
+    glyph->advance = advance;
+
+    // The glyph is rendered as a one character string, so that it is placed on the line
+    // exactly like within any other string: the pen starts after any part of the glyph
+    // drawn on its left, and the surface is as high as the font.
+    const uint16_t text[] = { character, 0 };
+    const SDL_Color white = { 255, 255, 255, 255 };
+    SDL_Surface* surface = TTF_RenderUNICODE_Blended(_ttf_font, text, white);
+    if (surface == nullptr) {
+        // Zero width glyphs can't be rendered.
+        return;
+    }
+
+    SDL_LockSurface(surface);
+
+    // Only the visible pixels are kept in the texture sheet.
+    int32_t left = surface->w;
+    int32_t right = -1;
+    int32_t top = surface->h;
+    int32_t bottom = -1;
+    for (int32_t y = 0; y < surface->h; ++y) {
+        const Uint32* row = reinterpret_cast<const Uint32*>(static_cast<const uint8_t*>(surface->pixels) + y * surface->pitch);
+        for (int32_t x = 0; x < surface->w; ++x) {
+            if ((row[x] & surface->format->Amask) == 0)
+                continue;
+
+            left = std::min(left, x);
+            right = std::max(right, x);
+            top = std::min(top, y);
+            bottom = std::max(bottom, y);
+        }
+    }
+
+    SDL_UnlockSurface(surface);
+
+    // Blank glyphs, like spaces, only move the pen.
+    if (right < 0) {
+        SDL_FreeSurface(surface);
+        return;
+    }
+
+    ImageMemory surface_pixels(surface);
+    SDL_FreeSurface(surface);
+
+    ImageMemory glyph_pixels;
+    glyph_pixels.Resize(right - left + 1, bottom - top + 1, false);
+    glyph_pixels.CopyFrom(surface_pixels, top * surface_pixels.GetWidth() + left);
+
+    glyph->width = glyph_pixels.GetWidth();
+    glyph->height = glyph_pixels.GetHeight();
+    glyph->offset_x = left + std::min(min_x, 0);
+    glyph->offset_y = top;
+    glyph->smooth = true;
+
+    for (uint32_t i = 0; i < _sheets.size(); ++i) {
+        if (_sheets[i]->AddTexture(glyph, glyph_pixels))
+            return;
+    }
+
+    TexSheet* sheet = TextureManager->_CreateTexSheet(GLYPH_SHEET_SIZE, GLYPH_SHEET_SIZE, VIDEO_TEXSHEET_GLYPHS, true);
+    if (sheet == nullptr) {
+        IF_PRINT_WARNING(VIDEO_DEBUG) << "failed to create a new glyph texture sheet" << std::endl;
+        return;
+    }
+    sheet->Smooth(true);
+    _sheets.push_back(sheet);
+
+    if (!sheet->AddTexture(glyph, glyph_pixels)) {
+        IF_PRINT_WARNING(VIDEO_DEBUG) << "failed to add the glyph to a new glyph texture sheet, for character: "
+                                      << character << std::endl;
+        glyph->texture_sheet = nullptr;
+    }
+}
+
+GlyphAtlas::GlyphAtlas(const GlyphAtlas&)
+{
+    throw vt_utils::Exception("Not Implemented!", __FILE__, __LINE__, __FUNCTION__);
+}
+
+GlyphAtlas& GlyphAtlas::operator=(const GlyphAtlas&)
+{
+    throw vt_utils::Exception("Not Implemented!", __FILE__, __LINE__, __FUNCTION__);
+    return *this;
+}
+
+} // namespace private_video
+
+} // namespace vt_video
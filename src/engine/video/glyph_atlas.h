@@ -0,0 +1,159 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    glyph_atlas.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the font glyph atlases
+***
+*** Each font glyph is rendered by SDL_ttf only once, the first time it is used,
+*** and stored in texture sheets dedicated to the glyphs. Text is then laid out
+*** using the cached glyph metrics, and drawn as one textured quad per glyph.
+*** Changing a text thus neither renders nor uploads anything.
+*** ***************************************************************************/
+
+#ifndef __GLYPH_ATLAS_HEADER__
+#define __GLYPH_ATLAS_HEADER__
+
+#include "image_base.h"
+
+#include <map>
+#include <vector>
+
+typedef struct _TTF_Font TTF_Font;
+
+namespace vt_video
+{
+
+namespace private_video
+{
+
+//! \brief The width and height of the glyph texture sheets.
+const int32_t GLYPH_SHEET_SIZE = 512;
+
+/** ****************************************************************************
+*** \brief A font glyph, stored in a glyph texture sheet.
+***
+*** Glyphs without any visible pixel, like spaces, have no texture sheet.
+*** ***************************************************************************/
+class Glyph : public BaseTexture
+{
+public:
+    Glyph() :
+        offset_x(0),
+        offset_y(0),
+        min_x(0),
+        max_x(0),
+        advance(0)
+    {}
+
+    //! \brief The position of the glyph pixels relative to the pen position, on the top of the line.
+    int32_t offset_x, offset_y;
+
+    //! \brief The horizontal glyph metrics, as given by SDL_ttf.
+    int32_t min_x, max_x;
+
+    //! \brief The distance the pen moves after drawing the glyph.
+    int32_t advance;
+};
+
+//! \brief A visible glyph placed on a line of text.
+struct GlyphQuad {
+    const Glyph* glyph;
+
+    //! \brief The pen position, relative to the line left.
+    int32_t x;
+};
+
+//! \brief A line of text laid out using a glyph atlas.
+struct TextLine {
+    TextLine():
+        width(0)
+    {}
+
+    std::vector<GlyphQuad> glyphs;
+
+    //! \brief The line width, as SDL_ttf would have rendered it.
+    int32_t width;
+};
+
+/** ****************************************************************************
+*** \brief The glyphs of a font, cached along with their metrics.
+***
+*** The atlas owns its SDL_ttf font and is kept until the text supervisor is
+*** destroyed, so that the glyphs used by already laid out texts remain valid.
+*** ***************************************************************************/
+class GlyphAtlas
+{
+public:
+    //! \param ttf_font The font, now owned by the atlas.
+    explicit GlyphAtlas(TTF_Font* ttf_font);
+
+    ~GlyphAtlas();
+
+    TTF_Font* GetTTFFont() const {
+        return _ttf_font;
+    }
+
+    /** \brief Lays out a single line of unicode text.
+    *** \param text The characters of the line, without any new line.
+    *** \param length The number of characters.
+    *** \param line The line receiving the visible glyphs and the width.
+    ***
+    *** The glyphs are placed the way SDL_ttf places them when rendering a whole string.
+    **/
+    void LayoutText(const uint16_t* text, size_t length, TextLine& line);
+
+    /** \brief Calculates the width of a single line of unicode text.
+    *** \return The width, identical to the one of the laid out text.
+    **/
+    int32_t CalculateTextWidth(const uint16_t* text, size_t length) {
+        return _LayoutText(text, length, nullptr);
+    }
+
+private:
+    //! \brief The font glyphs are rendered from.
+    TTF_Font* _ttf_font;
+
+    //! \brief Tells whether the font applies kerning between glyphs.
+    bool _use_kerning;
+
+    //! \brief The glyphs already rendered, using the character as key.
+    std::map<uint16_t, Glyph*> _glyphs;
+
+    //! \brief The kerning already queried, using (previous character << 16 | character) as key.
+    std::map<uint32_t, int32_t> _kernings;
+
+    //! \brief The texture sheets containing the glyphs pixels.
+    std::vector<TexSheet*> _sheets;
+
+    /** \brief Lays out or measures a line of text.
+    *** \param glyphs Receives the visible glyphs, if not nullptr.
+    *** \return The line width.
+    **/
+    int32_t _LayoutText(const uint16_t* text, size_t length, std::vector<GlyphQuad>* glyphs);
+
+    //! \brief Returns the given glyph, rendering it on first use.
+    const Glyph* _GetGlyph(uint16_t character);
+
+    //! \brief Returns the kerning offset to apply between two characters.
+    int32_t _GetKerning(uint16_t previous_character, uint16_t character);
+
+    //! \brief Renders a glyph and copies its visible pixels into a glyph texture sheet.
+    void _RenderGlyph(uint16_t character, Glyph* glyph);
+
+    GlyphAtlas(const GlyphAtlas& copy);
+    GlyphAtlas& operator=(const GlyphAtlas& copy);
+}; // class GlyphAtlas
+
+} // namespace private_video
+
+} // namespace vt_video
+
+#endif // __GLYPH_ATLAS_HEADER__
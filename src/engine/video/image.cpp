@@ -59,15 +59,6 @@ ImageDescriptor::ImageDescriptor() :
 
 ImageDescriptor::~ImageDescriptor()
 {
-    // The destructor for the inherited class should have disabled grayscale mode
-    // If it didn't, the grayscale image might not have been properly dereferenced
-    // and/or removed from texture memory
-    if(_grayscale) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "grayscale mode was still enabled when destructor was invoked "
-                                      << "-- possible memory leak" << std::endl;
-    }
-
-    // Remove the reference to the original, colored texture
     if(_texture != nullptr)
         _RemoveTextureReference();
 
@@ -142,12 +133,6 @@ ImageDescriptor &ImageDescriptor::operator=(const ImageDescriptor &copy)
 
 void ImageDescriptor::Clear()
 {
-    // This will also remove a reference to the grayscale version of the image
-    // FIXME: This is triggering a crash when several images using the same file
-    // are in different states.
-    //if (_grayscale)
-    //    _DisableGrayscale();
-
     if(_texture != nullptr)
         _RemoveTextureReference();
 
@@ -435,6 +420,15 @@ bool ImageDescriptor::SaveMultiImage(const std::vector<StillImage *>& images,
     return success;
 }
 
+void ImageDescriptor::PrefetchImage(const std::string &filename)
+{
+    // An already loaded image file won't be read again.
+    if(TextureManager->_IsImageTextureRegistered(filename))
+        return;
+
+    TextureManager->_image_loader.Prefetch(filename);
+}
+
 void ImageDescriptor::DEBUG_PrintInfo()
 {
     PRINT_WARNING << "__ImageDescriptor Properties__" << std::endl;
@@ -563,13 +557,13 @@ void ImageDescriptor::_DrawTexture(const Color* draw_color) const
     if (VideoManager->_current_context.blend) {
         VideoManager->EnableBlending();
         if (VideoManager->_current_context.blend == 1) {
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); // Normal blending
+            VideoManager->SetBlendFunction(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); // Normal blending
         } else {
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE); // Additive blending
+            VideoManager->SetBlendFunction(GL_SRC_ALPHA, GL_ONE); // Additive blending
         }
     } else if (_blend) {
         VideoManager->EnableBlending();
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); // Normal blending
+        VideoManager->SetBlendFunction(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); // Normal blending
     } else {
         VideoManager->DisableBlending();
     }
@@ -622,8 +616,9 @@ void ImageDescriptor::_DrawTexture(const Color* draw_color) const
         TextureManager->_BindTexture(_texture->texture_sheet->tex_id);
         _texture->texture_sheet->Smooth(_smooth);
 
-        // Load the sprite shader program.
-        shader_program = VideoManager->LoadShaderProgram(gl::shader_programs::Sprite);
+        // Load the sprite shader program, converting the texels to grayscale when needed.
+        shader_program = VideoManager->LoadShaderProgram(_grayscale ? gl::shader_programs::SpriteGrayscale
+                                                                    : gl::shader_programs::Sprite);
         assert(shader_program != nullptr);
     } else {
         //
@@ -634,7 +629,8 @@ void ImageDescriptor::_DrawTexture(const Color* draw_color) const
         VideoManager->DisableTexture2D();
 
         // Load the solid shader program.
-        shader_program = VideoManager->LoadShaderProgram(gl::shader_programs::Solid);
+        shader_program = VideoManager->LoadShaderProgram(_grayscale ? gl::shader_programs::SolidGrayscale
+                                                                    : gl::shader_programs::Solid);
         assert(shader_program != nullptr);
     }
 
@@ -655,19 +651,14 @@ void ImageDescriptor::_DrawTexture(const Color* draw_color) const
             vertex_colors[(i * 4) + 3] = color[3];
         }
 
-        // Unload the shader program.
-        VideoManager->UnloadShaderProgram();
-
         // Load the solid shader program.
-        shader_program = VideoManager->LoadShaderProgram(gl::shader_programs::Solid);
+        shader_program = VideoManager->LoadShaderProgram(_grayscale ? gl::shader_programs::SolidGrayscale
+                                                                    : gl::shader_programs::Solid);
         assert(shader_program != nullptr);
 
         // Draw the image.
         VideoManager->DrawSprite(shader_program, vertex_positions, vertex_texture_coordinates, vertex_colors);
     }
-
-    // Unload the shader program.
-    VideoManager->UnloadShaderProgram();
 }
 
 bool ImageDescriptor::_LoadMultiImage(std::vector<StillImage>& images, const std::string &filename,
@@ -705,8 +696,14 @@ bool ImageDescriptor::_LoadMultiImage(std::vector<StillImage>& images, const std
     // from disk and create enough memory to copy over individual sub-image elements from it
     ImageMemory multi_image;
     ImageMemory sub_image;
-    if(need_load) {
-        if(multi_image.LoadImage(filename) == false) {
+    bool prefetched = false;
+    if(!need_load) {
+        // The file won't be needed if it was prefetched.
+        TextureManager->_image_loader.Discard(filename);
+    }
+    else {
+        prefetched = TextureManager->_image_loader.TakeImage(filename, multi_image);
+        if(!prefetched && multi_image.LoadImage(filename) == false) {
             IF_PRINT_WARNING(VIDEO_DEBUG) << "Failed to load multi image file: " << filename << std::endl;
             return false;
         }
@@ -756,7 +753,9 @@ bool ImageDescriptor::_LoadMultiImage(std::vector<StillImage>& images, const std
                 img = new ImageTexture(filename, tags[current_image], sub_image.GetWidth(), sub_image.GetHeight());
 
                 // Try to insert the image in a texture sheet
-                TexSheet *sheet = TextureManager->_InsertImageInTexSheet(img, sub_image, images.at(current_image)._is_static);
+                TexSheet *sheet = TextureManager->_InsertImageTextureInTexSheet(img, sub_image,
+                                                                                images.at(current_image)._is_static,
+                                                                                prefetched);
 
                 if(sheet == nullptr) {
                     IF_PRINT_WARNING(VIDEO_DEBUG) << "Call to TextureController::_InsertImageInTexSheet failed -- " <<
@@ -771,14 +770,6 @@ bool ImageDescriptor::_LoadMultiImage(std::vector<StillImage>& images, const std
 
             img->AddReference();
 
-            // Finally, do a grayscale conversion for the image if grayscale mode is enabled
-            if(images.at(current_image)._grayscale) {
-                // Set _grayscale to false so that the call doesn't think that the grayscale image is already loaded
-                // It will be set back to true by the _EnableGrayscale call
-                images.at(current_image)._grayscale = false;
-                images.at(current_image)._EnableGrayscale();
-            }
-
             current_image++;
         } // for (y = 0; y < grid_cols; y++)
     } // for (x = 0; x < grid_rows; x++)
@@ -851,23 +842,27 @@ bool StillImage::Load(const std::string &filename)
             _height = static_cast<float>(_image_texture->height);
 
         _texture->AddReference();
+
+        // The file won't be needed if it was prefetched.
+        TextureManager->_image_loader.Discard(_filename);
         return true;
     }
 
-    // 2. The image file needs to be loaded from disk
+    // 2. The image file needs to be loaded from disk, unless it was prefetched.
+    // In that case, the pixels are copied into texture memory over the next frames.
     ImageMemory img_data;
-    if(img_data.LoadImage(_filename) == false) {
+    bool prefetched = TextureManager->_image_loader.TakeImage(_filename, img_data);
+    if(!prefetched && img_data.LoadImage(_filename) == false) {
         IF_PRINT_WARNING(VIDEO_DEBUG) << "call to ImageMemory::LoadImage() failed for file: " << _filename << std::endl;
         return false;
     }
 
-    // Create a new texture image and store it in a texture sheet. If the _grayscale member of this class is true,
-    // we first load the color copy of the image to a texture sheet. Then we'll convert the image data to grayscale
-    // and save that image data to texture memory as well
+    // Create a new texture image and store it in a texture sheet.
+    // Grayscale images use the same texture, and are converted when drawn.
     _image_texture = new ImageTexture(_filename, "", img_data.GetWidth(), img_data.GetHeight());
     _texture = _image_texture;
 
-    if(TextureManager->_InsertImageInTexSheet(_image_texture, img_data, _is_static) == nullptr) {
+    if(TextureManager->_InsertImageTextureInTexSheet(_image_texture, img_data, _is_static, prefetched) == nullptr) {
         IF_PRINT_WARNING(VIDEO_DEBUG) << "call to TextureController::_InsertImageInTexSheet() failed for file: " << _filename << std::endl;
         delete _image_texture;
         _image_texture = nullptr;
@@ -884,28 +879,6 @@ bool StillImage::Load(const std::string &filename)
     if(IsFloatEqual(_height, 0.0f))
         _height = static_cast<float>(img_data.GetHeight());
 
-    // If we don't need to create a grayscale version, we finished successfully
-    if(_grayscale == false) {
-        return true;
-    }
-
-    // 3. If we reached this point, we must now create a grayscale version of this image
-    img_data.ConvertToGrayscale();
-    ImageTexture *gray_image = new ImageTexture(_filename, "<G>", img_data.GetWidth(), img_data.GetHeight());
-    if(TextureManager->_InsertImageInTexSheet(gray_image, img_data, _is_static) == nullptr) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "call to TextureController::_InsertImageInTexSheet() failed for file: " << _filename << std::endl;
-
-        TextureManager->_UnregisterImageTexture(gray_image);
-        delete gray_image;
-        _RemoveTextureReference(); // sets _texture to nullptr
-        _image_texture = nullptr;
-        return false;
-    }
-
-    _image_texture = gray_image;
-    _texture = _image_texture;
-    _image_texture->AddReference();
-
     return true;
 }
 
@@ -915,6 +888,10 @@ void StillImage::Draw(const Color &draw_color) const
     if (IsFloatEqual(draw_color[3], 0.0f))
         return;
 
+    // Nor when its pixels aren't in texture memory yet.
+    if (IsPending())
+        return;
+
     VideoManager->PushMatrix();
 
     if (_offset.x != 0.0f || _offset.y != 0.0f)
@@ -967,72 +944,14 @@ bool StillImage::Save(const std::string &filename) const
     return buffer.SaveImage(filename);
 }
 
-void StillImage::_EnableGrayscale()
+bool StillImage::IsPending() const
 {
-    if(_grayscale)
-        return;
-
-    _grayscale = true;
-
-    // If no image texture is available we are done here (when Load() is next called, grayscale will automatically be enabled)
-    if(_image_texture == nullptr)
-        return;
-
-    // Check if a grayscale version of this image already exists in texture memory and if so, update the ImageTexture pointer and reference
-    std::string search_key = _filename + _image_texture->tags + "<G>";
-    std::string tags = _image_texture->tags;
-    ImageTexture *temp_texture = _image_texture;
-    if((_image_texture = TextureManager->_GetImageTexture(search_key)) != nullptr) {
-        // NOTE: We do not decrement the reference to the colored image, because we want to guarantee that
-        // it remains referenced in texture memory while its grayscale counterpart is being used
-        _texture = _image_texture;
-        _image_texture->AddReference();
-        return;
-    }
-
-    // If no grayscale version exists, create a copy of the image, convert it to grayscale, and add the gray copy to texture memory
-    ImageMemory gray_img;
-    gray_img.CopyFromImage(temp_texture);
-    gray_img.ConvertToGrayscale();
-
-    ImageTexture* new_img = new ImageTexture(_filename, tags + "<G>", gray_img.GetWidth(), gray_img.GetHeight());
-
-    if(TextureManager->_InsertImageInTexSheet(new_img, gray_img, _is_static) == nullptr) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "failed to insert new grayscale image into texture sheet" << std::endl;
-        delete new_img;
-
-        return;
-    }
-
-    _image_texture = new_img;
-    _texture = _image_texture;
-    _image_texture->AddReference();
+    return _image_texture != nullptr && _image_texture->pending;
 }
 
-void StillImage::_DisableGrayscale()
+void StillImage::WaitForPixels()
 {
-    if(_grayscale == false)
-        return;
-
-    _grayscale = false;
-
-    // If no image data is loaded, we're finished
-    if(_image_texture == nullptr)
-        return;
-
-    std::string search_key = _image_texture->filename + _image_texture->tags.substr(0, _image_texture->tags.length() - 3);
-    if((_image_texture = TextureManager->_GetImageTexture(search_key)) == nullptr) {
-        PRINT_WARNING << "non-grayscale version of image was not found in texture memory: "
-                      << GetFilename() << std::endl;
-        return;
-    }
-
-    // Remove the reference to the grayscale version and grab the reference to the original color image
-    _RemoveTextureReference();
-
-    // No reference change is needed for the color image, since the color texture did not have a reference
-    // decrement when the grayscale version was enabled
-    _texture = _image_texture;
+    TextureManager->_FinishPendingUpload(_image_texture);
 }
 
 void StillImage::SetWidthKeepRatio(float width)
@@ -1195,7 +1114,6 @@ bool AnimatedImage::LoadFromFrameSize(const std::string &filename, const std::ve
                                       const uint32_t frame_width, const uint32_t frame_height, const uint32_t trim)
 {
     // Make the multi image call
-    // TODO: Handle the case where the _grayscale member is true so all frames are loaded in grayscale format
     std::vector<StillImage> image_frames;
     if(ImageDescriptor::LoadMultiImageFromElementSize(image_frames, filename, frame_width, frame_height) == false) {
         return false;
@@ -1243,7 +1161,6 @@ bool AnimatedImage::LoadFromFrameGrid(const std::string &filename, const std::ve
     ResetAnimation();
 
     // Make the multi image call
-    // TODO: Handle the case where the _grayscale member is true so all frames are loaded in grayscale format
     std::vector<StillImage> image_frames;
     if(ImageDescriptor::LoadMultiImageFromElementGrid(image_frames, filename, frame_rows, frame_cols) == false) {
         return false;
@@ -1388,6 +1305,7 @@ bool AnimatedImage::AddFrame(const std::string &frame, uint32_t frame_time)
     AnimationFrame new_frame;
     new_frame.frame_time = frame_time;
     new_frame.image = img;
+    new_frame.image.SetGrayscale(_grayscale);
     _frames.push_back(new_frame);
     _animation_time += frame_time;
     return true;
@@ -1402,6 +1320,7 @@ bool AnimatedImage::AddFrame(const StillImage &frame, uint32_t frame_time)
 
     AnimationFrame new_frame;
     new_frame.image = frame;
+    new_frame.image.SetGrayscale(_grayscale);
     new_frame.frame_time = frame_time;
 
     _frames.push_back(new_frame);
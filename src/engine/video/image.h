@@ -252,6 +252,15 @@ public:
     **/
     static bool SaveMultiImage(const std::vector<StillImage *>& images, const std::string &filename,
                                const uint32_t grid_rows, const uint32_t grid_cols);
+
+    /** \brief Starts decoding an image file in the background
+    *** \param filename The name of the image or multi image file that will be loaded soon
+    ***
+    *** Images loaded from a prefetched file don't decode it again, and their pixels are copied
+    *** into texture memory over the next frames: they stay pending until then.
+    *** \note Prefetching a file which is never loaded keeps its decoded pixels in memory.
+    **/
+    static void PrefetchImage(const std::string &filename);
     //@}
 
     //! \brief A debug function which prints the image's information to the screen
@@ -349,6 +358,7 @@ class StillImage : public ImageDescriptor
     friend class ImageDescriptor;
     friend class AnimatedImage;
     friend class CompositeImage;
+    friend class StaticImageBatch;
     friend class TextureController;
     friend class vt_mode_manager::ParticleSystem;
 
@@ -391,6 +401,14 @@ public:
     **/
     bool Save(const std::string &filename) const;
 
+    /** \brief Tells whether the image pixels are still waiting to be copied into texture memory
+    *** A pending image is not drawn. Callers may draw a placeholder instead, or call WaitForPixels().
+    **/
+    bool IsPending() const;
+
+    //! \brief Copies the pixels of a pending image into texture memory right away
+    void WaitForPixels();
+
     //! \name Class Member Access Functions
     //@{
     //! \brief Returns the filename string for the image
@@ -490,11 +508,15 @@ protected:
     //! \brief X and y draw position offsets of this element
     vt_common::Position2D _offset;
 
-    //! \brief Enables grayscaling for the image then reloads it
-    void _EnableGrayscale() override;
+    //! \brief Enables grayscaling for the image, done by the shader program when drawing
+    void _EnableGrayscale() override {
+        _grayscale = true;
+    }
 
-    //! \brief Disables grayscaling for the image then reloads it
-    void _DisableGrayscale() override;
+    //! \brief Disables grayscaling for the image
+    void _DisableGrayscale() override {
+        _grayscale = false;
+    }
 };
 
 namespace private_video
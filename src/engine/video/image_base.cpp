@@ -282,57 +282,6 @@ bool ImageMemory::SaveImage(const std::string& filename)
     return true;
 }
 
-void ImageMemory::ConvertToGrayscale()
-{
-    if (_pixels.empty()) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "No image data (_pixels is empty)"
-                                      << std::endl;
-        return;
-    }
-
-    assert(_width > 0);
-    assert(_height > 0);
-
-    uint8_t bytes_per_pixel = GetBytesPerPixel();
-
-    assert(_pixels.size() > bytes_per_pixel);
-
-    // We are going to increment through the loop by 'bytes_per_pixel'.
-    // So, the size of the array must be divisible by 'bytes_per_pixel'.
-    assert(_pixels.size() % bytes_per_pixel == 0);
-    if (_pixels.size() % bytes_per_pixel == 0) {
-
-        auto current_pixel = _pixels.begin();
-        auto end_pixel = _pixels.end();
-
-        while (current_pixel != end_pixel) {
-
-            //
-            // Calculate the grayscale value for this pixel based on RGB values: 0.30R + 0.59G + 0.11B.
-            //
-
-            uint8_t red   = *(current_pixel + 0);
-            uint8_t green = *(current_pixel + 1);
-            uint8_t blue  = *(current_pixel + 2);
-
-            // Compute the sum.
-            uint32_t sum = (30 * red) + (59 * green) + (11 * blue);
-
-            // Scale the sum.
-            uint8_t value = static_cast<uint8_t>(sum * 0.01f);
-
-            // Store the result.
-            *(current_pixel + 0) = value;
-            *(current_pixel + 1) = value;
-            *(current_pixel + 2) = value;
-            // *(current_pixel + 3) for RGBA is the alpha value and is left unmodified.
-
-            // Increment to the next pixel.
-            current_pixel = current_pixel + bytes_per_pixel;
-        }
-    }
-}
-
 void ImageMemory::RGBAToRGB()
 {
     if(_pixels.empty()) {
@@ -369,6 +318,9 @@ void ImageMemory::CopyFromTexture(TexSheet *texture)
 {
     assert(texture != nullptr);
 
+    // The sheet must contain the pixels of its pending images.
+    TextureManager->_FinishPendingUploads(texture);
+
     Resize(texture->width, texture->height, false);
 
     if (_pixels.empty()) {
@@ -561,7 +513,8 @@ ImageTexture::ImageTexture(const std::string &filename_,
                            int32_t width_, int32_t height_) :
     BaseTexture(width_, height_),
     filename(filename_),
-    tags(tags_)
+    tags(tags_),
+    pending(false)
 {
     if(VIDEO_DEBUG) {
         if(TextureManager->_IsImageTextureRegistered(filename + tags))
@@ -578,7 +531,8 @@ ImageTexture::ImageTexture(TexSheet *texture_sheet_,
                            int32_t width_, int32_t height_) :
     BaseTexture(texture_sheet_, width_, height_),
     filename(filename_),
-    tags(tags_)
+    tags(tags_),
+    pending(false)
 {
     if(VIDEO_DEBUG) {
         if(TextureManager->_IsImageTextureRegistered(filename + tags))
@@ -591,6 +545,9 @@ ImageTexture::ImageTexture(TexSheet *texture_sheet_,
 
 ImageTexture::~ImageTexture()
 {
+    if(pending)
+        TextureManager->_CancelPendingUpload(this);
+
     // Remove this instance from the texture manager
     TextureManager->_UnregisterImageTexture(this);
 }
@@ -33,8 +33,8 @@
 *** properties of that image data.
 ***
 *** \note There are more derived classes from this set in other areas of the
-*** code. In particular, there is a TextTexture and TextElement class
-*** defined in the text.h header file.
+*** code. In particular, there is a Glyph class defined in the glyph_atlas.h
+*** header file.
 *** ***************************************************************************/
 
 #ifndef __IMAGE_BASE_HEADER__
@@ -72,9 +72,6 @@ public:
     ImageMemory();
     explicit ImageMemory(const SDL_Surface* surface);
 
-    ~ImageMemory()
-    {}
-
     size_t GetWidth() const {
         return _width;
     }
@@ -103,15 +100,6 @@ public:
     **/
     bool SaveImage(const std::string &filename);
 
-    /** \brief Converts the image data to grayscale format
-    *** \note Calling this function when the image data is already grayscaled will create the
-    *** exact same grayscaled image, but still take CPU time to do the conversion. There is
-    *** no way
-    *** \note You can not convert from grayscale back to the original image. If you wish to
-    *** do that, you must re-load or otherwise re-create the original.
-    **/
-    void ConvertToGrayscale();
-
     /** \brief Converts the RGBA pixel buffer to a RGB one
     *** \note Upon conversion, this function will also reduced the memory size pointed to
     *** by pixels to 3/4s of its original size, since the alpha information is no longer
@@ -297,12 +285,17 @@ public:
     ***    while "ROWS" is the total number of rows of elements in the multi image
     *** -# \<Ycol_COLS>: used for multi image elements. "col" is the column number of this particular element
     ***    while "COLS" is the total number of columns of elements in the multi image
-    *** -# \<G>: used to indicate that this image texture has been converted to grayscale mode
     ***
     *** \note Please remember to document new tags here when they are added
     **/
     std::string tags;
 
+    /** \brief True while the image pixels are waiting to be copied into the texture sheet.
+    *** The image already has its place in the texture sheet, but drawing it would show
+    *** the previous content of that place. See TextureController::_UploadPendingTextures().
+    **/
+    bool pending;
+
 private:
     ImageTexture(const ImageTexture &copy);
     ImageTexture &operator=(const ImageTexture &copy);
@@ -0,0 +1,209 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    image_loader.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for decoding image files in background threads.
+*** ***************************************************************************/
+
+#include "image_loader.h"
+
+#include "utils/utils_common.h"
+
+#include <algorithm>
+
+#include <SDL2/SDL_image.h>
+
+namespace vt_video
+{
+
+namespace private_video
+{
+
+ImageLoader::ImageLoader() :
+    _stop(false)
+{
+}
+
+ImageLoader::~ImageLoader()
+{
+    if (_threads.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _queued_condition.notify_all();
+
+    for (uint32_t i = 0; i < _threads.size(); ++i)
+        _threads[i].join();
+
+    IMG_Quit();
+}
+
+void ImageLoader::Prefetch(const std::string& filename)
+{
+    if (filename.empty())
+        return;
+
+    if (_threads.empty())
+        _StartThreads();
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        std::map<std::string, Request>::iterator it = _requests.find(filename);
+        if (it != _requests.end()) {
+            it->second.discarded = false;
+            return;
+        }
+
+        _requests[filename] = Request();
+        _queue.push_back(filename);
+    }
+    _queued_condition.notify_one();
+}
+
+bool ImageLoader::TakeImage(const std::string& filename, ImageMemory& image)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    std::map<std::string, Request>::iterator it = _requests.find(filename);
+    if (it == _requests.end())
+        return false;
+
+    // Loading the file on the calling thread is faster than waiting
+    // for the other requests to be decoded.
+    if (it->second.state == REQUEST_QUEUED) {
+        _queue.erase(std::find(_queue.begin(), _queue.end(), filename));
+        _requests.erase(it);
+        return false;
+    }
+
+    // The map iterators remain valid while other requests are added or removed.
+    while (it->second.state == REQUEST_DECODING)
+        _decoded_condition.wait(lock);
+
+    bool decoded = (it->second.state == REQUEST_DECODED);
+    if (decoded)
+        image = std::move(it->second.image);
+
+    _requests.erase(it);
+    return decoded;
+}
+
+void ImageLoader::Discard(const std::string& filename)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::map<std::string, Request>::iterator it = _requests.find(filename);
+    if (it == _requests.end())
+        return;
+
+    switch (it->second.state) {
+    case REQUEST_QUEUED:
+        _queue.erase(std::find(_queue.begin(), _queue.end(), filename));
+        _requests.erase(it);
+        break;
+    case REQUEST_DECODING:
+        // The loader thread will forget it once done.
+        it->second.discarded = true;
+        break;
+    default:
+        _requests.erase(it);
+        break;
+    }
+}
+
+void ImageLoader::Clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _queue.clear();
+
+    std::map<std::string, Request>::iterator it = _requests.begin();
+    while (it != _requests.end()) {
+        if (it->second.state == REQUEST_DECODING) {
+            it->second.discarded = true;
+            ++it;
+        }
+        else {
+            it = _requests.erase(it);
+        }
+    }
+}
+
+void ImageLoader::_StartThreads()
+{
+    // Initializes the PNG decoder once for all, as SDL_image would otherwise
+    // do it on first use, from any of the loader threads.
+    IMG_Init(IMG_INIT_PNG);
+
+    // Keep a core for the main thread.
+    uint32_t number_of_threads = std::thread::hardware_concurrency();
+    number_of_threads = (number_of_threads > 1) ? number_of_threads - 1 : 1;
+    number_of_threads = std::min(number_of_threads, MAX_IMAGE_LOADER_THREADS);
+
+    for (uint32_t i = 0; i < number_of_threads; ++i)
+        _threads.push_back(std::thread(&ImageLoader::_DecodeImages, this));
+
+    IF_PRINT_DEBUG(VIDEO_DEBUG) << "Started " << number_of_threads << " image loader threads" << std::endl;
+}
+
+void ImageLoader::_DecodeImages()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (true) {
+        while (!_stop && _queue.empty())
+            _queued_condition.wait(lock);
+
+        if (_stop)
+            return;
+
+        std::string filename = _queue.front();
+        _queue.pop_front();
+        _requests[filename].state = REQUEST_DECODING;
+
+        // Decode without holding the lock.
+        lock.unlock();
+        ImageMemory image;
+        bool decoded = image.LoadImage(filename);
+        lock.lock();
+
+        // Only the loader thread can remove a request while it is being decoded.
+        std::map<std::string, Request>::iterator it = _requests.find(filename);
+        if (it->second.discarded) {
+            _requests.erase(it);
+        }
+        else {
+            it->second.state = decoded ? REQUEST_DECODED : REQUEST_FAILED;
+            it->second.image = std::move(image);
+        }
+
+        _decoded_condition.notify_all();
+    }
+}
+
+ImageLoader::ImageLoader(const ImageLoader&)
+{
+    throw vt_utils::Exception("Not Implemented!", __FILE__, __LINE__, __FUNCTION__);
+}
+
+ImageLoader& ImageLoader::operator=(const ImageLoader&)
+{
+    throw vt_utils::Exception("Not Implemented!", __FILE__, __LINE__, __FUNCTION__);
+    return *this;
+}
+
+} // namespace private_video
+
+} // namespace vt_video
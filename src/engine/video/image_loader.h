@@ -0,0 +1,144 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    image_loader.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for decoding image files in background threads.
+***
+*** Image files can be prefetched: they are then decoded into system memory
+*** by a small pool of loader threads while the main thread goes on with the
+*** loading of a mode. When the image is loaded afterwards, its decoded pixels
+*** are simply taken from the loader, waiting for the decoding to end if needed.
+***
+*** Only the decoding happens in the loader threads. Everything touching
+*** OpenGL or the texture manager remains on the main thread.
+*** ***************************************************************************/
+
+#ifndef __IMAGE_LOADER_HEADER__
+#define __IMAGE_LOADER_HEADER__
+
+#include "image_base.h"
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace vt_video
+{
+
+namespace private_video
+{
+
+//! \brief The maximum number of loader threads.
+const uint32_t MAX_IMAGE_LOADER_THREADS = 4;
+
+/** ****************************************************************************
+*** \brief A pool of threads decoding image files into system memory.
+***
+*** The threads are only started with the first prefetch request.
+*** ***************************************************************************/
+class ImageLoader
+{
+public:
+    ImageLoader();
+
+    ~ImageLoader();
+
+    /** \brief Requests an image file to be decoded in the background.
+    *** \param filename The image file to decode.
+    *** Requesting a file already requested does nothing.
+    **/
+    void Prefetch(const std::string& filename);
+
+    /** \brief Takes the decoded pixels of a prefetched image file.
+    *** \param filename The image file prefetched.
+    *** \param image The image memory receiving the pixels.
+    *** \return True if the image was decoded in the background. False if it was not
+    *** requested, not decoded yet or if the decoding failed, in which case the caller
+    *** is expected to load the file itself.
+    ***
+    *** If the file is being decoded, this waits for the decoding to end.
+    *** The request is forgotten afterwards.
+    **/
+    bool TakeImage(const std::string& filename, ImageMemory& image);
+
+    /** \brief Forgets a request which won't be taken, freeing its pixels.
+    *** \param filename The image file that was prefetched.
+    **/
+    void Discard(const std::string& filename);
+
+    //! \brief Forgets every request.
+    void Clear();
+
+private:
+    //! \brief The states of a request.
+    enum RequestState {
+        REQUEST_QUEUED,
+        REQUEST_DECODING,
+        REQUEST_DECODED,
+        REQUEST_FAILED
+    };
+
+    //! \brief A decoding request.
+    struct Request {
+        Request() :
+            state(REQUEST_QUEUED),
+            discarded(false)
+        {}
+
+        RequestState state;
+
+        //! \brief Set when the request was discarded while being decoded.
+        bool discarded;
+
+        //! \brief The decoded pixels.
+        ImageMemory image;
+    };
+
+    //! \brief Starts the loader threads.
+    void _StartThreads();
+
+    //! \brief The loader threads main function.
+    void _DecodeImages();
+
+    //! \brief The loader threads.
+    std::vector<std::thread> _threads;
+
+    //! \brief Protects every member below.
+    std::mutex _mutex;
+
+    //! \brief Notified when a request is queued or when the threads must stop.
+    std::condition_variable _queued_condition;
+
+    //! \brief Notified when the decoding of a request ended.
+    std::condition_variable _decoded_condition;
+
+    //! \brief The filenames queued for decoding, in request order.
+    std::deque<std::string> _queue;
+
+    //! \brief The requests, using the filename as key.
+    std::map<std::string, Request> _requests;
+
+    //! \brief Tells the loader threads to stop.
+    bool _stop;
+
+    ImageLoader(const ImageLoader& copy);
+    ImageLoader& operator=(const ImageLoader& copy);
+}; // class ImageLoader
+
+} // namespace private_video
+
+} // namespace vt_video
+
+#endif // __IMAGE_LOADER_HEADER__
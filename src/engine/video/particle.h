@@ -14,11 +14,10 @@
 *** \author  Yohann Ferreira, yohann ferreira orange fr
 *** \brief   Header file for particle data
 ***
-*** This file contains structure(s) for representing a single particle. In theory,
-*** we should be able to just have one structure which holds all properties for
-*** a particle, but in fact we have two: one for the position, and one for everything
-*** else. The reason is that having the positions separated is more efficient
-*** for rendering.
+*** This file contains the structure holding the particles of a system. Each
+*** particle property is stored in its own array (structure of arrays), so that
+*** the update loops go through contiguous memory and can process several
+*** particles at once using SIMD instructions.
 *** **************************************************************************/
 
 #ifndef __PARTICLE_HEADER__
@@ -26,162 +25,164 @@
 
 #include "particle_keyframe.h"
 
-namespace vt_mode_manager
-{
-
-/*!***************************************************************************
- *  \brief Every time the particle system is rendered, we need to iterate through
- *         all the particles in the system, and use the position, size, and
- *         rotation to generate 4 ParticleVertex's. This is pretty expensive, but
- *         unfortunately it's necessary since the positions change every frame.
- *****************************************************************************/
+#include <vector>
 
-class ParticleVertex
+namespace vt_mode_manager
 {
-public:
-    ParticleVertex() :
-        _x(0.0f),
-        _y(0.0f),
-        _z(0.0f)
-    {
-    }
 
-    //! The position of a vertex of the particle's quad.
-    float _x;
-    float _y;
-    float _z;
+//! \brief The particle properties interpolated between two keyframes.
+enum PARTICLE_KEYFRAMED_PROPERTY {
+    PARTICLE_ROTATION_SPEED = 0,
+    PARTICLE_SIZE_X,
+    PARTICLE_SIZE_Y,
+    PARTICLE_COLOR_RED,
+    PARTICLE_COLOR_GREEN,
+    PARTICLE_COLOR_BLUE,
+    PARTICLE_COLOR_ALPHA,
+    PARTICLE_KEYFRAMED_PROPERTIES
 };
 
 /*!***************************************************************************
- *  \brief this is used in texture coordinate array for DrawArrays()
- *         Unless animated particles are used, this can be generated just once
+ *  \brief The particles of a system, stored as one array per property.
+ *
+ *  The keyframed properties (rotation speed, size and color) are interpolated
+ *  between the values of the current and next keyframes, variations included.
+ *  Those values only change when a particle reaches its next keyframe, so that
+ *  the interpolation itself is a simple linear function of the particle time.
  *****************************************************************************/
 
-class ParticleTexCoord
+class ParticleArrays
 {
 public:
-    ParticleTexCoord():
-        _t0(0.0f),
-        _t1(0.0f)
-    {
-    }
-
-    //! The texture coordinates of a vertex of the particle's quad.
-    float _t0;
-    float _t1;
-};
+    ParticleArrays()
+    {}
 
-/*!***************************************************************************
- *  \brief this is the structure we use to represent a particle
- *****************************************************************************/
+    //! \brief Resizes every property array.
+    void Resize(size_t size) {
+        std::vector<float>* arrays[NUMBER_OF_FLOAT_ARRAYS];
+        _GetFloatArrays(arrays);
+        for(size_t i = 0; i < NUMBER_OF_FLOAT_ARRAYS; ++i)
+            arrays[i]->resize(size, 0.0f);
+        keyframe.resize(size, 0);
+    }
 
-class Particle
-{
-public:
-    Particle():
-        pos(0.0f, 0.0f),
-        size(0.0f, 0.0f),
-        velocity(0.0f, 0.0f),
-        combined_velocity(0.0f, 0.0f),
-        rotation_angle(0.0f),
-        rotation_speed(0.0f),
-        time(0.0f),
-        lifetime(0.0f),
-        wave_length_coefficient(0.0f),
-        wave_half_amplitude(0.0f),
-        acceleration(0.0f, 0.0f),
-        tangential_acceleration(0.0f),
-        radial_acceleration(0.0f),
-        wind_velocity(0.0f, 0.0f),
-        damping(0.0f),
-        rotation_direction(0.0f),
-        current_size_variation(0.0f, 0.0f),
-        next_size_variation(0.0f, 0.0f),
-        current_rotation_speed_variation(0.0f),
-        next_rotation_speed_variation(0.0f),
-        current_keyframe(nullptr),
-        next_keyframe(nullptr)
-    {}
+    //! \brief Copies the particle at the src index onto the dest one.
+    void Move(size_t src, size_t dest) {
+        std::vector<float>* arrays[NUMBER_OF_FLOAT_ARRAYS];
+        _GetFloatArrays(arrays);
+        for(size_t i = 0; i < NUMBER_OF_FLOAT_ARRAYS; ++i)
+            (*arrays[i])[dest] = (*arrays[i])[src];
+        keyframe[dest] = keyframe[src];
+    }
 
     //! position
-    vt_common::Position2D pos;
-
-    //! size
-    vt_common::Position2D size;
+    std::vector<float> pos_x;
+    std::vector<float> pos_y;
 
     //! velocity
-    vt_common::Position2D velocity;
+    std::vector<float> velocity_x;
+    std::vector<float> velocity_y;
 
     //! store the combined velocity (particle + wind + wave) so we only have
     //! to calculate it once
-    vt_common::Position2D combined_velocity;
+    std::vector<float> combined_velocity_x;
+    std::vector<float> combined_velocity_y;
+
+    //! acceleration, i.e. change in velocity per second. The most common use
+    //! for this is for simulating gravity.
+    std::vector<float> acceleration_x;
+    std::vector<float> acceleration_y;
 
-    //! color
-    vt_video::Color color;
+    //! wind velocity. this gets added to the particle's velocity each frame.
+    std::vector<float> wind_velocity_x;
+    std::vector<float> wind_velocity_y;
 
     //! current rotation angle
-    float rotation_angle;
+    std::vector<float> rotation_angle;
 
-    //! rotation speed
-    float rotation_speed;
+    //! when a particle is created, it is given a rotation direction: either
+    //! 1 (clockwise) or -1 (counterclockwise)
+    std::vector<float> rotation_direction;
 
     //! seconds since particle was spawned
-    float time;
+    std::vector<float> time;
 
     //! lifetime (when the particle is supposed to die)
-    float lifetime;
+    std::vector<float> lifetime;
 
-    //! this is 2 * pi / wavelength. The reason we store this weird
-    //! number instead of the wavelength is because that's what we
-    //! will ultimately plug into the sin function
-    float wave_length_coefficient;
+    //! this is 2 * pi / wavelength, since that's what we will ultimately
+    //! plug into the sin function
+    std::vector<float> wave_length_coefficient;
 
-    //! half the amplitude of the wave. We store half the amplitude
-    //! instead of the whole amplitude because that's what gets multiplied
+    //! half the amplitude of the wave, since that's what gets multiplied
     //! with the sin function
-    float wave_half_amplitude;
-
-    //! acceleration, i.e. change in velocity per second. The most common use
-    //! for this is for simulating gravity. If you have multiple constant
-    //! forces acting on particles, then this vector should be the sum of
-    //! those forces.
-    vt_common::Position2D acceleration;
+    std::vector<float> wave_half_amplitude;
 
     //! tangential acceleration- just like normal acceleration, except it
     //! is applied in the tangent direction. positive = clockwise.
-    float tangential_acceleration;
+    std::vector<float> tangential_acceleration;
 
     //! radial acceleration- acceleration towards (negative) or away (positive)
-    //! from an attractor. Note that the default attractor is the emitter position.
-    //! The client can set an attractor for the entire effect by calling
-    //! ParticleEffect::SetAttractor(x,y)
-    float radial_acceleration;
-
-    //! wind velocity. this gets added to the particle's velocity each frame.
-    //! note that different particles might also have a slightly different wind
-    //! velocity, if the system has some wind velocity variation
-    vt_common::Position2D wind_velocity;
+    //! from an attractor.
+    std::vector<float> radial_acceleration;
 
     //! damping- the particle's velocity gets multiplied by this value each second.
-    //! So for example, a damping of .6 means that a particle slows down by 40% each
-    //! second.
-    float damping;
-
-    //! when a particle is created, it is given a rotation direction: either
-    //! 1 (clockwise) or -1 (counterclockwise)
-    float rotation_direction;
-
-    //! property variations
-    vt_common::Position2D current_size_variation;
-    vt_common::Position2D next_size_variation;
-    float current_rotation_speed_variation;
-    float next_rotation_speed_variation;
-    vt_video::Color current_color_variation;
-    vt_video::Color next_color_variation;
-
-    //! keep track of current and next keyframes
-    ParticleKeyframe *current_keyframe;
-    ParticleKeyframe *next_keyframe;
+    std::vector<float> damping;
+
+    //! The current value of each keyframed property.
+    std::vector<float> keyframed[PARTICLE_KEYFRAMED_PROPERTIES];
+
+    //! The keyframed property values, variation included, at the current and next keyframes.
+    std::vector<float> keyframe_from[PARTICLE_KEYFRAMED_PROPERTIES];
+    std::vector<float> keyframe_to[PARTICLE_KEYFRAMED_PROPERTIES];
+
+    //! The particle time at the current keyframe, in seconds.
+    std::vector<float> keyframe_start;
+
+    //! 1 / the time between the current and next keyframes, in seconds. 0 on the last keyframe.
+    std::vector<float> keyframe_scale;
+
+    //! The particle time at the next keyframe, in seconds. FLT_MAX on the last keyframe.
+    std::vector<float> keyframe_end;
+
+    //! The index of the current keyframe in the system definition.
+    std::vector<uint32_t> keyframe;
+
+private:
+    //! \brief The number of float property arrays.
+    static const size_t NUMBER_OF_FLOAT_ARRAYS = 22 + 3 * PARTICLE_KEYFRAMED_PROPERTIES;
+
+    //! \brief Lists every float property array, so that they are all resized or moved at once.
+    void _GetFloatArrays(std::vector<float>** arrays) {
+        size_t i = 0;
+        arrays[i++] = &pos_x;
+        arrays[i++] = &pos_y;
+        arrays[i++] = &velocity_x;
+        arrays[i++] = &velocity_y;
+        arrays[i++] = &combined_velocity_x;
+        arrays[i++] = &combined_velocity_y;
+        arrays[i++] = &acceleration_x;
+        arrays[i++] = &acceleration_y;
+        arrays[i++] = &wind_velocity_x;
+        arrays[i++] = &wind_velocity_y;
+        arrays[i++] = &rotation_angle;
+        arrays[i++] = &rotation_direction;
+        arrays[i++] = &time;
+        arrays[i++] = &lifetime;
+        arrays[i++] = &wave_length_coefficient;
+        arrays[i++] = &wave_half_amplitude;
+        arrays[i++] = &tangential_acceleration;
+        arrays[i++] = &radial_acceleration;
+        arrays[i++] = &damping;
+        arrays[i++] = &keyframe_start;
+        arrays[i++] = &keyframe_scale;
+        arrays[i++] = &keyframe_end;
+        for(size_t p = 0; p < PARTICLE_KEYFRAMED_PROPERTIES; ++p) {
+            arrays[i++] = &keyframed[p];
+            arrays[i++] = &keyframe_from[p];
+            arrays[i++] = &keyframe_to[p];
+        }
+    }
 };
 
 } // vt_mode_manager
@@ -18,6 +18,7 @@
 #include "engine/video/particle_effect.h"
 
 #include "engine/video/particle_system.h"
+#include "engine/video/particle_worker_pool.h"
 #include "engine/video/video.h"
 
 #include "script/script_read.h"
@@ -365,7 +366,9 @@ bool ParticleEffect::_CreateEffect()
     std::vector<ParticleSystemDef>::iterator it = _effect_def._systems.begin();
     for(; it != _effect_def._systems.end(); ++it) {
         if((*it).enabled) {
-            ParticleSystem sys(&(*it));
+            // The seeds are drawn on the main thread, so that the effects stay
+            // reproducible whatever thread updates their systems.
+            ParticleSystem sys(&(*it), static_cast<uint32_t>(rand()));
             if(!sys.IsAlive()) {
                 // If a system could not be created then we bail out
                 _systems.clear();
@@ -422,35 +425,65 @@ void ParticleEffect::Update()
 
 void ParticleEffect::Update(float frame_time)
 {
-    _age += frame_time;
+    _BeginUpdate(frame_time);
+
+    if(_alive) {
+        std::vector<ParticleSystem>::iterator iSystem = _systems.begin();
+        for(; iSystem != _systems.end(); ++iSystem)
+            (*iSystem).Update(frame_time, _effect_parameters);
+    }
+
+    FinishUpdate();
+}
+
+void ParticleEffect::QueueUpdate(float frame_time, ParticleWorkerPool &worker_pool)
+{
+    _BeginUpdate(frame_time);
+
+    if(!_alive)
+        return;
+
+    std::vector<ParticleSystem>::iterator iSystem = _systems.begin();
+    for(; iSystem != _systems.end(); ++iSystem)
+        worker_pool.AddJob(&(*iSystem), frame_time, &_effect_parameters);
+}
+
+void ParticleEffect::FinishUpdate()
+{
     _num_particles = 0;
 
     if(!_alive)
         return;
 
-    vt_mode_manager::EffectParameters effect_parameters;
-    effect_parameters.orientation = _orientation;
+    std::vector<ParticleSystem>::const_iterator iSystem = _systems.begin();
+    for(; iSystem != _systems.end(); ++iSystem)
+        _num_particles += (*iSystem).GetNumParticles();
+}
+
+void ParticleEffect::_BeginUpdate(float frame_time)
+{
+    _age += frame_time;
+
+    if(!_alive)
+        return;
+
+    _effect_parameters.orientation = _orientation;
 
     // note we subtract the effect position to put the attractor point in effect
     // space instead of screen space
-    effect_parameters.attractor.x = _attractor.x - _pos.x;
-    effect_parameters.attractor.y = _attractor.y - _pos.y;
+    _effect_parameters.attractor.x = _attractor.x - _pos.x;
+    _effect_parameters.attractor.y = _attractor.y - _pos.y;
 
     std::vector<ParticleSystem>::iterator iSystem = _systems.begin();
-
     while(iSystem != _systems.end()) {
-        if(!(*iSystem).IsAlive()) {
+        if(!(*iSystem).IsAlive())
             iSystem = _systems.erase(iSystem);
-
-            if(_systems.empty())
-                _alive = false;
-        } else {
-            (*iSystem).Update(frame_time, effect_parameters);
-
-            _num_particles += (*iSystem).GetNumParticles();
+        else
             ++iSystem;
-        }
     }
+
+    if(_systems.empty())
+        _alive = false;
 }
 
 
@@ -53,6 +53,8 @@ class ParticleObject;
 namespace vt_mode_manager
 {
 
+class ParticleWorkerPool;
+
 /*!***************************************************************************
  *  \brief particle effect definition, just consists of each of its subsystems'
  *         definitions.
@@ -244,7 +246,25 @@ public:
      */
     void Update(float frame_time);
     void Update();
+
+    /*!
+     * \brief queues the updates of the effect systems, so that they are done by the
+     *        worker pool, along with the updates of the other effects.
+     * \param frame_time the new frame time
+     * \param worker_pool the pool the system updates are queued to
+     * \note FinishUpdate() must be called once the worker pool has run.
+     */
+    void QueueUpdate(float frame_time, ParticleWorkerPool &worker_pool);
+
+    //! \brief ends an update started with QueueUpdate().
+    void FinishUpdate();
 private:
+    /*!
+     * \brief ages the effect, removes its dead systems, and sets up the
+     *        effect parameters for the coming system updates.
+     */
+    void _BeginUpdate(float frame_time);
+
     /*!
      * \brief destroys the effect. This is private so that only the ParticleManager class
      *         can destroy effects.
@@ -286,6 +306,10 @@ private:
     //! orientation of the effect (angle in radians)
     float _orientation;
 
+    //! the parameters given to the systems during the current update. They are kept
+    //! here so that the systems can still use them once queued to the worker pool.
+    EffectParameters _effect_parameters;
+
     //! is the effect is alive or not
     bool  _alive;
 
@@ -19,6 +19,8 @@
 
 #include "engine/video/video.h"
 #include "engine/video/particle_effect.h"
+#include "engine/video/particle_worker_pool.h"
+#include "engine/profiler.h"
 
 #include "utils/utils_common.h"
 
@@ -63,6 +65,8 @@ void ParticleManager::Draw() const
 
     std::vector<ParticleEffect *>::const_iterator it = _active_effects.begin();
 
+    // The pending sprites may use the stencil buffer.
+    VideoManager->FlushSpriteBatch();
     glClearStencil(0);
     glClear(GL_STENCIL_BUFFER_BIT);
 
@@ -76,21 +80,33 @@ void ParticleManager::Draw() const
 
 void ParticleManager::Update(int32_t frame_time)
 {
+    PROFILE_ZONE("ParticleManager::Update");
+
     float frame_time_seconds = static_cast<float>(frame_time) / 1000.0f;
 
+    ParticleWorkerPool *worker_pool = VideoManager->GetParticleWorkerPool();
+
     std::vector<ParticleEffect *>::iterator it = _active_effects.begin();
 
     _num_particles = 0;
 
+    // The systems of every effect are queued first, so that they can all be updated in parallel.
     while(it != _active_effects.end()) {
         if(!(*it)->IsAlive()) {
             it = _active_effects.erase(it);
         } else {
-            (*it)->Update(frame_time_seconds);
-            _num_particles += (*it)->GetNumParticles();
+            (*it)->QueueUpdate(frame_time_seconds, *worker_pool);
             ++it;
         }
     }
+
+    // Wait for the updates to be done, so that the effects are ready to be drawn.
+    worker_pool->Run();
+
+    for(it = _active_effects.begin(); it != _active_effects.end(); ++it) {
+        (*it)->FinishUpdate();
+        _num_particles += (*it)->GetNumParticles();
+    }
 }
 
 void ParticleManager::StopAll(bool kill_immediate)
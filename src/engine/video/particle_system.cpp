@@ -18,11 +18,13 @@
 #include "particle_system.h"
 
 #include "particle_keyframe.h"
+#include "particle_update.h"
 #include "engine/video/video.h"
 
 #include "utils/utils_random.h"
 
 #include <cassert>
+#include <cfloat>
 
 using namespace vt_utils;
 using namespace vt_video;
@@ -31,6 +33,71 @@ using namespace vt_common;
 namespace vt_mode_manager
 {
 
+//! \brief Gets the keyframed property values and variations of a keyframe.
+static void _GetKeyframeValues(const ParticleKeyframe& keyframe, float* values, float* variations)
+{
+    values[PARTICLE_ROTATION_SPEED] = keyframe.rotation_speed;
+    variations[PARTICLE_ROTATION_SPEED] = keyframe.rotation_speed_variation;
+    values[PARTICLE_SIZE_X] = keyframe.size.x;
+    variations[PARTICLE_SIZE_X] = keyframe.size_variation.x;
+    values[PARTICLE_SIZE_Y] = keyframe.size.y;
+    variations[PARTICLE_SIZE_Y] = keyframe.size_variation.y;
+    for(int32_t c = 0; c < 4; ++c) {
+        values[PARTICLE_COLOR_RED + c] = keyframe.color[c];
+        variations[PARTICLE_COLOR_RED + c] = keyframe.color_variation[c];
+    }
+}
+
+//! \brief Writes the texture coordinates of the particle quads.
+static void _WriteTextureCoordinates(float* texture_coordinates, int32_t num_particles,
+                                     float u1, float v1, float u2, float v2)
+{
+    for(int32_t j = 0; j < num_particles; ++j) {
+        // The upper-left vertex.
+        *texture_coordinates++ = u1;
+        *texture_coordinates++ = v1;
+
+        // The upper-right vertex.
+        *texture_coordinates++ = u2;
+        *texture_coordinates++ = v1;
+
+        // The lower-right vertex.
+        *texture_coordinates++ = u2;
+        *texture_coordinates++ = v2;
+
+        // The lower-left vertex.
+        *texture_coordinates++ = u1;
+        *texture_coordinates++ = v2;
+    }
+}
+
+//! \brief Writes the particle colors, the color channels being multiplied by the given factor.
+static void _WriteColors(float* colors, const ParticleArrays& particles, int32_t num_particles, float factor)
+{
+    const float* red = &particles.keyframed[PARTICLE_COLOR_RED][0];
+    const float* green = &particles.keyframed[PARTICLE_COLOR_GREEN][0];
+    const float* blue = &particles.keyframed[PARTICLE_COLOR_BLUE][0];
+    const float* alpha = &particles.keyframed[PARTICLE_COLOR_ALPHA][0];
+
+    for(int32_t j = 0; j < num_particles; ++j) {
+        for(int32_t v = 0; v < 4; ++v) {
+            *colors++ = red[j] * factor;
+            *colors++ = green[j] * factor;
+            *colors++ = blue[j] * factor;
+            *colors++ = alpha[j];
+        }
+    }
+}
+
+//! \brief Writes a particle quad vertex.
+static inline float* _WriteVertex(float* positions, float x, float y)
+{
+    *positions++ = x;
+    *positions++ = y;
+    *positions++ = 0.0f;
+    return positions;
+}
+
 bool ParticleSystem::_Create(ParticleSystemDef *sys_def)
 {
     // Make sure the system def is valid before initializing.
@@ -43,10 +110,7 @@ bool ParticleSystem::_Create(ParticleSystemDef *sys_def)
     _system_def = sys_def;
     _num_particles = 0;
 
-    _particles.resize(_system_def->max_particles);
-    _particle_vertices.resize(_system_def->max_particles * 4);
-    _particle_texcoords.resize(_system_def->max_particles * 4);
-    _particle_colors.resize(_system_def->max_particles * 4);
+    _particles.Resize(_system_def->max_particles);
 
     _alive = true;
     _stopped = false;
@@ -81,11 +145,15 @@ void ParticleSystem::Draw()
         VideoManager->EnableBlending();
 
         if (_system_def->blend_mode == VIDEO_BLEND)
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            VideoManager->SetBlendFunction(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
         else
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE); // Additive.
+            VideoManager->SetBlendFunction(GL_SRC_ALPHA, GL_ONE); // Additive.
     }
 
+    // The stencil and texture parameters below are set directly,
+    // so the pending sprites must be drawn first.
+    VideoManager->FlushSpriteBatch();
+
     if (_system_def->use_stencil) {
         VideoManager->EnableStencilTest();
         glStencilFunc(GL_EQUAL, 1, 0xFFFFFFFF);
@@ -118,37 +186,47 @@ void ParticleSystem::Draw()
 
     float frame_progress = _animation.GetPercentProgress();
 
-    float u1 = img->u1;
-    float u2 = img->u2;
-    float v1 = img->v1;
-    float v2 = img->v2;
-
     float img_width  = static_cast<float>(img->width);
     float img_height = static_cast<float>(img->height);
 
     float img_width_half = img_width * 0.5f;
     float img_height_half = img_height * 0.5f;
 
+    // Load the sprite shader program.
+    gl::ShaderProgram* shader_program = VideoManager->LoadShaderProgram(gl::shader_programs::Sprite);
+    assert(shader_program != nullptr);
+
+    // The vertices are written straight into the video engine buffers.
+    float* positions = nullptr;
+    float* texture_coordinates = nullptr;
+    float* colors = nullptr;
+    if (!VideoManager->MapParticleBuffers(_num_particles, &positions, &texture_coordinates, &colors))
+        return;
+
+    const float* pos_x = &_particles.pos_x[0];
+    const float* pos_y = &_particles.pos_y[0];
+    const float* size_x = &_particles.keyframed[PARTICLE_SIZE_X][0];
+    const float* size_y = &_particles.keyframed[PARTICLE_SIZE_Y][0];
+
     // Fill the vertex array.
     if (_system_def->rotation_used) {
-        int32_t v = 0;
-
         for (int32_t j = 0; j < _num_particles; ++j) {
-            float scaled_width_half  = img_width_half * _particles[j].size.x;
-            float scaled_height_half = img_height_half * _particles[j].size.y;
+            float scaled_width_half  = img_width_half * size_x[j];
+            float scaled_height_half = img_height_half * size_y[j];
 
-            float rotation_angle = _particles[j].rotation_angle;
+            float rotation_angle = _particles.rotation_angle[j];
 
             if(_system_def->rotate_to_velocity) {
+                float velocity_x = _particles.combined_velocity_x[j];
+                float velocity_y = _particles.combined_velocity_y[j];
+
                 // Calculate the angle based on the velocity.
-                rotation_angle += UTILS_HALF_PI + atan2f(_particles[j].combined_velocity.y,
-                                                         _particles[j].combined_velocity.x);
+                rotation_angle += UTILS_HALF_PI + atan2f(velocity_y, velocity_x);
 
                 // Calculate the scaling due to speed.
                 if(_system_def->speed_scale_used) {
                     // Speed is the magnitude of velocity.
-                    float speed = sqrtf(_particles[j].combined_velocity.x * _particles[j].combined_velocity.x
-                                        + _particles[j].combined_velocity.y * _particles[j].combined_velocity.y);
+                    float speed = sqrtf(velocity_x * velocity_x + velocity_y * velocity_y);
                     float scale_factor = _system_def->speed_scale * speed;
 
                     if (scale_factor < _system_def->min_speed_scale)
@@ -160,121 +238,54 @@ void ParticleSystem::Draw()
                 }
             }
 
+            // Rotate the quad half extents once, the four corners being combinations of them.
+            float cos_angle = cosf(rotation_angle);
+            float sin_angle = sinf(rotation_angle);
+            float width_x = scaled_width_half * cos_angle;
+            float width_y = scaled_width_half * sin_angle;
+            float height_x = -scaled_height_half * sin_angle;
+            float height_y = scaled_height_half * cos_angle;
+
             // The upper-left vertex.
-            _particle_vertices[v]._x = -scaled_width_half;
-            _particle_vertices[v]._y = -scaled_height_half;
-            RotatePoint(_particle_vertices[v]._x, _particle_vertices[v]._y, rotation_angle);
-            _particle_vertices[v]._x += _particles[j].pos.x;
-            _particle_vertices[v]._y += _particles[j].pos.y;
-            ++v;
+            positions = _WriteVertex(positions, pos_x[j] - width_x - height_x, pos_y[j] - width_y - height_y);
 
             // The upper-right vertex.
-            _particle_vertices[v]._x = scaled_width_half;
-            _particle_vertices[v]._y = -scaled_height_half;
-            RotatePoint(_particle_vertices[v]._x, _particle_vertices[v]._y, rotation_angle);
-            _particle_vertices[v]._x += _particles[j].pos.x;
-            _particle_vertices[v]._y += _particles[j].pos.y;
-            ++v;
+            positions = _WriteVertex(positions, pos_x[j] + width_x - height_x, pos_y[j] + width_y - height_y);
 
             // The lower-right vertex.
-            _particle_vertices[v]._x = scaled_width_half;
-            _particle_vertices[v]._y = scaled_height_half;
-            RotatePoint(_particle_vertices[v]._x, _particle_vertices[v]._y, rotation_angle);
-            _particle_vertices[v]._x += _particles[j].pos.x;
-            _particle_vertices[v]._y += _particles[j].pos.y;
-            ++v;
+            positions = _WriteVertex(positions, pos_x[j] + width_x + height_x, pos_y[j] + width_y + height_y);
 
             // The lower-left vertex.
-            _particle_vertices[v]._x = -scaled_width_half;
-            _particle_vertices[v]._y = scaled_height_half;
-            RotatePoint(_particle_vertices[v]._x, _particle_vertices[v]._y, rotation_angle);
-            _particle_vertices[v]._x += _particles[j].pos.x;
-            _particle_vertices[v]._y += _particles[j].pos.y;
-            ++v;
+            positions = _WriteVertex(positions, pos_x[j] - width_x + height_x, pos_y[j] - width_y + height_y);
         }
     } else {
-        int32_t v = 0;
-
         for (int32_t j = 0; j < _num_particles; ++j) {
-            float scaled_width_half  = img_width_half * _particles[j].size.x;
-            float scaled_height_half = img_height_half * _particles[j].size.y;
+            float scaled_width_half  = img_width_half * size_x[j];
+            float scaled_height_half = img_height_half * size_y[j];
 
             // The upper-left vertex.
-            _particle_vertices[v]._x = _particles[j].pos.x - scaled_width_half;
-            _particle_vertices[v]._y = _particles[j].pos.y - scaled_height_half;
-            ++v;
+            positions = _WriteVertex(positions, pos_x[j] - scaled_width_half, pos_y[j] - scaled_height_half);
 
             // The upper-right vertex.
-            _particle_vertices[v]._x = _particles[j].pos.x + scaled_width_half;
-            _particle_vertices[v]._y = _particles[j].pos.y - scaled_height_half;
-            ++v;
+            positions = _WriteVertex(positions, pos_x[j] + scaled_width_half, pos_y[j] - scaled_height_half);
 
             // The lower-right vertex.
-            _particle_vertices[v]._x = _particles[j].pos.x + scaled_width_half;
-            _particle_vertices[v]._y = _particles[j].pos.y + scaled_height_half;
-            ++v;
-
-            // lower-left vertex
-            _particle_vertices[v]._x = _particles[j].pos.x - scaled_width_half;
-            _particle_vertices[v]._y = _particles[j].pos.y + scaled_height_half;
-            ++v;
+            positions = _WriteVertex(positions, pos_x[j] + scaled_width_half, pos_y[j] + scaled_height_half);
+
+            // The lower-left vertex.
+            positions = _WriteVertex(positions, pos_x[j] - scaled_width_half, pos_y[j] + scaled_height_half);
         }
     }
 
     // Fill the color array.
-
-    int32_t c = 0;
-    for (int32_t j = 0; j < _num_particles; ++j) {
-        Color color = _particles[j].color;
-
-        if (_system_def->smooth_animation)
-            color = color * (1.0f - frame_progress);
-
-        _particle_colors[c] = color;
-        ++c;
-        _particle_colors[c] = color;
-        ++c;
-        _particle_colors[c] = color;
-        ++c;
-        _particle_colors[c] = color;
-        ++c;
-    }
+    _WriteColors(colors, _particles, _num_particles,
+                 _system_def->smooth_animation ? 1.0f - frame_progress : 1.0f);
 
     // Fill the texture coordinate array.
-
-    int32_t t = 0;
-    for (int32_t j = 0; j < _num_particles; ++j) {
-        // The upper-left vertex.
-        _particle_texcoords[t]._t0 = u1;
-        _particle_texcoords[t]._t1 = v1;
-        ++t;
-
-        // The upper-right vertex.
-        _particle_texcoords[t]._t0 = u2;
-        _particle_texcoords[t]._t1 = v1;
-        ++t;
-
-        // The lower-right vertex.
-        _particle_texcoords[t]._t0 = u2;
-        _particle_texcoords[t]._t1 = v2;
-        ++t;
-
-        // The lower-left vertex.
-        _particle_texcoords[t]._t0 = u1;
-        _particle_texcoords[t]._t1 = v2;
-        ++t;
-    }
-
-    // Load the sprite shader program.
-    gl::ShaderProgram* shader_program = VideoManager->LoadShaderProgram(gl::shader_programs::Sprite);
-    assert(shader_program != nullptr);
+    _WriteTextureCoordinates(texture_coordinates, _num_particles, img->u1, img->v1, img->u2, img->v2);
 
     // Draw the particle system.
-    VideoManager->DrawParticleSystem(shader_program,
-                                     reinterpret_cast<float*>(&_particle_vertices[0]),
-                                     reinterpret_cast<float*>(&_particle_texcoords[0]),
-                                     reinterpret_cast<float*>(&_particle_colors[0]),
-                                     _num_particles * 4);
+    VideoManager->DrawParticleSystem(shader_program);
 
     if (_system_def->smooth_animation) {
         uint32_t findex = _animation.GetCurrentFrameIndex();
@@ -284,59 +295,16 @@ void ParticleSystem::Draw()
         private_video::ImageTexture *img2 = id2->_image_texture;
         TextureManager->_BindTexture(img2->texture_sheet->tex_id);
 
-        u1 = img2->u1;
-        u2 = img2->u2;
-        v1 = img2->v1;
-        v2 = img2->v2;
+        // The vertex positions are kept from the previous draw.
+        if (!VideoManager->MapParticleBuffers(_num_particles, nullptr, &texture_coordinates, &colors))
+            return;
 
-        t = 0;
-        for (int32_t j = 0; j < _num_particles; ++j) {
-            // The upper-left vertex.
-            _particle_texcoords[t]._t0 = u1;
-            _particle_texcoords[t]._t1 = v1;
-            ++t;
-
-            // The upper-right vertex.
-            _particle_texcoords[t]._t0 = u2;
-            _particle_texcoords[t]._t1 = v1;
-            ++t;
-
-            // The lower-right vertex.
-            _particle_texcoords[t]._t0 = u2;
-            _particle_texcoords[t]._t1 = v2;
-            ++t;
-
-            // The lower-left vertex.
-            _particle_texcoords[t]._t0 = u1;
-            _particle_texcoords[t]._t1 = v2;
-            ++t;
-        }
-
-        c = 0;
-        for (int32_t j = 0; j < _num_particles; ++j) {
-            Color color = _particles[j].color;
-            color = color * frame_progress;
-
-            _particle_colors[c] = color;
-            ++c;
-            _particle_colors[c] = color;
-            ++c;
-            _particle_colors[c] = color;
-            ++c;
-            _particle_colors[c] = color;
-            ++c;
-        }
+        _WriteTextureCoordinates(texture_coordinates, _num_particles, img2->u1, img2->v1, img2->u2, img2->v2);
+        _WriteColors(colors, _particles, _num_particles, frame_progress);
 
         // Draw the particle system.
-        VideoManager->DrawParticleSystem(shader_program,
-                                         reinterpret_cast<float*>(&_particle_vertices[0]),
-                                         reinterpret_cast<float*>(&_particle_texcoords[0]),
-                                         reinterpret_cast<float*>(&_particle_colors[0]),
-                                         _num_particles * 4);
+        VideoManager->DrawParticleSystem(shader_program);
     }
-
-    // Unload the shader program.
-    VideoManager->UnloadShaderProgram();
 }
 
 //-----------------------------------------------------------------------------
@@ -415,217 +383,53 @@ void ParticleSystem::_Destroy()
     _alive = false;
     _stopped = false;
 
-    _particles.clear();
-    _particle_vertices.clear();
+    _particles.Resize(0);
     // Don't delete it, since it's handled by the ParticleEffectDef
     _system_def = 0;
 }
 
 void ParticleSystem::_UpdateParticles(float t, const EffectParameters &params)
 {
-    for(int32_t j = 0; j < _num_particles; ++j) {
-        // calculate a time for the particle from 0 to 1 since this is what
-        // the keyframes are based on
-        float scaled_time = _particles[j].time / _particles[j].lifetime;
-
-        // figure out which keyframe we're on
-        if(_particles[j].next_keyframe) {
-            ParticleKeyframe *old_next = _particles[j].next_keyframe;
-
-            // check if we need to advance the keyframe
-            if(scaled_time >= _particles[j].next_keyframe->time) {
-                // figure out what keyframe we're on
-                size_t num_keyframes = _system_def->keyframes.size();
-
-                size_t k;
-                for(k = 0; k < num_keyframes; ++k) {
-                    if(_system_def->keyframes[k].time > scaled_time) {
-                        _particles[j].current_keyframe = &_system_def->keyframes[k - 1];
-                        _particles[j].next_keyframe    = &_system_def->keyframes[k];
-                        break;
-                    }
-                }
-
-                // if we didn't find any keyframe whose time is larger than this
-                // particle's time, then we are on the last one
-                if(k == num_keyframes) {
-                    _particles[j].current_keyframe = &_system_def->keyframes[k - 1];
-                    _particles[j].next_keyframe = nullptr;
-
-                    // set all of the keyframed properties to the value stored in the last
-                    // keyframe
-                    _particles[j].color          = _particles[j].current_keyframe->color;
-                    _particles[j].rotation_speed = _particles[j].current_keyframe->rotation_speed;
-                    _particles[j].size         = _particles[j].current_keyframe->size;
-                }
-
-                // if we skipped ahead only 1 keyframe, then inherit the current variations
-                // from the next ones
-                if(_particles[j].current_keyframe == old_next) {
-                    _particles[j].current_color_variation = _particles[j].next_color_variation;
-                    _particles[j].current_rotation_speed_variation = _particles[j].next_rotation_speed_variation;
-                    _particles[j].current_size_variation = _particles[j].next_size_variation;
-                } else {
-                    _particles[j].current_rotation_speed_variation = RandomFloat(-_particles[j].current_keyframe->rotation_speed_variation, _particles[j].current_keyframe->rotation_speed_variation);
-                    for(int32_t c = 0; c < 4; ++c)
-                        _particles[j].current_color_variation[c] = RandomFloat(-_particles[j].current_keyframe->color_variation[c], _particles[j].current_keyframe->color_variation[c]);
-                    _particles[j].current_size_variation.x = RandomFloat(-_particles[j].current_keyframe->size_variation.x,
-                                                                         _particles[j].current_keyframe->size_variation.x);
-                    _particles[j].current_size_variation.y = RandomFloat(-_particles[j].current_keyframe->size_variation.y,
-                                                                         _particles[j].current_keyframe->size_variation.y);
-                }
-
-                // if there is a next keyframe, generate variations for it
-                if(_particles[j].next_keyframe) {
-                    _particles[j].next_rotation_speed_variation = RandomFloat(-_particles[j].next_keyframe->rotation_speed_variation, _particles[j].next_keyframe->rotation_speed_variation);
-                    for(int32_t c = 0; c < 4; ++c)
-                        _particles[j].next_color_variation[c] = RandomFloat(-_particles[j].next_keyframe->color_variation[c], _particles[j].next_keyframe->color_variation[c]);
-                    _particles[j].next_size_variation.x = RandomFloat(-_particles[j].next_keyframe->size_variation.x,
-                                                                      _particles[j].next_keyframe->size_variation.x);
-                    _particles[j].next_size_variation.y = RandomFloat(-_particles[j].next_keyframe->size_variation.y,
-                                                                      _particles[j].next_keyframe->size_variation.y);
-                }
-            }
-        }
-
-        // if we aren't already at the last keyframe, interpolate to figure out the
-        // current keyframed properties
-        if(_particles[j].next_keyframe) {
-            // figure out how far we are from the current to the next (0.0 to 1.0)
-            float cur_a = (scaled_time - _particles[j].current_keyframe->time) /
-                          (_particles[j].next_keyframe->time - _particles[j].current_keyframe->time);
-
-            _particles[j].rotation_speed = Lerp(cur_a, _particles[j].current_keyframe->rotation_speed
-                                                + _particles[j].current_rotation_speed_variation,
-                                                _particles[j].next_keyframe->rotation_speed
-                                                + _particles[j].next_rotation_speed_variation);
-            _particles[j].size.x         = Lerp(cur_a, _particles[j].current_keyframe->size.x
-                                                + _particles[j].current_size_variation.x,
-                                                _particles[j].next_keyframe->size.x
-                                                + _particles[j].next_size_variation.x);
-            _particles[j].size.y         = Lerp(cur_a, _particles[j].current_keyframe->size.y
-                                                + _particles[j].current_size_variation.y,
-                                                _particles[j].next_keyframe->size.y
-                                                + _particles[j].next_size_variation.y);
-            _particles[j].color[0]       = Lerp(cur_a, _particles[j].current_keyframe->color[0]
-                                                + _particles[j].current_color_variation[0],
-                                                _particles[j].next_keyframe->color[0]
-                                                + _particles[j].next_color_variation[0]);
-            _particles[j].color[1]       = Lerp(cur_a, _particles[j].current_keyframe->color[1]
-                                                + _particles[j].current_color_variation[1],
-                                                _particles[j].next_keyframe->color[1]
-                                                + _particles[j].next_color_variation[1]);
-            _particles[j].color[2]       = Lerp(cur_a, _particles[j].current_keyframe->color[2]
-                                                + _particles[j].current_color_variation[2],
-                                                _particles[j].next_keyframe->color[2]
-                                                + _particles[j].next_color_variation[2]);
-            _particles[j].color[3]       = Lerp(cur_a, _particles[j].current_keyframe->color[3]
-                                                + _particles[j].current_color_variation[3],
-                                                _particles[j].next_keyframe->color[3]
-                                                + _particles[j].next_color_variation[3]);
-        }
-
-        _particles[j].rotation_angle += _particles[j].rotation_speed * _particles[j].rotation_direction * t;
-
-        Position2D wind_velocity = _particles[j].wind_velocity;
-
-        _particles[j].combined_velocity.x = _particles[j].velocity.x + wind_velocity.x;
-        _particles[j].combined_velocity.y = _particles[j].velocity.y + wind_velocity.y;
-
-        if(_system_def->wave_motion_used && _particles[j].wave_half_amplitude > 0.0f) {
-            // find the magnitude of the wave velocity
-            float wave_speed = _particles[j].wave_half_amplitude
-                               * sinf(_particles[j].wave_length_coefficient * _particles[j].time);
-
-            // now the wave velocity is just that wave speed times the particle's tangential vector
-            // Note the inverted x and y assignments
-            Position2D tangent(-_particles[j].combined_velocity.y,
-                               _particles[j].combined_velocity.x);
-            float speed = sqrtf(tangent.GetLength2());
-            tangent.x /= speed;
-            tangent.y /= speed;
-
-            Position2D wave_velocity(tangent.x * wave_speed,
-                                     tangent.y * wave_speed);
-
-            _particles[j].combined_velocity.x += wave_velocity.x;
-            _particles[j].combined_velocity.y += wave_velocity.y;
-        }
-
-        _particles[j].pos.x += (_particles[j].combined_velocity.x) * t;
-        _particles[j].pos.y += (_particles[j].combined_velocity.y) * t;
-
-
-        // client-specified acceleration (dv = a * t)
-        _particles[j].velocity.x += _particles[j].acceleration.x * t;
-        _particles[j].velocity.y += _particles[j].acceleration.y * t;
-
-        // radial acceleration: calculate unit vector from emitter center to this particle,
-        // and scale by the radial acceleration, if there is any
-
-        bool use_radial     = (_particles[j].radial_acceleration != 0.0f);
-        bool use_tangential = (_particles[j].tangential_acceleration != 0.0f);
-
-        if(use_radial || use_tangential) {
-            // unit vector from attractor to particle
-            Position2D attractor_to_particle;
-
-            if(_system_def->user_defined_attractor) {
-                attractor_to_particle.x = _particles[j].pos.x - params.attractor.x;
-                attractor_to_particle.y = _particles[j].pos.y - params.attractor.y;
-            } else {
-                attractor_to_particle.x = _particles[j].pos.x - _system_def->emitter._center.x;
-                attractor_to_particle.y = _particles[j].pos.y - _system_def->emitter._center.y;
-            }
-
-            float distance = sqrtf(attractor_to_particle.GetLength2());
-
-            if(distance != 0.0f) {
-                attractor_to_particle.x /= distance;
-                attractor_to_particle.y /= distance;
-            }
-
-            // radial acceleration
-            if(use_radial) {
-                if(_system_def->attractor_falloff != 0.0f) {
-                    float attraction = 1.0f - _system_def->attractor_falloff * distance;
-                    if(attraction > 0.0f) {
-                        _particles[j].velocity.x += attractor_to_particle.x
-                                                    * _particles[j].radial_acceleration
-                                                    * t * attraction;
-                        _particles[j].velocity.y += attractor_to_particle.y
-                                                    * _particles[j].radial_acceleration
-                                                    * t * attraction;
-                    }
-                } else {
-                    _particles[j].velocity.x += attractor_to_particle.x
-                                                * _particles[j].radial_acceleration * t;
-                    _particles[j].velocity.y += attractor_to_particle.y
-                                                * _particles[j].radial_acceleration * t;
-                }
-            }
-
-            // tangential acceleration
-            if(use_tangential) {
-                // tangent vector is simply perpendicular vector
-                // Note the inversion of x and y
-                Position2D tangent(-attractor_to_particle.y,
-                                   attractor_to_particle.x);
-
-                _particles[j].velocity.x += tangent.x * _particles[j].tangential_acceleration * t;
-                _particles[j].velocity.y += tangent.y * _particles[j].tangential_acceleration * t;
-            }
-        }
+    if(_num_particles <= 0)
+        return;
 
-        // damp the velocity
+    const size_t count = static_cast<size_t>(_num_particles);
+    ParticleArrays &p = _particles;
 
-        if(_particles[j].damping != 1.0f) {
-            _particles[j].velocity.x *= pow(_particles[j].damping, t);
-            _particles[j].velocity.y *= pow(_particles[j].damping, t);
+    // advance the keyframe of the particles which reached their next one. This is done
+    // particle per particle, as the new keyframe variations are drawn randomly.
+    for(size_t j = FindNextKeyframeReached(p, 0, count); j < count;
+            j = FindNextKeyframeReached(p, j + 1, count)) {
+        // calculate a time for the particle from 0 to 1 since this is what
+        // the keyframes are based on
+        float scaled_time = p.time[j] / p.lifetime[j];
+
+        // figure out what keyframe we're on
+        size_t num_keyframes = _system_def->keyframes.size();
+        size_t k;
+        for(k = 0; k < num_keyframes; ++k) {
+            if(_system_def->keyframes[k].time > scaled_time)
+                break;
         }
+        size_t current_keyframe = (k > 0) ? k - 1 : 0;
 
-        _particles[j].time += t;
+        // if we skipped ahead only 1 keyframe, then inherit the current variations
+        // from the next ones
+        _SetParticleKeyframe(j, current_keyframe, current_keyframe == p.keyframe[j] + 1);
     }
+
+    // The other properties only depend on the system definition and the effect parameters.
+    ParticleMotion motion;
+    motion.wave_motion_used = _system_def->wave_motion_used;
+    motion.radial_used = _system_def->radial_acceleration != 0.0f
+                         || _system_def->radial_acceleration_variation != 0.0f;
+    motion.tangential_used = _system_def->tangential_acceleration != 0.0f
+                             || _system_def->tangential_acceleration_variation != 0.0f;
+    motion.attractor = _system_def->user_defined_attractor ? params.attractor : _system_def->emitter._center;
+    motion.attractor_falloff = _system_def->attractor_falloff;
+    motion.damping_variation_used = _system_def->damping_variation != 0.0f;
+    motion.damping = _system_def->damping;
+    UpdateParticleMotion(p, count, t, motion);
 }
 
 
@@ -640,7 +444,7 @@ void ParticleSystem::_KillParticles(int32_t &num, const EffectParameters &params
 {
     // check each active particle to see if it is expired
     for(int32_t j = 0; j < _num_particles; ++j) {
-        if(_particles[j].time > _particles[j].lifetime) {
+        if(_particles.time[j] > _particles.lifetime[j]) {
             if(num > 0) {
                 // if we still have particles to emit, then instead of killing the particle,
                 // respawn it as a new one
@@ -679,7 +483,7 @@ void ParticleSystem::_EmitParticles(int32_t num, const EffectParameters &params)
 
 void ParticleSystem::_MoveParticle(int32_t src, int32_t dest)
 {
-    _particles[dest] = _particles[src];
+    _particles.Move(src, dest);
 }
 
 
@@ -691,34 +495,38 @@ void ParticleSystem::_MoveParticle(int32_t src, int32_t dest)
 void ParticleSystem::_RespawnParticle(int32_t i, const EffectParameters &params)
 {
     const ParticleEmitter &emitter = _system_def->emitter;
+    ParticleArrays &p = _particles;
+
+    float pos_x = 0.0f;
+    float pos_y = 0.0f;
 
     switch(emitter._shape) {
     case EMITTER_SHAPE_POINT: {
-        _particles[i].pos.x = emitter._pos.x;
-        _particles[i].pos.y = emitter._pos.y;
+        pos_x = emitter._pos.x;
+        pos_y = emitter._pos.y;
         break;
     }
     case EMITTER_SHAPE_LINE: {
-        _particles[i].pos.x = RandomFloat(emitter._pos.x, emitter._pos2.x);
-        _particles[i].pos.y = RandomFloat(emitter._pos.y, emitter._pos2.y);
+        pos_x = _RandomFloat(emitter._pos.x, emitter._pos2.x);
+        pos_y = _RandomFloat(emitter._pos.y, emitter._pos2.y);
         break;
     }
     case EMITTER_SHAPE_CIRCLE: {
-        float angle = RandomFloat(0.0f, UTILS_2PI);
-        _particles[i].pos.x = emitter._radius * cosf(angle);
-        _particles[i].pos.y = emitter._radius * sinf(angle);
+        float angle = _RandomFloat(0.0f, UTILS_2PI);
+        pos_x = emitter._radius * cosf(angle);
+        pos_y = emitter._radius * sinf(angle);
         // Apply offset
-        _particles[i].pos.x += emitter._pos.x;
-        _particles[i].pos.y += emitter._pos.y;
+        pos_x += emitter._pos.x;
+        pos_y += emitter._pos.y;
         break;
     }
     case EMITTER_SHAPE_ELLIPSE: {
-        float angle = RandomFloat(0.0f, UTILS_2PI);
-        _particles[i].pos.x = emitter._pos.x * cosf(angle);
-        _particles[i].pos.y = emitter._pos.y * sinf(angle);
+        float angle = _RandomFloat(0.0f, UTILS_2PI);
+        pos_x = emitter._pos.x * cosf(angle);
+        pos_y = emitter._pos.y * sinf(angle);
         // Apply offset
-        _particles[i].pos.x += emitter._pos2.x;
-        _particles[i].pos.y += emitter._pos2.y;
+        pos_x += emitter._pos2.x;
+        pos_y += emitter._pos2.y;
         break;
     }
     case EMITTER_SHAPE_FILLED_CIRCLE: {
@@ -729,18 +537,17 @@ void ParticleSystem::_RespawnParticle(int32_t i, const EffectParameters &params)
         // this may need to be replaced by a speedier algorithm later on
         do {
             float half_radius = emitter._radius * 0.5f;
-            _particles[i].pos.x = RandomFloat(-half_radius, half_radius);
-            _particles[i].pos.y = RandomFloat(-half_radius, half_radius);
-        } while(_particles[i].pos.x * _particles[i].pos.x +
-                _particles[i].pos.y * _particles[i].pos.y > radius_squared);
+            pos_x = _RandomFloat(-half_radius, half_radius);
+            pos_y = _RandomFloat(-half_radius, half_radius);
+        } while(pos_x * pos_x + pos_y * pos_y > radius_squared);
         // Apply offset
-        _particles[i].pos.x += emitter._pos.x;
-        _particles[i].pos.y += emitter._pos.y;
+        pos_x += emitter._pos.x;
+        pos_y += emitter._pos.y;
         break;
     }
     case EMITTER_SHAPE_FILLED_RECTANGLE: {
-        _particles[i].pos.x = RandomFloat(emitter._pos.x, emitter._pos2.x);
-        _particles[i].pos.y = RandomFloat(emitter._pos.y, emitter._pos2.y);
+        pos_x = _RandomFloat(emitter._pos.x, emitter._pos2.x);
+        pos_y = _RandomFloat(emitter._pos.y, emitter._pos2.y);
         break;
     }
     default:
@@ -748,155 +555,167 @@ void ParticleSystem::_RespawnParticle(int32_t i, const EffectParameters &params)
     };
 
 
-    _particles[i].pos.x += RandomFloat(-emitter._variation.x, emitter._variation.x);
-    _particles[i].pos.y += RandomFloat(-emitter._variation.y, emitter._variation.y);
+    pos_x += _RandomFloat(-emitter._variation.x, emitter._variation.x);
+    pos_y += _RandomFloat(-emitter._variation.y, emitter._variation.y);
 
     if(params.orientation != 0.0f)
-        RotatePoint(_particles[i].pos.x, _particles[i].pos.y, params.orientation);
+        RotatePoint(pos_x, pos_y, params.orientation);
 
-    _particles[i].color = _system_def->keyframes[0].color;
+    p.pos_x[i] = pos_x;
+    p.pos_y[i] = pos_y;
 
-    _particles[i].rotation_speed  = _system_def->keyframes[0].rotation_speed;
-    _particles[i].time            = 0.0f;
-    _particles[i].size            = _system_def->keyframes[0].size;
+    p.time[i] = 0.0f;
+    p.lifetime[i] = _system_def->particle_lifetime
+                    + _RandomFloat(-_system_def->particle_lifetime_variation,
+                                  _system_def->particle_lifetime_variation);
 
     if(_system_def->random_initial_angle)
-        _particles[i].rotation_angle = RandomFloat(0.0f, UTILS_2PI);
-    else
-        _particles[i].rotation_angle = 0.0f;
-
-    _particles[i].current_keyframe = &_system_def->keyframes[0];
-
-    if(_system_def->keyframes.size() > 1)
-        _particles[i].next_keyframe = &_system_def->keyframes[1];
+        p.rotation_angle[i] = _RandomFloat(0.0f, UTILS_2PI);
     else
-        _particles[i].next_keyframe = nullptr;
+        p.rotation_angle[i] = 0.0f;
 
     float speed = _system_def->emitter._initial_speed;
-    speed += RandomFloat(-emitter._initial_speed_variation, emitter._initial_speed_variation);
+    speed += _RandomFloat(-emitter._initial_speed_variation, emitter._initial_speed_variation);
 
     if(_system_def->emitter._spin == EMITTER_SPIN_CLOCKWISE) {
-        _particles[i].rotation_direction = 1.0f;
+        p.rotation_direction[i] = 1.0f;
     } else if(_system_def->emitter._spin == EMITTER_SPIN_COUNTERCLOCKWISE) {
-        _particles[i].rotation_direction = -1.0f;
+        p.rotation_direction[i] = -1.0f;
     } else {
-        _particles[i].rotation_direction = static_cast<float>(2 * (rand() % 2)) - 1.0f;
+        p.rotation_direction[i] = static_cast<float>(2 * (_random_generator() % 2)) - 1.0f;
     }
 
     // figure out the orientation
     float angle = 0.0f;
 
     if(emitter._omnidirectional) {
-        angle = RandomFloat(0.0f, UTILS_2PI);
+        angle = _RandomFloat(0.0f, UTILS_2PI);
     }
     else {
         angle = emitter._orientation + params.orientation;
 
         if(!IsFloatEqual(emitter._angle_variation, 0.0f))
-            angle += RandomFloat(-emitter._angle_variation, emitter._angle_variation);
+            angle += _RandomFloat(-emitter._angle_variation, emitter._angle_variation);
     }
 
-    _particles[i].velocity.x = speed * cosf(angle);
-    _particles[i].velocity.y = speed * sinf(angle);
-
-    // figure out property variations
-
-    _particles[i].current_size_variation.x  = RandomFloat(-_system_def->keyframes[0].size_variation.x,
-            _system_def->keyframes[0].size_variation.x);
-    _particles[i].current_size_variation.y  = RandomFloat(-_system_def->keyframes[0].size_variation.y,
-            _system_def->keyframes[0].size_variation.y);
-
-    for(int32_t j = 0; j < 4; ++j) {
-        _particles[i].current_color_variation[j] = RandomFloat(-_system_def->keyframes[0].color_variation[j],
-                _system_def->keyframes[0].color_variation[j]);
-    }
+    p.velocity_x[i] = speed * cosf(angle);
+    p.velocity_y[i] = speed * sinf(angle);
+    p.combined_velocity_x[i] = p.velocity_x[i];
+    p.combined_velocity_y[i] = p.velocity_y[i];
 
-    _particles[i].current_rotation_speed_variation = RandomFloat(-_system_def->keyframes[0].rotation_speed_variation,
-            _system_def->keyframes[0].rotation_speed_variation);
+    // figure out the keyframed property values, variations included
+    _SetParticleKeyframe(i, 0, false);
 
-    if(_system_def->keyframes.size() > 1) {
-        // figure out the next keyframe's variations
-        _particles[i].next_size_variation.x  = RandomFloat(-_system_def->keyframes[1].size_variation.x,
-                                               _system_def->keyframes[1].size_variation.x);
-        _particles[i].next_size_variation.y  = RandomFloat(-_system_def->keyframes[1].size_variation.y,
-                                               _system_def->keyframes[1].size_variation.y);
-
-        for(int32_t j = 0; j < 4; ++j) {
-            _particles[i].next_color_variation[j] = RandomFloat(-_system_def->keyframes[1].color_variation[j],
-                                                    _system_def->keyframes[1].color_variation[j]);
-        }
-
-        _particles[i].next_rotation_speed_variation = RandomFloat(-_system_def->keyframes[1].rotation_speed_variation,
-                _system_def->keyframes[1].rotation_speed_variation);
-    } else {
+    if(_system_def->keyframes.size() == 1) {
         // if there's only 1 keyframe, then apply the variations now
-        for(int32_t j = 0; j < 4; ++j) {
-            _particles[i].color[j] += RandomFloat(-_particles[i].current_color_variation[j],
-                                                  _particles[i].current_color_variation[j]);
+        float values[PARTICLE_KEYFRAMED_PROPERTIES];
+        float variations[PARTICLE_KEYFRAMED_PROPERTIES];
+        _GetKeyframeValues(_system_def->keyframes[0], values, variations);
+
+        for(size_t k = 0; k < PARTICLE_KEYFRAMED_PROPERTIES; ++k) {
+            float variation = _RandomFloat(-variations[k], variations[k]);
+            values[k] += _RandomFloat(-variation, variation);
+            p.keyframe_from[k][i] = values[k];
+            p.keyframe_to[k][i] = values[k];
         }
-
-        _particles[i].size.x += RandomFloat(-_particles[i].current_size_variation.x,
-                                            _particles[i].current_size_variation.x);
-        _particles[i].size.y += RandomFloat(-_particles[i].current_size_variation.y,
-                                            _particles[i].current_size_variation.y);
-
-        _particles[i].rotation_speed += RandomFloat(-_particles[i].current_rotation_speed_variation,
-                                        _particles[i].current_rotation_speed_variation);
     }
 
-    _particles[i].tangential_acceleration = _system_def->tangential_acceleration;
+    for(size_t k = 0; k < PARTICLE_KEYFRAMED_PROPERTIES; ++k)
+        p.keyframed[k][i] = p.keyframe_from[k][i];
+
+    p.tangential_acceleration[i] = _system_def->tangential_acceleration;
     if(_system_def->tangential_acceleration_variation != 0.0f)
-        _particles[i].tangential_acceleration += RandomFloat(-_system_def->tangential_acceleration_variation,
-                _system_def->tangential_acceleration_variation);
+        p.tangential_acceleration[i] += _RandomFloat(-_system_def->tangential_acceleration_variation,
+                                                    _system_def->tangential_acceleration_variation);
 
-    _particles[i].radial_acceleration = _system_def->radial_acceleration;
+    p.radial_acceleration[i] = _system_def->radial_acceleration;
     if(_system_def->radial_acceleration_variation != 0.0f)
-        _particles[i].radial_acceleration += RandomFloat(-_system_def->radial_acceleration_variation,
-                                             _system_def->radial_acceleration_variation);
+        p.radial_acceleration[i] += _RandomFloat(-_system_def->radial_acceleration_variation,
+                                                _system_def->radial_acceleration_variation);
 
-    _particles[i].acceleration.x = _system_def->acceleration.x;
+    p.acceleration_x[i] = _system_def->acceleration.x;
     if(_system_def->acceleration_variation.x != 0.0f)
-        _particles[i].acceleration.x += RandomFloat(-_system_def->acceleration_variation.x,
-                                        _system_def->acceleration_variation.x);
+        p.acceleration_x[i] += _RandomFloat(-_system_def->acceleration_variation.x,
+                                           _system_def->acceleration_variation.x);
 
-    _particles[i].acceleration.y = _system_def->acceleration.y;
+    p.acceleration_y[i] = _system_def->acceleration.y;
     if(_system_def->acceleration_variation.y != 0.0f)
-        _particles[i].acceleration.y += RandomFloat(-_system_def->acceleration_variation.y,
-                                        _system_def->acceleration_variation.y);
+        p.acceleration_y[i] += _RandomFloat(-_system_def->acceleration_variation.y,
+                                           _system_def->acceleration_variation.y);
 
-    _particles[i].wind_velocity.x = _system_def->wind_velocity.x;
+    p.wind_velocity_x[i] = _system_def->wind_velocity.x;
     if(_system_def->wind_velocity_variation.x != 0.0f)
-        _particles[i].wind_velocity.x += RandomFloat(-_system_def->wind_velocity_variation.x,
-                                         _system_def->wind_velocity_variation.x);
+        p.wind_velocity_x[i] += _RandomFloat(-_system_def->wind_velocity_variation.x,
+                                            _system_def->wind_velocity_variation.x);
 
-    _particles[i].wind_velocity.y = _system_def->wind_velocity.y;
+    p.wind_velocity_y[i] = _system_def->wind_velocity.y;
     if(_system_def->wind_velocity_variation.y != 0.0f)
-        _particles[i].wind_velocity.y += RandomFloat(-_system_def->wind_velocity_variation.y,
-                                         _system_def->wind_velocity_variation.y);
+        p.wind_velocity_y[i] += _RandomFloat(-_system_def->wind_velocity_variation.y,
+                                            _system_def->wind_velocity_variation.y);
 
-    _particles[i].damping = _system_def->damping;
+    p.damping[i] = _system_def->damping;
     if(_system_def->damping_variation != 0.0f)
-        _particles[i].damping += RandomFloat(-_system_def->damping_variation,
-                                             _system_def->damping_variation);
+        p.damping[i] += _RandomFloat(-_system_def->damping_variation,
+                                    _system_def->damping_variation);
+
+    p.wave_length_coefficient[i] = 0.0f;
+    p.wave_half_amplitude[i] = 0.0f;
 
     if(_system_def->wave_motion_used) {
-        _particles[i].wave_length_coefficient = _system_def->wave_length;
+        p.wave_length_coefficient[i] = _system_def->wave_length;
         if(_system_def->wave_length_variation != 0.0f)
-            _particles[i].wave_length_coefficient += RandomFloat(-_system_def->wave_length_variation,
-                    _system_def->wave_length_variation);
+            p.wave_length_coefficient[i] += _RandomFloat(-_system_def->wave_length_variation,
+                                                        _system_def->wave_length_variation);
 
-        _particles[i].wave_length_coefficient = UTILS_2PI / _particles[i].wave_length_coefficient;
+        p.wave_length_coefficient[i] = UTILS_2PI / p.wave_length_coefficient[i];
 
-        _particles[i].wave_half_amplitude = _system_def->wave_amplitude;
+        p.wave_half_amplitude[i] = _system_def->wave_amplitude;
         if(_system_def->wave_amplitude != 0.0f)
-            _particles[i].wave_half_amplitude += RandomFloat(-_system_def->wave_amplitude_variation,
-                                                 _system_def->wave_amplitude_variation);
-        _particles[i].wave_half_amplitude *= 0.5f;
+            p.wave_half_amplitude[i] += _RandomFloat(-_system_def->wave_amplitude_variation,
+                                                    _system_def->wave_amplitude_variation);
+        p.wave_half_amplitude[i] *= 0.5f;
     }
+}
+
+void ParticleSystem::_SetParticleKeyframe(int32_t i, size_t keyframe, bool inherit_variations)
+{
+    ParticleArrays &p = _particles;
+    const std::vector<ParticleKeyframe> &keyframes = _system_def->keyframes;
+
+    float values[PARTICLE_KEYFRAMED_PROPERTIES];
+    float variations[PARTICLE_KEYFRAMED_PROPERTIES];
+    _GetKeyframeValues(keyframes[keyframe], values, variations);
+
+    p.keyframe[i] = static_cast<uint32_t>(keyframe);
+    p.keyframe_start[i] = keyframes[keyframe].time * p.lifetime[i];
+
+    // once on the last keyframe, the keyframed properties keep its values
+    if(keyframe + 1 >= keyframes.size()) {
+        for(size_t k = 0; k < PARTICLE_KEYFRAMED_PROPERTIES; ++k) {
+            p.keyframe_from[k][i] = values[k];
+            p.keyframe_to[k][i] = values[k];
+        }
+        p.keyframe_scale[i] = 0.0f;
+        p.keyframe_end[i] = FLT_MAX;
+        return;
+    }
+
+    for(size_t k = 0; k < PARTICLE_KEYFRAMED_PROPERTIES; ++k) {
+        if(inherit_variations)
+            p.keyframe_from[k][i] = p.keyframe_to[k][i];
+        else
+            p.keyframe_from[k][i] = values[k] + _RandomFloat(-variations[k], variations[k]);
+    }
+
+    // generate the variations of the next keyframe
+    const ParticleKeyframe &next_keyframe = keyframes[keyframe + 1];
+    _GetKeyframeValues(next_keyframe, values, variations);
+    for(size_t k = 0; k < PARTICLE_KEYFRAMED_PROPERTIES; ++k)
+        p.keyframe_to[k][i] = values[k] + _RandomFloat(-variations[k], variations[k]);
 
-    _particles[i].lifetime = _system_def->particle_lifetime
-                             + RandomFloat(-_system_def->particle_lifetime_variation,
-                                           _system_def->particle_lifetime_variation);
+    float duration = (next_keyframe.time - keyframes[keyframe].time) * p.lifetime[i];
+    p.keyframe_scale[i] = (duration > 0.0f) ? 1.0f / duration : 0.0f;
+    p.keyframe_end[i] = next_keyframe.time * p.lifetime[i];
 }
 
 }  // namespace vt_mode_manager
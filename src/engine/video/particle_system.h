@@ -35,6 +35,8 @@
 
 #include "engine/video/image.h"
 
+#include <random>
+
 namespace vt_mode_manager
 {
 
@@ -275,8 +277,12 @@ class ParticleSystem
 public:
     /*!
      * \brief Constructor
+     * \param sys_def the system definition
+     * \param seed the seed of the system random numbers. The systems may be updated
+     *        by other threads, so they each draw their random numbers on their own.
      */
-    explicit ParticleSystem(ParticleSystemDef* sys_def) {
+    ParticleSystem(ParticleSystemDef* sys_def, uint32_t seed):
+        _random_generator(seed) {
         _Destroy();
         _Create(sys_def);
     }
@@ -393,6 +399,26 @@ private:
      */
     void _RespawnParticle(int32_t i, const EffectParameters &params);
 
+    /*!
+     *  \brief sets the keyframed property values a particle interpolates between,
+     *         once it reached the given keyframe
+     * \param i index of the particle
+     * \param keyframe index of the keyframe reached in the system definition
+     * \param inherit_variations true if the current values are taken from the previous
+     *        next keyframe values, i.e. when only one keyframe was skipped
+     */
+    void _SetParticleKeyframe(int32_t i, size_t keyframe, bool inherit_variations);
+
+    /*!
+     *  \brief returns a random float between the two given values, drawn from the
+     *         system random number generator
+     */
+    float _RandomFloat(float a, float b) {
+        float random = static_cast<float>(_random_generator() - _random_generator.min())
+                       / static_cast<float>(_random_generator.max() - _random_generator.min());
+        return a + (b - a) * random;
+    }
+
     //! The system definition, contains information like the emitter properties, lifetime of
     //! particles, particle keyframes, etc. Basically everything which isn't instance-specific
     //! Note that this pointer shouldn't be deleted by the particle system, since it's handled by
@@ -406,15 +432,9 @@ private:
     //! we might set a particle quota for the system which is higher than what's actually there.)
     int32_t _num_particles;
 
-    //! The array of particle vertices. Note that this array contains FOUR vertices per particle.
-    //! This is used for rendering the particles with OpenGL
-    std::vector<ParticleVertex> _particle_vertices;
-    std::vector<vt_video::Color> _particle_colors;
-    std::vector<ParticleTexCoord> _particle_texcoords;
-
-    //! This array holds everything except positions and colors. The reason we keep positions and
-    //! colors separate is so that they can be efficiently fed to OpenGL for rendering.
-    std::vector<Particle> _particles;
+    //! The particle properties, one array per property. The vertices are generated from them
+    //! straight into the video engine buffers when drawing.
+    ParticleArrays _particles;
 
     //! if stopped is true, no new particles should be emitted
     bool _stopped;
@@ -428,6 +448,9 @@ private:
     //! last time the system was updated (based on the system's age)
     float _last_update_time;
 
+    //! the system random number generator
+    std::minstd_rand _random_generator;
+
 }; // class ParticleSystem
 
 }  // namespace vt_mode_manager
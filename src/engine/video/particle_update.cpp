@@ -0,0 +1,280 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ***************************************************************************
+*** \file    particle_update.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the particle update kernels
+*** **************************************************************************/
+
+#include "particle_update.h"
+
+#include <cmath>
+
+// The update kernels process four particles at once when SSE is available,
+// which is always the case on x86-64. The remaining particles go through the scalar code.
+// Defining PARTICLE_SYSTEM_NO_SSE forces the scalar code, e.g.: to benchmark it.
+#if !defined(PARTICLE_SYSTEM_NO_SSE) && \
+    (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+#   define PARTICLE_SYSTEM_SSE
+#   include <xmmintrin.h>
+#endif
+
+using namespace vt_common;
+
+namespace vt_mode_manager
+{
+
+//! \brief values[i] += factors[i] * scale
+static void _AddScaled(float* values, const float* factors, float scale, size_t count)
+{
+    size_t i = 0;
+#ifdef PARTICLE_SYSTEM_SSE
+    const __m128 scale4 = _mm_set1_ps(scale);
+    for(; i + 4 <= count; i += 4) {
+        __m128 product = _mm_mul_ps(_mm_loadu_ps(factors + i), scale4);
+        _mm_storeu_ps(values + i, _mm_add_ps(_mm_loadu_ps(values + i), product));
+    }
+#endif
+    for(; i < count; ++i)
+        values[i] += factors[i] * scale;
+}
+
+//! \brief values[i] += factors1[i] * factors2[i] * scale
+static void _AddScaled(float* values, const float* factors1, const float* factors2, float scale, size_t count)
+{
+    size_t i = 0;
+#ifdef PARTICLE_SYSTEM_SSE
+    const __m128 scale4 = _mm_set1_ps(scale);
+    for(; i + 4 <= count; i += 4) {
+        __m128 product = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(factors1 + i), _mm_loadu_ps(factors2 + i)), scale4);
+        _mm_storeu_ps(values + i, _mm_add_ps(_mm_loadu_ps(values + i), product));
+    }
+#endif
+    for(; i < count; ++i)
+        values[i] += factors1[i] * factors2[i] * scale;
+}
+
+//! \brief result[i] = values1[i] + values2[i]
+static void _Add(float* result, const float* values1, const float* values2, size_t count)
+{
+    size_t i = 0;
+#ifdef PARTICLE_SYSTEM_SSE
+    for(; i + 4 <= count; i += 4)
+        _mm_storeu_ps(result + i, _mm_add_ps(_mm_loadu_ps(values1 + i), _mm_loadu_ps(values2 + i)));
+#endif
+    for(; i < count; ++i)
+        result[i] = values1[i] + values2[i];
+}
+
+//! \brief values[i] += value
+static void _Add(float* values, float value, size_t count)
+{
+    size_t i = 0;
+#ifdef PARTICLE_SYSTEM_SSE
+    const __m128 value4 = _mm_set1_ps(value);
+    for(; i + 4 <= count; i += 4)
+        _mm_storeu_ps(values + i, _mm_add_ps(_mm_loadu_ps(values + i), value4));
+#endif
+    for(; i < count; ++i)
+        values[i] += value;
+}
+
+//! \brief values[i] *= factor
+static void _Multiply(float* values, float factor, size_t count)
+{
+    size_t i = 0;
+#ifdef PARTICLE_SYSTEM_SSE
+    const __m128 factor4 = _mm_set1_ps(factor);
+    for(; i + 4 <= count; i += 4)
+        _mm_storeu_ps(values + i, _mm_mul_ps(_mm_loadu_ps(values + i), factor4));
+#endif
+    for(; i < count; ++i)
+        values[i] *= factor;
+}
+
+//! \brief Computes the progress of each particle between its current and next keyframes, from 0.0 to 1.0.
+static void _ComputeKeyframeProgress(float* progress, const float* time, const float* start,
+                                     const float* scale, size_t count)
+{
+    size_t i = 0;
+#ifdef PARTICLE_SYSTEM_SSE
+    for(; i + 4 <= count; i += 4) {
+        __m128 elapsed = _mm_sub_ps(_mm_loadu_ps(time + i), _mm_loadu_ps(start + i));
+        _mm_storeu_ps(progress + i, _mm_mul_ps(elapsed, _mm_loadu_ps(scale + i)));
+    }
+#endif
+    for(; i < count; ++i)
+        progress[i] = (time[i] - start[i]) * scale[i];
+}
+
+//! \brief result[i] = from[i] + (to[i] - from[i]) * progress[i]
+static void _Interpolate(float* result, const float* from, const float* to, const float* progress, size_t count)
+{
+    size_t i = 0;
+#ifdef PARTICLE_SYSTEM_SSE
+    for(; i + 4 <= count; i += 4) {
+        __m128 from4 = _mm_loadu_ps(from + i);
+        __m128 delta = _mm_sub_ps(_mm_loadu_ps(to + i), from4);
+        _mm_storeu_ps(result + i, _mm_add_ps(from4, _mm_mul_ps(delta, _mm_loadu_ps(progress + i))));
+    }
+#endif
+    for(; i < count; ++i)
+        result[i] = from[i] + (to[i] - from[i]) * progress[i];
+}
+
+//! \brief Returns the index of the first particle from the given one which reached its next keyframe,
+//! or count if there is none.
+size_t FindNextKeyframeReached(const ParticleArrays &particles, size_t first, size_t count)
+{
+    const float* time = &particles.time[0];
+    const float* keyframe_end = &particles.keyframe_end[0];
+
+    size_t i = first;
+#ifdef PARTICLE_SYSTEM_SSE
+    for(; i + 4 <= count; i += 4) {
+        int mask = _mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(time + i), _mm_loadu_ps(keyframe_end + i)));
+        if(mask == 0)
+            continue;
+
+        for(size_t j = 0; j < 4; ++j) {
+            if(mask & (1 << j))
+                return i + j;
+        }
+    }
+#endif
+    for(; i < count; ++i) {
+        if(time[i] >= keyframe_end[i])
+            return i;
+    }
+    return count;
+}
+
+void UpdateParticleMotion(ParticleArrays &particles, size_t count, float t, const ParticleMotion &motion)
+{
+    if(count == 0)
+        return;
+
+    ParticleArrays &p = particles;
+
+    // interpolate to figure out the current keyframed properties. Once on the last keyframe,
+    // the progress is always zero, and both values are those of the last keyframe.
+    std::vector<float> &progress = p.keyframed[PARTICLE_ROTATION_SPEED];
+    _ComputeKeyframeProgress(&progress[0], &p.time[0], &p.keyframe_start[0], &p.keyframe_scale[0], count);
+    for(size_t k = PARTICLE_KEYFRAMED_PROPERTIES; k-- > 0;) {
+        // The rotation speed is interpolated last, since its array holds the progress meanwhile.
+        _Interpolate(&p.keyframed[k][0], &p.keyframe_from[k][0], &p.keyframe_to[k][0], &progress[0], count);
+    }
+
+    _AddScaled(&p.rotation_angle[0], &p.keyframed[PARTICLE_ROTATION_SPEED][0], &p.rotation_direction[0], t, count);
+
+    _Add(&p.combined_velocity_x[0], &p.velocity_x[0], &p.wind_velocity_x[0], count);
+    _Add(&p.combined_velocity_y[0], &p.velocity_y[0], &p.wind_velocity_y[0], count);
+
+    if(motion.wave_motion_used) {
+        for(size_t j = 0; j < count; ++j) {
+            if(p.wave_half_amplitude[j] <= 0.0f)
+                continue;
+
+            // find the magnitude of the wave velocity
+            float wave_speed = p.wave_half_amplitude[j] * sinf(p.wave_length_coefficient[j] * p.time[j]);
+
+            // now the wave velocity is just that wave speed times the particle's tangential vector
+            // Note the inverted x and y assignments
+            Position2D tangent(-p.combined_velocity_y[j], p.combined_velocity_x[j]);
+            float speed = sqrtf(tangent.GetLength2());
+            tangent.x /= speed;
+            tangent.y /= speed;
+
+            p.combined_velocity_x[j] += tangent.x * wave_speed;
+            p.combined_velocity_y[j] += tangent.y * wave_speed;
+        }
+    }
+
+    _AddScaled(&p.pos_x[0], &p.combined_velocity_x[0], t, count);
+    _AddScaled(&p.pos_y[0], &p.combined_velocity_y[0], t, count);
+
+    // client-specified acceleration (dv = a * t)
+    _AddScaled(&p.velocity_x[0], &p.acceleration_x[0], t, count);
+    _AddScaled(&p.velocity_y[0], &p.acceleration_y[0], t, count);
+
+    // radial acceleration: calculate unit vector from emitter center to this particle,
+    // and scale by the radial acceleration, if there is any
+    if(motion.radial_used || motion.tangential_used) {
+        const Position2D &attractor = motion.attractor;
+
+        for(size_t j = 0; j < count; ++j) {
+            bool use_radial     = (p.radial_acceleration[j] != 0.0f);
+            bool use_tangential = (p.tangential_acceleration[j] != 0.0f);
+
+            if(!use_radial && !use_tangential)
+                continue;
+
+            // unit vector from attractor to particle
+            Position2D attractor_to_particle(p.pos_x[j] - attractor.x, p.pos_y[j] - attractor.y);
+
+            float distance = sqrtf(attractor_to_particle.GetLength2());
+
+            if(distance != 0.0f) {
+                attractor_to_particle.x /= distance;
+                attractor_to_particle.y /= distance;
+            }
+
+            // radial acceleration
+            if(use_radial) {
+                float attraction = 1.0f;
+                if(motion.attractor_falloff != 0.0f)
+                    attraction = 1.0f - motion.attractor_falloff * distance;
+
+                if(attraction > 0.0f) {
+                    p.velocity_x[j] += attractor_to_particle.x * p.radial_acceleration[j] * t * attraction;
+                    p.velocity_y[j] += attractor_to_particle.y * p.radial_acceleration[j] * t * attraction;
+                }
+            }
+
+            // tangential acceleration
+            if(use_tangential) {
+                // tangent vector is simply perpendicular vector
+                // Note the inversion of x and y
+                p.velocity_x[j] += -attractor_to_particle.y * p.tangential_acceleration[j] * t;
+                p.velocity_y[j] += attractor_to_particle.x * p.tangential_acceleration[j] * t;
+            }
+        }
+    }
+
+    // damp the velocity. Without variation, all the particles share the same damping factor.
+    if(!motion.damping_variation_used) {
+        if(motion.damping != 1.0f) {
+            float damping = powf(motion.damping, t);
+            _Multiply(&p.velocity_x[0], damping, count);
+            _Multiply(&p.velocity_y[0], damping, count);
+        }
+    } else {
+        for(size_t j = 0; j < count; ++j) {
+            if(p.damping[j] != 1.0f) {
+                float damping = powf(p.damping[j], t);
+                p.velocity_x[j] *= damping;
+                p.velocity_y[j] *= damping;
+            }
+        }
+    }
+
+    _Add(&p.time[0], t, count);
+}
+
+bool IsParticleUpdateVectorized()
+{
+#ifdef PARTICLE_SYSTEM_SSE
+    return true;
+#else
+    return false;
+#endif
+}
+
+}  // namespace vt_mode_manager
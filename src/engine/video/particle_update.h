@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ***************************************************************************
+*** \file    particle_update.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the particle update kernels
+***
+*** The particle properties are updated for all the particles of a system at
+*** once, so that the loops go through contiguous arrays. They process four
+*** particles at once when SSE is available. The less common motions (waves,
+*** radial and tangential accelerations, per particle damping) are handled
+*** particle per particle, and only when the system uses them.
+***
+*** These functions don't depend on the video engine, so that they can be
+*** benchmarked on their own.
+*** **************************************************************************/
+
+#ifndef __PARTICLE_UPDATE_HEADER__
+#define __PARTICLE_UPDATE_HEADER__
+
+#include "particle.h"
+
+namespace vt_mode_manager
+{
+
+//! \brief The motion parameters shared by all the particles of a system.
+class ParticleMotion
+{
+public:
+    ParticleMotion():
+        wave_motion_used(false),
+        radial_used(false),
+        tangential_used(false),
+        attractor(0.0f, 0.0f),
+        attractor_falloff(0.0f),
+        damping_variation_used(false),
+        damping(1.0f)
+    {}
+
+    //! true if some particles may have a wave motion
+    bool wave_motion_used;
+
+    //! true if some particles may have a radial or tangential acceleration
+    bool radial_used;
+    bool tangential_used;
+
+    //! the point the radial and tangential accelerations are relative to
+    vt_common::Position2D attractor;
+
+    //! how quickly the radial acceleration falls off with the distance to the attractor
+    float attractor_falloff;
+
+    //! true if each particle has its own damping, false if they all use the damping below
+    bool damping_variation_used;
+    float damping;
+};
+
+/*!
+ * \brief returns the index of the first particle from the given one which reached
+ *        its next keyframe, or count if there is none
+ */
+size_t FindNextKeyframeReached(const ParticleArrays &particles, size_t first, size_t count);
+
+/*!
+ * \brief interpolates the keyframed properties, and moves the particles
+ * \param particles the particles to update, whose keyframes are already up to date
+ * \param count the number of particles alive
+ * \param t the time elapsed since the last update, in seconds
+ * \param motion the motion parameters of the particles system
+ */
+void UpdateParticleMotion(ParticleArrays &particles, size_t count, float t, const ParticleMotion &motion);
+
+//! \brief returns true if the particle update kernels use SSE instructions
+bool IsParticleUpdateVectorized();
+
+}  // namespace vt_mode_manager
+
+#endif  //! __PARTICLE_UPDATE_HEADER__
@@ -0,0 +1,166 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ***************************************************************************
+*** \file    particle_worker_pool.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the particle system update threads.
+*** **************************************************************************/
+
+#include "particle_worker_pool.h"
+
+#include "particle_system.h"
+
+#include "utils/utils_common.h"
+
+namespace vt_video
+{
+extern bool VIDEO_DEBUG;
+}
+
+namespace vt_mode_manager
+{
+
+ParticleWorkerPool::ParticleWorkerPool(uint32_t thread_count) :
+    _next_job(0),
+    _finished_jobs(0),
+    _running(false),
+    _stop(false)
+{
+    if (thread_count == 0) {
+        // Leave a core for the rest of the game, e.g. the audio streaming.
+        uint32_t cores = std::thread::hardware_concurrency();
+        thread_count = cores > 2 ? cores - 1 : 1;
+    }
+    if (thread_count > MAX_PARTICLE_THREADS)
+        thread_count = MAX_PARTICLE_THREADS;
+
+    for (uint32_t i = 1; i < thread_count; ++i)
+        _threads.push_back(std::thread(&ParticleWorkerPool::_Work, this));
+
+    IF_PRINT_DEBUG(vt_video::VIDEO_DEBUG) << "Particle systems updated by "
+                                          << GetThreadCount() << " thread(s)" << std::endl;
+}
+
+ParticleWorkerPool::~ParticleWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _work_condition.notify_all();
+
+    for (uint32_t i = 0; i < _threads.size(); ++i)
+        _threads[i].join();
+}
+
+void ParticleWorkerPool::AddJob(ParticleSystem* system, float frame_time, const EffectParameters* parameters)
+{
+    ParticleJob job;
+    job.system = system;
+    job.frame_time = frame_time;
+    job.parameters = parameters;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _jobs.push_back(job);
+}
+
+void ParticleWorkerPool::Run()
+{
+    if (_jobs.empty())
+        return;
+
+    // Not worth waking the workers up.
+    if (_threads.empty() || _jobs.size() == 1) {
+        for (uint32_t i = 0; i < _jobs.size(); ++i)
+            _RunJob(_jobs[i]);
+        _jobs.clear();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _next_job = 0;
+        _finished_jobs = 0;
+        _running = true;
+    }
+    _work_condition.notify_all();
+
+    _RunJobs();
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (_finished_jobs < _jobs.size())
+        _done_condition.wait(lock);
+
+    _running = false;
+    _jobs.clear();
+}
+
+void ParticleWorkerPool::_RunJobs()
+{
+    while (true) {
+        ParticleJob job;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_next_job >= _jobs.size())
+                return;
+            job = _jobs[_next_job++];
+        }
+
+        _RunJob(job);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_finished_jobs;
+    }
+}
+
+void ParticleWorkerPool::_Work()
+{
+    while (true) {
+        ParticleJob job;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (!_stop && !(_running && _next_job < _jobs.size()))
+                _work_condition.wait(lock);
+
+            if (_stop)
+                return;
+
+            job = _jobs[_next_job++];
+        }
+
+        _RunJob(job);
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            ++_finished_jobs;
+            if (_finished_jobs < _jobs.size())
+                continue;
+        }
+        _done_condition.notify_one();
+    }
+}
+
+void ParticleWorkerPool::_RunJob(const ParticleJob& job)
+{
+    job.system->Update(job.frame_time, *job.parameters);
+}
+
+ParticleWorkerPool::ParticleWorkerPool(const ParticleWorkerPool&)
+{
+    throw vt_utils::Exception("Not Implemented!", __FILE__, __LINE__, __FUNCTION__);
+}
+
+ParticleWorkerPool& ParticleWorkerPool::operator=(const ParticleWorkerPool&)
+{
+    throw vt_utils::Exception("Not Implemented!", __FILE__, __LINE__, __FUNCTION__);
+    return *this;
+}
+
+} // namespace vt_mode_manager
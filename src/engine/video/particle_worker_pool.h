@@ -0,0 +1,119 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ***************************************************************************
+*** \file    particle_worker_pool.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the particle system update threads.
+***
+*** The particle systems don't share any state until they are drawn, so the
+*** particle managers queue their updates here, and the queued updates are
+*** spread between worker threads and the main thread. Each particle system
+*** draws its random numbers from its own generator, so that the result doesn't
+*** depend on which thread updated it.
+*** **************************************************************************/
+
+#ifndef __PARTICLE_WORKER_POOL_HEADER__
+#define __PARTICLE_WORKER_POOL_HEADER__
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vt_mode_manager
+{
+
+class EffectParameters;
+class ParticleSystem;
+
+//! \brief The maximum number of threads updating the particle systems, the main thread included.
+const uint32_t MAX_PARTICLE_THREADS = 8;
+
+/** ***************************************************************************
+*** \brief Updates the queued particle systems using several threads.
+***
+*** The worker threads wait until Run() is called, and the main thread takes
+*** part in the updates until they are all done.
+*** **************************************************************************/
+class ParticleWorkerPool
+{
+public:
+    /** \param thread_count The number of threads updating the particle systems,
+    *** the main thread included. 0 picks a count depending on the number of CPU cores.
+    **/
+    explicit ParticleWorkerPool(uint32_t thread_count);
+
+    ~ParticleWorkerPool();
+
+    //! \brief Returns the number of threads updating the particle systems, the main thread included.
+    uint32_t GetThreadCount() const {
+        return static_cast<uint32_t>(_threads.size()) + 1;
+    }
+
+    /** \brief Queues a particle system update, done during the next call to Run().
+    *** \param parameters The effect parameters, which must stay valid until Run() returns.
+    **/
+    void AddJob(ParticleSystem* system, float frame_time, const EffectParameters* parameters);
+
+    //! \brief Updates every queued particle system, and returns once they are all updated.
+    void Run();
+
+private:
+    //! \brief A queued particle system update.
+    struct ParticleJob {
+        ParticleSystem* system;
+        float frame_time;
+        const EffectParameters* parameters;
+    };
+
+    //! \brief Updates queued particle systems until none is left. Called by the main thread.
+    void _RunJobs();
+
+    //! \brief The worker threads main function.
+    void _Work();
+
+    //! \brief Updates the particle system of a job.
+    static void _RunJob(const ParticleJob& job);
+
+    //! \brief The worker threads.
+    std::vector<std::thread> _threads;
+
+    //! \brief Protects the members below.
+    std::mutex _mutex;
+
+    //! \brief Notified when the jobs are started, or when the workers must stop.
+    std::condition_variable _work_condition;
+
+    //! \brief Notified when the last job is done.
+    std::condition_variable _done_condition;
+
+    //! \brief The queued jobs.
+    std::vector<ParticleJob> _jobs;
+
+    //! \brief The index of the next job to start.
+    size_t _next_job;
+
+    //! \brief The number of jobs done.
+    size_t _finished_jobs;
+
+    //! \brief Whether the jobs may be started, i.e. Run() was called.
+    bool _running;
+
+    //! \brief Tells the worker threads to stop.
+    bool _stop;
+
+    ParticleWorkerPool(const ParticleWorkerPool& copy);
+    ParticleWorkerPool& operator=(const ParticleWorkerPool& copy);
+}; // class ParticleWorkerPool
+
+} // namespace vt_mode_manager
+
+#endif // __PARTICLE_WORKER_POOL_HEADER__
@@ -0,0 +1,208 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    rectangle_packer.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for packing rectangles into a texture sheet.
+*** ***************************************************************************/
+
+#include "rectangle_packer.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace vt_video
+{
+
+namespace private_video
+{
+
+//! \brief Tells whether the first rectangle is inside the second one.
+static bool _IsContainedIn(const PackedRect& first, const PackedRect& second)
+{
+    return first.x >= second.x && first.y >= second.y
+        && first.x + first.width <= second.x + second.width
+        && first.y + first.height <= second.y + second.height;
+}
+
+RectanglePacker::RectanglePacker(uint32_t width, uint32_t height) :
+    _width(width),
+    _height(height),
+    _max_free_width(0),
+    _max_free_height(0)
+{
+    Clear();
+}
+
+bool RectanglePacker::Insert(uint32_t width, uint32_t height, uint32_t& x, uint32_t& y)
+{
+    if (width == 0 || height == 0 || !MayFit(width, height))
+        return false;
+
+    // Best short side fit: the free rectangle leaving the smallest leftover side,
+    // and then the smallest longer leftover side.
+    uint32_t best_short_side = std::numeric_limits<uint32_t>::max();
+    uint32_t best_long_side = std::numeric_limits<uint32_t>::max();
+    int32_t best_index = -1;
+    for (uint32_t i = 0; i < _free_rects.size(); ++i) {
+        const PackedRect& free_rect = _free_rects[i];
+        if (free_rect.width < width || free_rect.height < height)
+            continue;
+
+        uint32_t leftover_width = free_rect.width - width;
+        uint32_t leftover_height = free_rect.height - height;
+        uint32_t short_side = std::min(leftover_width, leftover_height);
+        uint32_t long_side = std::max(leftover_width, leftover_height);
+        if (short_side < best_short_side || (short_side == best_short_side && long_side < best_long_side)) {
+            best_short_side = short_side;
+            best_long_side = long_side;
+            best_index = static_cast<int32_t>(i);
+        }
+    }
+
+    if (best_index < 0)
+        return false;
+
+    PackedRect used_rect(_free_rects[best_index].x, _free_rects[best_index].y, width, height);
+    _PlaceUsedRect(used_rect);
+    _used_rects.push_back(used_rect);
+    _UpdateMaxFreeSize();
+
+    x = used_rect.x;
+    y = used_rect.y;
+    return true;
+}
+
+void RectanglePacker::Remove(const PackedRect& rect)
+{
+    if (_EraseUsedRect(rect))
+        _RebuildFreeRects();
+}
+
+void RectanglePacker::Remove(const std::vector<PackedRect>& rects)
+{
+    bool removed = false;
+    for (uint32_t i = 0; i < rects.size(); ++i) {
+        if (_EraseUsedRect(rects[i]))
+            removed = true;
+    }
+
+    if (removed)
+        _RebuildFreeRects();
+}
+
+void RectanglePacker::Clear()
+{
+    _used_rects.clear();
+    _free_rects.clear();
+    _free_rects.push_back(PackedRect(0, 0, _width, _height));
+    _UpdateMaxFreeSize();
+}
+
+uint32_t RectanglePacker::GetLargestFreeArea() const
+{
+    uint32_t largest_area = 0;
+    for (uint32_t i = 0; i < _free_rects.size(); ++i)
+        largest_area = std::max(largest_area, _free_rects[i].GetArea());
+    return largest_area;
+}
+
+bool RectanglePacker::_SplitFreeRect(const PackedRect& free_rect, const PackedRect& used_rect,
+                                     std::vector<PackedRect>& parts) const
+{
+    if (used_rect.x >= free_rect.x + free_rect.width || used_rect.x + used_rect.width <= free_rect.x ||
+            used_rect.y >= free_rect.y + free_rect.height || used_rect.y + used_rect.height <= free_rect.y)
+        return false;
+
+    // The free parts on each side of the used rectangle, each spanning the whole free rectangle.
+    if (used_rect.x > free_rect.x) {
+        parts.push_back(PackedRect(free_rect.x, free_rect.y,
+                                   used_rect.x - free_rect.x, free_rect.height));
+    }
+    if (used_rect.x + used_rect.width < free_rect.x + free_rect.width) {
+        uint32_t right = used_rect.x + used_rect.width;
+        parts.push_back(PackedRect(right, free_rect.y,
+                                   free_rect.x + free_rect.width - right, free_rect.height));
+    }
+    if (used_rect.y > free_rect.y) {
+        parts.push_back(PackedRect(free_rect.x, free_rect.y,
+                                   free_rect.width, used_rect.y - free_rect.y));
+    }
+    if (used_rect.y + used_rect.height < free_rect.y + free_rect.height) {
+        uint32_t bottom = used_rect.y + used_rect.height;
+        parts.push_back(PackedRect(free_rect.x, bottom,
+                                   free_rect.width, free_rect.y + free_rect.height - bottom));
+    }
+    return true;
+}
+
+void RectanglePacker::_PlaceUsedRect(const PackedRect& used_rect)
+{
+    std::vector<PackedRect> parts;
+    uint32_t kept_number = 0;
+    for (uint32_t i = 0; i < _free_rects.size(); ++i) {
+        if (!_SplitFreeRect(_free_rects[i], used_rect, parts))
+            _free_rects[kept_number++] = _free_rects[i];
+    }
+    _free_rects.erase(_free_rects.begin() + kept_number, _free_rects.end());
+
+    // The free rectangles left untouched are still maximal, so only the new parts
+    // may be contained in another free rectangle. Of identical parts, the first one is kept.
+    std::vector<PackedRect> maximal_parts;
+    for (uint32_t i = 0; i < parts.size(); ++i) {
+        bool contained = false;
+        for (uint32_t j = 0; j < kept_number && !contained; ++j)
+            contained = _IsContainedIn(parts[i], _free_rects[j]);
+        for (uint32_t j = 0; j < parts.size() && !contained; ++j) {
+            contained = j != i && _IsContainedIn(parts[i], parts[j])
+                && (j < i || !_IsContainedIn(parts[j], parts[i]));
+        }
+        if (!contained)
+            maximal_parts.push_back(parts[i]);
+    }
+    _free_rects.insert(_free_rects.end(), maximal_parts.begin(), maximal_parts.end());
+}
+
+bool RectanglePacker::_EraseUsedRect(const PackedRect& rect)
+{
+    for (uint32_t i = 0; i < _used_rects.size(); ++i) {
+        const PackedRect& used_rect = _used_rects[i];
+        if (used_rect.x == rect.x && used_rect.y == rect.y
+                && used_rect.width == rect.width && used_rect.height == rect.height) {
+            _used_rects[i] = _used_rects.back();
+            _used_rects.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void RectanglePacker::_RebuildFreeRects()
+{
+    _free_rects.clear();
+    _free_rects.push_back(PackedRect(0, 0, _width, _height));
+    for (uint32_t i = 0; i < _used_rects.size(); ++i)
+        _PlaceUsedRect(_used_rects[i]);
+    _UpdateMaxFreeSize();
+}
+
+void RectanglePacker::_UpdateMaxFreeSize()
+{
+    _max_free_width = 0;
+    _max_free_height = 0;
+    for (uint32_t i = 0; i < _free_rects.size(); ++i) {
+        _max_free_width = std::max(_max_free_width, _free_rects[i].width);
+        _max_free_height = std::max(_max_free_height, _free_rects[i].height);
+    }
+}
+
+} // namespace private_video
+
+} // namespace vt_video
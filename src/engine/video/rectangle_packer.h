@@ -0,0 +1,140 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    rectangle_packer.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for packing rectangles into a texture sheet.
+***
+*** The packer uses the MaxRects algorithm: it keeps a list of the maximal free
+*** rectangles, which may overlap. A new rectangle goes in the free rectangle
+*** leaving the shortest leftover side, and the free rectangles it intersects
+*** are split into the parts that remain free. When rectangles are removed,
+*** the free rectangles are found again from the ones still used, so that the
+*** freed space is fully recovered.
+*** ***************************************************************************/
+
+#ifndef __RECTANGLE_PACKER_HEADER__
+#define __RECTANGLE_PACKER_HEADER__
+
+#include <cstdint>
+#include <vector>
+
+namespace vt_video
+{
+
+namespace private_video
+{
+
+//! \brief A rectangle in a texture sheet, in pixels.
+struct PackedRect {
+    PackedRect():
+        x(0),
+        y(0),
+        width(0),
+        height(0)
+    {}
+
+    PackedRect(uint32_t rect_x, uint32_t rect_y, uint32_t rect_width, uint32_t rect_height):
+        x(rect_x),
+        y(rect_y),
+        width(rect_width),
+        height(rect_height)
+    {}
+
+    uint32_t GetArea() const {
+        return width * height;
+    }
+
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+};
+
+/** ****************************************************************************
+*** \brief Finds free places for rectangles of any size in a texture sheet.
+*** ***************************************************************************/
+class RectanglePacker
+{
+public:
+    RectanglePacker(uint32_t width, uint32_t height);
+
+    /** \brief Finds a free place for a rectangle, and marks it as used.
+    *** \param x, y Set to the top left corner of the place found.
+    *** \return false if there is no place left for the rectangle.
+    **/
+    bool Insert(uint32_t width, uint32_t height, uint32_t& x, uint32_t& y);
+
+    //! \brief Marks a rectangle given by Insert() as free again.
+    void Remove(const PackedRect& rect);
+
+    //! \brief Marks several rectangles given by Insert() as free again, at once.
+    void Remove(const std::vector<PackedRect>& rects);
+
+    //! \brief Marks the whole area as free.
+    void Clear();
+
+    /** \brief Tells whether a rectangle of the given size may fit.
+    *** This only compares the size with the largest free width and height,
+    *** so that full sheets are skipped without looking at their free rectangles.
+    **/
+    bool MayFit(uint32_t width, uint32_t height) const {
+        return width <= _max_free_width && height <= _max_free_height;
+    }
+
+    //! \brief Returns the number of free rectangles, which may overlap.
+    uint32_t GetNumberFreeRects() const {
+        return static_cast<uint32_t>(_free_rects.size());
+    }
+
+    //! \brief Returns the area of the largest free rectangle.
+    uint32_t GetLargestFreeArea() const;
+
+private:
+    uint32_t _width;
+    uint32_t _height;
+
+    //! \brief The maximal free rectangles.
+    std::vector<PackedRect> _free_rects;
+
+    //! \brief The rectangles given by Insert() and not removed yet.
+    std::vector<PackedRect> _used_rects;
+
+    //! \brief The largest width and height of the free rectangles, not necessarily of the same one.
+    uint32_t _max_free_width;
+    uint32_t _max_free_height;
+
+    /** \brief Splits a free rectangle intersecting the used one into the parts remaining free.
+    *** \param parts The parts are added to this vector.
+    *** \return false if the rectangles don't intersect, in which case nothing is done.
+    **/
+    bool _SplitFreeRect(const PackedRect& free_rect, const PackedRect& used_rect,
+                        std::vector<PackedRect>& parts) const;
+
+    /** \brief Replaces the free rectangles intersecting the used one by their parts remaining free.
+    *** The parts contained in another free rectangle are dropped.
+    **/
+    void _PlaceUsedRect(const PackedRect& used_rect);
+
+    //! \brief Removes a rectangle from the used ones. \return false if it isn't used.
+    bool _EraseUsedRect(const PackedRect& rect);
+
+    //! \brief Finds the free rectangles again, from the whole area and the used rectangles.
+    void _RebuildFreeRects();
+
+    //! \brief Updates the largest free width and height.
+    void _UpdateMaxFreeSize();
+};
+
+} // namespace private_video
+
+} // namespace vt_video
+
+#endif // __RECTANGLE_PACKER_HEADER__
@@ -0,0 +1,283 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    static_image_batch.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for drawing many images at fixed positions at once.
+*** ***************************************************************************/
+
+#include "engine/video/static_image_batch.h"
+
+#include "engine/video/video.h"
+#include "engine/video/gl/gl_sprite_buffer.h"
+
+#include "utils/utils_common.h"
+
+#include <algorithm>
+
+using namespace vt_video::private_video;
+
+namespace vt_video
+{
+
+//! \brief The number of values per image in the vertex data.
+const unsigned POSITIONS_PER_IMAGE = 4 * 3;
+const unsigned TEXTURE_COORDINATES_PER_IMAGE = 4 * 2;
+const unsigned COLORS_PER_IMAGE = 4 * 4;
+
+StaticImageBatch::StaticImageBatch() :
+    _sprite_buffer(nullptr)
+{
+}
+
+StaticImageBatch::~StaticImageBatch()
+{
+    delete _sprite_buffer;
+    _sprite_buffer = nullptr;
+}
+
+bool StaticImageBatch::AddImage(const StillImage& image, float x, float y)
+{
+    assert(_sprite_buffer == nullptr);
+
+    // Grayscale images need their own shader program.
+    if (image._texture == nullptr || image._grayscale || image._offset.x != 0.0f || image._offset.y != 0.0f)
+        return false;
+
+    // The batch doesn't check for pending images when drawing.
+    TextureManager->_FinishPendingUpload(image._image_texture);
+
+    BatchedImage batched_image;
+    batched_image.image = &image;
+    batched_image.animation = nullptr;
+    batched_image.frame_index = 0;
+    batched_image.x = x;
+    batched_image.y = y;
+    _images.push_back(batched_image);
+
+    return true;
+}
+
+bool StaticImageBatch::AddImage(const AnimatedImage& image, float x, float y)
+{
+    assert(_sprite_buffer == nullptr);
+
+    if (image.GetNumFrames() == 0)
+        return false;
+
+    // Every frame must be drawable using the same texture sheet and geometry.
+    const StillImage* first_frame = image.GetFrame(0);
+    for (uint32_t i = 0; i < image.GetNumFrames(); ++i) {
+        const StillImage* frame = image.GetFrame(i);
+        if (frame->_texture == nullptr || first_frame->_texture == nullptr)
+            return false;
+
+        if (frame->_texture->texture_sheet != first_frame->_texture->texture_sheet ||
+                frame->_smooth != first_frame->_smooth ||
+                frame->_grayscale ||
+                frame->_width != first_frame->_width ||
+                frame->_height != first_frame->_height ||
+                frame->_offset.x != 0.0f || frame->_offset.y != 0.0f)
+            return false;
+    }
+
+    // The batch doesn't check for pending images when drawing.
+    for (uint32_t i = 0; i < image.GetNumFrames(); ++i)
+        TextureManager->_FinishPendingUpload(image.GetFrame(i)->_image_texture);
+
+    BatchedImage batched_image;
+    batched_image.frame_index = image.GetCurrentFrameIndex();
+    batched_image.image = image.GetFrame(batched_image.frame_index);
+    batched_image.animation = &image;
+    batched_image.x = x;
+    batched_image.y = y;
+    _images.push_back(batched_image);
+
+    return true;
+}
+
+void StaticImageBatch::Finalize()
+{
+    assert(_sprite_buffer == nullptr);
+
+    if (_images.empty())
+        return;
+
+    if (_images.size() > gl::SpriteBuffer::MAX_SPRITES) {
+        IF_PRINT_WARNING(VIDEO_DEBUG) << "Too many images in the batch, only the first ones will be drawn: "
+                                      << _images.size() << std::endl;
+        _images.resize(gl::SpriteBuffer::MAX_SPRITES);
+    }
+
+    // Group the images by texture sheet.
+    std::stable_sort(_images.begin(), _images.end(),
+                     [](const BatchedImage& first, const BatchedImage& second) {
+        if (first.image->_texture->texture_sheet != second.image->_texture->texture_sheet)
+            return first.image->_texture->texture_sheet < second.image->_texture->texture_sheet;
+        return first.image->_smooth < second.image->_smooth;
+    });
+
+    std::vector<float> vertex_positions(_images.size() * POSITIONS_PER_IMAGE);
+    std::vector<float> vertex_colors(_images.size() * COLORS_PER_IMAGE);
+    _vertex_texture_coordinates.resize(_images.size() * TEXTURE_COORDINATES_PER_IMAGE);
+
+    for (unsigned i = 0; i < _images.size(); ++i) {
+        const BatchedImage& batched_image = _images[i];
+        const StillImage& image = *batched_image.image;
+
+        // The same geometry as ImageDescriptor::_DrawTexture() with top-left alignment,
+        // going downward.
+        float left = batched_image.x + (image._u1 * image._width);
+        float right = batched_image.x + (image._u2 * image._width);
+        float bottom = batched_image.y + image._height - (image._v1 * image._height);
+        float top = batched_image.y + image._height - (image._v2 * image._height);
+
+        float* positions = &vertex_positions[i * POSITIONS_PER_IMAGE];
+        positions[0] = left;  positions[1] = bottom; positions[2] = 0.0f;  // Vertex One.
+        positions[3] = right; positions[4] = bottom; positions[5] = 0.0f;  // Vertex Two.
+        positions[6] = right; positions[7] = top;    positions[8] = 0.0f;  // Vertex Three.
+        positions[9] = left;  positions[10] = top;   positions[11] = 0.0f; // Vertex Four.
+
+        _ComputeTextureCoordinates(image, &_vertex_texture_coordinates[i * TEXTURE_COORDINATES_PER_IMAGE]);
+
+        float* colors = &vertex_colors[i * COLORS_PER_IMAGE];
+        for (unsigned j = 0; j < 4; ++j) {
+            colors[(j * 4) + 0] = image._color[j][0];
+            colors[(j * 4) + 1] = image._color[j][1];
+            colors[(j * 4) + 2] = image._color[j][2];
+            colors[(j * 4) + 3] = image._color[j][3];
+        }
+
+        if (batched_image.animation != nullptr)
+            _animated_images.push_back(i);
+
+        // Start a new group when the texture sheet or its filtering changes.
+        TexSheet* texture_sheet = image._texture->texture_sheet;
+        if (_groups.empty() || _groups.back().texture_sheet != texture_sheet
+                || _groups.back().smooth != image._smooth) {
+            SheetGroup group;
+            group.texture_sheet = texture_sheet;
+            group.smooth = image._smooth;
+            group.first_image = i;
+            group.number_of_images = 0;
+            _groups.push_back(group);
+        }
+        ++_groups.back().number_of_images;
+    }
+
+    _sprite_buffer = new gl::SpriteBuffer(vertex_positions, _vertex_texture_coordinates, vertex_colors);
+}
+
+void StaticImageBatch::Draw()
+{
+    if (_sprite_buffer == nullptr)
+        return;
+
+    // Update the texture coordinates of the animated images which changed their frames.
+    bool frames_changed = false;
+    for (unsigned i = 0; i < _animated_images.size(); ++i) {
+        BatchedImage& batched_image = _images[_animated_images[i]];
+
+        uint32_t frame_index = batched_image.animation->GetCurrentFrameIndex();
+        if (frame_index == batched_image.frame_index)
+            continue;
+
+        batched_image.frame_index = frame_index;
+        batched_image.image = batched_image.animation->GetFrame(frame_index);
+        _ComputeTextureCoordinates(*batched_image.image,
+                                   &_vertex_texture_coordinates[_animated_images[i] * TEXTURE_COORDINATES_PER_IMAGE]);
+        frames_changed = true;
+    }
+
+    if (frames_changed)
+        _sprite_buffer->UpdateTextureCoordinates(_vertex_texture_coordinates);
+
+    VideoManager->PushMatrix();
+
+    Context& current_context = VideoManager->_current_context;
+    const CoordSys& coordinate_system = current_context.coordinate_system;
+
+    // Apply the screen shaking the same way ImageDescriptor::_DrawOrientation() does.
+    if (VideoManager->IsScreenShaking()) {
+        float shake_x = VideoManager->_shake_offset.x
+                        * (coordinate_system.GetRight() - coordinate_system.GetLeft())
+                        / VIDEO_STANDARD_RES_WIDTH;
+        float shake_y = VideoManager->_shake_offset.y
+                        * (coordinate_system.GetTop() - coordinate_system.GetBottom())
+                        / VIDEO_STANDARD_RES_HEIGHT;
+        VideoManager->MoveRelative(shake_x * coordinate_system.GetHorizontalDirection(),
+                                   shake_y * coordinate_system.GetVerticalDirection());
+    }
+
+    // The vertex positions go from left to right and top to bottom.
+    VideoManager->Scale(coordinate_system.GetHorizontalDirection(),
+                        -coordinate_system.GetVerticalDirection());
+
+    // Normal blending.
+    VideoManager->EnableBlending();
+    VideoManager->SetBlendFunction(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // Load the sprite shader program.
+    VideoManager->EnableTexture2D();
+    gl::ShaderProgram* shader_program = VideoManager->LoadShaderProgram(gl::shader_programs::Sprite);
+    assert(shader_program != nullptr);
+
+    // One draw call per texture sheet.
+    for (unsigned i = 0; i < _groups.size(); ++i) {
+        const SheetGroup& group = _groups[i];
+
+        TextureManager->_BindTexture(group.texture_sheet->tex_id);
+        group.texture_sheet->Smooth(group.smooth);
+
+        VideoManager->DrawSpriteBuffer(shader_program, _sprite_buffer,
+                                       group.first_image, group.number_of_images);
+    }
+
+    VideoManager->PopMatrix();
+}
+
+void StaticImageBatch::_ComputeTextureCoordinates(const StillImage& image, float* vertex_texture_coordinates) const
+{
+    const BaseTexture* texture = image._texture;
+
+    float s0 = texture->u1 + (image._u1 * (texture->u2 - texture->u1));
+    float s1 = texture->u1 + (image._u2 * (texture->u2 - texture->u1));
+    float t0 = texture->v1 + (image._v1 * (texture->v2 - texture->v1));
+    float t1 = texture->v1 + (image._v2 * (texture->v2 - texture->v1));
+
+    // Vertex One.
+    vertex_texture_coordinates[0] = s0;
+    vertex_texture_coordinates[1] = t1;
+
+    // Vertex Two.
+    vertex_texture_coordinates[2] = s1;
+    vertex_texture_coordinates[3] = t1;
+
+    // Vertex Three.
+    vertex_texture_coordinates[4] = s1;
+    vertex_texture_coordinates[5] = t0;
+
+    // Vertex Four.
+    vertex_texture_coordinates[6] = s0;
+    vertex_texture_coordinates[7] = t0;
+}
+
+StaticImageBatch::StaticImageBatch(const StaticImageBatch&)
+{
+    throw vt_utils::Exception("Not Implemented!", __FILE__, __LINE__, __FUNCTION__);
+}
+
+StaticImageBatch& StaticImageBatch::operator=(const StaticImageBatch&)
+{
+    throw vt_utils::Exception("Not Implemented!", __FILE__, __LINE__, __FUNCTION__);
+    return *this;
+}
+
+} // namespace vt_video
@@ -0,0 +1,138 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    static_image_batch.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for drawing many images at fixed positions at once.
+***
+*** A static image batch is typically used for map tile layers: the images
+*** and their positions are given once, and stored on the GPU grouped by
+*** texture sheet. Drawing the batch then costs a single draw call per
+*** texture sheet, no matter how many images it contains.
+***
+*** Animated images are supported as long as all their frames share the same
+*** texture sheet. Their texture coordinates are updated when drawing,
+*** only when one of them changed its frame.
+*** ***************************************************************************/
+
+#ifndef __STATIC_IMAGE_BATCH_HEADER__
+#define __STATIC_IMAGE_BATCH_HEADER__
+
+#include <cstdint>
+#include <vector>
+
+namespace vt_video
+{
+
+class AnimatedImage;
+class StillImage;
+
+namespace gl
+{
+class SpriteBuffer;
+}
+
+namespace private_video
+{
+class TexSheet;
+}
+
+//! \brief A set of images drawn at fixed positions, stored on the GPU.
+class StaticImageBatch
+{
+public:
+    StaticImageBatch();
+
+    ~StaticImageBatch();
+
+    /** \brief Adds an image to the batch.
+    *** \param image The image to add.
+    *** \param x The left position of the image, relative to the batch origin.
+    *** \param y The top position of the image, relative to the batch origin.
+    *** \return false if the image can't be batched: i.e. it has no texture, draw offsets or is grayscale.
+    *** \note The positions are given from left to right and top to bottom, whatever
+    *** the coordinate system used when drawing the batch.
+    **/
+    bool AddImage(const StillImage& image, float x, float y);
+
+    /** \brief Adds an animated image to the batch.
+    *** \note The image must remain valid as long as the batch is used.
+    *** Blended animations are drawn without the blending between frames.
+    *** \return false if the image can't be batched: i.e. its frames use different texture sheets.
+    **/
+    bool AddImage(const AnimatedImage& image, float x, float y);
+
+    /** \brief Stores the added images on the GPU.
+    *** No images can be added afterwards.
+    **/
+    void Finalize();
+
+    /** \brief Draws the batch, with its origin at the current draw cursor position.
+    *** The images are drawn with normal blending, ignoring the draw flags.
+    **/
+    void Draw();
+
+    //! \brief Tells whether the batch contains no images.
+    bool IsEmpty() const {
+        return _images.empty();
+    }
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design
+    //! to cause compilation errors when attempting to copy or assign this class.
+    StaticImageBatch(const StaticImageBatch& batch);
+    StaticImageBatch& operator=(const StaticImageBatch& batch);
+
+    //! \brief An image added to the batch.
+    struct BatchedImage {
+        //! \brief The still image, or the current frame of the animated image.
+        const StillImage* image;
+
+        //! \brief The animated image, if any.
+        const AnimatedImage* animation;
+
+        //! \brief The animation frame index used for the current texture coordinates.
+        uint32_t frame_index;
+
+        //! \brief The position of the image top left corner.
+        float x;
+        float y;
+    };
+
+    //! \brief A set of consecutive images sharing the same texture sheet.
+    struct SheetGroup {
+        private_video::TexSheet* texture_sheet;
+        bool smooth;
+        unsigned first_image;
+        unsigned number_of_images;
+    };
+
+    //! \brief Computes the texture coordinates of an image, storing them at the given place.
+    void _ComputeTextureCoordinates(const StillImage& image, float* vertex_texture_coordinates) const;
+
+    //! \brief The images, sorted by texture sheet once the batch is finalized.
+    std::vector<BatchedImage> _images;
+
+    //! \brief The indices of the animated images within _images.
+    std::vector<unsigned> _animated_images;
+
+    //! \brief The texture sheet groups.
+    std::vector<SheetGroup> _groups;
+
+    //! \brief The texture coordinates of every image, kept to update the animated ones.
+    std::vector<float> _vertex_texture_coordinates;
+
+    //! \brief The GPU buffers, created by Finalize().
+    gl::SpriteBuffer* _sprite_buffer;
+};
+
+} // namespace vt_video
+
+#endif // __STATIC_IMAGE_BATCH_HEADER__
@@ -27,6 +27,7 @@
 
 #include "script/script_read.h"
 #include "engine/system.h"
+#include "engine/profiler.h"
 
 #ifdef __APPLE__
 #   include <SDL_ttf.h>
@@ -59,6 +60,7 @@ FontProperties::FontProperties() :
     ascent(0),
     descent(0),
     ttf_font(nullptr),
+    glyph_atlas(nullptr),
     font_size(0)
 {
 }
@@ -70,11 +72,9 @@ FontProperties::~FontProperties()
 
 void FontProperties::ClearFont()
 {
-    // Free the font.
-    if (ttf_font)
-        TTF_CloseFont(ttf_font);
-
+    // The font is freed along with its glyph atlas, by the text supervisor.
     ttf_font = nullptr;
+    glyph_atlas = nullptr;
 }
 
 FontProperties::FontProperties(const FontProperties&)
@@ -229,162 +229,6 @@ void TextStyle::_UpdateTextShadowColor()
     }
 }
 
-namespace private_video
-{
-
-// -----------------------------------------------------------------------------
-// TextTexture class
-// -----------------------------------------------------------------------------
-
-TextTexture::TextTexture(const vt_utils::ustring &string_,
-                         const TextStyle &style_) :
-    BaseTexture(),
-    string(string_),
-    style(style_)
-{
-    // Enable image smoothing for text
-    smooth = true;
-}
-
-TextTexture::~TextTexture()
-{
-    // Remove this instance from the texture manager
-    TextureManager->_UnregisterTextTexture(this);
-}
-
-bool TextTexture::Regenerate()
-{
-    if(texture_sheet) {
-        texture_sheet->RemoveTexture(this);
-        TextureManager->_RemoveSheet(texture_sheet);
-        texture_sheet = nullptr;
-    }
-
-    ImageMemory buffer;
-    if(!TextManager->_RenderText(string, style, buffer))
-        return false;
-
-    width = buffer.GetWidth();
-    height = buffer.GetHeight();
-
-    TexSheet *sheet =
-        TextureManager->_InsertImageInTexSheet(this, buffer, true);
-    if(sheet == nullptr) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "Call to TextureManager::_InsertImageInTexSheet() returned nullptr" << std::endl;
-        return false;
-    }
-
-    texture_sheet = sheet;
-    return true;
-}
-
-bool TextTexture::Reload()
-{
-    // Regenerate text image if it is not already loaded in a texture sheet
-    if(texture_sheet == nullptr)
-        return Regenerate();
-
-    ImageMemory buffer;
-    if(!TextManager->_RenderText(string, style, buffer))
-        return false;
-
-    if(!texture_sheet->CopyRect(x, y, buffer)) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "Call to TextureSheet::CopyRect() failed" << std::endl;
-        return false;
-    }
-
-    return true;
-}
-
-// -----------------------------------------------------------------------------
-// TextElement class
-// -----------------------------------------------------------------------------
-
-TextElement::TextElement() :
-    ImageDescriptor(),
-    text_texture(nullptr)
-{}
-
-TextElement::TextElement(TextTexture *texture) :
-    ImageDescriptor(),
-    text_texture(texture)
-{
-    SetTexture(texture);
-}
-
-TextElement::~TextElement()
-{
-    Clear();
-}
-
-void TextElement::Clear()
-{
-    ImageDescriptor::Clear(); // This call will remove the texture reference for us
-    text_texture = nullptr;
-}
-
-void TextElement::Draw() const
-{
-    Draw(Color::white);
-}
-
-void TextElement::Draw(const Color &draw_color) const
-{
-    // Don't draw anything if this image is completely transparent (invisible).
-    if (IsFloatEqual(draw_color[3], 0.0f))
-        return;
-
-    VideoManager->PushMatrix();
-    _DrawOrientation();
-
-    if(draw_color == Color::white) {
-        _DrawTexture(_color);
-    } else {
-        Color modulated_colors[4];
-        modulated_colors[0] = _color[0] * draw_color;
-        modulated_colors[1] = _color[1] * draw_color;
-        modulated_colors[2] = _color[2] * draw_color;
-        modulated_colors[3] = _color[3] * draw_color;
-
-        _DrawTexture(modulated_colors);
-    }
-
-    VideoManager->PopMatrix();
-}
-
-void TextElement::SetTexture(TextTexture *texture)
-{
-    // Do nothing if the texture pointer is not going to change
-    if(text_texture == texture) {
-        return;
-    }
-
-    // Remove references and possibly delete the existing texture
-    if(text_texture != nullptr) {
-        _RemoveTextureReference();
-
-        text_texture = nullptr;
-        _texture = nullptr;
-    }
-
-    // Set the new texture
-    if(texture == nullptr) {
-        text_texture = nullptr;
-        _texture = nullptr;
-        _width = 0.0f;
-        _height = 0.0f;
-    } else {
-        texture->AddReference();
-        text_texture = texture;
-        _texture = texture;
-
-        _width = static_cast<float>(texture->width);
-        _height = static_cast<float>(texture->height);
-    }
-}
-
-} // namespace private_video
-
 // -----------------------------------------------------------------------------
 // TextImage class
 // -----------------------------------------------------------------------------
@@ -418,11 +262,9 @@ TextImage::TextImage(const TextImage &copy) :
     ImageDescriptor(copy),
     _text(copy._text),
     _style(copy._style),
-    _max_width(copy._max_width)
+    _max_width(copy._max_width),
+    _text_lines(copy._text_lines)
 {
-    for(uint32_t i = 0; i < copy._text_sections.size(); i++) {
-        _text_sections.push_back(new TextElement(*(copy._text_sections[i])));
-    }
 }
 
 TextImage &TextImage::operator=(const TextImage &copy)
@@ -431,17 +273,11 @@ TextImage &TextImage::operator=(const TextImage &copy)
     if(this == &copy)
         return *this;
 
-    // Remove references to any existing text sections
-    for(uint32_t i = 0; i < _text_sections.size(); ++i)
-        delete _text_sections[i];
-
-    _text_sections.clear();
-
+    ImageDescriptor::operator=(copy);
     _text = copy._text;
     _style = copy._style;
     _max_width = copy._max_width;
-    for(uint32_t i = 0; i < copy._text_sections.size(); ++i)
-        _text_sections.push_back(new TextElement(*(copy._text_sections[i])));
+    _text_lines = copy._text_lines;
 
     return *this;
 }
@@ -450,10 +286,7 @@ void TextImage::Clear()
 {
     ImageDescriptor::Clear();
     _text.clear();
-    for(uint32_t i = 0; i < _text_sections.size(); ++i)
-        delete _text_sections[i];
-
-    _text_sections.clear();
+    _text_lines.clear();
     _width = 0;
     _height = 0;
     // Don't reset the max width as the normal flow might want a new text again
@@ -462,28 +295,42 @@ void TextImage::Clear()
 
 void TextImage::Draw(const Color& draw_color) const
 {
+    PROFILE_ZONE("TextImage::Draw");
+
     // Don't draw anything if this image is completely transparent (invisible).
     if (IsFloatEqual(draw_color[3], 0.0f))
         return;
 
+    FontProperties* fp = _style.GetFontProperties();
+    if (_text_lines.empty() || fp == nullptr)
+        return;
+
     // Save the draw cursor position before drawing this text.
     VideoManager->PushMatrix();
 
-    for (uint32_t i = 0; i < _text_sections.size(); ++i) {
-        if (_style.GetShadowStyle() != VIDEO_TEXT_SHADOW_NONE) {
-            // Draw the text's shadow.
-            const float dx = VideoManager->_current_context.coordinate_system.GetHorizontalDirection() * _style.GetShadowOffsetX();
-            const float dy = VideoManager->_current_context.coordinate_system.GetVerticalDirection() * _style.GetShadowOffsetY();
-            VideoManager->MoveRelative(dx, dy);
-            _text_sections[i]->Draw(draw_color * _style.GetShadowColor());
-            VideoManager->MoveRelative(-dx, -dy);
-        }
+    const CoordSys& coordinate_system = VideoManager->_current_context.coordinate_system;
+    if (VideoManager->IsScreenShaking()) {
+        float shake_x = VideoManager->_shake_offset.x * (coordinate_system.GetRight() - coordinate_system.GetLeft())
+                        / VIDEO_STANDARD_RES_WIDTH;
+        float shake_y = VideoManager->_shake_offset.y * (coordinate_system.GetTop() - coordinate_system.GetBottom())
+                        / VIDEO_STANDARD_RES_HEIGHT;
+        VideoManager->MoveRelative(shake_x * coordinate_system.GetHorizontalDirection(),
+                                   shake_y * coordinate_system.GetVerticalDirection());
+    }
+
+    const float shadow_x = coordinate_system.GetHorizontalDirection() * _style.GetShadowOffsetX();
+    const float shadow_y = coordinate_system.GetVerticalDirection() * _style.GetShadowOffsetY();
+
+    for (uint32_t i = 0; i < _text_lines.size(); ++i) {
+        // Draw the text's shadow.
+        if (_style.GetShadowStyle() != VIDEO_TEXT_SHADOW_NONE)
+            TextManager->_DrawTextLine(_text_lines[i], fp, draw_color * _style.GetShadowColor(), shadow_x, shadow_y);
 
         // Draw the text.
-        _text_sections[i]->Draw(draw_color * _style.GetColor());
+        TextManager->_DrawTextLine(_text_lines[i], fp, draw_color * _style.GetColor());
 
         // Move the draw cursor one line down.
-        VideoManager->MoveRelative(0.0f, _style.GetFontProperties()->line_skip * -VideoManager->_current_context.coordinate_system.GetVerticalDirection());
+        VideoManager->MoveRelative(0.0f, fp->line_skip * -coordinate_system.GetVerticalDirection());
     }
 
     // Restore the position of the draw cursor.
@@ -500,50 +347,33 @@ void TextImage::SetWordWrapWidth(uint32_t width)
 
 void TextImage::_Regenerate()
 {
+    PROFILE_ZONE("TextImage::Layout");
+
     _width = 0.0f;
     _height = 0.0f;
 
-    for (uint32_t i = 0; i < _text_sections.size(); ++i)
-        delete _text_sections[i];
-
-    _text_sections.clear();
+    _text_lines.clear();
 
     if(_text.empty())
         return;
 
     FontProperties* fp = _style.GetFontProperties();
-    if (fp == nullptr || fp->ttf_font == nullptr) {
+    if (fp == nullptr || fp->glyph_atlas == nullptr) {
         IF_PRINT_WARNING(VIDEO_DEBUG) << "invalid font or font properties"
                                       << std::endl;
         return;
     }
 
-    // Iterate through each line of text and render a text texture for each one.
-    std::vector<ustring> lines_array = TextManager->WrapText(_text, fp->ttf_font, _max_width);
-    std::vector<ustring>::iterator line_iter;
-    for(line_iter = lines_array.begin(); line_iter != lines_array.end(); ++line_iter) {
-
-        TextElement *new_element = new TextElement();
-        // If this line is only a newline character or is an empty string, create an empty TextElement object
-        if((*line_iter) == ustring(&NEW_LINE) || (*line_iter).empty()) {
-            new_element->SetDimensions(0.0f, static_cast<float>(fp->line_skip));
-        }
-        // Otherwise, create a new TextTexture to be managed by the new element
-        else {
-            // PRINT_DEBUG << **line_iter << std::endl;
-            TextTexture *texture = new TextTexture(*line_iter, _style);
-            if(texture->Regenerate() == false) {
-                IF_PRINT_WARNING(VIDEO_DEBUG) << "call to TextTexture::_Regenerate() failed" << std::endl;
-            }
-            TextureManager->_RegisterTextTexture(texture);
-
-            // Resize the TextImage width if this line is wider than the current width
-            if(texture->width > _width)
-                _width = static_cast<float>(texture->width);
+    // Lay out each line of text using the font glyphs. Nothing is rendered here.
+    std::vector<ustring> lines_array = TextManager->WrapText(_text, fp, _max_width);
+    _text_lines.resize(lines_array.size());
+    for(uint32_t i = 0; i < lines_array.size(); ++i) {
+        const ustring& line = lines_array[i];
+        fp->glyph_atlas->LayoutText(line.c_str(), line.length(), _text_lines[i]);
 
-            new_element->SetTexture(texture); // Automatically adds a reference to texture
-        }
-        _text_sections.push_back(new_element);
+        // Resize the TextImage width if this line is wider than the current width
+        if(_text_lines[i].width > _width)
+            _width = static_cast<float>(_text_lines[i].width);
 
         // Increase height by the font specified line height
         _height += fp->line_skip;
@@ -554,31 +384,19 @@ void TextImage::_Regenerate()
 // TextSupervisor class
 // -----------------------------------------------------------------------------
 
-TextSupervisor::TextSupervisor() :
-    _text_texture(0),
-    _text_texture_width(0),
-    _text_texture_height(0)
+TextSupervisor::TextSupervisor()
 {
-    glGenTextures(1, &_text_texture);
-    if (_text_texture == 0) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "call to glGenTextures() failed" << std::endl;
-        assert(_text_texture != 0);
-    }
 }
 
 TextSupervisor::~TextSupervisor()
 {
-    // Clean up the text texture.
-    if (_text_texture != 0) {
-        GLuint textures[] = { _text_texture };
-        glDeleteTextures(1, textures);
-        _text_texture = 0;
-    }
-
-    // Remove all loaded fonts.  Then, shutdown the SDL_ttf library.
+    // Remove all loaded fonts and their glyphs.  Then, shutdown the SDL_ttf library.
     for (auto it = _font_map.begin(); it != _font_map.end(); ++it)
         delete it->second;
 
+    for (auto it = _glyph_atlases.begin(); it != _glyph_atlases.end(); ++it)
+        delete it->second;
+
     TTF_Quit();
 }
 
@@ -752,14 +570,11 @@ bool TextSupervisor::_LoadFont(const std::string& textstyle_name,
             return true;
     }
 
-    // Attempt to load the font
-    TTF_Font *font = TTF_OpenFont(font_filename.c_str(), font_size);
-    if(font == nullptr) {
-        PRINT_ERROR << "Call to TTF_OpenFont() failed to load the font file: "
-                    << font_filename  << std::endl
-                    << TTF_GetError() << std::endl;
+    // Attempt to load the font, or reuse it if it was already loaded
+    GlyphAtlas *glyph_atlas = _GetGlyphAtlas(font_filename, font_size);
+    if(glyph_atlas == nullptr)
         return false;
-    }
+    TTF_Font *font = glyph_atlas->GetTTFFont();
 
     // Get or Create a new FontProperties object for this font and set all of the properties according to SDL_ttf
     FontProperties* fp = reload ? it->second : new FontProperties();
@@ -775,6 +590,7 @@ bool TextSupervisor::_LoadFont(const std::string& textstyle_name,
         fp->ClearFont();
 
     fp->ttf_font = font;
+    fp->glyph_atlas = glyph_atlas;
     fp->font_filename = font_filename;
     fp->font_size = font_size;
     fp->height = TTF_FontHeight(font);
@@ -798,7 +614,8 @@ void TextSupervisor::_FreeFont(const std::string &font_name)
         return;
     }
 
-    // Free the font and remove it from the font cache
+    // Free the font properties and remove them from the font cache.
+    // The glyph atlas is kept for the text images still using its glyphs.
     delete it->second;
 
     // Remove the data from the map once freed.
@@ -818,101 +635,73 @@ FontProperties *TextSupervisor::_GetFontProperties(const std::string &font_name)
 
 void TextSupervisor::Draw(const ustring &text, const TextStyle &style)
 {
+    PROFILE_ZONE("TextSupervisor::Draw");
+
     if (text.empty()) {
         IF_PRINT_WARNING(VIDEO_DEBUG) << "empty string was passed to function" << std::endl;
         return;
     }
 
     FontProperties *fp = style.GetFontProperties();
-    if (fp == nullptr || fp->ttf_font == nullptr) {
+    if (fp == nullptr || fp->glyph_atlas == nullptr) {
         IF_PRINT_WARNING(VIDEO_DEBUG) << "failed because font was invalid: " << style.GetFontName() << std::endl;
         return;
     }
 
     VideoManager->PushState();
 
-    // Break the string into lines and render the shadow and text for each line
-    uint16_t buffer[2048];
+    const CoordSys& coordinate_system = VideoManager->_current_context.coordinate_system;
+    const float shadow_x = coordinate_system.GetHorizontalDirection() * style.GetShadowOffsetX();
+    const float shadow_y = coordinate_system.GetVerticalDirection() * style.GetShadowOffsetY();
+
+    // Break the string into lines and draw the shadow and text for each line
     size_t last_line = 0;
     do {
-        // Find the next new line character in the string and save the line
-        size_t next_line;
-        for(next_line = last_line; next_line < text.length(); next_line++) {
-            if(text[next_line] == NEW_LINE)
-                break;
+        // Find the next new line character in the string
+        size_t next_line = last_line;
+        while (next_line < text.length() && text[next_line] != NEW_LINE)
+            ++next_line;
 
-            buffer[next_line - last_line] = text[next_line];
-        }
-        buffer[next_line - last_line] = 0;
+        // Lay out the line. Empty lines have no glyphs and only move the draw cursor.
+        fp->glyph_atlas->LayoutText(text.c_str() + last_line, next_line - last_line, _draw_line);
         last_line = next_line + 1;
 
-        // If this line is empty, skip on to the next one
-        if(buffer[0] == 0) {
-            VideoManager->MoveRelative(0, -fp->line_skip * VideoManager->_current_context.coordinate_system.GetVerticalDirection());
-            continue;
-        }
-
-        // Save the draw cursor position before drawing this text.
-        VideoManager->PushMatrix();
-
-        // If text shadows are enabled...
-        if (style.GetShadowStyle() != VIDEO_TEXT_SHADOW_NONE) {
-            // Draw the text with its shadow.
-            _RenderText(buffer, fp, style.GetColor(), style.GetShadowOffsetX(), style.GetShadowOffsetY(), style.GetShadowColor());
-        } else {
-            // Draw the text.
-            _RenderText(buffer, fp, style.GetColor());
-        }
+        // If text shadows are enabled, draw the shadow first.
+        if (style.GetShadowStyle() != VIDEO_TEXT_SHADOW_NONE)
+            _DrawTextLine(_draw_line, fp, style.GetShadowColor(), shadow_x, shadow_y);
 
-        // Restore the position of the draw cursor.
-        VideoManager->PopMatrix();
+        // Draw the text.
+        _DrawTextLine(_draw_line, fp, style.GetColor());
 
         // Move the draw cursor one line down.
-        VideoManager->MoveRelative(0, -fp->line_skip * VideoManager->_current_context.coordinate_system.GetVerticalDirection());
+        VideoManager->MoveRelative(0, -fp->line_skip * coordinate_system.GetVerticalDirection());
 
     } while (last_line < text.length());
 
     VideoManager->PopState();
 }
 
-int32_t TextSupervisor::CalculateTextWidth(TTF_Font* ttf_font, const vt_utils::ustring &text)
+int32_t TextSupervisor::CalculateTextWidth(FontProperties* font_properties, const vt_utils::ustring &text)
 {
-    if(ttf_font == nullptr) {
+    if(font_properties == nullptr || font_properties->glyph_atlas == nullptr) {
         IF_PRINT_WARNING(VIDEO_DEBUG) << "Invalid font" << std::endl;
         return -1;
     }
 
-    int32_t width;
-    if(TTF_SizeUNICODE(ttf_font, text.c_str(), &width, nullptr) == -1) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "Call to TTF_SizeUNICODE failed with TTF error: " << TTF_GetError() << std::endl;
-        return -1;
-    }
-
-    return width;
+    return font_properties->glyph_atlas->CalculateTextWidth(text.c_str(), text.length());
 }
 
-int32_t TextSupervisor::CalculateTextWidth(TTF_Font* ttf_font, const std::string &text)
+int32_t TextSupervisor::CalculateTextWidth(FontProperties* font_properties, const std::string &text)
 {
-    if(ttf_font == nullptr) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "Invalid font" << std::endl;
-        return -1;
-    }
-
-    int32_t width;
-    if(TTF_SizeText(ttf_font, text.c_str(), &width, nullptr) == -1) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "Call to TTF_SizeText failed with TTF error: " << TTF_GetError() << std::endl;
-        return -1;
-    }
-
-    return width;
+    return CalculateTextWidth(font_properties, MakeUnicodeString(text));
 }
 
 std::vector<vt_utils::ustring> TextSupervisor::WrapText(const vt_utils::ustring& text,
-                                                        TTF_Font* ttf_font,
+                                                        FontProperties* font_properties,
                                                         uint32_t max_width)
 {
     std::vector<vt_utils::ustring> lines_array;
-    if (text.empty() || max_width == 0) {
+    if (text.empty() || max_width == 0 || font_properties == nullptr) {
         // This can happen when called with uninit // gui objects.
         return lines_array;
     }
@@ -947,6 +736,10 @@ std::vector<vt_utils::ustring> TextSupervisor::WrapText(const vt_utils::ustring&
     if (temp_text.length() > 0)
         lines_array.push_back(temp_text);
 
+    // Some languages have spaces in the sentence, some don't (Japanese, Chinese, ...)
+    std::string locale = vt_system::SystemManager->GetLanguageLocale();
+    bool interwords_spaces = vt_system::SystemManager->GetLocaleProperty(locale).UsesInterWordsSpaces();
+
     // We then perform word wrapping in a loop until all the text is added
     // And copy it into the new vector
     std::vector<vt_utils::ustring> wrapped_lines_array;
@@ -960,12 +753,8 @@ std::vector<vt_utils::ustring> TextSupervisor::WrapText(const vt_utils::ustring&
             continue;
         }
 
-        // Some languages have spaces in the sentence, some don't (Japanese, Chinese, ...)
-        std::string locale = vt_system::SystemManager->GetLanguageLocale();
-        bool interwords_spaces = vt_system::SystemManager->GetLocaleProperty(locale).UsesInterWordsSpaces();
-
         while(!temp_line.empty()) {
-            int32_t text_width = TextManager->CalculateTextWidth(ttf_font, temp_line);
+            int32_t text_width = CalculateTextWidth(font_properties, temp_line);
 
             // If the text can fit in the text box, add the whole line and return
             if(text_width < (int32_t)max_width) {
@@ -984,7 +773,7 @@ std::vector<vt_utils::ustring> TextSupervisor::WrapText(const vt_utils::ustring&
                 // If we meet a space character (0x20), we can wrap the text
                 // If the current language don't have any spaces in the sentence, check all words.
                 if (!interwords_spaces || temp_line[num_wrapped_chars] == SPACE_CHAR) {
-                    int32_t text_width = TextManager->CalculateTextWidth(ttf_font, wrapped_line);
+                    int32_t text_width = CalculateTextWidth(font_properties, wrapped_line);
 
                     if(text_width < (int32_t)max_width) {
                         // We haven't gone past the breaking point: mark this as a possible breaking point
@@ -1002,7 +791,7 @@ std::vector<vt_utils::ustring> TextSupervisor::WrapText(const vt_utils::ustring&
             } // while (num_wrapped_chars < line_length)
 
             // Figure out the number of characters in the wrapped line and construct the wrapped line
-            text_width = TextManager->CalculateTextWidth(ttf_font, wrapped_line);
+            text_width = CalculateTextWidth(font_properties, wrapped_line);
             if(text_width >= (int32_t)max_width && last_breakable_index != -1) {
                 num_wrapped_chars = last_breakable_index;
             }
@@ -1027,247 +816,51 @@ std::vector<vt_utils::ustring> TextSupervisor::WrapText(const vt_utils::ustring&
     return wrapped_lines_array;
 }
 
-void TextSupervisor::_RenderText(const uint16_t* text, FontProperties* font_properties, const Color& color)
+GlyphAtlas* TextSupervisor::_GetGlyphAtlas(const std::string& font_filename, uint32_t size)
 {
-    if (text == nullptr || *text == 0) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "invalid argument, empty or null string" << std::endl;
-        assert(text != nullptr && *text != 0);
-        return;
-    }
+    const std::string key = font_filename + "@" + NumberToString(size);
+    auto it = _glyph_atlases.find(key);
+    if (it != _glyph_atlases.end())
+        return it->second;
 
-    if (font_properties == nullptr || font_properties->ttf_font == nullptr) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "invalid argument, nullptr font properties or nullptr ttf font" << std::endl;
-        assert(font_properties != nullptr && font_properties->ttf_font != nullptr);
-        return;
-    }
-
-    // Render the text.
-    const SDL_Color white = { 255, 255, 255, 255 };
-    SDL_Surface* surface = TTF_RenderUNICODE_Blended(font_properties->ttf_font, text, white);
-    if (surface == nullptr) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "call to TTF_RenderUNICODE_Blended() failed" << std::endl;
-        assert(surface != nullptr);
-        return;
-    }
-
-    // Retrieve the size of the text.
-    int32_t font_width = 0, font_height = 0;
-    if (TTF_SizeUNICODE(font_properties->ttf_font, text, &font_width, &font_height) != 0) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "call to TTF_SizeUNICODE() failed" << std::endl;
-        SDL_FreeSurface(surface);
-        assert(false);
-        return;
-    }
-
-    // Enable texturing.
-    VideoManager->EnableTexture2D();
-
-    // Bind the OpenGL texture.
-    TextureManager->_BindTexture(_text_texture);
-
-    // Lock the SDL surface.
-    SDL_LockSurface(surface);
-
-    //
-    // Send the surface pixel data to OpenGL.
-    //
-
-    if (_text_texture_width == static_cast<GLuint>(surface->w) &&
-        _text_texture_height == static_cast<GLuint>(surface->h)) {
-        // The size of the old texture is the same.  Just update the pixel data.
-        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _text_texture_width, _text_texture_height, GL_RGBA, GL_UNSIGNED_BYTE, surface->pixels);
-    } else {
-        // The size of the old texture is different.  Update the storage definition as well as the pixel data.
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, surface->w, surface->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, surface->pixels);
+    TTF_Font *font = TTF_OpenFont(font_filename.c_str(), size);
+    if(font == nullptr) {
+        PRINT_ERROR << "Call to TTF_OpenFont() failed to load the font file: "
+                    << font_filename  << std::endl
+                    << TTF_GetError() << std::endl;
+        return nullptr;
     }
 
-    // Update the texture's width and height.
-    _text_texture_width = surface->w;
-    _text_texture_height = surface->h;
-
-    // Unlock the SDL surface.
-    SDL_UnlockSurface(surface);
-
-    // Update some of the OpenGL texture parameters.
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    // Enable blending.
-    VideoManager->EnableBlending();
-
-    // Update the blending function.
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    // Push the matrix stack.
-    VideoManager->PushMatrix();
-
-    // Update the transmation matrix.
-    CoordSys& coordinate_system = VideoManager->_current_context.coordinate_system;
-    float x_offset = ((VideoManager->_current_context.x_align + 1) * font_width) * 0.5f * -coordinate_system.GetHorizontalDirection();
-    float y_offset = ((VideoManager->_current_context.y_align + 1) * font_height) * 0.5f * -coordinate_system.GetVerticalDirection();
-    VideoManager->MoveRelative(x_offset, y_offset);
-
-    // Load the shader program.
-    gl::ShaderProgram* shader_program = VideoManager->LoadShaderProgram(gl::shader_programs::Sprite);
-    assert(shader_program != nullptr);
-
-    // The vertex positions.
-    float vertex_positions[] =
-    {
-        0.0f,                           0.0f,                            0.0f, // Vertex One.
-        static_cast<float>(font_width), 0.0f,                            0.0f, // Vertex Two.
-        static_cast<float>(font_width), static_cast<float>(font_height), 0.0f, // Vertex Three.
-        0.0f,                           static_cast<float>(font_height), 0.0f  // Vertex Four.
-    };
-
-    // The vertex texture coordinates.
-    float vertex_texture_coordinates[] =
-    {
-        0.0f, 0.0f, // Vertex One.
-        1.0f, 0.0f, // Vertex Two.
-        1.0f, 1.0f, // Vertex Three.
-        0.0f, 1.0f  // Vertex Four.
-    };
-
-    // The vertex colors.
-    float vertex_colors[] =
-    {
-        1.0f, 1.0f, 1.0f, 1.0f, // Vertex One.
-        1.0f, 1.0f, 1.0f, 1.0f, // Vertex Two.
-        1.0f, 1.0f, 1.0f, 1.0f, // Vertex Three.
-        1.0f, 1.0f, 1.0f, 1.0f  // Vertex Four.
-    };
-
-    // Draw the text.
-    VideoManager->DrawSprite(shader_program, vertex_positions, vertex_texture_coordinates, vertex_colors, color);
-
-    // Unload the shader program.
-    VideoManager->UnloadShaderProgram();
-
-    // Restore the transformation stack.
-    VideoManager->PopMatrix();
-
-    // Clean up.
-    if (surface != nullptr) {
-        SDL_FreeSurface(surface);
-        surface = nullptr;
-    }
+    GlyphAtlas* glyph_atlas = new GlyphAtlas(font);
+    _glyph_atlases[key] = glyph_atlas;
+    return glyph_atlas;
 }
 
-void TextSupervisor::_RenderText(const uint16_t* text, FontProperties* font_properties,
-                                 const Color& color,
-                                 float shadow_offset_x, float shadow_offset_y,
-                                 const Color& color_shadow)
+void TextSupervisor::_DrawTextLine(const TextLine& line, FontProperties* font_properties,
+                                   const Color& color, float offset_x, float offset_y)
 {
-    if (text == nullptr || *text == 0) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "invalid argument, empty or null string" << std::endl;
-        assert(text != nullptr && *text != 0);
+    if (line.glyphs.empty())
         return;
-    }
 
-    if (font_properties == nullptr || font_properties->ttf_font == nullptr) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "invalid argument, nullptr font properties or nullptr ttf font" << std::endl;
-        assert(font_properties != nullptr && font_properties->ttf_font != nullptr);
-        return;
-    }
+    // Align the line as if it was a single image.
+    const Context& context = VideoManager->_current_context;
+    const float h_direction = context.coordinate_system.GetHorizontalDirection();
+    const float v_direction = context.coordinate_system.GetVerticalDirection();
+    const float line_x = offset_x - ((context.x_align + 1) * line.width) * 0.5f * h_direction;
+    const float line_y = offset_y - ((context.y_align + 1) * font_properties->height) * 0.5f * v_direction;
 
-    // Render the text.
-    const SDL_Color white = { 255, 255, 255, 255 };
-    SDL_Surface* surface = TTF_RenderUNICODE_Blended(font_properties->ttf_font, text, white);
-    if (surface == nullptr) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "call to TTF_RenderUNICODE_Blended() failed" << std::endl;
-        assert(surface != nullptr);
-        return;
-    }
-
-    // Retrieve the size of the text.
-    int32_t font_width = 0, font_height = 0;
-    if (TTF_SizeUNICODE(font_properties->ttf_font, text, &font_width, &font_height) != 0) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "call to TTF_SizeUNICODE() failed" << std::endl;
-        SDL_FreeSurface(surface);
-        assert(false);
-        return;
-    }
-
-    // Enable texturing.
+    // Enable texturing and blending.
     VideoManager->EnableTexture2D();
-
-    // Bind the OpenGL texture.
-    TextureManager->_BindTexture(_text_texture);
-
-    // Lock the SDL surface.
-    SDL_LockSurface(surface);
-
-    //
-    // Send the surface pixel data to OpenGL.
-    //
-
-    if (_text_texture_width == static_cast<GLuint>(surface->w) &&
-        _text_texture_height == static_cast<GLuint>(surface->h)) {
-        // The size of the old texture is the same.  Just update the pixel data.
-        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _text_texture_width, _text_texture_height, GL_RGBA, GL_UNSIGNED_BYTE, surface->pixels);
-    } else {
-        // The size of the old texture is different.  Update the storage definition as well as the pixel data.
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, surface->w, surface->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, surface->pixels);
-    }
-
-    // Update the texture's width and height.
-    _text_texture_width = surface->w;
-    _text_texture_height = surface->h;
-
-    // Unlock the SDL surface.
-    SDL_UnlockSurface(surface);
-
-    // Update some of the OpenGL texture parameters.
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    // Enable blending.
     VideoManager->EnableBlending();
-
-    // Update the blending function.
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    //
-    // Draw the shadow first.
-    //
-
-    // Push the transformation stack.
-    VideoManager->PushMatrix();
-
-    // Apply the shadow offset.
-    const float delta_x = VideoManager->_current_context.coordinate_system.GetHorizontalDirection() * shadow_offset_x;
-    const float delta_y = VideoManager->_current_context.coordinate_system.GetVerticalDirection() * shadow_offset_y;
-    VideoManager->MoveRelative(delta_x, delta_y);
-
-    // Update the transmation matrix.
-    CoordSys& coordinate_system = VideoManager->_current_context.coordinate_system;
-    float x_offset = ((VideoManager->_current_context.x_align + 1) * font_width) * 0.5f * -coordinate_system.GetHorizontalDirection();
-    float y_offset = ((VideoManager->_current_context.y_align + 1) * font_height) * 0.5f * -coordinate_system.GetVerticalDirection();
-    VideoManager->MoveRelative(x_offset, y_offset);
+    if (context.blend == 2)
+        VideoManager->SetBlendFunction(GL_SRC_ALPHA, GL_ONE); // Additive blending
+    else
+        VideoManager->SetBlendFunction(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); // Normal blending
 
     // Load the shader program.
     gl::ShaderProgram* shader_program = VideoManager->LoadShaderProgram(gl::shader_programs::Sprite);
     assert(shader_program != nullptr);
 
-    // The vertex positions.
-    float vertex_positions[] =
-    {
-        0.0f,                           0.0f,                            0.0f, // Vertex One.
-        static_cast<float>(font_width), 0.0f,                            0.0f, // Vertex Two.
-        static_cast<float>(font_width), static_cast<float>(font_height), 0.0f, // Vertex Three.
-        0.0f,                           static_cast<float>(font_height), 0.0f  // Vertex Four.
-    };
-
-    // The vertex texture coordinates.
-    float vertex_texture_coordinates[] =
-    {
-        0.0f, 0.0f, // Vertex One.
-        1.0f, 0.0f, // Vertex Two.
-        1.0f, 1.0f, // Vertex Three.
-        0.0f, 1.0f  // Vertex Four.
-    };
-
     // The vertex colors.
     float vertex_colors[] =
     {
@@ -1277,64 +870,36 @@ void TextSupervisor::_RenderText(const uint16_t* text, FontProperties* font_prop
         1.0f, 1.0f, 1.0f, 1.0f  // Vertex Four.
     };
 
-    // Draw the shadow.
-    VideoManager->DrawSprite(shader_program, vertex_positions, vertex_texture_coordinates, vertex_colors, color_shadow);
-
-    // Restore the transformation stack.
-    VideoManager->PopMatrix();
-
-    //
-    // Draw the text second.
-    //
-
-    // Push the transformation stack.
-    VideoManager->PushMatrix();
-
-    // Update the transmation matrix.
-    VideoManager->MoveRelative(x_offset, y_offset);
-
-    // Draw the text.
-    VideoManager->DrawSprite(shader_program, vertex_positions, vertex_texture_coordinates, vertex_colors, color);
-
-    // Unload the shader program.
-    VideoManager->UnloadShaderProgram();
-
-    // Restore the transformation stack.
-    VideoManager->PopMatrix();
-
-    // Clean up.
-    if (surface != nullptr) {
-        SDL_FreeSurface(surface);
-        surface = nullptr;
-    }
-}
-
-bool TextSupervisor::_RenderText(const vt_utils::ustring& text, TextStyle& style, ImageMemory& buffer)
-{
-    FontProperties* font_properties = style.GetFontProperties();
-    if (font_properties == nullptr || font_properties->ttf_font == nullptr) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "The TextStyle argument using font:'" << style.GetFontName() << "' was invalid" << std::endl;
-        assert(font_properties != nullptr && font_properties->ttf_font == nullptr);
-        return false;
+    // Each glyph is a sprite: the ones sharing a glyph texture sheet are drawn at once.
+    for (uint32_t i = 0; i < line.glyphs.size(); ++i) {
+        const Glyph* glyph = line.glyphs[i].glyph;
+        TextureManager->_BindTexture(glyph->texture_sheet->tex_id);
+
+        const float left = line_x + (line.glyphs[i].x + glyph->offset_x) * h_direction;
+        const float right = left + glyph->width * h_direction;
+        const float top = line_y - glyph->offset_y * v_direction;
+        const float bottom = top - glyph->height * v_direction;
+
+        // The vertex positions.
+        float vertex_positions[] =
+        {
+            left,  top,    0.0f, // Vertex One.
+            right, top,    0.0f, // Vertex Two.
+            right, bottom, 0.0f, // Vertex Three.
+            left,  bottom, 0.0f  // Vertex Four.
+        };
+
+        // The vertex texture coordinates.
+        float vertex_texture_coordinates[] =
+        {
+            glyph->u1, glyph->v1, // Vertex One.
+            glyph->u2, glyph->v1, // Vertex Two.
+            glyph->u2, glyph->v2, // Vertex Three.
+            glyph->u1, glyph->v2  // Vertex Four.
+        };
+
+        VideoManager->DrawSprite(shader_program, vertex_positions, vertex_texture_coordinates, vertex_colors, color);
     }
-
-    // Render the text.
-    const SDL_Color white = { 255, 255, 255, 255 };
-    SDL_Surface* surface = TTF_RenderUNICODE_Blended(font_properties->ttf_font, text.c_str(), white);
-    if (surface == nullptr) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "call to TTF_RenderUNICODE_Blended() failed" << std::endl;
-        assert(surface != nullptr);
-        return false;
-    }
-
-    // Copy the text to the buffer.
-    buffer = ImageMemory(surface);
-
-    // Clean up.
-    SDL_FreeSurface(surface);
-    surface = nullptr;
-
-    return true;
 }
 
 }  // namespace vt_video
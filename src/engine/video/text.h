@@ -15,13 +15,15 @@
 *** \brief   Header file for text rendering
 ***
 *** This code makes use of the SDL_ttf font library for representing fonts,
-*** font glyphs, and text.
+*** font glyphs, and text. The glyphs are rendered once in glyph atlases, see
+*** glyph_atlas.h.
 *** ***************************************************************************/
 
 #ifndef __TEXT_HEADER__
 #define __TEXT_HEADER__
 
 #include "engine/video/image.h"
+#include "engine/video/glyph_atlas.h"
 
 #include "utils/singleton.h"
 #include "utils/ustring.h"
@@ -71,6 +73,7 @@ public:
     //! \brief Clears out the font object.
     //! Useful when changing a TextStyle font without deleting
     //! the font properties object.
+    //! The font itself is owned by its glyph atlas.
     void ClearFont();
 
     //! \brief The maximum height of all of the glyphs for this font.
@@ -85,6 +88,10 @@ public:
     //! \brief A pointer to SDL_TTF's font structure.
     TTF_Font* ttf_font;
 
+    //! \brief The glyphs of the font, used to lay out and draw text.
+    //! This acts as reference cache, thus it must not be deleted here!
+    private_video::GlyphAtlas* glyph_atlas;
+
     //! \brief Used to know the font currently used.
     std::string font_filename;
 
@@ -217,118 +224,6 @@ private:
     void _UpdateTextShadowColor();
 };
 
-namespace private_video
-{
-
-/** ****************************************************************************
-*** \brief Represents an image of rendered text stored in a texture sheet
-***
-*** A text specific class derived from the BaseImage class, it contains a
-*** unicode string and text style needed to render a piece of text.
-*** ***************************************************************************/
-class TextTexture : public private_video::BaseTexture
-{
-public:
-    /** \brief Constructor defaults image as the first one in a texture sheet.
-    *** \note The actual sheet where the image is located will be determined later.
-    **/
-    TextTexture(const vt_utils::ustring &string_, const TextStyle &style_);
-
-    ~TextTexture();
-
-    // ---------- Public members
-
-    //! \brief The string represented
-    vt_utils::ustring string;
-
-    //! \brief The text style of the rendered string
-    TextStyle style;
-
-    // ---------- Public methods
-
-    //! \brief Generate a text texture and add to a texture sheet
-    bool Regenerate();
-
-    //! \brief Reload texture to an already assigned texture sheet
-    bool Reload();
-
-private:
-    TextTexture(const TextTexture &copy);
-    TextTexture &operator=(const TextTexture &copy);
-}; // class TextTexture : public private_video::BaseImage
-
-
-/** ****************************************************************************
-*** \brief An element used as a portion of a full rendered block of text.
-***
-*** This class represents a block (usually a single line) of rendered text that
-*** is stored by the TextImage class as a portion, or element, that makes up
-*** a rendered block of text. This class managed a pointer to a TextTexture
-*** object that refers to the rendered line of text as it is stored in texture
-*** memory.
-*** ***************************************************************************/
-class TextElement : public ImageDescriptor
-{
-public:
-    TextElement();
-
-    explicit TextElement(TextTexture* texture);
-
-    virtual ~TextElement() override;
-
-    // ---------- Public members
-
-    //! \brief The image that is being referenced by this object.
-    TextTexture *text_texture;
-
-    // ---------- Public methods
-
-    void Clear() override;
-
-    void Draw() const;
-
-    void Draw(const Color& draw_color) const override;
-
-    /** \brief Sets the texture used by the class and modifies the width and height members
-    *** \param texture A pointer to the TextTexture object that this class object should manage
-    ***
-    *** Because it is rare that the user needs to define a custom width/height for the text (since
-    *** scaled text looks so poor), this function also automatically sets the _width and _height members
-    *** to the translated value of the width and height of the TextTexture in the current coordinate system
-    *** (current context) in which this function call is made. Passing a nullptr argument will deallocate any
-    *** texture resources and set the width/height to zero.
-    ***
-    *** \note This function will invoke the AddReference() method for the argument object if it is not nullptr.
-    **/
-    void SetTexture(TextTexture *texture);
-
-    void SetStatic(bool is_static) override {
-        _is_static = is_static;
-    }
-
-    void SetWidth(float width) override {
-        _width = width;
-    }
-
-    void SetHeight(float height) override {
-        _height = height;
-    }
-
-    void SetDimensions(float width, float height) override {
-        SetWidth(width);
-        SetHeight(height);
-    }
-
-private:
-    void _EnableGrayscale() override
-    {}
-
-    void _DisableGrayscale() override
-    {}
-};
-
-} // namespace private_video
-
 /** ****************************************************************************
 *** \brief Represents a rendered text string
 *** TextImage is a compound image containing each line of a text string.
@@ -467,12 +362,12 @@ private:
     //! \brief The text max width, used for word wrapping
     uint32_t _max_width;
 
-    //! \brief The TextTexture elements representing rendered text portions, usually lines.
-    std::vector<private_video::TextElement *> _text_sections;
+    //! \brief The text lines, laid out using the style font glyphs.
+    std::vector<private_video::TextLine> _text_lines;
 
     // ---------- Private methods
 
-    //! \brief Regenerates the texture images for the text
+    //! \brief Lays out the text lines again
     void _Regenerate();
 
     //! \brief Dervied from ImageDescriptor, this method is not used by TextImage
@@ -503,7 +398,6 @@ class TextSupervisor : public vt_utils::Singleton<TextSupervisor>
     friend class vt_utils::Singleton<TextSupervisor>;
     friend class VideoEngine;
     friend class TextureController;
-    friend class private_video::TextTexture;
     friend class TextImage;
     friend class TextStyle;
 
@@ -552,25 +446,26 @@ public:
         Draw(vt_utils::MakeUnicodeString(text), style);
     }
 
-    /** \brief Calculates what the width would be for a unicode string of text if it were rendered
-    *** \param ttf_font The True Type SDL font object
+    /** \brief Calculates what the width would be for a single line of unicode text if it were rendered
+    *** \param font_properties The properties of the font to use
     *** \param text The text string in unicode format
     *** \return The width of the text as it would be rendered, or -1 if there was an error
+    *** \note The width is computed from the cached glyph metrics.
     **/
-    int32_t CalculateTextWidth(TTF_Font* ttf_font, const vt_utils::ustring& text);
+    int32_t CalculateTextWidth(FontProperties* font_properties, const vt_utils::ustring& text);
 
-    /** \brief Calculates what the width would be for a standard string of text if it were rendered
-    *** \param ttf_font The True Type SDL font object
+    /** \brief Calculates what the width would be for a single line of standard text if it were rendered
+    *** \param font_properties The properties of the font to use
     *** \param text The text string in standard format
     *** \return The width of the text as it would be rendered, or -1 if there was an error
     **/
-    int32_t CalculateTextWidth(TTF_Font* ttf_font, const std::string& text);
+    int32_t CalculateTextWidth(FontProperties* font_properties, const std::string& text);
 
     /** \brief Returns the text as a vector of lines which text width is inferior or equal to the given pixel max width.
     *** \param text The ustring text
-    *** \param ttf_font The True Type SDL font object
+    *** \param font_properties The properties of the font to use
     **/
-    std::vector<vt_utils::ustring> WrapText(const vt_utils::ustring& text, TTF_Font* ttf_font, uint32_t max_width);
+    std::vector<vt_utils::ustring> WrapText(const vt_utils::ustring& text, FontProperties* font_properties, uint32_t max_width);
     //@}
 
     //! \name Class member access methods
@@ -589,15 +484,6 @@ private:
 
     // ---------- Private members
 
-    //! \brief A texture used to draw text to the screen.
-    GLuint _text_texture;
-
-    //! \brief The text texture's width.
-    GLuint _text_texture_width;
-
-    //! \brief The text texture's height.
-    GLuint _text_texture_height;
-
     //! \brief The default text style
     TextStyle _default_style;
 
@@ -606,6 +492,15 @@ private:
     **/
     std::map<std::string, FontProperties *> _font_map;
 
+    /** \brief The glyph atlases of every font file and size loaded.
+    *** The key to the map is the font filename followed by the font size.
+    *** They are kept until the supervisor is destroyed, as text images keep using their glyphs.
+    **/
+    std::map<std::string, private_video::GlyphAtlas *> _glyph_atlases;
+
+    //! \brief The line being drawn by Draw(), kept to reuse its memory.
+    private_video::TextLine _draw_line;
+
     /** \brief Loads or Reloads a font file from disk with a specific size and name
     *** \param Text style name The name which to refer to the text style after it is loaded
     *** \param font_filename The filename of the TTF font filename to load
@@ -622,37 +517,22 @@ private:
     **/
     void _FreeFont(const std::string &font_name);
 
-    /** \brief Renders a unicode string to the screen.
-    *** \param text A pointer to a unicode string to draw.
-    *** \param font_properties A pointer to the properties of the font to use in drawing the text.
-    *** \param color The color to render the text in.
-    ***
-    *** This method is intended for drawing only a single line of text.
+    /** \brief Returns the glyph atlas of a font file with the given size, opening the font if needed
+    *** \return The glyph atlas, or nullptr if the font file couldn't be opened
     **/
-    void _RenderText(const uint16_t* text, FontProperties* font_properties, const Color& color);
-
-    /** \brief Renders a unicode, shadowed string to the screen.
-    *** \param text A pointer to a unicode string to draw.
-    *** \param font_properties A pointer to the properties of the font to use in drawing the text.
-    *** \param color The color to render the text in.
-    *** \param shadow_offset_x The X offset for the text's shadow.
-    *** \param shadow_offset_y The Y offset for the text's shadow.
-    *** \param color_shadow The color to render the text's shadow in.
+    private_video::GlyphAtlas* _GetGlyphAtlas(const std::string& font_filename, uint32_t size);
+
+    /** \brief Draws a laid out line of text at the current draw cursor position.
+    *** \param line The laid out line to draw.
+    *** \param font_properties The properties of the font used to lay out the line.
+    *** \param color The color to draw the text in.
+    *** \param offset_x The X offset to draw the text at, used for shadows.
+    *** \param offset_y The Y offset to draw the text at, used for shadows.
     ***
-    *** This method is intended for drawing only a single line of text.
-    **/
-    void _RenderText(const uint16_t* text, FontProperties* font_properties,
-                     const Color& color,
-                     float shadow_offset_x, float shadow_offset_y,
-                     const Color& color_shadow);
-
-    /** \brief Renders a unicode string to a pixel array.
-    *** \param text The unicdoe string to render.
-    *** \param style The text style to render the string in.
-    *** \param buffer A reference to the pixel array where to place the rendered string into.
-    *** \return True if the string was rendered successfully, or false if it was not.
+    *** The line is aligned according to the current draw flags as a single image would be.
     **/
-    bool _RenderText(const vt_utils::ustring& text, TextStyle& style, private_video::ImageMemory& buffer);
+    void _DrawTextLine(const private_video::TextLine& line, FontProperties* font_properties,
+                       const Color& color, float offset_x = 0.0f, float offset_y = 0.0f);
 
     /** \brief Returns true if a font of a certain reference name exists
     *** \param font_name The reference name of the font to check
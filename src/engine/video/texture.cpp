@@ -101,6 +101,8 @@ bool TexSheet::Reload()
 
 bool TexSheet::CopyRect(int32_t x, int32_t y, ImageMemory& data)
 {
+    // The pending sprites may use the previous content of the sheet.
+    VideoManager->FlushSpriteBatch();
     TextureManager->_BindTexture(tex_id);
 
     data.GlTexSubImage(x, y);
@@ -115,6 +117,8 @@ bool TexSheet::CopyRect(int32_t x, int32_t y, ImageMemory& data)
 
 bool TexSheet::CopyScreenRect(int32_t x, int32_t y, const ScreenRect &screen_rect)
 {
+    // The screen must contain every pending sprite.
+    VideoManager->FlushSpriteBatch();
     TextureManager->_BindTexture(tex_id);
 
     glCopyTexSubImage2D(
@@ -143,6 +147,8 @@ void TexSheet::Smooth(bool flag)
         smoothed = flag;
         GLenum filtering_type = smoothed ? GL_LINEAR : GL_NEAREST;
 
+        // The pending sprites are to be drawn using the previous filtering.
+        VideoManager->FlushSpriteBatch();
         TextureManager->_BindTexture(tex_id);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filtering_type);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filtering_type);
@@ -190,18 +196,12 @@ void TexSheet::DEBUG_Draw() const
     // Draw a black background.
     VideoManager->DrawSprite(shader_program, vertex_positions, vertex_texture_coordinates, vertex_colors, ::vt_video::Color::black);
 
-    // Unload the shader program.
-    VideoManager->UnloadShaderProgram();
-
     // Load the sprite shader program.
     shader_program = VideoManager->LoadShaderProgram(gl::shader_programs::Sprite);
     assert(shader_program != nullptr);
 
     // Draw the image.
     VideoManager->DrawSprite(shader_program, vertex_positions, vertex_texture_coordinates, vertex_colors);
-
-    // Unload the shader program.
-    VideoManager->UnloadShaderProgram();
 }
 
 // -----------------------------------------------------------------------------
@@ -391,6 +391,15 @@ uint32_t FixedTexSheet::GetNumberTextures()
 
 
 
+bool FixedTexSheet::CanInsert(uint32_t img_width, uint32_t img_height) const
+{
+    return _open_list_head != nullptr
+        && img_width <= static_cast<uint32_t>(_texture_width)
+        && img_height <= static_cast<uint32_t>(_texture_height);
+}
+
+
+
 int32_t FixedTexSheet::_CalculateBlockIndex(BaseTexture *img)
 {
     int32_t block_x = img->x / _texture_width;
@@ -438,22 +447,16 @@ FixedTexNode *FixedTexSheet::_RemoveOpenNode()
 // -----------------------------------------------------------------------------
 
 VariableTexSheet::VariableTexSheet(int32_t sheet_width, int32_t sheet_height, GLuint sheet_id, TexSheetType sheet_type, bool sheet_static) :
-    TexSheet(sheet_width, sheet_height, sheet_id, sheet_type, sheet_static)
+    TexSheet(sheet_width, sheet_height, sheet_id, sheet_type, sheet_static),
+    _packer(sheet_width, sheet_height),
+    _used_area(0)
 {
-    _block_width = width / 16;
-    _block_height = height / 16;
-    _blocks = new VariableTexNode[_block_width * _block_height];
 }
 
 VariableTexSheet::~VariableTexSheet()
 {
     if (GetNumberTextures() != 0)
         IF_PRINT_WARNING(VIDEO_DEBUG) << "texture sheet being deleted when it has a non-zero allocated texture count: " << GetNumberTextures() << std::endl;
-
-    if (_blocks != nullptr) {
-        delete [] _blocks;
-        _blocks = nullptr;
-    }
 }
 
 bool VariableTexSheet::AddTexture(BaseTexture *img, ImageMemory &data)
@@ -481,66 +484,24 @@ bool VariableTexSheet::InsertTexture(BaseTexture *img)
 
     // Don't allow insertions into a texture sheet containing a texture larger than 512x512.
     // Texture sheets with this property may only be used by one texture at a time
-    if(_block_width > 32 || _block_height > 32) {  // 32 blocks == 512 pixels
-        if(_blocks[0].free_image == false)
-            return false;
-    }
-
-    // Attempt to find an open region in the texture sheet to fit this texture
-    int32_t block_x = -1, block_y = -1;
-    int32_t w = (img->width + 15) / 16;
-    int32_t h = (img->height + 15) / 16;
-
-    // This is a brute force algorithm to try and find space to allocate the texture.
-    // If this becomes a bottleneck, we may wish to use a more intellegent algorithm here.
-    bool continue_search = true;
-    for(int32_t y = 0; y < _block_height - h + 1 && continue_search; y++) {
-        for(int32_t x = 0; x < _block_width - w + 1; x++) {
-            int32_t furthest_blocker = -1;
-
-            bool continue_neighbor_search = true;
-            for(int32_t dy = 0; dy < h && continue_neighbor_search; dy++) {
-                for(int32_t dx = 0; dx < w; dx++) {
-                    if(_blocks[(x + dx) + ((y + dy) * _block_width)].free_image == false) {
-                        furthest_blocker = x + dx;
-                        continue_neighbor_search = false;
-                        break;
-                    }
-                }
-            }
-
-            if(furthest_blocker == -1) {
-                block_x = x;
-                block_y = y;
-                continue_search = false;
-                break;
-            }
-        }
-    }
-
-    // If either of these conditions is true, it means we were unable to allocate enough space to insert this texture
-    if(block_x == -1 || block_y == -1)
+    if(_IsSingleTextureSheet() && _textures.size() > _freed_textures.size())
         return false;
 
-    // Go through each block that is to be occupied by the new texture and set its properties
-    for(int32_t y = block_y; y < block_y + h; y++) {
-        for(int32_t x = block_x; x < block_x + w; x++) {
-            int32_t index = x + (y * _block_width);
-
-            // If the texture pointer for the block is not nullptr, this means it contains a freed texture.
-            // Now we must remove that texture entirely since we are overwriting at least one of its blocks.
-            if(_blocks[index].image) {
-                RemoveTexture(_blocks[index].image);
-            }
+    uint32_t x = 0;
+    uint32_t y = 0;
+    if(!_packer.Insert(img->width, img->height, x, y)) {
+        // Make room by removing the freed textures, if any.
+        if(_freed_textures.empty())
+            return false;
 
-            _blocks[index].free_image = false;
-            _blocks[index].image = img;
-        }
+        _RemoveFreedTextures();
+        if(!_packer.Insert(img->width, img->height, x, y))
+            return false;
     }
 
     // Calculate the pixel and uv coordinates for the newly inserted texture
-    img->x = block_x * 16;
-    img->y = block_y * 16;
+    img->x = x;
+    img->y = y;
 
     float sheet_width = static_cast<float>(width);
     float sheet_height = static_cast<float>(height);
@@ -552,6 +513,7 @@ bool VariableTexSheet::InsertTexture(BaseTexture *img)
 
     img->texture_sheet = this;
     _textures.insert(img);
+    _used_area += img->width * img->height;
 
     return true;
 } // bool VariableTexSheet::InsertTexture(BaseTexture* img)
@@ -560,40 +522,81 @@ bool VariableTexSheet::InsertTexture(BaseTexture *img)
 
 void VariableTexSheet::RemoveTexture(BaseTexture *img)
 {
-    _SetBlockProperties(img, nullptr, true);
-    _textures.erase(img);
+    if(img == nullptr) {
+        IF_PRINT_WARNING(VIDEO_DEBUG) << "nullptr pointer was given as function argument" << std::endl;
+        return;
+    }
+
+    if(_textures.erase(img) == 0) {
+        IF_PRINT_WARNING(VIDEO_DEBUG) << "texture pointer argument was not contained within this texture sheet" << std::endl;
+        return;
+    }
+
+    _freed_textures.erase(img);
+    _used_area -= img->width * img->height;
+
+    // Starting over from a single free rectangle avoids any fragmentation once the sheet is empty.
+    if(_textures.empty())
+        _packer.Clear();
+    else
+        _packer.Remove(PackedRect(img->x, img->y, img->width, img->height));
 }
 
 
 
-void VariableTexSheet::_SetBlockProperties(BaseTexture *tex, BaseTexture *new_tex, bool free)
+void VariableTexSheet::FreeTexture(BaseTexture *img)
 {
-    if(tex == nullptr) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "nullptr pointer was given as function argument" << std::endl;
+    if(_textures.find(img) == _textures.end()) {
+        IF_PRINT_WARNING(VIDEO_DEBUG) << "texture pointer argument was not contained within this texture sheet" << std::endl;
         return;
     }
 
-    if(_textures.find(tex) == _textures.end()) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "texture pointer argument was not contained within this texture sheet" << std::endl;
-    }
+    _freed_textures.insert(img);
+}
 
-    // Calculate upper-left corner in blocks
-    int32_t block_x = tex->x / 16;
-    int32_t block_y = tex->y / 16;
 
-    // Calculate width and height in blocks
-    int32_t w = (tex->width  + 15) / 16;
-    int32_t h = (tex->height + 15) / 16;
 
-    for(int32_t y = block_y; y < block_y + h; y++) {
-        for(int32_t x = block_x; x < block_x + w; x++) {
-            int32_t index = x + y * _block_width;
-            if(_blocks[index].image == tex) {
-                _blocks[index].free_image = free;
-                _blocks[index].image = new_tex;
-            }
-        }
+void VariableTexSheet::RestoreTexture(BaseTexture *img)
+{
+    if(_freed_textures.erase(img) == 0)
+        IF_PRINT_WARNING(VIDEO_DEBUG) << "failed to restore, texture was not freed" << std::endl;
+}
+
+
+
+bool VariableTexSheet::CanInsert(uint32_t img_width, uint32_t img_height) const
+{
+    // Freed textures may be removed to make room.
+    if(!_freed_textures.empty())
+        return true;
+
+    if(_IsSingleTextureSheet() && !_textures.empty())
+        return false;
+
+    return _packer.MayFit(img_width, img_height);
+}
+
+
+
+void VariableTexSheet::_RemoveFreedTextures()
+{
+    if(_freed_textures.empty())
+        return;
+
+    // The packer finds its free rectangles again once for all the freed textures.
+    std::vector<PackedRect> freed_rects;
+    for(std::set<BaseTexture *>::iterator it = _freed_textures.begin(); it != _freed_textures.end(); ++it) {
+        BaseTexture *img = *it;
+        _textures.erase(img);
+        _used_area -= img->width * img->height;
+        freed_rects.push_back(PackedRect(img->x, img->y, img->width, img->height));
     }
+    _freed_textures.clear();
+
+    if(_textures.empty())
+        _packer.Clear();
+    else
+        _packer.Remove(freed_rects);
 }
 
 } // namespace private_video
@@ -35,14 +35,13 @@
 *** - <b>VariableTexSheet</b>: a texture sheet for variable-size textures.
 *** This sheet allows textures of any size to be inserted, but has slower
 *** performance than the FixedTexSheet.
-***
-*** - <b>VariableTexNode</b>: represents a texture node entry for the
-*** VariableTexSheet class.
 *** ***************************************************************************/
 
 #ifndef __TEXTURE_HEADER__
 #define __TEXTURE_HEADER__
 
+#include "rectangle_packer.h"
+
 #include "utils/gl_include.h"
 
 #include <set>
@@ -69,8 +68,12 @@ enum TexSheetType {
     VIDEO_TEXSHEET_32x64 = 1,
     VIDEO_TEXSHEET_64x64 = 2,
     VIDEO_TEXSHEET_ANY = 3,
+    //! \brief Reserved to the font glyph atlases.
+    VIDEO_TEXSHEET_GLYPHS = 4,
+    //! \brief Reserved to the screen captures, one per sheet.
+    VIDEO_TEXSHEET_SCREEN_CAPTURE = 5,
 
-    VIDEO_TEXSHEET_TOTAL = 4
+    VIDEO_TEXSHEET_TOTAL = 6
 };
 
 
@@ -150,6 +153,12 @@ public:
     //! \brief Returns the number of textures that are contained on this texture sheet
     virtual uint32_t GetNumberTextures() = 0;
 
+    /** \brief Tells whether an image of the given size may still fit in the sheet
+    *** This is a cheap check used to skip full sheets: a true value doesn't
+    *** guarantee that the insertion will succeed.
+    **/
+    virtual bool CanInsert(uint32_t img_width, uint32_t img_height) const = 0;
+
     /** \brief Unloads all texture memory used by OpenGL for this sheet
     *** \return Success/failure
     **/
@@ -218,10 +227,6 @@ public:
 
     //! \brief Flag indicating if texture sheet is loaded or not
     bool loaded;
-
-protected:
-    //! \brief The width and height of the sheet in number of texture blocks
-    int32_t _block_width, _block_height;
 }; // class TexSheet
 
 
@@ -315,12 +320,17 @@ public:
     void RestoreTexture(BaseTexture *img);
 
     uint32_t GetNumberTextures();
+
+    bool CanInsert(uint32_t img_width, uint32_t img_height) const;
     //@}
 
 private:
     //! \brief The width and height of each texture block, in number of pixels
     int32_t _texture_width, _texture_height;
 
+    //! \brief The width and height of the sheet in number of texture blocks
+    int32_t _block_width, _block_height;
+
     //! \brief Head of the list of open texture blocks
     FixedTexNode *_open_list_head;
 
@@ -350,33 +360,16 @@ private:
     FixedTexNode *_RemoveOpenNode();
 };
 
-/** ****************************************************************************
-*** \brief Keeps track of which images are used/freed in the variable texture mem manager
-*** ***************************************************************************/
-class VariableTexNode
-{
-public:
-    VariableTexNode() :
-        image(nullptr),
-        free_image(true)
-    {
-    }
-
-    //! \brief A pointer to the image.
-    BaseTexture *image;
-
-    //! \brief Set to true if the image is freed.
-    bool free_image;
-};
-
 /** ****************************************************************************
 *** \brief Used to manage texture sheets of variable image sizes
 ***
-*** This class divides a texture sheet up into 16x16 pixel blocks, and keeps
-*** track of which images have allocated which blocks. This is done to reduce
-*** the time complexity for doing texture insertion and removal operations, but
-*** the downside is that it may leave some space in the texture sheet occupied
-*** but unused for images that are not divisible by 16 in width or height.
+*** The places of the textures are given by a RectanglePacker, so that each
+*** texture only uses its own size in the sheet. The packer also knows the
+*** largest free width and height, which lets full sheets be skipped quickly.
+***
+*** Freed textures keep their place until there is no room left for a new
+*** texture, in case they are restored in the meantime. They are then removed
+*** all at once and the insertion is tried again.
 *** ***************************************************************************/
 class VariableTexSheet : public TexSheet
 {
@@ -404,36 +397,57 @@ public:
 
     void RemoveTexture(BaseTexture *img);
 
-    void FreeTexture(BaseTexture *img) {
-        _SetBlockProperties(img, img, true);
-    }
+    void FreeTexture(BaseTexture *img);
 
-    void RestoreTexture(BaseTexture *img) {
-        _SetBlockProperties(img, img, false);
-    }
+    void RestoreTexture(BaseTexture *img);
 
     uint32_t GetNumberTextures() {
         return _textures.size();
     }
+
+    bool CanInsert(uint32_t img_width, uint32_t img_height) const;
+    //@}
+
+    //! \name Statistics shown when debugging the texture sheets
+    //@{
+    //! \brief Returns the number of pixels used by the textures.
+    uint32_t GetUsedArea() const {
+        return _used_area;
+    }
+
+    //! \brief Returns the number of free rectangles tracked by the packer.
+    uint32_t GetNumberFreeRects() const {
+        return _packer.GetNumberFreeRects();
+    }
+
+    //! \brief Returns the area of the largest free rectangle.
+    uint32_t GetLargestFreeArea() const {
+        return _packer.GetLargestFreeArea();
+    }
     //@}
 
 private:
-    /** \brief The list of 16x16 pixel blocks in the sheet.
-    *** The size of this structure is: (width / 16) * (height / 16)
-    **/
-    VariableTexNode *_blocks;
+    //! \brief Gives the places of the textures in the sheet.
+    RectanglePacker _packer;
 
     /** \brief A set containing each texture that has been inserted into this class
     *** This container is used to be able to quickly determine if a texture is loaded by an object of this class
     **/
     std::set<BaseTexture *> _textures;
 
-    /** \brief Updates the properties of all of the blocks associated with a given texture
-    *** \param tex The texture to update
-    *** \param new_tex The texture pointer to set the block to
-    *** \param new_image The boolean value to set the free status flag to
-    **/
-    void _SetBlockProperties(BaseTexture *tex, BaseTexture *new_tex, bool free);
+    //! \brief The textures marked as free, still holding their place in the sheet.
+    std::set<BaseTexture *> _freed_textures;
+
+    //! \brief The number of pixels used by the textures, freed ones included.
+    uint32_t _used_area;
+
+    //! \brief Tells whether the sheet is larger than 512 pixels, and may thus only hold one texture.
+    bool _IsSingleTextureSheet() const {
+        return width > 512 || height > 512;
+    }
+
+    //! \brief Removes the freed textures from the sheet, to make room for new ones.
+    void _RemoveFreedTextures();
 };
 
 } // namespace private_video
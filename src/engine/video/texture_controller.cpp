@@ -30,7 +30,13 @@ namespace vt_video
 TextureController* TextureManager = nullptr;
 
 TextureController::TextureController() :
-    _debug_current_sheet(-1)
+    _debug_current_sheet(-1),
+    _packing_time(0),
+    _packing_insertions(0),
+    _packing_skipped_sheets(0),
+    _upload_time(0),
+    _uploads(0),
+    _last_tex_id(INVALID_TEXTURE_ID)
 {
 }
 
@@ -155,6 +161,10 @@ void TextureController::DEBUG_ShowTexSheet()
         sprintf(buf, "  Type:    64x64");
     else if (sheet->type == VIDEO_TEXSHEET_ANY)
         sprintf(buf, "  Type:    Any size");
+    else if (sheet->type == VIDEO_TEXSHEET_GLYPHS)
+        sprintf(buf, "  Type:    Glyphs");
+    else if (sheet->type == VIDEO_TEXSHEET_SCREEN_CAPTURE)
+        sprintf(buf, "  Type:    Screen capture");
     else
         sprintf(buf, "  Type:    Unknown");
 
@@ -169,6 +179,50 @@ void TextureController::DEBUG_ShowTexSheet()
     VideoManager->MoveRelative(0, 20);
     TextManager->Draw(buf);
 
+    sprintf(buf, "  Textures: %u", sheet->GetNumberTextures());
+    VideoManager->MoveRelative(0, 20);
+    TextManager->Draw(buf);
+
+    if (sheet->type == VIDEO_TEXSHEET_ANY || sheet->type == VIDEO_TEXSHEET_GLYPHS
+            || sheet->type == VIDEO_TEXSHEET_SCREEN_CAPTURE) {
+        VariableTexSheet *variable_sheet = static_cast<VariableTexSheet *>(sheet);
+        uint32_t sheet_area = sheet->width * sheet->height;
+        uint32_t used_area = variable_sheet->GetUsedArea();
+        uint32_t free_area = sheet_area > used_area ? sheet_area - used_area : 0;
+        uint32_t largest_free_area = variable_sheet->GetLargestFreeArea();
+
+        sprintf(buf, "  Used:    %.1f%%", 100.0f * used_area / sheet_area);
+        VideoManager->MoveRelative(0, 20);
+        TextManager->Draw(buf);
+
+        sprintf(buf, "  Free rects: %u (largest: %u px)", variable_sheet->GetNumberFreeRects(), largest_free_area);
+        VideoManager->MoveRelative(0, 20);
+        TextManager->Draw(buf);
+
+        // The part of the free area which isn't in the largest free rectangle.
+        float fragmentation = free_area > 0 ? 100.0f * (1.0f - static_cast<float>(largest_free_area) / free_area) : 0.0f;
+        sprintf(buf, "  Fragmentation: %.1f%%", fragmentation);
+        VideoManager->MoveRelative(0, 20);
+        TextManager->Draw(buf);
+    }
+
+    VideoManager->MoveRelative(0, 20);
+    TextManager->Draw("Texture packing:");
+
+    double packing_time = 1000.0 * _packing_time / SDL_GetPerformanceFrequency();
+    sprintf(buf, "  Insertions: %u (%.2f ms)", _packing_insertions, packing_time);
+    VideoManager->MoveRelative(0, 20);
+    TextManager->Draw(buf);
+
+    sprintf(buf, "  Full sheets skipped: %u", _packing_skipped_sheets);
+    VideoManager->MoveRelative(0, 20);
+    TextManager->Draw(buf);
+
+    double upload_time = 1000.0 * _upload_time / SDL_GetPerformanceFrequency();
+    sprintf(buf, "  Uploads: %u (%.2f ms)", _uploads, upload_time);
+    VideoManager->MoveRelative(0, 20);
+    TextManager->Draw(buf);
+
     VideoManager->PopState();
 }
 
@@ -206,12 +260,26 @@ GLuint TextureController::_CreateBlankGLTexture(int32_t width, int32_t height)
 
 void TextureController::_BindTexture(GLuint tex_id)
 {
+    if (tex_id == _last_tex_id)
+        return;
+
+    // The pending sprites are to be drawn using the previous texture.
+    VideoManager->FlushSpriteBatch();
+
     glBindTexture(GL_TEXTURE_2D, tex_id);
+    _last_tex_id = tex_id;
 }
 
 void TextureController::_DeleteTexture(GLuint tex_id)
 {
     if (tex_id != 0) {
+        // The pending sprites may still use the texture.
+        VideoManager->FlushSpriteBatch();
+
+        // Deleting the bound texture binds the default one.
+        if (tex_id == _last_tex_id)
+            _last_tex_id = 0;
+
         GLuint textures[] = { tex_id };
         glDeleteTextures(1, textures);
     }
@@ -277,8 +345,25 @@ void TextureController::_RemoveSheet(TexSheet *sheet)
     IF_PRINT_WARNING(VIDEO_DEBUG) << "could not find texture sheet to delete" << std::endl;
 }
 
-TexSheet *TextureController::_InsertImageInTexSheet(BaseTexture *image, ImageMemory &load_info, bool is_static)
+TexSheet *TextureController::_InsertImageInTexSheet(BaseTexture *image, ImageMemory &load_info,
+                                                   bool is_static, bool copy_pixels)
 {
+    // Either only reserve the place of the image, or also copy its pixels.
+    // The packing and the upload are timed apart.
+    auto add_texture = [this, image, &load_info, copy_pixels](TexSheet *sheet) -> bool {
+        Uint64 start_time = SDL_GetPerformanceCounter();
+        bool inserted = sheet->InsertTexture(image);
+        _packing_time += SDL_GetPerformanceCounter() - start_time;
+        if(!inserted || !copy_pixels)
+            return inserted;
+
+        if(!_CopyImageToTexSheet(sheet, image, load_info)) {
+            IF_PRINT_WARNING(VIDEO_DEBUG) << "call to TexSheet::CopyRect() failed" << std::endl;
+            return false;
+        }
+        return true;
+    };
+
     // Image sizes larger than 512 in either dimension require their own texture sheet
     if(load_info.GetWidth() > 512 || load_info.GetHeight() > 512) {
         int32_t round_width = vt_utils::RoundUpPow2(load_info.GetWidth());
@@ -291,7 +376,7 @@ TexSheet *TextureController::_InsertImageInTexSheet(BaseTexture *image, ImageMem
             return nullptr;
         }
 
-        if(sheet->AddTexture(image, load_info))
+        if(add_texture(sheet))
             return sheet;
         else {
             IF_PRINT_WARNING(VIDEO_DEBUG) << "TexSheet::AddTexture returned false when trying to insert a large image" << std::endl;
@@ -311,6 +396,8 @@ TexSheet *TextureController::_InsertImageInTexSheet(BaseTexture *image, ImageMem
     else
         type = VIDEO_TEXSHEET_ANY;
 
+    ++_packing_insertions;
+
     // Look through all existing texture sheets and see if the image will fit in any of the ones which
     // match the type and static status that we are looking for
     for(uint32_t i = 0; i < _tex_sheets.size(); ++i) {
@@ -320,11 +407,17 @@ TexSheet *TextureController::_InsertImageInTexSheet(BaseTexture *image, ImageMem
             continue;
         }
 
-        if(sheet->type == type && sheet->is_static == is_static) {
-            if(sheet->AddTexture(image, load_info)) {
-                return sheet;
-            }
+        if(sheet->type != type || sheet->is_static != is_static)
+            continue;
+
+        // Skip the sheets which are known to be too full for the image
+        if(!sheet->CanInsert(load_info.GetWidth(), load_info.GetHeight())) {
+            ++_packing_skipped_sheets;
+            continue;
         }
+
+        if(add_texture(sheet))
+            return sheet;
     }
 
     // We couldn't add it to any existing sheets, so we must create a new one for it
@@ -335,7 +428,7 @@ TexSheet *TextureController::_InsertImageInTexSheet(BaseTexture *image, ImageMem
     }
 
     // AddTexture should always work here. If not, there is a serious problem
-    if(sheet->AddTexture(image, load_info)) {
+    if(add_texture(sheet)) {
         return sheet;
     } else {
         IF_PRINT_WARNING(VIDEO_DEBUG) << "all attempts to add image to a texture sheet have failed" << std::endl;
@@ -343,6 +436,23 @@ TexSheet *TextureController::_InsertImageInTexSheet(BaseTexture *image, ImageMem
     }
 }
 
+TexSheet *TextureController::_InsertImageTextureInTexSheet(ImageTexture *image, ImageMemory &load_info,
+                                                          bool is_static, bool pending)
+{
+    TexSheet *sheet = _InsertImageInTexSheet(image, load_info, is_static, !pending);
+    if(sheet == nullptr || !pending)
+        return sheet;
+
+    // The pixels are copied, as the caller may reuse its buffer.
+    PendingUpload upload;
+    upload.image = image;
+    upload.pixels = load_info;
+    _pending_uploads.push_back(std::move(upload));
+    image->pending = true;
+
+    return sheet;
+}
+
 bool TextureController::_ReloadImagesToSheet(TexSheet *sheet)
 {
     // Delete images
@@ -406,10 +516,6 @@ bool TextureController::_ReloadImagesToSheet(TexSheet *sheet)
                            load_info.GetWidth() * (x * load_info.GetHeight() / rows)
                                + load_info.GetWidth() * y / cols);
 
-            // Convert to grayscale if needed
-            if(img->tags.find("<G>", 0) != img->filename.npos)
-                image.ConvertToGrayscale();
-
             // Copy the image into the texture sheet
             if(sheet->CopyRect(img->x, img->y, image) == false) {
                 IF_PRINT_WARNING(VIDEO_DEBUG) << "call to TexSheet::CopyRect() failed" << std::endl;
@@ -428,10 +534,6 @@ bool TextureController::_ReloadImagesToSheet(TexSheet *sheet)
                 success = false;
             }
 
-            // Convert to grayscale if needed
-            if(img->tags.find("<G>", 0) != img->filename.npos)
-                load_info.ConvertToGrayscale();
-
             if(sheet->CopyRect(img->x, img->y, load_info) == false) {
                 IF_PRINT_WARNING(VIDEO_DEBUG) << "call to TexSheet::CopyRect() failed" << std::endl;
                 success = false;
@@ -439,87 +541,115 @@ bool TextureController::_ReloadImagesToSheet(TexSheet *sheet)
         }
     } // for (std::map<string, ImageTexture*>::iterator i = _images.begin(); i != _images.end(); i++)
 
-    // Regenerate all font textures
-    for(std::set<TextTexture *>::iterator i = _text_images.begin(); i != _text_images.end(); ++i) {
-        if((*i)->texture_sheet == sheet) {
-            if((*i)->Reload() == false) {
-                IF_PRINT_WARNING(VIDEO_DEBUG) << "failed to reload a TextTexture" << std::endl;
-                success = false;
-            }
-        }
-    }
-
     return success;
 } // bool TextureController::_ReloadImagesToSheet(TexSheet* sheet)
 
 
 
-void TextureController::_RegisterImageTexture(ImageTexture *img)
+void TextureController::_UploadPendingTextures(float time_budget)
 {
-    if(img == nullptr) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "nullptr argument passed to function" << std::endl;
+    if(_pending_uploads.empty())
         return;
-    }
 
-    std::string nametag = img->filename + img->tags;
-    if(_IsImageTextureRegistered(nametag)) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "this ImageTexture was already registered: " << nametag << std::endl;
-        return;
-    }
+    Uint64 start_time = SDL_GetPerformanceCounter();
+    Uint64 budget_ticks = static_cast<Uint64>(time_budget * SDL_GetPerformanceFrequency() / 1000.0f);
 
-    _images[nametag] = img;
+    do {
+        _UploadPendingTexture(_pending_uploads.front());
+        _pending_uploads.pop_front();
+    } while(!_pending_uploads.empty() && SDL_GetPerformanceCounter() - start_time < budget_ticks);
 }
 
+void TextureController::_FinishPendingUpload(ImageTexture *image)
+{
+    if(image == nullptr || !image->pending)
+        return;
 
+    for(std::deque<PendingUpload>::iterator it = _pending_uploads.begin(); it != _pending_uploads.end(); ++it) {
+        if(it->image == image) {
+            _UploadPendingTexture(*it);
+            _pending_uploads.erase(it);
+            return;
+        }
+    }
+}
 
-void TextureController::_UnregisterImageTexture(ImageTexture *img)
+void TextureController::_FinishPendingUploads(TexSheet *sheet)
 {
-    if(img == nullptr) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "nullptr argument passed to function" << std::endl;
-        return;
+    std::deque<PendingUpload>::iterator it = _pending_uploads.begin();
+    while(it != _pending_uploads.end()) {
+        if(it->image->texture_sheet == sheet) {
+            _UploadPendingTexture(*it);
+            it = _pending_uploads.erase(it);
+        }
+        else {
+            ++it;
+        }
     }
+}
 
-    std::string nametag = img->filename + img->tags;
-    std::map<std::string, private_video::ImageTexture *>::iterator img_iter = _images.find(nametag);
-    if(img_iter == _images.end()) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "this ImageTexture was not registered: " << nametag << std::endl;
-        return;
+void TextureController::_CancelPendingUpload(ImageTexture *image)
+{
+    for(std::deque<PendingUpload>::iterator it = _pending_uploads.begin(); it != _pending_uploads.end(); ++it) {
+        if(it->image == image) {
+            _pending_uploads.erase(it);
+            break;
+        }
     }
-    _images.erase(img_iter);
+    image->pending = false;
 }
 
+void TextureController::_UploadPendingTexture(PendingUpload &upload)
+{
+    ImageTexture *image = upload.image;
+    if(!_CopyImageToTexSheet(image->texture_sheet, image, upload.pixels)) {
+        IF_PRINT_WARNING(VIDEO_DEBUG) << "call to TexSheet::CopyRect() failed for image: "
+                                      << image->filename << image->tags << std::endl;
+    }
+    image->pending = false;
+}
 
+bool TextureController::_CopyImageToTexSheet(TexSheet *sheet, BaseTexture *image, ImageMemory &pixels)
+{
+    Uint64 start_time = SDL_GetPerformanceCounter();
+    bool copied = sheet->CopyRect(image->x, image->y, pixels);
+    _upload_time += SDL_GetPerformanceCounter() - start_time;
+    ++_uploads;
+    return copied;
+}
 
-void TextureController::_RegisterTextTexture(TextTexture *tex)
+void TextureController::_RegisterImageTexture(ImageTexture *img)
 {
-    if(tex == nullptr) {
+    if(img == nullptr) {
         IF_PRINT_WARNING(VIDEO_DEBUG) << "nullptr argument passed to function" << std::endl;
         return;
     }
 
-    if(_IsTextTextureRegistered(tex)) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "attempted to register an already registered TextTexture" << std::endl;
+    std::string nametag = img->filename + img->tags;
+    if(_IsImageTextureRegistered(nametag)) {
+        IF_PRINT_WARNING(VIDEO_DEBUG) << "this ImageTexture was already registered: " << nametag << std::endl;
         return;
     }
 
-    _text_images.insert(tex);
+    _images[nametag] = img;
 }
 
 
 
-void TextureController::_UnregisterTextTexture(TextTexture *tex)
+void TextureController::_UnregisterImageTexture(ImageTexture *img)
 {
-    if(tex == nullptr) {
+    if(img == nullptr) {
         IF_PRINT_WARNING(VIDEO_DEBUG) << "nullptr argument passed to function" << std::endl;
         return;
     }
 
-    std::set<private_video::TextTexture *>::iterator tex_iter = _text_images.find(tex);
-    if(tex_iter == _text_images.end()) {
-        IF_PRINT_WARNING(VIDEO_DEBUG) << "TextTexture was not registered" << std::endl;
+    std::string nametag = img->filename + img->tags;
+    std::map<std::string, private_video::ImageTexture *>::iterator img_iter = _images.find(nametag);
+    if(img_iter == _images.end()) {
+        IF_PRINT_WARNING(VIDEO_DEBUG) << "this ImageTexture was not registered: " << nametag << std::endl;
         return;
     }
-    _text_images.erase(tex_iter);
+    _images.erase(img_iter);
 }
 
 
@@ -26,7 +26,9 @@
 
 #include "texture.h"
 #include "image_base.h"
+#include "image_loader.h"
 
+#include <deque>
 #include <map>
 
 namespace vt_mode_manager {
@@ -37,9 +39,12 @@ namespace vt_video
 {
 
 namespace private_video {
-class TextTexture;
+class GlyphAtlas;
 }
 
+//! \brief The time spent at most each frame copying pending images into texture sheets, in milliseconds.
+const float PENDING_UPLOADS_TIME_BUDGET = 4.0f;
+
 class TextureController : public vt_utils::Singleton<TextureController>
 {
     friend class vt_utils::Singleton<TextureController>;
@@ -48,9 +53,10 @@ class TextureController : public vt_utils::Singleton<TextureController>
     friend class ImageDescriptor;
     friend class StillImage;
     friend class private_video::ImageTexture;
-    friend class private_video::TextTexture;
+    friend class private_video::GlyphAtlas;
     friend class TextSupervisor;
     friend class TextImage;
+    friend class StaticImageBatch;
     friend class private_video::TexSheet;
     friend class private_video::FixedTexSheet;
     friend class private_video::VariableTexSheet;
@@ -82,12 +88,39 @@ private:
     //! \brief A STL map containing all of the images currently being managed by this class
     std::map<std::string, private_video::ImageTexture *> _images;
 
-    //! \brief A STL set containing all of the text images currently being managed by this class
-    std::set<private_video::TextTexture *> _text_images;
-
     //! \brief An index to _tex_sheets of the current texture sheet being shown in debug mode. -1 indicates no sheet
     int32_t _debug_current_sheet;
 
+    //! \name Texture packing statistics, shown when debugging the texture sheets
+    //@{
+    //! \brief The time spent by the sheets packers placing the images, in performance counter ticks.
+    uint64_t _packing_time;
+
+    //! \brief The number of images inserted into shared texture sheets.
+    uint32_t _packing_insertions;
+
+    //! \brief The number of full texture sheets skipped without trying to insert the images.
+    uint32_t _packing_skipped_sheets;
+
+    //! \brief The time spent copying the image pixels into the texture sheets, in performance counter ticks.
+    uint64_t _upload_time;
+
+    //! \brief The number of images copied into the texture sheets.
+    uint32_t _uploads;
+    //@}
+
+    //! \brief Decodes the prefetched image files in background threads.
+    private_video::ImageLoader _image_loader;
+
+    //! \brief An image waiting for its pixels to be copied into its texture sheet.
+    struct PendingUpload {
+        private_video::ImageTexture *image;
+        private_video::ImageMemory pixels;
+    };
+
+    //! \brief The images waiting for their pixels to be copied, in insertion order.
+    std::deque<PendingUpload> _pending_uploads;
+
     // ---------- Private methods
 
     //! \name Texture Operations
@@ -101,7 +134,7 @@ private:
 
     /** \brief A wrapper to glBindTexture() that also adds checking to eliminate redundant texture binding
     *** \param tex_id The integer handle to the OpenGL texture to bind
-    *** \note Redundancy checks are already implemented by most drivers, but this is a double check "just in case"
+    *** \note The pending batched sprites are drawn first when the bound texture changes.
     **/
     void _BindTexture(GLuint tex_id);
 
@@ -111,6 +144,11 @@ private:
     void _DeleteTexture(GLuint tex_id);
     //@}
 
+    /** \brief The last texture bound through _BindTexture().
+    *** Set it to INVALID_TEXTURE_ID when a texture was bound without using _BindTexture().
+    **/
+    GLuint _last_tex_id;
+
     //! \name Texture Sheet Operations
     //@{
     /** \brief Creates a new texture sheet
@@ -137,7 +175,18 @@ private:
     *** compatible texture sheets. Second, if the image is very large (either height or width of the image exceeds 512 pixels), it will
     *** merit having its own un-shared texture sheet.
     **/
-    private_video::TexSheet *_InsertImageInTexSheet(private_video::BaseTexture *image, private_video::ImageMemory &load_info, bool is_static);
+    private_video::TexSheet *_InsertImageInTexSheet(private_video::BaseTexture *image, private_video::ImageMemory &load_info,
+                                                    bool is_static, bool copy_pixels = true);
+
+    /** \brief Inserts an image texture into a compatible texture sheet
+    *** \param image A pointer to the image to insert
+    *** \param load_info The attributes and pixels of the image to be inserted
+    *** \param is_static Indicates whether the image is static or not
+    *** \param pending If true, the pixels are only copied into the sheet later on, by _UploadPendingTextures()
+    *** \return The texture sheet containing the image, or nullptr if an error occured
+    **/
+    private_video::TexSheet *_InsertImageTextureInTexSheet(private_video::ImageTexture *image, private_video::ImageMemory &load_info,
+                                                           bool is_static, bool pending);
 
     /** \brief Iterate through all currently loaded images and if they belong to the specified TexSheet, reload them into it
     *** \param sheet A pointer to the TexSheet whose images we wish to reload
@@ -146,6 +195,31 @@ private:
     bool _ReloadImagesToSheet(private_video::TexSheet *sheet);
     //@}
 
+    //! \name Pending Images Operations
+    //@{
+    /** \brief Copies the pixels of pending images into their texture sheets
+    *** \param time_budget The time to spend at most, in milliseconds. At least one image is copied.
+    *** This is called once per frame by the video engine.
+    **/
+    void _UploadPendingTextures(float time_budget);
+
+    //! \brief Copies the pixels of a pending image into its texture sheet right away
+    void _FinishPendingUpload(private_video::ImageTexture *image);
+
+    //! \brief Copies the pixels of every pending image of a texture sheet right away
+    void _FinishPendingUploads(private_video::TexSheet *sheet);
+
+    //! \brief Forgets the pixels of a pending image being deleted
+    void _CancelPendingUpload(private_video::ImageTexture *image);
+
+    //! \brief Copies the pixels of a pending image into its texture sheet
+    void _UploadPendingTexture(PendingUpload &upload);
+
+    //! \brief Copies the pixels of an image into its place in a texture sheet, timing the upload.
+    bool _CopyImageToTexSheet(private_video::TexSheet *sheet, private_video::BaseTexture *image,
+                              private_video::ImageMemory &pixels);
+    //@}
+
     //! \name Image Texture Operations
     //@{
     /** \brief Adds an image texture to the map registery
@@ -175,26 +249,6 @@ private:
     }
     //@}
 
-    //! \name Text Texture Operations
-    //@{
-    /** \brief Adds a TextTexture object to the map registery
-    *** \param text A pointer to the TextTexture to add
-    **/
-    void _RegisterTextTexture(private_video::TextTexture *tex);
-
-    /** \brief Removes a TextTexture object from the map registery
-    *** \param text A pointer to the TextTexture to remove
-    **/
-    void _UnregisterTextTexture(private_video::TextTexture *tex);
-
-    /** \brief Determines if a TextTexture is already registered and maintainted by the texture controller
-    *** \param tex A pointer to the TextTexture to check for
-    *** \return True if the TextTexture is already registered, false if it is not
-    **/
-    bool _IsTextTextureRegistered(private_video::TextTexture *tex) const {
-        return (_text_images.find(tex) != _text_images.end());
-    }
-    //@}
 }; // class TextureController : public vt_utils::Singleton<TextureController>
 
 //! \brief The singleton pointer for the instance of the texture controller
@@ -20,6 +20,7 @@
 #include "engine/mode_manager.h"
 #include "script/script_read.h"
 #include "engine/system.h"
+#include "engine/video/gl/gl_debug.h"
 #include "engine/video/gl/gl_particle_system.h"
 #include "engine/video/gl/gl_render_target.h"
 #include "engine/video/gl/gl_shader.h"
@@ -28,10 +29,15 @@
 #include "engine/video/gl/gl_shader_programs.h"
 #include "engine/video/gl/gl_shaders.h"
 #include "engine/video/gl/gl_sprite.h"
+#include "engine/video/gl/gl_sprite_batch.h"
+#include "engine/video/gl/gl_sprite_buffer.h"
 #include "engine/video/gl/gl_transform.h"
+#include "engine/video/particle_worker_pool.h"
 
 #include "utils/utils_strings.h"
 
+#include <algorithm>
+
 using namespace vt_utils;
 using namespace vt_video::private_video;
 
@@ -40,6 +46,7 @@ namespace vt_video
 
 VideoEngine *VideoManager = nullptr;
 bool VIDEO_DEBUG = false;
+bool GL_DEBUG = false;
 
 //-----------------------------------------------------------------------------
 // Static variable for the Color class
@@ -83,12 +90,20 @@ VideoEngine::VideoEngine():
     _fps_sum(0),
     _current_sample(0),
     _number_samples(0),
+    _last_frame_tick(0),
     _FPS_textimage(nullptr),
+    _draw_calls(0),
+    _frame_draw_calls(0),
+    _frame_batch_flushes(0),
+    _frame_batched_sprites(0),
+    _draw_calls_textimage(nullptr),
     _gl_error_code(GL_NO_ERROR),
     _gl_blend_is_active(false),
     _gl_texture_2d_is_active(false),
     _gl_stencil_test_is_active(false),
     _gl_scissor_test_is_active(false),
+    _gl_blend_source_factor(GL_ONE),
+    _gl_blend_destination_factor(GL_ZERO),
     _viewport_x_offset(0),
     _viewport_y_offset(0),
     _viewport_width(0),
@@ -106,8 +121,14 @@ VideoEngine::VideoEngine():
     _vsync_mode(0),
     _game_update_mode(false),
     _sprite(nullptr),
+    _sprite_batch(nullptr),
     _particle_system(nullptr),
-    _initialized(false)
+    _particle_worker_pool(nullptr),
+    _particle_thread_count(0),
+    _current_shader_program(nullptr),
+    _initialized(false),
+    _capture_framebuffer(0),
+    _capture_blur_target(nullptr)
 {
     _current_context.blend = 0;
     _current_context.x_align = -1;
@@ -138,14 +159,27 @@ VideoEngine::~VideoEngine()
         _sprite = nullptr;
     }
 
+    // Clean up the sprite batch.
+    if (_sprite_batch != nullptr) {
+        delete _sprite_batch;
+        _sprite_batch = nullptr;
+    }
+
     // Clean up the particle system.
     if (_particle_system != nullptr) {
         delete _particle_system;
         _particle_system = nullptr;
     }
 
+    // Stop the particle update threads.
+    if (_particle_worker_pool != nullptr) {
+        delete _particle_worker_pool;
+        _particle_worker_pool = nullptr;
+    }
+
     // Clean up the shaders and shader programs.
     glUseProgram(0);
+    _current_shader_program = nullptr;
 
     for (std::map<gl::shader_programs::ShaderPrograms, gl::ShaderProgram*>::iterator i = _programs.begin(); i != _programs.end(); ++i) {
         if (i->second != nullptr) {
@@ -169,6 +203,21 @@ VideoEngine::~VideoEngine()
         _secondary_render_target = nullptr;
     }
 
+    // Clean up the screen captures. The ones still used by images are deleted with the texture manager.
+    for (uint32_t i = 0; i < _screen_captures.size(); ++i)
+        _DeleteScreenCapture(_screen_captures[i]);
+    _screen_captures.clear();
+
+    if (_capture_framebuffer != 0) {
+        glDeleteFramebuffers(1, &_capture_framebuffer);
+        _capture_framebuffer = 0;
+    }
+
+    if (_capture_blur_target != nullptr) {
+        delete _capture_blur_target;
+        _capture_blur_target = nullptr;
+    }
+
     TextManager->SingletonDestroy();
 
     _rectangle_image.Clear();
@@ -178,6 +227,11 @@ VideoEngine::~VideoEngine()
         _FPS_textimage = nullptr;
     }
 
+    if (_draw_calls_textimage != nullptr) {
+        delete _draw_calls_textimage;
+        _draw_calls_textimage = nullptr;
+    }
+
     TextureManager->SingletonDestroy();
 }
 
@@ -195,6 +249,9 @@ bool VideoEngine::FinalizeInitialization()
     // Create the sprite.
     _sprite = new gl::Sprite();
 
+    // Create the sprite batch.
+    _sprite_batch = new gl::SpriteBatch();
+
     // Create the secondary render target.
     _secondary_render_target = new gl::RenderTarget(VIDEO_STANDARD_RES_WIDTH,
                                                     VIDEO_STANDARD_RES_HEIGHT);
@@ -222,6 +279,9 @@ bool VideoEngine::FinalizeInitialization()
     gl::Shader* sprite_grayscale_fragment =
         new gl::Shader(GL_FRAGMENT_SHADER,
                        gl::shader_definitions::SPRITE_GRAYSCALE_FRAGMENT);
+    gl::Shader* sprite_blur_fragment =
+        new gl::Shader(GL_FRAGMENT_SHADER,
+                       gl::shader_definitions::SPRITE_BLUR_FRAGMENT);
 
     // Store the shaders.
     _shaders[gl::shaders::VertexDefault] = default_vertex;
@@ -229,6 +289,7 @@ bool VideoEngine::FinalizeInitialization()
     _shaders[gl::shaders::FragmentSolidGrayscale] = solid_color_grayscale_fragment;
     _shaders[gl::shaders::FragmentSprite] = sprite_fragment;
     _shaders[gl::shaders::FragmentSpriteGrayscale] = sprite_grayscale_fragment;
+    _shaders[gl::shaders::FragmentSpriteBlur] = sprite_blur_fragment;
 
     //
     // Create the shader programs.
@@ -259,6 +320,11 @@ bool VideoEngine::FinalizeInitialization()
                               _shaders[gl::shaders::FragmentSpriteGrayscale],
                               attributes);
 
+    gl::ShaderProgram* sprite_blur_program =
+        new gl::ShaderProgram(_shaders[gl::shaders::VertexDefault],
+                              _shaders[gl::shaders::FragmentSpriteBlur],
+                              attributes);
+
     //
     // Store the shader programs.
     //
@@ -267,6 +333,7 @@ bool VideoEngine::FinalizeInitialization()
     _programs[gl::shader_programs::SolidGrayscale] = solid_grayscale_program;
     _programs[gl::shader_programs::Sprite] = sprite_program;
     _programs[gl::shader_programs::SpriteGrayscale] = sprite_grayscale_program;
+    _programs[gl::shader_programs::SpriteBlur] = sprite_blur_program;
 
     // Create instances of the various sub-systems
     TextureManager = TextureController::SingletonCreate();
@@ -368,6 +435,8 @@ void VideoEngine::SetDrawFlags(int32_t first_flag, ...)
 
 void VideoEngine::Clear()
 {
+    FlushSpriteBatch();
+
     glClear(GL_COLOR_BUFFER_BIT |
             GL_DEPTH_BUFFER_BIT |
             GL_STENCIL_BUFFER_BIT);
@@ -378,9 +447,13 @@ void VideoEngine::Update()
     uint32_t frame_time = vt_system::SystemManager->GetUpdateTime();
 
     _screen_fader.Update(frame_time);
+}
 
-    if (_fps_display)
-        _UpdateFPS();
+void VideoEngine::BeginFrame()
+{
+    // Copy a part of the pending images into their texture sheets,
+    // so that they may already be drawn this frame.
+    TextureManager->_UploadPendingTextures(PENDING_UPLOADS_TIME_BUDGET);
 }
 
 void VideoEngine::DrawDebugInfo()
@@ -392,8 +465,34 @@ void VideoEngine::DrawDebugInfo()
         _DrawFPS();
 }
 
+void VideoEngine::EndFrame()
+{
+    FlushSpriteBatch();
+
+    // Keep the frame statistics for the debug display.
+    _frame_draw_calls = _draw_calls;
+    _frame_batch_flushes = _sprite_batch->GetNumberOfFlushes();
+    _frame_batched_sprites = _sprite_batch->GetNumberOfSpritesDrawn();
+
+    _draw_calls = 0;
+    _sprite_batch->ResetStatistics();
+
+    // Free the memory of the screen captures no image refers to anymore.
+    _TrimScreenCaptures();
+
+    // The game logic updates run at a fixed rate: the frame rate is measured here.
+    if (_fps_display)
+        _UpdateFPS();
+
+    // A single error sweep for the whole frame.
+    if(CheckGLError()) {
+        IF_PRINT_WARNING(VIDEO_DEBUG || GL_DEBUG) << "an OpenGL error occured during the frame: "
+                                                  << CreateGLErrorString() << std::endl;
+    }
+}
+
 bool VideoEngine::CheckGLError() {
-    if(!VIDEO_DEBUG)
+    if(!VIDEO_DEBUG && !GL_DEBUG)
         return false;
 
     _gl_error_code = glGetError();
@@ -484,8 +583,12 @@ bool VideoEngine::ApplySettings()
 
     // Resize the secondary render target.
     assert(_secondary_render_target != nullptr);
+    FlushSpriteBatch();
     _secondary_render_target->Resize(_screen_width, _screen_height);
 
+    // The render target left no texture bound.
+    TextureManager->_last_tex_id = 0;
+
     // Try to apply the VSync mode
     if (_vsync_mode > 2) {
         _vsync_mode = 0;
@@ -535,11 +638,19 @@ void VideoEngine::SetCoordSys(const CoordSys &coordinate_system)
     float m13 = -(top + bottom) / (top - bottom);
     float m23 = -(far_z + near_z) / (far_z - near_z);
 
+    gl::Transform projection(m00, 0.0f, 0.0f, m03,
+                             0.0f, m11, 0.0f, m13,
+                             0.0f, 0.0f, m22, m23,
+                             0.0f, 0.0f, 0.0f, 1.0f);
+
+    if (projection == _projection)
+        return;
+
+    // The pending sprites are to be drawn using the previous projection.
+    FlushSpriteBatch();
+
     // Store the orthographic projection.
-    _projection = gl::Transform(m00, 0.0f, 0.0f, m03,
-                                0.0f, m11, 0.0f, m13,
-                                0.0f, 0.0f, m22, m23,
-                                0.0f, 0.0f, 0.0f, 1.0f);
+    _projection = projection;
 }
 
 void VideoEngine::GetCurrentViewport(float &x, float &y,
@@ -564,6 +675,14 @@ void VideoEngine::SetViewport(float x, float y, float width, float height)
         return;
     }
 
+    if (_viewport_x_offset == static_cast<int32_t>(x) &&
+            _viewport_y_offset == static_cast<int32_t>(y) &&
+            _viewport_width == static_cast<int32_t>(width) &&
+            _viewport_height == static_cast<int32_t>(height))
+        return;
+
+    FlushSpriteBatch();
+
     _viewport_x_offset = x;
     _viewport_y_offset = y;
     _viewport_width = width;
@@ -576,6 +695,7 @@ void VideoEngine::SetViewport(float x, float y, float width, float height)
 void VideoEngine::EnableBlending()
 {
     if(!_gl_blend_is_active) {
+        FlushSpriteBatch();
         glEnable(GL_BLEND);
         _gl_blend_is_active = true;
     }
@@ -584,6 +704,7 @@ void VideoEngine::EnableBlending()
 void VideoEngine::DisableBlending()
 {
     if(_gl_blend_is_active) {
+        FlushSpriteBatch();
         glDisable(GL_BLEND);
         _gl_blend_is_active = false;
     }
@@ -592,6 +713,7 @@ void VideoEngine::DisableBlending()
 void VideoEngine::EnableStencilTest()
 {
     if(!_gl_stencil_test_is_active) {
+        FlushSpriteBatch();
         glEnable(GL_STENCIL_TEST);
         _gl_stencil_test_is_active = true;
     }
@@ -600,6 +722,7 @@ void VideoEngine::EnableStencilTest()
 void VideoEngine::DisableStencilTest()
 {
     if(_gl_stencil_test_is_active) {
+        FlushSpriteBatch();
         glDisable(GL_STENCIL_TEST);
         _gl_stencil_test_is_active = false;
     }
@@ -608,6 +731,7 @@ void VideoEngine::DisableStencilTest()
 void VideoEngine::EnableTexture2D()
 {
     if(!_gl_texture_2d_is_active) {
+        FlushSpriteBatch();
         glEnable(GL_TEXTURE_2D);
         _gl_texture_2d_is_active = true;
     }
@@ -616,19 +740,34 @@ void VideoEngine::EnableTexture2D()
 void VideoEngine::DisableTexture2D()
 {
     if(_gl_texture_2d_is_active) {
+        FlushSpriteBatch();
         glDisable(GL_TEXTURE_2D);
         _gl_texture_2d_is_active = false;
     }
 }
 
+void VideoEngine::SetBlendFunction(GLenum source_factor, GLenum destination_factor)
+{
+    if (source_factor == _gl_blend_source_factor &&
+            destination_factor == _gl_blend_destination_factor)
+        return;
+
+    FlushSpriteBatch();
+    glBlendFunc(source_factor, destination_factor);
+    _gl_blend_source_factor = source_factor;
+    _gl_blend_destination_factor = destination_factor;
+}
+
 void VideoEngine::EnableSecondaryRenderTarget()
 {
     assert(_secondary_render_target != nullptr);
+    FlushSpriteBatch();
     _secondary_render_target->Bind();
 }
 
 void VideoEngine::DisableSecondaryRenderTarget()
 {
+    FlushSpriteBatch();
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
@@ -640,6 +779,9 @@ void VideoEngine::DrawSecondaryRenderTarget()
     float width_render_target = static_cast<float>(_secondary_render_target->GetWidth());
     float height_render_target = static_cast<float>(_secondary_render_target->GetHeight());
 
+    // The uniforms below are set directly, so the pending sprites must be drawn first.
+    FlushSpriteBatch();
+
     // Set up the video manager state.
     vt_video::VideoManager->PushState();
 
@@ -648,7 +790,7 @@ void VideoEngine::DrawSecondaryRenderTarget()
     vt_video::VideoManager->SetDrawFlags(vt_video::VIDEO_X_LEFT, vt_video::VIDEO_Y_TOP, vt_video::VIDEO_BLEND, 0);
 
     VideoManager->EnableBlending();
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    VideoManager->SetBlendFunction(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // Load the shader program.
     gl::ShaderProgram* shader_program = VideoManager->LoadShaderProgram(gl::shader_programs::Sprite);
@@ -658,15 +800,15 @@ void VideoEngine::DrawSecondaryRenderTarget()
     float buffer[16] = { 0 };
     gl::Transform identity;
     identity.Apply(buffer);
-    shader_program->UpdateUniform("u_Model", buffer, 16);
+    shader_program->UpdateUniform(gl::uniforms::Model, buffer, 16);
 
     identity.Apply(buffer);
-    shader_program->UpdateUniform("u_View", buffer, 16);
+    shader_program->UpdateUniform(gl::uniforms::View, buffer, 16);
 
     identity.Apply(buffer);
-    shader_program->UpdateUniform("u_Projection", buffer, 16);
+    shader_program->UpdateUniform(gl::uniforms::Projection, buffer, 16);
 
-    shader_program->UpdateUniform("u_Color", ::vt_video::Color::white.GetColors(), 4);
+    shader_program->UpdateUniform(gl::uniforms::Color, ::vt_video::Color::white.GetColors(), 4);
 
     // Disable the secondary render target.
     DisableSecondaryRenderTarget();
@@ -706,12 +848,11 @@ void VideoEngine::DrawSecondaryRenderTarget()
     };
 
     _sprite->Draw(vertex_positions, vertex_texture_coordinates, vertex_colors);
+    ++_draw_calls;
 
     // Unbind the secondary render target's texture.
     glBindTexture(GL_TEXTURE_2D, 0);
-
-    // Unload the shader program.
-    VideoManager->UnloadShaderProgram();
+    TextureManager->_last_tex_id = 0;
 
     // Restore the state.
     vt_video::VideoManager->PopState();
@@ -724,46 +865,112 @@ gl::ShaderProgram* VideoEngine::LoadShaderProgram(const gl::shader_programs::Sha
     assert(_programs.find(shader_program) != _programs.end());
     if (_programs.find(shader_program) != _programs.end()) {
         result = _programs.at(shader_program);
-        result->Load();
+
+        if (result != _current_shader_program) {
+            // The pending sprites are to be drawn using the previous program.
+            FlushSpriteBatch();
+            result->Load();
+            _current_shader_program = result;
+        }
     }
 
     return result;
 }
 
-void VideoEngine::UnloadShaderProgram()
+bool VideoEngine::MapParticleBuffers(unsigned number_of_particles,
+                                     float** vertex_positions,
+                                     float** vertex_texture_coordinates,
+                                     float** vertex_colors)
 {
-    glUseProgram(0);
+    assert(_particle_system != nullptr);
+
+    return _particle_system->MapBuffers(number_of_particles,
+                                        vertex_positions,
+                                        vertex_texture_coordinates,
+                                        vertex_colors);
 }
 
-void VideoEngine::DrawParticleSystem(gl::ShaderProgram* shader_program,
-                                     float* vertex_positions,
-                                     float* vertex_texture_coordinates,
-                                     float* vertex_colors,
-                                     unsigned number_of_vertices)
+void VideoEngine::DrawParticleSystem(gl::ShaderProgram* shader_program)
 {
     assert(_particle_system != nullptr);
     assert(shader_program != nullptr);
-    assert(vertex_positions != nullptr);
-    assert(vertex_texture_coordinates != nullptr);
-    assert(vertex_colors != nullptr);
-    assert(number_of_vertices % 4 == 0);
+
+    // The uniforms below are set directly, so the pending sprites must be drawn first.
+    FlushSpriteBatch();
 
     // Load the shader uniforms common to all programs.
     float buffer[16] = { 0 };
     _transform_stack.top().Apply(buffer);
-    shader_program->UpdateUniform("u_Model", buffer, 16);
+    shader_program->UpdateUniform(gl::uniforms::Model, buffer, 16);
 
     gl::Transform identity;
     identity.Apply(buffer);
-    shader_program->UpdateUniform("u_View", buffer, 16);
+    shader_program->UpdateUniform(gl::uniforms::View, buffer, 16);
 
     _projection.Apply(buffer);
-    shader_program->UpdateUniform("u_Projection", buffer, 16);
+    shader_program->UpdateUniform(gl::uniforms::Projection, buffer, 16);
 
-    shader_program->UpdateUniform("u_Color", reinterpret_cast<const float*>(&::vt_video::Color::white), 4);
+    shader_program->UpdateUniform(gl::uniforms::Color, ::vt_video::Color::white.GetColors(), 4);
 
     // Draw the particle system.
-    _particle_system->Draw(vertex_positions, vertex_texture_coordinates, vertex_colors, number_of_vertices);
+    _particle_system->DrawMappedBuffers();
+    ++_draw_calls;
+}
+
+void VideoEngine::SetParticleThreadCount(uint32_t thread_count)
+{
+    if (thread_count > vt_mode_manager::MAX_PARTICLE_THREADS)
+        thread_count = vt_mode_manager::MAX_PARTICLE_THREADS;
+
+    if (thread_count == _particle_thread_count)
+        return;
+
+    _particle_thread_count = thread_count;
+
+    // The threads are created again with the new count on next use.
+    if (_particle_worker_pool != nullptr) {
+        delete _particle_worker_pool;
+        _particle_worker_pool = nullptr;
+    }
+}
+
+vt_mode_manager::ParticleWorkerPool* VideoEngine::GetParticleWorkerPool()
+{
+    if (_particle_worker_pool == nullptr)
+        _particle_worker_pool = new vt_mode_manager::ParticleWorkerPool(_particle_thread_count);
+
+    return _particle_worker_pool;
+}
+
+void VideoEngine::DrawSpriteBuffer(gl::ShaderProgram* shader_program,
+                                   const gl::SpriteBuffer* sprite_buffer,
+                                   unsigned first_sprite,
+                                   unsigned number_of_sprites)
+{
+    assert(shader_program != nullptr);
+    assert(shader_program == _current_shader_program);
+    assert(sprite_buffer != nullptr);
+
+    // The uniforms below are set directly, so the pending sprites must be drawn first.
+    FlushSpriteBatch();
+
+    // Load the shader uniforms common to all programs.
+    float buffer[16] = { 0 };
+    _transform_stack.top().Apply(buffer);
+    shader_program->UpdateUniform(gl::uniforms::Model, buffer, 16);
+
+    gl::Transform identity;
+    identity.Apply(buffer);
+    shader_program->UpdateUniform(gl::uniforms::View, buffer, 16);
+
+    _projection.Apply(buffer);
+    shader_program->UpdateUniform(gl::uniforms::Projection, buffer, 16);
+
+    shader_program->UpdateUniform(gl::uniforms::Color, ::vt_video::Color::white.GetColors(), 4);
+
+    // Draw the sprites.
+    sprite_buffer->Draw(first_sprite, number_of_sprites);
+    ++_draw_calls;
 }
 
 void VideoEngine::DrawSprite(gl::ShaderProgram* shader_program,
@@ -772,34 +979,63 @@ void VideoEngine::DrawSprite(gl::ShaderProgram* shader_program,
                              float* vertex_colors,
                              const Color& color)
 {
-    assert(_sprite != nullptr);
+    assert(_sprite_batch != nullptr);
     assert(shader_program != nullptr);
     assert(vertex_positions != nullptr);
     assert(vertex_texture_coordinates != nullptr);
     assert(vertex_colors != nullptr);
 
+    // The pending sprites are to be drawn using the previous program.
+    if (shader_program != _current_shader_program) {
+        FlushSpriteBatch();
+        shader_program->Load();
+        _current_shader_program = shader_program;
+    }
+
+    if (_sprite_batch->IsFull())
+        FlushSpriteBatch();
+
+    // Queue the sprite. The model transform and the color
+    // are applied on the vertices so that the uniforms are shared.
+    _sprite_batch->AddSprite(_transform_stack.top(),
+                             vertex_positions,
+                             vertex_texture_coordinates,
+                             vertex_colors,
+                             color.GetColors());
+}
+
+void VideoEngine::FlushSpriteBatch()
+{
+    if (_sprite_batch == nullptr || _sprite_batch->IsEmpty())
+        return;
+
+    assert(_current_shader_program != nullptr);
+
     // Load the shader uniforms common to all programs.
+    // The model transform and color were already applied on the batched vertices,
+    // and the program only uploads the values changed since its last draw, e.g.:
+    // the projection after a SetCoordSys() call.
     float buffer[16] = { 0 };
-    _transform_stack.top().Apply(buffer);
-    shader_program->UpdateUniform("u_Model", buffer, 16);
-
     gl::Transform identity;
     identity.Apply(buffer);
-    shader_program->UpdateUniform("u_View", buffer, 16);
+    _current_shader_program->UpdateUniform(gl::uniforms::Model, buffer, 16);
+    _current_shader_program->UpdateUniform(gl::uniforms::View, buffer, 16);
 
     _projection.Apply(buffer);
-    shader_program->UpdateUniform("u_Projection", buffer, 16);
+    _current_shader_program->UpdateUniform(gl::uniforms::Projection, buffer, 16);
 
-    shader_program->UpdateUniform("u_Color", color.GetColors(), 4);
+    _current_shader_program->UpdateUniform(gl::uniforms::Color, ::vt_video::Color::white.GetColors(), 4);
 
-    // Draw the sprite.
-    _sprite->Draw(vertex_positions, vertex_texture_coordinates, vertex_colors);
+    // Draw the sprites.
+    _sprite_batch->Flush();
+    ++_draw_calls;
 }
 
 void VideoEngine::EnableScissoring()
 {
     _current_context.scissoring_enabled = true;
     if (!_gl_scissor_test_is_active) {
+        FlushSpriteBatch();
         glEnable(GL_SCISSOR_TEST);
         _gl_scissor_test_is_active = true;
     }
@@ -809,6 +1045,7 @@ void VideoEngine::DisableScissoring()
 {
     _current_context.scissoring_enabled = false;
     if (_gl_scissor_test_is_active) {
+        FlushSpriteBatch();
         glDisable(GL_SCISSOR_TEST);
         _gl_scissor_test_is_active = false;
     }
@@ -824,6 +1061,10 @@ void VideoEngine::SetScissorRect(const ScreenRect& screen_rectangle)
 {
     _current_context.scissor_rectangle = screen_rectangle;
 
+    // The scissor rectangle only matters to the pending sprites when scissoring is active.
+    if (_gl_scissor_test_is_active)
+        FlushSpriteBatch();
+
     glScissor(static_cast<GLint>(_current_context.scissor_rectangle.left),
               static_cast<GLint>(_current_context.scissor_rectangle.top),
               static_cast<GLsizei>(_current_context.scissor_rectangle.width),
@@ -972,11 +1213,8 @@ void VideoEngine::DisableFadeEffect()
         FadeIn(0);
 }
 
-StillImage VideoEngine::CaptureScreen()
+StillImage VideoEngine::CaptureScreen(bool blurred)
 {
-    // Static variable used to make sure the capture has a unique name in the texture image map
-    static uint32_t capture_id = 0;
-
     // Get the viewport.
     float viewport_x = 0.0f;
     float viewport_y = 0.0f;
@@ -985,62 +1223,264 @@ StillImage VideoEngine::CaptureScreen()
     vt_video::VideoManager->GetCurrentViewport(viewport_x, viewport_y,
                                                viewport_width, viewport_height);
 
-    StillImage screen_image;
-    screen_image.SetDimensions(viewport_width, viewport_height);
-
     // Set up the screen rectangle to copy.
     ScreenRect screen_rect(static_cast<int32_t>(viewport_x),
                            static_cast<int32_t>(viewport_y),
                            static_cast<int32_t>(viewport_width),
                            static_cast<int32_t>(viewport_height));
 
-    // Create a new ImageTexture with a unique filename for this newly captured screen
-    ImageTexture* new_image = new ImageTexture("capture_screen" + NumberToString(capture_id),
-                                               "",
-                                               static_cast<int32_t>(viewport_width),
-                                               static_cast<int32_t>(viewport_height));
-    new_image->AddReference();
+    ImageTexture* capture = _GetScreenCapture(std::max(1, screen_rect.width),
+                                              std::max(1, screen_rect.height));
+    if (!_CopyScreenToCapture(screen_rect, capture))
+        throw Exception("could not copy the screen into the capture texture",
+                        __FILE__, __LINE__, __FUNCTION__);
 
-    // Create a texture sheet of an appropriate size that can retain the capture
-    TexSheet *temp_sheet = TextureManager->_CreateTexSheet(RoundUpPow2(static_cast<uint32_t>(viewport_width)),
-                                                           RoundUpPow2(static_cast<uint32_t>(viewport_height)),
-                                                           VIDEO_TEXSHEET_ANY,
-                                                           false);
-    VariableTexSheet *sheet = dynamic_cast<VariableTexSheet *>(temp_sheet);
+    if (blurred && !_BlurScreenCapture(capture))
+        throw Exception("could not blur the capture texture",
+                        __FILE__, __LINE__, __FUNCTION__);
 
-    // Ensure that texture sheet creation succeeded, insert the texture image into the sheet, and copy the screen into the sheet
-    if (sheet == nullptr) {
-        delete new_image;
+    StillImage screen_image;
+    screen_image.SetDimensions(viewport_width, viewport_height);
+    screen_image._image_texture = capture;
+    screen_image._texture = capture;
+    capture->AddReference();
+
+    return screen_image;
+}
+
+ImageTexture* VideoEngine::_GetScreenCapture(uint32_t width, uint32_t height)
+{
+    // Static variable used to make sure the capture has a unique name in the texture image map
+    static uint32_t capture_id = 0;
+
+    // Reuse a free capture of the same size, if any.
+    std::vector<ImageTexture*>::iterator free_capture = _screen_captures.end();
+    for (std::vector<ImageTexture*>::iterator it = _screen_captures.begin(); it != _screen_captures.end(); ++it) {
+        if ((*it)->ref_count > 1)
+            continue;
+
+        if ((*it)->width == width && (*it)->height == height)
+            return *it;
+
+        if (free_capture == _screen_captures.end())
+            free_capture = it;
+    }
+
+    // Make room for the new capture by deleting a free one of another size, e.g.: before the screen was resized.
+    if (_screen_captures.size() >= VIDEO_SCREEN_CAPTURE_POOL_SIZE && free_capture != _screen_captures.end()) {
+        _DeleteScreenCapture(*free_capture);
+        _screen_captures.erase(free_capture);
+    }
+
+    TexSheet* sheet = TextureManager->_CreateTexSheet(RoundUpPow2(width), RoundUpPow2(height),
+                                                      VIDEO_TEXSHEET_SCREEN_CAPTURE, false);
+    if (sheet == nullptr)
         throw Exception("could not create texture sheet to store captured screen",
                         __FILE__, __LINE__, __FUNCTION__);
-    }
 
-    if (sheet->InsertTexture(new_image) == false) {
+    ImageTexture* capture = new ImageTexture("capture_screen" + NumberToString(capture_id++), "",
+                                             static_cast<int32_t>(width), static_cast<int32_t>(height));
+    if (!sheet->InsertTexture(capture)) {
         TextureManager->_RemoveSheet(sheet);
-        delete new_image;
+        delete capture;
         throw Exception("could not insert captured screen image into texture sheet",
                         __FILE__, __LINE__, __FUNCTION__);
     }
 
-    if (sheet->CopyScreenRect(0, 0, screen_rect) == false) {
-        TextureManager->_RemoveSheet(sheet);
-        delete new_image;
-        throw Exception("call to TexSheet::CopyScreenRect() failed",
-                        __FILE__, __LINE__, __FUNCTION__);
+    // The pool reference.
+    capture->AddReference();
+    _screen_captures.push_back(capture);
+    return capture;
+}
+
+void VideoEngine::_TrimScreenCaptures()
+{
+    uint32_t free_captures = 0;
+    for (std::vector<ImageTexture*>::iterator it = _screen_captures.begin(); it != _screen_captures.end();) {
+        // Captures still used by images are kept.
+        if ((*it)->ref_count > 1 || ++free_captures <= VIDEO_SCREEN_CAPTURE_POOL_SIZE) {
+            ++it;
+            continue;
+        }
+
+        _DeleteScreenCapture(*it);
+        it = _screen_captures.erase(it);
     }
+}
 
-    // Store the image element to the saved image (with a flipped y axis)
-    screen_image._image_texture = new_image;
-    screen_image._texture = new_image;
+void VideoEngine::_DeleteScreenCapture(ImageTexture* capture)
+{
+    if (!capture->RemoveReference())
+        return;
 
-    // Vertically flip the texture image by swapping the v coordinates,
-    // since OpenGL returns the image upside down in the CopyScreenRect call
-    float temp = new_image->v1;
-    new_image->v1 = new_image->v2;
-    new_image->v2 = temp;
+    TexSheet* sheet = capture->texture_sheet;
+    sheet->RemoveTexture(capture);
+    delete capture;
+    TextureManager->_RemoveSheet(sheet);
+}
 
-    ++capture_id;
-    return screen_image;
+bool VideoEngine::_CopyScreenToCapture(const ScreenRect& screen_rect, ImageTexture* capture)
+{
+    // The screen must contain every pending sprite.
+    FlushSpriteBatch();
+
+    if (_capture_framebuffer == 0)
+        glGenFramebuffers(1, &_capture_framebuffer);
+
+    // Copy from the framebuffer currently drawn to, e.g.: the secondary render target.
+    GLint screen_framebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &screen_framebuffer);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(screen_framebuffer));
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _capture_framebuffer);
+    glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                           capture->texture_sheet->tex_id, 0);
+
+    // The scissor test applies to blits as well.
+    if (_gl_scissor_test_is_active)
+        glDisable(GL_SCISSOR_TEST);
+
+    // The rows are flipped, so that the capture is stored from top to bottom like the loaded images.
+    glBlitFramebuffer(screen_rect.left, screen_rect.top,
+                      screen_rect.left + screen_rect.width, screen_rect.top + screen_rect.height,
+                      capture->x, capture->y + capture->height,
+                      capture->x + capture->width, capture->y,
+                      GL_COLOR_BUFFER_BIT, GL_LINEAR);
+
+    if (_gl_scissor_test_is_active)
+        glEnable(GL_SCISSOR_TEST);
+
+    glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(screen_framebuffer));
+
+    if (CheckGLError()) {
+        IF_PRINT_WARNING(VIDEO_DEBUG) << "an OpenGL error occured: " << CreateGLErrorString() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool VideoEngine::_BlurScreenCapture(ImageTexture* capture)
+{
+    TexSheet* sheet = capture->texture_sheet;
+    const float sheet_width = static_cast<float>(sheet->width);
+    const float sheet_height = static_cast<float>(sheet->height);
+    const float width = static_cast<float>(capture->width);
+    const float height = static_cast<float>(capture->height);
+
+    // The render target is only resized when the screen capture size changes.
+    if (_capture_blur_target == nullptr) {
+        _capture_blur_target = new gl::RenderTarget(capture->width, capture->height);
+    }
+    else if (_capture_blur_target->GetWidth() != static_cast<unsigned>(capture->width) ||
+             _capture_blur_target->GetHeight() != static_cast<unsigned>(capture->height)) {
+        _capture_blur_target->Resize(capture->width, capture->height);
+    }
+
+    gl::ShaderProgram* shader_program = LoadShaderProgram(gl::shader_programs::SpriteBlur);
+    assert(shader_program != nullptr);
+
+    // The quads are given in normalized device coordinates.
+    float buffer[16] = { 0 };
+    gl::Transform identity;
+    identity.Apply(buffer);
+    shader_program->UpdateUniform(gl::uniforms::Model, buffer, 16);
+    shader_program->UpdateUniform(gl::uniforms::View, buffer, 16);
+    shader_program->UpdateUniform(gl::uniforms::Projection, buffer, 16);
+    shader_program->UpdateUniform(gl::uniforms::Color, ::vt_video::Color::white.GetColors(), 4);
+
+    GLint screen_framebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &screen_framebuffer);
+
+    // The passes replace the target pixels.
+    bool blending = _gl_blend_is_active;
+    DisableBlending();
+    if (_gl_scissor_test_is_active)
+        glDisable(GL_SCISSOR_TEST);
+
+    // The horizontal pass, from the capture into the render target.
+    // The taps are kept within the capture, as the rest of its texture sheet is undefined.
+    _capture_blur_target->Bind();
+    glViewport(0, 0, capture->width, capture->height);
+    glBindTexture(GL_TEXTURE_2D, sheet->tex_id);
+
+    float step[4] = { VIDEO_SCREEN_CAPTURE_BLUR_SPREAD / sheet_width, 0.0f, 0.0f, 0.0f };
+    float bounds[4] = { (capture->x + 0.5f) / sheet_width, (capture->y + 0.5f) / sheet_height,
+                        (capture->x + width - 0.5f) / sheet_width, (capture->y + height - 0.5f) / sheet_height };
+    shader_program->UpdateUniform("u_BlurStep", step, 4);
+    shader_program->UpdateUniform("u_BlurBounds", bounds, 4);
+    _DrawCaptureBlurPass(capture->x / sheet_width, capture->y / sheet_height,
+                         (capture->x + width) / sheet_width, (capture->y + height) / sheet_height);
+
+    // The vertical pass, from the render target back into the capture.
+    glBindFramebuffer(GL_FRAMEBUFFER, _capture_framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, sheet->tex_id, 0);
+    glViewport(capture->x, capture->y, capture->width, capture->height);
+    _capture_blur_target->BindTexture();
+
+    step[0] = 0.0f;
+    step[1] = VIDEO_SCREEN_CAPTURE_BLUR_SPREAD / height;
+    bounds[0] = 0.5f / width;
+    bounds[1] = 0.5f / height;
+    bounds[2] = 1.0f - bounds[0];
+    bounds[3] = 1.0f - bounds[1];
+    shader_program->UpdateUniform("u_BlurStep", step, 4);
+    shader_program->UpdateUniform("u_BlurBounds", bounds, 4);
+    _DrawCaptureBlurPass(0.0f, 0.0f, 1.0f, 1.0f);
+
+    // Restore the state.
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(screen_framebuffer));
+    glViewport(_viewport_x_offset, _viewport_y_offset, _viewport_width, _viewport_height);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    TextureManager->_last_tex_id = 0;
+
+    if (_gl_scissor_test_is_active)
+        glEnable(GL_SCISSOR_TEST);
+    if (blending)
+        EnableBlending();
+
+    if (CheckGLError()) {
+        IF_PRINT_WARNING(VIDEO_DEBUG) << "an OpenGL error occured: " << CreateGLErrorString() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+void VideoEngine::_DrawCaptureBlurPass(float u1, float v1, float u2, float v2)
+{
+    // The vertex positions.
+    float vertex_positions[] =
+    {
+        -1.0f, -1.0f, 0.0f, // Vertex One.
+         1.0f, -1.0f, 0.0f, // Vertex Two.
+         1.0f,  1.0f, 0.0f, // Vertex Three.
+        -1.0f,  1.0f, 0.0f  // Vertex Four.
+    };
+
+    // The vertex texture coordinates. The rows keep their order in both passes.
+    float vertex_texture_coordinates[] =
+    {
+        u1, v1, // Vertex One.
+        u2, v1, // Vertex Two.
+        u2, v2, // Vertex Three.
+        u1, v2  // Vertex Four.
+    };
+
+    // The vertex colors.
+    float vertex_colors[] =
+    {
+        1.0f, 1.0f, 1.0f, 1.0f, // Vertex One.
+        1.0f, 1.0f, 1.0f, 1.0f, // Vertex Two.
+        1.0f, 1.0f, 1.0f, 1.0f, // Vertex Three.
+        1.0f, 1.0f, 1.0f, 1.0f  // Vertex Four.
+    };
+
+    _sprite->Draw(vertex_positions, vertex_texture_coordinates, vertex_colors);
+    ++_draw_calls;
 }
 
 StillImage VideoEngine::CreateImage(ImageMemory *raw_image,
@@ -1153,6 +1593,9 @@ void VideoEngine::MakeScreenshot(const std::string &filename)
 {
     private_video::ImageMemory buffer;
 
+    // Make sure every sprite is drawn before reading the pixels.
+    FlushSpriteBatch();
+
     // Retrieve the width and height of the viewport.
     GLint viewport_dimensions[4]; // viewport_dimensions[2] is the width, [3] is the height
     glGetIntegerv(GL_VIEWPORT, viewport_dimensions);
@@ -1220,7 +1663,7 @@ void VideoEngine::DrawLine(float x1, float y1, unsigned width1,
     DisableTexture2D();
 
     // Normal blending.
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    SetBlendFunction(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // Load the solid shader program.
     gl::ShaderProgram* shader_program = VideoManager->LoadShaderProgram(gl::shader_programs::Solid);
@@ -1228,9 +1671,6 @@ void VideoEngine::DrawLine(float x1, float y1, unsigned width1,
 
     // Draw the line.
     DrawSprite(shader_program, vertex_positions, vertex_texture_coordinates, vertex_colors, color);
-
-    // Unload the shader program.
-    UnloadShaderProgram();
 }
 
 void VideoEngine::DrawGrid(float left, float top, float right, float bottom,
@@ -1366,9 +1806,11 @@ void VideoEngine::_UpdateFPS()
     if (!_fps_display)
         return;
 
-    // We only create the text image when needed, to permit getting the text style correctly.
+    // We only create the text images when needed, to permit getting the text style correctly.
     if (!_FPS_textimage)
         _FPS_textimage = new TextImage("FPS: ", TextStyle("text20", Color::white));
+    if (!_draw_calls_textimage)
+        _draw_calls_textimage = new TextImage("Draw calls: ", TextStyle("text20", Color::white));
 
     //! \brief Maximum milliseconds that the current frame time and our averaged frame time must vary
     //! before we begin trying to catch up
@@ -1377,7 +1819,9 @@ void VideoEngine::_UpdateFPS()
     //! \brief The number of samples to take if we need to play catchup with the current FPS
     const uint32_t FPS_CATCHUP = 20;
 
-    uint32_t frame_time = vt_system::SystemManager->GetUpdateTime();
+    uint32_t frame_tick = SDL_GetTicks();
+    uint32_t frame_time = frame_tick - _last_frame_tick;
+    _last_frame_tick = frame_tick;
 
     // Calculate the FPS for the current frame
     uint32_t current_fps = 1000;
@@ -1423,6 +1867,9 @@ void VideoEngine::_UpdateFPS()
 
     // The text to display to the screen
     _FPS_textimage->SetText("FPS: " + NumberToString(avg_fps));
+    _draw_calls_textimage->SetText("Draw calls: " + NumberToString(_frame_draw_calls)
+                                   + " - Batches: " + NumberToString(_frame_batch_flushes)
+                                   + " (" + NumberToString(_frame_batched_sprites) + " sprites)");
 }
 
 void VideoEngine::_DrawFPS()
@@ -1436,6 +1883,12 @@ void VideoEngine::_DrawFPS()
                  VIDEO_BLEND, 0);
     Move(930.0f, 40.0f); // Upper right hand corner of the screen
     _FPS_textimage->Draw();
+
+    if (_draw_calls_textimage) {
+        SetDrawFlags(VIDEO_X_RIGHT, 0);
+        Move(1014.0f, 65.0f);
+        _draw_calls_textimage->Draw();
+    }
     PopState();
 }
 
@@ -64,6 +64,7 @@ class MapTransitionEvent;
 
 namespace vt_mode_manager {
 class ModeEngine;
+class ParticleWorkerPool;
 }
 
 //! \brief All calls to the video engine are wrapped in this namespace.
@@ -75,6 +76,8 @@ class RenderTarget;
 class Shader;
 class ShaderProgram;
 class Sprite;
+class SpriteBatch;
+class SpriteBuffer;
 }
 
 class VideoEngine;
@@ -85,6 +88,12 @@ extern VideoEngine *VideoManager;
 //! \brief Determines whether the code in the vt_video namespace should print
 extern bool VIDEO_DEBUG;
 
+//! \brief The number of screen captures kept for reuse once no image refers to them.
+const uint32_t VIDEO_SCREEN_CAPTURE_POOL_SIZE = 2;
+
+//! \brief The distance in pixels between two taps of the screen capture blur filter.
+const float VIDEO_SCREEN_CAPTURE_BLUR_SPREAD = 2.0f;
+
 /** \brief Rotates a point (x,y) around the origin (0,0), by angle radians
 *** \param x x coordinate of point to rotate
 *** \param y y coordinate of point to rotate
@@ -118,7 +127,7 @@ class VideoEngine : public vt_utils::Singleton<VideoEngine>
 
     friend class ImageDescriptor;
     friend class CompositeImage;
-    friend class private_video::TextElement;
+    friend class StaticImageBatch;
     friend class TextImage;
 
 public:
@@ -152,14 +161,26 @@ public:
     **/
     void Update();
 
-    //! \brief Displays potential debug information (FPS and textures).
+    /** \brief Copies a part of the pending images into their texture sheets.
+    *** \note Call it once per frame, before drawing. The upload time budget is thus
+    *** per frame, whatever the number of game logic updates done before it.
+    **/
+    void BeginFrame();
+
+    //! \brief Displays potential debug information (FPS, draw calls and textures).
     void DrawDebugInfo();
 
+    /** \brief Draws the sprites still waiting in the sprite batch and closes the frame statistics.
+    *** \note Call it once per frame, right before swapping the buffers.
+    *** The OpenGL errors raised during the frame are also reported there, when debugging.
+    **/
+    void EndFrame();
+
     /** \brief Retrieves the OpenGL error code and retains it in the _gl_error_code member
     *** \return True if an OpenGL error has been detected, false if no errors were detected
-    *** \note This function only produces a meaningful result if the VIDEO_DEBUG variable is set to true. This is done
+    *** \note This function only produces a meaningful result if the VIDEO_DEBUG or GL_DEBUG variable is set to true. This is done
     *** because the call to glGetError() requires a round trip to the GPU and a flush of the rendering pipeline; a fairly
-    *** expensive operation. If VIDEO_DEBUG is false, the function will always return false immediately.
+    *** expensive operation. Otherwise, the function will always return false immediately.
     **/
     bool CheckGLError();
 
@@ -310,6 +331,9 @@ public:
     void EnableTexture2D();
     void DisableTexture2D();
 
+    //! \brief Sets the blending function, but only if it changed.
+    void SetBlendFunction(GLenum source_factor, GLenum destination_factor);
+
     //! Enables the secondary render target.
     void EnableSecondaryRenderTarget();
 
@@ -323,26 +347,67 @@ public:
     **/
     void DrawSecondaryRenderTarget();
 
-    //! \brief Loads a shader program.
+    /** \brief Loads a shader program.
+    *** \note The program stays in use until another one is loaded,
+    *** so that consecutive sprites can share the same draw call.
+    **/
     gl::ShaderProgram* LoadShaderProgram(const gl::shader_programs::ShaderPrograms& shader_program);
 
-    //! \brief Unloads the currently loaded shader program.
-    void UnloadShaderProgram();
+    /** \brief Maps the particle vertex buffers, so that the particle vertices are written straight into them.
+    *** \param number_of_particles The number of particles to draw.
+    *** A nullptr buffer parameter keeps the content written for the previous draw.
+    *** \return false if the buffers couldn't be mapped.
+    *** \note The buffers must be drawn with DrawParticleSystem() once written.
+    **/
+    bool MapParticleBuffers(unsigned number_of_particles,
+                            float** vertex_positions,
+                            float** vertex_texture_coordinates,
+                            float** vertex_colors);
+
+    //! \brief Draws the particles written in the mapped particle buffers.
+    void DrawParticleSystem(gl::ShaderProgram* shader_program);
 
-    //! \brief Draws a particle system.
-    void DrawParticleSystem(gl::ShaderProgram* shader_program,
-                            float* vertex_positions,
-                            float* vertex_texture_coordinates,
-                            float* vertex_colors,
-                            unsigned number_of_vertices);
+    /** \brief Sets the number of threads updating the particle systems, the main thread included.
+    *** \param thread_count 1 updates the systems on the main thread only,
+    *** and 0 picks a count depending on the number of CPU cores.
+    **/
+    void SetParticleThreadCount(uint32_t thread_count);
+
+    //! \brief Returns the thread count setting, 0 meaning it depends on the number of CPU cores.
+    uint32_t GetParticleThreadCount() const {
+        return _particle_thread_count;
+    }
+
+    //! \brief Returns the threads updating the particle systems.
+    vt_mode_manager::ParticleWorkerPool* GetParticleWorkerPool();
+
+    /** \brief Draws a range of sprites stored on the GPU, using the current transformation.
+    *** \param shader_program The shader program, already loaded through LoadShaderProgram().
+    *** \param sprite_buffer The sprites to draw.
+    *** \param first_sprite The index of the first sprite to draw.
+    *** \param number_of_sprites The number of sprites to draw.
+    **/
+    void DrawSpriteBuffer(gl::ShaderProgram* shader_program,
+                          const gl::SpriteBuffer* sprite_buffer,
+                          unsigned first_sprite,
+                          unsigned number_of_sprites);
 
-    //! \brief Draws a sprite.
+    /** \brief Draws a sprite.
+    *** The sprite is queued in the sprite batch, and actually drawn along with
+    *** the following ones sharing the same shader program, texture, blending and scissoring.
+    **/
     void DrawSprite(gl::ShaderProgram* shader_program,
                     float* vertex_positions,
                     float* vertex_texture_coordinates,
                     float* vertex_colors,
                     const Color& color = ::vt_video::Color::white);
 
+    /** \brief Draws the sprites waiting in the sprite batch.
+    *** The video engine already does it before changing any OpenGL state the pending sprites depend on.
+    *** Call it before issuing such OpenGL calls directly.
+    **/
+    void FlushSpriteBatch();
+
     /** \brief Enables the scissoring effect in the video engine
     *** Scissoring is where you can specify a rectangle of the screen which is affected
     *** by rendering operations (and hence, specify what area is not affected). Make sure
@@ -456,16 +521,16 @@ public:
     // ----------  Image operation methods
 
     /** \brief Captures the contents of the screen and saves it as an image texture
+    *** \param blurred Whether the capture is blurred on the GPU, which suits menu backgrounds.
     *** \return An initialized StillImage object used to draw/manipulate the captured screen
     *** \throw Exception If the new captured screen could not be created
     ***
-    *** When this function is called, it will generate an image using the contents that are
-    *** being displayed on the current screen. This means that you can have multiple screen
-    *** captures in memory at the same time. You should be careful not to have too many
-    *** screen captures existing at one time, because each image capture requires a relatively
-    *** large amount of texutre memory (roughly 3GB for a 1024x768 screen).
+    *** The screen is copied on the GPU into a pooled capture texture, which is reused
+    *** by later captures once no image refers to it anymore. You should be careful not
+    *** to keep too many screen captures at one time, because each of them requires
+    *** a relatively large amount of texture memory (4MB for a 1024x768 screen).
     **/
-    StillImage CaptureScreen();
+    StillImage CaptureScreen(bool blurred = false);
 
     /** \brief Creates an image based on the raw image information passed in. This
     *** image can be rendered or used as a texture by the rendering system
@@ -664,9 +729,23 @@ private:
     **/
     uint32_t _number_samples;
 
+    //! \brief The time when the last frame ended, in milliseconds.
+    uint32_t _last_frame_tick;
+
     //! The FPS text
     TextImage* _FPS_textimage;
 
+    //! \brief The number of draw calls issued during the current frame.
+    uint32_t _draw_calls;
+
+    //! \brief The number of draw calls, sprite batch flushes and batched sprites of the last complete frame.
+    uint32_t _frame_draw_calls;
+    uint32_t _frame_batch_flushes;
+    uint32_t _frame_batched_sprites;
+
+    //! The draw calls text
+    TextImage* _draw_calls_textimage;
+
     //! \brief Holds the most recently fetched OpenGL error code
     GLenum _gl_error_code;
 
@@ -684,6 +763,10 @@ private:
     //! \brief Holds whether the GL_SCISSOR_TEST state is activated. Used to optimize the drawing logic
     bool _gl_scissor_test_is_active;
 
+    //! \brief Holds the current blending function factors. Used to optimize the drawing logic
+    GLenum _gl_blend_source_factor;
+    GLenum _gl_blend_destination_factor;
+
     //! \brief The x/y offsets, width and height of the current viewport (the drawn part), in pixels
     //! \note the viewport is different from the screen size when in non-4:3 modes.
     int32_t _viewport_x_offset;
@@ -754,18 +837,41 @@ private:
     //! The OpenGL buffers and objects to draw a sprite.
     gl::Sprite* _sprite;
 
+    //! The OpenGL buffers and objects to draw batches of sprites.
+    gl::SpriteBatch* _sprite_batch;
+
     //! The OpenGL buffers and objects to draw a particle system.
     gl::ParticleSystem* _particle_system;
 
+    //! The threads updating the particle systems, created on first use.
+    vt_mode_manager::ParticleWorkerPool* _particle_worker_pool;
+
+    //! The number of threads updating the particle systems. 0 means it depends on the number of CPU cores.
+    uint32_t _particle_thread_count;
+
     //! The OpenGL shaders.
     std::map<gl::shaders::Shaders, gl::Shader*> _shaders;
 
     //! The OpenGL shader programs.
     std::map<gl::shader_programs::ShaderPrograms, gl::ShaderProgram*> _programs;
 
+    //! The shader program currently in use.
+    gl::ShaderProgram* _current_shader_program;
+
     //! Check to see if the VideoManager has already been setup.
     bool _initialized;
 
+    /** \brief The pooled screen captures, each alone in its texture sheet.
+    *** The pool keeps a reference to each of them: a capture with no other reference is free.
+    **/
+    std::vector<private_video::ImageTexture*> _screen_captures;
+
+    //! \brief The framebuffer used to copy the screen into the capture textures, created on first use.
+    GLuint _capture_framebuffer;
+
+    //! \brief The render target holding the first blur pass of the screen captures, created on first use.
+    gl::RenderTarget* _capture_blur_target;
+
     //-- Private methods ------------------------------------------------------
 
     /** \brief converts VIDEO_DRAW_LEFT or VIDEO_DRAW_RIGHT flags to a numerical offset
@@ -784,11 +890,33 @@ private:
     //! \note it also centers the viewport when the resolution isn't a 4:3 one.
     void _UpdateViewportMetrics();
 
+    /** \brief Returns a free pooled screen capture of the given size, creating it when needed.
+    *** \throw Exception If the capture texture could not be created
+    **/
+    private_video::ImageTexture* _GetScreenCapture(uint32_t width, uint32_t height);
+
+    //! \brief Removes the pool reference to a screen capture, and deletes it when it was the last one.
+    void _DeleteScreenCapture(private_video::ImageTexture* capture);
+
+    //! \brief Deletes the free pooled screen captures above VIDEO_SCREEN_CAPTURE_POOL_SIZE.
+    void _TrimScreenCaptures();
+
+    //! \brief Copies a screen rectangle into a screen capture, scaling it to the capture size.
+    bool _CopyScreenToCapture(const ScreenRect& screen_rect, private_video::ImageTexture* capture);
+
+    /** \brief Blurs a screen capture with two gaussian passes: a horizontal one from the capture
+    *** into the blur render target, and a vertical one from the render target back into the capture.
+    **/
+    bool _BlurScreenCapture(private_video::ImageTexture* capture);
+
+    //! \brief Draws a quad on the whole viewport, with the given texture coordinates.
+    void _DrawCaptureBlurPass(float u1, float v1, float u2, float v2);
+
     // Debug info
-    //! \brief Updates the FPS counter.
+    //! \brief Updates the FPS counter. Called once per frame drawn.
     void _UpdateFPS();
 
-    //! \brief Draws the current average FPS to the screen.
+    //! \brief Draws the current average FPS and the last frame draw calls to the screen.
     void _DrawFPS();
 };
 
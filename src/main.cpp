@@ -32,6 +32,7 @@
 #include "engine/mode_manager.h"
 #include "engine/video/video.h"
 #include "engine/system.h"
+#include "engine/profiler.h"
 
 #include "common/global/global.h"
 #include "common/gui/gui.h"
@@ -163,6 +164,8 @@ static bool LoadSettings()
     VideoManager->SetFullscreen(settings.ReadBool("full_screen"));
     if (settings.DoesUIntExist("vsync_mode"))
         VideoManager->SetVSyncMode(settings.ReadUInt("vsync_mode"));
+    if (settings.DoesUIntExist("particle_threads"))
+        VideoManager->SetParticleThreadCount(settings.ReadUInt("particle_threads"));
     GUIManager->SetUserMenuSkin(settings.ReadString("ui_theme"));
     settings.CloseTable(); // video_settings
 
@@ -178,6 +181,8 @@ static bool LoadSettings()
 
         AudioManager->SetMusicVolume(static_cast<float>(settings.ReadFloat("music_vol")));
         AudioManager->SetSoundVolume(static_cast<float>(settings.ReadFloat("sound_vol")));
+        if (settings.DoesUIntExist("cache_size"))
+            AudioManager->SetCacheBudget(settings.ReadUInt("cache_size") * 1024 * 1024);
 
         settings.CloseTable(); // audio_settings
     }
@@ -198,6 +203,12 @@ static bool LoadSettings()
         if (settings.DoesBoolExist("battle_target_cursor_memory"))
             SystemManager->SetBattleTargetMemory(settings.ReadBool("battle_target_cursor_memory"));
 
+        if (settings.DoesUIntExist("update_rate"))
+            SystemManager->SetUpdateRate(settings.ReadUInt("update_rate"));
+
+        if (settings.DoesBoolExist("update_interpolation"))
+            SystemManager->SetUpdateInterpolation(settings.ReadBool("update_interpolation"));
+
         settings.CloseTable(); // game_options
     }
 
@@ -332,6 +343,7 @@ static void InitializeEngine()
     ScriptManager = ScriptEngine::SingletonCreate();
     VideoManager = VideoEngine::SingletonCreate();
     SystemManager = SystemEngine::SingletonCreate();
+    ProfilerManager = ProfilerEngine::SingletonCreate();
     ModeManager = ModeEngine::SingletonCreate();
     GUIManager = GUISystem::SingletonCreate();
     GlobalManager = GameGlobal::SingletonCreate();
@@ -359,6 +371,10 @@ static void InitializeEngine()
         throw Exception("ERROR: unable to initialize SystemManager",
                         __FILE__, __LINE__, __FUNCTION__);
     }
+    if(!ProfilerManager->SingletonInitialize()) {
+        throw Exception("ERROR: unable to initialize ProfilerManager",
+                        __FILE__, __LINE__, __FUNCTION__);
+    }
     if(!InputManager->SingletonInitialize()) {
         throw Exception("ERROR: unable to initialize InputManager",
                         __FILE__, __LINE__, __FUNCTION__);
@@ -532,46 +548,20 @@ int main(int argc, char* argv[])
     SDL_ShowWindow(sdl_window);
     ModeManager->Push(new BootMode(), false, true);
 
-    // Used for a variable game speed,
-    // sleeping when on sufficiently fast hardware, and max FPS.
-    const uint32_t UPDATES_PER_SECOND = 60 + 10; // 10 is a smoothness safety margin
-    const uint32_t SKIP_UPDATE_TICKS = 1000 / UPDATES_PER_SECOND;
-    // The average time assumed to do a game logic cycle
-    const uint32_t MIN_LOGIC_DELAY = 16; // in ms
-    uint32_t update_tick = SDL_GetTicks();
-    uint32_t next_update_tick = update_tick;
+    // The game logic is updated at a fixed rate, independently of the frame rate.
+    SystemManager->InitializeUpdateTimer();
 
     try {
         // This is the main loop for the game.
         // The loop iterates once for every frame drawn to the screen.
         while (SystemManager->NotDone()) {
 
-            update_tick = SDL_GetTicks();
-
-            // If we want to be nice with the CPU % used.
-            if (update_tick <= next_update_tick &&
-                    next_update_tick - update_tick >= MIN_LOGIC_DELAY) {
-                SDL_Delay(next_update_tick - update_tick);
-            }
-
-            // Render capped at UPDATES_PER_SECOND
-            // if the update mode is gentle with the CPU(s).
-            if (update_tick > next_update_tick) {
-
-                // Clear the primary render target.
-                VideoManager->Clear();
-
-                // Draw the game.
-                ModeManager->Draw();
-                ModeManager->DrawEffects();
-                ModeManager->DrawPostEffects();
-                VideoManager->DrawFadeEffect();
-                VideoManager->DrawDebugInfo();
-
-                // Swap the buffers once the draw operations are done.
-                SDL_GL_SwapWindow(sdl_window);
+            ProfilerManager->BeginFrame();
 
-                // Update the game logic
+            // Run as many fixed game logic updates as the elapsed time requires.
+            uint32_t updates = SystemManager->UpdateFrameTimer();
+            for (uint32_t i = 0; i < updates && SystemManager->NotDone(); ++i) {
+                PROFILE_ZONE("Update");
 
                 // Update timers for correct time-based movement operation
                 SystemManager->UpdateTimers();
@@ -587,10 +577,39 @@ int main(int argc, char* argv[])
 
                 // Update the game status
                 ModeManager->Update();
+            }
 
-                // Wait for the next update.
-                next_update_tick += SKIP_UPDATE_TICKS;
+            // Without interpolation, a frame drawn between two updates would be identical
+            // to the previous one: be nice with the CPU % used and wait for the next update.
+            if (updates == 0 && !SystemManager->IsUpdateInterpolationEnabled()) {
+                SDL_Delay(SystemManager->GetTimeUntilNextUpdate());
+                continue;
             }
+
+            {
+                PROFILE_ZONE("Draw");
+
+                // Upload a part of the pending textures, within the frame time budget.
+                VideoManager->BeginFrame();
+
+                // Clear the primary render target.
+                VideoManager->Clear();
+
+                // Draw the game.
+                ModeManager->Draw();
+                ModeManager->DrawEffects();
+                ModeManager->DrawPostEffects();
+                VideoManager->DrawFadeEffect();
+                VideoManager->DrawDebugInfo();
+                ProfilerManager->DrawOverlay();
+                VideoManager->EndFrame();
+            }
+
+            ProfilerManager->EndFrame();
+
+            // Swap the buffers once the draw operations are done.
+            // The frame rate is then only limited by the vertical sync, when enabled.
+            SDL_GL_SwapWindow(sdl_window);
         } // while (SystemManager->NotDone())
     } catch(const Exception& e) {
 #ifdef WIN32
@@ -617,6 +636,8 @@ int main(int argc, char* argv[])
     AudioEngine::SingletonDestroy();
     InputEngine::SingletonDestroy();
     SystemEngine::SingletonDestroy();
+    // Frees its OpenGL queries, so before the video engine.
+    ProfilerEngine::SingletonDestroy();
     VideoEngine::SingletonDestroy();
     // Do it last since all luabind objects must be freed
     // before closing the lua state.
@@ -19,6 +19,7 @@
 
 #include "engine/audio/audio.h"
 #include "engine/video/video.h"
+#include "engine/video/gl/gl_debug.h"
 #include "script/script_write.h"
 #include "engine/input.h"
 #include "engine/system.h"
@@ -78,6 +79,12 @@ bool ParseProgramOptions(int32_t &return_code, int32_t argc, char* argv[])
             i++;
         } else if(options[i] == "--disable-audio") {
             vt_audio::AUDIO_ENABLE = false;
+        } else if(options[i] == "--gl-debug") {
+#ifndef DEBUG_GL
+            std::cerr << "Option " << options[i] << " requires the game to be built with the DEBUG_GL option."
+                      << " Only the per-frame OpenGL error checks will be done." << std::endl;
+#endif
+            vt_video::GL_DEBUG = true;
         } else if(options[i] == "-h" || options[i] == "--help") {
             PrintUsage();
             return_code = 0;
@@ -151,6 +158,7 @@ void PrintUsage()
             << "                       map, mode_manager, pause, quit, scene, system" << std::endl
             << "                       utils, video" << std::endl
             << "  --disable-audio   :: disables loading and playing audio" << std::endl
+            << "  --gl-debug        :: checks for OpenGL errors after each draw call" << std::endl
             << "  --help/-h         :: prints this help menu" << std::endl
             << "  --info/-i         :: prints information about the user's system" << std::endl
             << "  --reset/-r        :: resets game configuration to use default settings" << std::endl;
@@ -306,10 +306,12 @@ void BattleMode::Update()
     // Update all actors animations and y-sorting
     _battle_objects.clear();
     for(uint32_t i = 0; i < _character_actors.size(); ++i) {
+        _character_actors[i]->SavePreviousLocation();
         _character_actors[i]->Update();
         _battle_objects.push_back(_character_actors[i]);
     }
     for(uint32_t i = 0; i < _enemy_actors.size(); ++i) {
+        _enemy_actors[i]->SavePreviousLocation();
         _enemy_actors[i]->Update();
         _battle_objects.push_back(_enemy_actors[i]);
     }
@@ -1028,7 +1030,9 @@ void BattleMode::_DrawBackgroundGraphics()
 {
     VideoManager->SetDrawFlags(VIDEO_X_LEFT, VIDEO_Y_BOTTOM, VIDEO_NO_BLEND, 0);
     VideoManager->Move(0.0f, 768.0f);
-    GlobalManager->GetBattleMedia().background_image.Draw();
+    BattleMedia& battle_media = GlobalManager->GetBattleMedia();
+    battle_media.LoadPendingBackgroundImage();
+    battle_media.background_image.Draw();
 
     VideoManager->SetDrawFlags(VIDEO_X_LEFT, VIDEO_Y_TOP, VIDEO_BLEND, 0);
     VideoManager->SetStandardCoordSys();
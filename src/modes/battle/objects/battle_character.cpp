@@ -320,7 +320,8 @@ void BattleCharacter::Update()
 
 void BattleCharacter::DrawSprite()
 {
-    VideoManager->Move(_location.x, _location.y);
+    vt_common::Position2D draw_location = GetInterpolatedLocation();
+    VideoManager->Move(draw_location.x, draw_location.y);
     _current_sprite_animation->Draw(Color(1.0f, 1.0f, 1.0f, _sprite_alpha));
     _current_weapon_animation.Draw(Color(1.0f, 1.0f, 1.0f, _sprite_alpha));
 
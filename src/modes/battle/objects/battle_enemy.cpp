@@ -214,7 +214,8 @@ void BattleEnemy::DrawSprite()
 
     float hp_percent = static_cast<float>(GetHitPoints()) / static_cast<float>(GetMaxHitPoints());
 
-    VideoManager->Move(_location.x, _location.y);
+    vt_common::Position2D draw_location = GetInterpolatedLocation();
+    VideoManager->Move(draw_location.x, draw_location.y);
     // Alpha will range from 1.0 to 0.0 in the following calculations
     if(_state == ACTOR_STATE_DYING) {
         _sprite_animations->at(GLOBAL_ENEMY_HURT_HEAVILY).Draw(Color(1.0f, 1.0f, 1.0f, _sprite_alpha));
@@ -13,12 +13,17 @@
 
 #include "common/position_2d.h"
 
+#include "engine/system.h"
+
 namespace vt_battle
 {
 
 namespace private_battle
 {
 
+//! \brief Moves longer than this distance in one update, in pixels, are teleports and aren't interpolated.
+const float BATTLE_INTERPOLATION_TELEPORT_DISTANCE = 64.0f;
+
 /** \brief An abstract class for representing an object in the battle
 *** Used to properly draw objects based on their Y coordinate.
 **/
@@ -27,7 +32,9 @@ class BattleObject
 public:
     BattleObject():
         _origin(0.0f, 0.0f),
-        _location(0.0f, 0.0f)
+        _location(0.0f, 0.0f),
+        _previous_location(0.0f, 0.0f),
+        _previous_location_update(0)
     {}
     virtual ~BattleObject()
     {}
@@ -64,6 +71,30 @@ public:
         _location.y = y_location;
     }
 
+    //! \brief Stores the current location as the one before the current update, for interpolation.
+    void SavePreviousLocation() {
+        _previous_location = _location;
+        _previous_location_update = vt_system::SystemManager->GetUpdateCount();
+    }
+
+    /** \brief Returns the location where the object should be drawn.
+    *** The location is interpolated between the previous and current updates,
+    *** unless the object wasn't updated during the last game update.
+    **/
+    vt_common::Position2D GetInterpolatedLocation() const {
+        float factor = vt_system::SystemManager->GetUpdateInterpolation();
+        if(factor >= 1.0f || _previous_location_update != vt_system::SystemManager->GetUpdateCount())
+            return _location;
+
+        float x_move = _location.x - _previous_location.x;
+        float y_move = _location.y - _previous_location.y;
+        if(x_move * x_move + y_move * y_move > BATTLE_INTERPOLATION_TELEPORT_DISTANCE * BATTLE_INTERPOLATION_TELEPORT_DISTANCE)
+            return _location;
+
+        return vt_common::Position2D(_previous_location.x + x_move * factor,
+                                     _previous_location.y + y_move * factor);
+    }
+
     virtual void DrawSprite()
     {}
 
@@ -82,6 +113,12 @@ protected:
 
     //! \brief The x and y coordinates of the actor's current location on the battle field
     vt_common::Position2D _location;
+
+    //! \brief The location before the last update, used to draw the object moving smoothly.
+    vt_common::Position2D _previous_location;
+
+    //! \brief The system update count when the previous location was stored.
+    uint32_t _previous_location_update;
 };
 
 } // namespace private_battle
@@ -379,14 +379,9 @@ void BootMode::DrawPostEffects()
 uint32_t BootMode::_GetNbSavesAvailable()
 {
     uint32_t savesAvailable = 0;
-    std::string data_path = GetUserDataPath();
     uint32_t max_slot_id = SystemManager->GetGameSaveSlots();
     for(uint32_t id = 0; id < max_slot_id; ++id) {
-        std::ostringstream f;
-        f << data_path + "saved_game_" << id << ".lua";
-        const std::string& filename = f.str();
-
-        if(DoesFileExist(filename)) {
+        if(DoesFileExist(FindSaveGameFilename(id))) {
             ++savesAvailable;
         }
     }
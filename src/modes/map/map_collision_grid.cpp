@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_collision_grid.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the packed map collision grid.
+*** ***************************************************************************/
+
+#include "modes/map/map_collision_grid.h"
+
+#include <algorithm>
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+//! \brief Returns a word mask with the bits first_bit to last_bit set, both included.
+static uint64_t GetBitRangeMask(uint32_t first_bit, uint32_t last_bit)
+{
+    uint64_t high_mask = (last_bit == 63) ? ~static_cast<uint64_t>(0) :
+                         (static_cast<uint64_t>(1) << (last_bit + 1)) - 1;
+    uint64_t low_mask = ~((static_cast<uint64_t>(1) << first_bit) - 1);
+    return high_mask & low_mask;
+}
+
+void CollisionGrid::Resize(uint32_t width, uint32_t height)
+{
+    _width = width;
+    _height = height;
+    _words_per_row = (width + 63) / 64;
+    _words.assign(_words_per_row * height, 0);
+}
+
+void CollisionGrid::Clear()
+{
+    std::fill(_words.begin(), _words.end(), 0);
+}
+
+void CollisionGrid::SetArea(int32_t left, int32_t top, int32_t right, int32_t bottom)
+{
+    left = std::max(left, 0);
+    top = std::max(top, 0);
+    right = std::min(right, static_cast<int32_t>(_width) - 1);
+    bottom = std::min(bottom, static_cast<int32_t>(_height) - 1);
+
+    for(int32_t y = top; y <= bottom; ++y) {
+        for(int32_t x = left; x <= right; ++x)
+            Set(x, y);
+    }
+}
+
+bool CollisionGrid::IsAreaSet(uint32_t left, uint32_t top, uint32_t right, uint32_t bottom) const
+{
+    uint32_t first_word = left / 64;
+    uint32_t last_word = right / 64;
+
+    for(uint32_t y = top; y <= bottom; ++y) {
+        const uint64_t *row = &_words[y * _words_per_row];
+
+        if(first_word == last_word) {
+            if(row[first_word] & GetBitRangeMask(left % 64, right % 64))
+                return true;
+            continue;
+        }
+
+        if(row[first_word] & GetBitRangeMask(left % 64, 63))
+            return true;
+        for(uint32_t word = first_word + 1; word < last_word; ++word) {
+            if(row[word])
+                return true;
+        }
+        if(row[last_word] & GetBitRangeMask(0, right % 64))
+            return true;
+    }
+
+    return false;
+}
+
+} // namespace private_map
+
+} // namespace vt_map
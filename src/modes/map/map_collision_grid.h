@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_collision_grid.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the packed map collision grid.
+*** ***************************************************************************/
+
+#ifndef __MAP_COLLISION_GRID_HEADER__
+#define __MAP_COLLISION_GRID_HEADER__
+
+#include <cstdint>
+#include <vector>
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+/** ****************************************************************************
+*** \brief A grid storing one bit per collision grid element.
+***
+*** The bits are stored row after row in a single vector of 64-bit words,
+*** each row starting on a new word. This permits to test whether any element
+*** of a rectangle is set one word at a time instead of one element at a time.
+*** ***************************************************************************/
+class CollisionGrid
+{
+public:
+    CollisionGrid() :
+        _width(0),
+        _height(0),
+        _words_per_row(0)
+    {}
+
+    //! \brief Resizes the grid, clearing every element.
+    void Resize(uint32_t width, uint32_t height);
+
+    //! \brief Clears every element, keeping the grid size.
+    void Clear();
+
+    //! \brief Sets or clears one element. Coordinates must be within the grid.
+    void Set(uint32_t x, uint32_t y, bool value = true) {
+        uint64_t &word = _words[(y * _words_per_row) + (x / 64)];
+        uint64_t bit = static_cast<uint64_t>(1) << (x % 64);
+        if(value)
+            word |= bit;
+        else
+            word &= ~bit;
+    }
+
+    //! \brief Sets every element of a rectangle, bounds included and clamped to the grid.
+    void SetArea(int32_t left, int32_t top, int32_t right, int32_t bottom);
+
+    //! \brief Tells whether an element is set. Coordinates must be within the grid.
+    bool Get(uint32_t x, uint32_t y) const {
+        return (_words[(y * _words_per_row) + (x / 64)] >> (x % 64)) & 1;
+    }
+
+    //! \brief Tells whether any element of a rectangle is set, bounds included.
+    //! Coordinates must be within the grid.
+    bool IsAreaSet(uint32_t left, uint32_t top, uint32_t right, uint32_t bottom) const;
+
+    uint32_t GetWidth() const {
+        return _width;
+    }
+
+    uint32_t GetHeight() const {
+        return _height;
+    }
+
+private:
+    //! \brief The number of elements on each axis.
+    uint32_t _width;
+    uint32_t _height;
+
+    //! \brief The number of words used by each row.
+    uint32_t _words_per_row;
+
+    /** \brief The elements bits.
+    *** \Note The element (x, y) is stored in:
+    *** _words[(y * _words_per_row) + (x / 64)], at bit (x % 64)
+    **/
+    std::vector<uint64_t> _words;
+};
+
+} // namespace private_map
+
+} // namespace vt_map
+
+#endif // __MAP_COLLISION_GRID_HEADER__
@@ -171,12 +171,19 @@ vt_video::StillImage Minimap::_CreateProcedurally()
         return vt_video::StillImage();
     }
 
+    // Read the packed collision grids directly, and only do the precise static
+    // object check on the grid elements touched by a static object.
+    const CollisionGrid& collision_grid = map_object_supervisor->GetCollisionGrid();
+    const CollisionGrid& static_object_grid = map_object_supervisor->GetStaticObjectGrid();
+
     for(uint32_t row = 0; row < _grid_width; ++row)
     {
         r.y = 0;
         for(uint32_t col = 0; col < _grid_height; ++col)
         {
-            if(!map_object_supervisor->IsStaticCollision(row, col))
+            bool collision = collision_grid.Get(row, col) ||
+                             (static_object_grid.Get(row, col) && map_object_supervisor->IsStaticCollision(row, col));
+            if(!collision)
             {
 
                 if(SDL_FillRect(temp_surface, &r, SDL_MapRGBA(temp_surface->format, 0x00, 0x00, 0x00, 0x00)))
@@ -27,6 +27,7 @@
 #include "modes/map/map_objects/map_treasure.h"
 
 #include "modes/map/map_sprites/map_enemy_sprite.h"
+#include "modes/map/map_sprites/map_sprite_animations.h"
 #include "modes/map/map_zones.h"
 #include "modes/map/map_tiles.h"
 
@@ -141,6 +142,11 @@ MapMode::MapMode(const std::string& data_filename, const std::string& script_fil
     _virtual_focus->SetCollisionMask(NO_COLLISION);
     _virtual_focus->SetVisible(false);
 
+    uint64_t load_start = SDL_GetPerformanceCounter();
+    uint32_t files_read = GetSpriteAnimationFilesRead();
+    uint32_t definitions_shared = GetSpriteAnimationDefinitionsShared();
+    float read_time = GetSpriteAnimationReadTime();
+
     if(!_Load()) {
         BootMode *BM = new BootMode();
         ModeManager->PopAll();
@@ -148,6 +154,12 @@ MapMode::MapMode(const std::string& data_filename, const std::string& script_fil
         return;
     }
 
+    IF_PRINT_DEBUG(MAP_DEBUG) << "Loaded map: " << _map_data_filename << " in "
+        << (SDL_GetPerformanceCounter() - load_start) * 1000 / SDL_GetPerformanceFrequency() << " ms ("
+        << GetSpriteAnimationFilesRead() - files_read << " sprite animation files read in "
+        << GetSpriteAnimationReadTime() - read_time << " ms, "
+        << GetSpriteAnimationDefinitionsShared() - definitions_shared << " shared)" << std::endl;
+
     // Once the minimap file has been set (in the load function),
     // we can create the minimap
     if(_show_minimap)
@@ -435,11 +447,27 @@ void MapMode::Update()
     float y_pos = cam->GetYPosition();
     std::ostringstream coord_txt;
     coord_txt << "Camera position: " << x_pos << ", " << y_pos;
+
+    // Collision and interaction queries cost since the last update
+    SpatialHash& spatial_hash = _object_supervisor->GetSpatialHash();
+    coord_txt << std::endl << "Spatial queries: " << spatial_hash.GetNumberOfCellsVisited() << " cells visited, "
+              << spatial_hash.GetNumberOfObjectsTested() << " objects tested";
+    spatial_hash.ResetCounters();
+
+    coord_txt << std::endl << "Objects updated: " << _object_supervisor->GetNumberOfObjectsUpdated()
+              << ", skipped: " << _object_supervisor->GetNumberOfObjectsSkipped();
+
+    coord_txt << std::endl << "Objects sort: " << _object_supervisor->GetLastSortDuration() << " ms";
+
     _debug_camera_position.SetText(coord_txt.str());
 }
 
 void MapMode::Draw()
 {
+    // Follow the camera between its last updated positions, like the other map objects.
+    if(SystemManager->IsUpdateInterpolationEnabled())
+        _UpdateMapFrame(true);
+
     VideoManager->PushState();
     VideoManager->SetStandardCoordSys();
     VideoManager->SetDrawFlags(VIDEO_BLEND, VIDEO_X_CENTER, VIDEO_Y_BOTTOM, 0);
@@ -519,6 +547,11 @@ void MapMode::DeleteMapObject(private_map::MapObject* object)
     _object_supervisor->DeleteObject(object);
 }
 
+void MapMode::SetObjectUpdateMargins(float full_margin, float reduced_margin)
+{
+    _object_supervisor->SetUpdateMargins(full_margin, reduced_margin);
+}
+
 void MapMode::SetCamera(private_map::VirtualSprite *sprite, uint32_t duration)
 {
     if(_camera == sprite) {
@@ -1009,12 +1042,13 @@ void MapMode::StartEnemyEncounter(EnemySprite* enemy,
     ModeManager->Push(TM);
 }
 
-void MapMode::_UpdateMapFrame()
+void MapMode::_UpdateMapFrame(bool interpolated)
 {
     // Determine the center position coordinates for the camera
     // Holds the final X, Y coordinates of the camera
-    Position2D camera_pos(_camera ? _camera->GetXPosition() : 0.0f,
-                          _camera ? _camera->GetYPosition() : 0.0f);
+    Position2D camera_pos(0.0f, 0.0f);
+    if(_camera)
+        camera_pos = interpolated ? _camera->GetInterpolatedPosition() : _camera->GetPosition();
 
     if(_camera_timer.IsRunning()) {
         camera_pos.x += (1.0f - _camera_timer.PercentComplete()) * _camera_move.x;
@@ -1346,8 +1380,8 @@ void MapMode::_DrawGUI()
 
     VideoManager->PushState();
     VideoManager->SetStandardCoordSys();
-    VideoManager->SetDrawFlags(VIDEO_X_LEFT, VIDEO_Y_CENTER, VIDEO_BLEND, 0);
-    VideoManager->Move(10.0f, 10.0f);
+    VideoManager->SetDrawFlags(VIDEO_X_LEFT, VIDEO_Y_TOP, VIDEO_BLEND, 0);
+    VideoManager->Move(10.0f, 0.0f);
     _debug_camera_position.Draw();
     VideoManager->PopState();
 }
@@ -161,6 +161,12 @@ public:
     //! \brief Removes an object from memory
     void DeleteMapObject(private_map::MapObject* obj);
 
+    /** \brief Sets the distances to the screen edges within which the map objects are updated, in grid elements.
+    *** The objects within the full margin are updated every frame, and the ones
+    *** within the reduced margin at a reduced rate. Farther objects aren't updated.
+    **/
+    void SetObjectUpdateMargins(float full_margin, float reduced_margin);
+
     //! \brief Vectors containing the save points animations (when the character is in or not).
     std::vector<vt_video::AnimatedImage> active_save_point_animations;
     std::vector<vt_video::AnimatedImage> inactive_save_point_animations;
@@ -667,8 +673,11 @@ private:
     //! \brief A helper function to Update() that is called only when the map is in the explore state
     void _UpdateExplore();
 
-    //! \brief Update the map frame coordinates
-    void _UpdateMapFrame();
+    /** \brief Update the map frame coordinates
+    *** \param interpolated Whether the camera position is interpolated between the last updates,
+    *** which is only wanted when drawing.
+    **/
+    void _UpdateMapFrame(bool interpolated = false);
 
     //! \brief Draws all visible map tiles and sprites to the screen
     void _DrawMapLayers();
@@ -25,6 +25,9 @@
 #include "common/global/global.h"
 #include "common/global/actors/global_character.h"
 
+#include "engine/profiler.h"
+#include "engine/system.h"
+
 #include "utils/utils_numeric.h"
 
 using namespace vt_common;
@@ -35,11 +38,50 @@ namespace vt_map
 namespace private_map
 {
 
+//! \brief Returns the draw layer of the objects an object of the given layer can collide with.
+static MapObjectDrawLayer GetCollisionDrawLayer(MapObjectDrawLayer layer)
+{
+    // Objects without layer are checked against the ground objects.
+    return (layer == NO_LAYER_OBJECT) ? GROUND_OBJECT : layer;
+}
+
+//! \brief Tells whether an object is a sprite, moving often and thus kept apart when sorting.
+static bool IsDynamicObject(MapObject *object)
+{
+    return dynamic_cast<VirtualSprite *>(object) != nullptr;
+}
+
+//! \brief Sorts the objects by draw order. Fast when they are nearly sorted already.
+static void InsertionSortObjects(std::vector<MapObject *>& objects)
+{
+    MapObject_Ptr_Less less;
+    for(uint32_t i = 1; i < objects.size(); ++i) {
+        MapObject *object = objects[i];
+        uint32_t j = i;
+        for(; j > 0 && less(object, objects[j - 1]); --j)
+            objects[j] = objects[j - 1];
+        objects[j] = object;
+    }
+}
+
+//! \brief Removes an object from a vector, if present.
+static void RemoveObjectFrom(std::vector<MapObject *>& objects, MapObject *object)
+{
+    std::vector<MapObject *>::iterator it = std::find(objects.begin(), objects.end(), object);
+    if(it != objects.end())
+        objects.erase(it);
+}
+
 ObjectSupervisor::ObjectSupervisor() :
     _num_grid_x_axis(0),
     _num_grid_y_axis(0),
     _last_id(1), //! Every object Id must be > 0 since 0 is reserved for speakerless dialogues.
-    _visible_party_member(nullptr)
+    _visible_party_member(nullptr),
+    _static_object_grid_outdated(true),
+    _last_sort_duration(0.0f),
+    _update_count(0),
+    _number_of_objects_updated(0),
+    _number_of_objects_skipped(0)
 {}
 
 ObjectSupervisor::~ObjectSupervisor()
@@ -91,6 +133,15 @@ void ObjectSupervisor::RegisterObject(MapObject* object)
         _all_objects.resize(obj_id + 1, nullptr);
     _all_objects[obj_id] = object;
 
+    _spatial_hash.AddObject(object);
+    if(object->GetObjectDrawLayer() == GROUND_OBJECT)
+        _static_object_grid_outdated = true;
+
+    // The object is classified as static or dynamic at the next sort,
+    // once it is fully constructed.
+    if(object->GetObjectDrawLayer() < NO_LAYER_OBJECT)
+        _draw_orders[object->GetObjectDrawLayer()].new_objects.push_back(object);
+
     switch(object->GetObjectDrawLayer()) {
     case FLATGROUND_OBJECT:
         _flat_ground_objects.push_back(object);
@@ -174,6 +225,17 @@ void ObjectSupervisor::DeleteObject(MapObject* object)
     if (!object)
         return;
 
+    _spatial_hash.RemoveObject(object);
+    if(object->GetObjectType() == PHYSICAL_TYPE)
+        _static_object_grid_outdated = true;
+
+    if(object->GetObjectDrawLayer() < NO_LAYER_OBJECT) {
+        LayerDrawOrder& draw_order = _draw_orders[object->GetObjectDrawLayer()];
+        RemoveObjectFrom(draw_order.static_objects, object);
+        RemoveObjectFrom(draw_order.dynamic_objects, object);
+        RemoveObjectFrom(draw_order.new_objects, object);
+    }
+
     for (uint32_t i = 0; i < _all_objects.size(); ++i) {
         // We only set it to null without removing its place in memory
         // to avoid breaking the vector key used as object id,
@@ -226,10 +288,46 @@ void ObjectSupervisor::DeleteObject(MapObject* object)
 
 void ObjectSupervisor::SortObjects()
 {
-    std::sort(_flat_ground_objects.begin(), _flat_ground_objects.end(), MapObject_Ptr_Less());
-    std::sort(_ground_objects.begin(), _ground_objects.end(), MapObject_Ptr_Less());
-    std::sort(_pass_objects.begin(), _pass_objects.end(), MapObject_Ptr_Less());
-    std::sort(_sky_objects.begin(), _sky_objects.end(), MapObject_Ptr_Less());
+    Uint64 start_time = SDL_GetPerformanceCounter();
+
+    _SortLayerObjects(FLATGROUND_OBJECT, _flat_ground_objects);
+    _SortLayerObjects(GROUND_OBJECT, _ground_objects);
+    _SortLayerObjects(PASS_OBJECT, _pass_objects);
+    _SortLayerObjects(SKY_OBJECT, _sky_objects);
+
+    _last_sort_duration = (SDL_GetPerformanceCounter() - start_time) * 1000.0f / SDL_GetPerformanceFrequency();
+}
+
+void ObjectSupervisor::_SortLayerObjects(MapObjectDrawLayer layer, std::vector<MapObject *>& objects)
+{
+    LayerDrawOrder& draw_order = _draw_orders[layer];
+
+    // Classify the new objects
+    for(uint32_t i = 0; i < draw_order.new_objects.size(); ++i) {
+        MapObject *object = draw_order.new_objects[i];
+        if(IsDynamicObject(object)) {
+            draw_order.dynamic_objects.push_back(object);
+        }
+        else {
+            draw_order.static_objects.push_back(object);
+            draw_order.static_objects_sorted = false;
+        }
+    }
+    draw_order.new_objects.clear();
+
+    // Static objects are only sorted again when one of them was added or moved.
+    if(!draw_order.static_objects_sorted) {
+        std::sort(draw_order.static_objects.begin(), draw_order.static_objects.end(), MapObject_Ptr_Less());
+        draw_order.static_objects_sorted = true;
+    }
+
+    // Sprites only move a little between two frames.
+    InsertionSortObjects(draw_order.dynamic_objects);
+
+    objects.resize(draw_order.static_objects.size() + draw_order.dynamic_objects.size());
+    std::merge(draw_order.static_objects.begin(), draw_order.static_objects.end(),
+               draw_order.dynamic_objects.begin(), draw_order.dynamic_objects.end(),
+               objects.begin(), MapObject_Ptr_Less());
 }
 
 bool ObjectSupervisor::Load(vt_script::ReadScriptDescriptor &map_file)
@@ -242,39 +340,134 @@ bool ObjectSupervisor::Load(vt_script::ReadScriptDescriptor &map_file)
     // Construct the collision grid
     map_file.OpenTable("map_grid");
     _num_grid_y_axis = map_file.GetTableSize();
+    std::vector<std::vector<uint32_t> > grid_rows(_num_grid_y_axis);
+    for(uint16_t y = 0; y < _num_grid_y_axis; ++y)
+        map_file.ReadUIntVector(y, grid_rows[y]);
+    map_file.CloseTable();
+    _num_grid_x_axis = grid_rows.empty() ? 0 : grid_rows[0].size();
+
+    // Pack the rows, any non-zero value being unwalkable
+    _collision_grid.Resize(_num_grid_x_axis, _num_grid_y_axis);
     for(uint16_t y = 0; y < _num_grid_y_axis; ++y) {
-        _collision_grid.push_back(std::vector<uint32_t>());
-        map_file.ReadUIntVector(y, _collision_grid.back());
+        if(grid_rows[y].size() != _num_grid_x_axis) {
+            PRINT_WARNING << "Invalid map grid row length: " << grid_rows[y].size()
+                          << " at row: " << y << " in map file: " << map_file.GetFilename() << std::endl;
+        }
+
+        uint32_t row_length = std::min<uint32_t>(grid_rows[y].size(), _num_grid_x_axis);
+        for(uint32_t x = 0; x < row_length; ++x) {
+            if(grid_rows[y][x] > 0)
+                _collision_grid.Set(x, y);
+        }
     }
-    map_file.CloseTable();
-    _num_grid_x_axis = _collision_grid[0].size();
+
+    _static_object_grid.Resize(_num_grid_x_axis, _num_grid_y_axis);
+    _static_object_grid_outdated = true;
+
+    // Prepare the path finding nodes
+    _path_finder.Initialize(_num_grid_x_axis, _num_grid_y_axis);
+
+    // Prepare the spatial index, and add the objects already registered.
+    _spatial_hash.Initialize(_num_grid_x_axis, _num_grid_y_axis);
+    _update_sectors.Initialize(_num_grid_x_axis, _num_grid_y_axis);
+    for(uint32_t i = 0; i < _all_objects.size(); ++i)
+        _spatial_hash.AddObject(_all_objects[i]);
+
     return true;
 }
 
+void ObjectSupervisor::UpdateObjectCollision(MapObject *object)
+{
+    // Only update the objects registered in this supervisor.
+    if(!object || object->GetObjectID() <= 0)
+        return;
+
+    uint32_t object_id = static_cast<uint32_t>(object->GetObjectID());
+    if(object_id >= _all_objects.size() || _all_objects[object_id] != object)
+        return;
+
+    _spatial_hash.UpdateObject(object);
+    if(object->GetObjectType() == PHYSICAL_TYPE)
+        _static_object_grid_outdated = true;
+
+    // A static object moved, its layer draw order needs to be sorted again.
+    if(object->GetObjectDrawLayer() < NO_LAYER_OBJECT && !IsDynamicObject(object))
+        _draw_orders[object->GetObjectDrawLayer()].static_objects_sorted = false;
+}
+
 void ObjectSupervisor::Update()
 {
-    for(uint32_t i = 0; i < _flat_ground_objects.size(); ++i)
-        _flat_ground_objects[i]->Update();
-    for(uint32_t i = 0; i < _ground_objects.size(); ++i)
-        _ground_objects[i]->Update();
+    PROFILE_ZONE("ObjectSupervisor::Update");
+
+    // Keep the positions before the update, so that the objects are drawn moving smoothly in between.
+    for(uint32_t i = 0; i < _all_objects.size(); ++i) {
+        if(_all_objects[i])
+            _all_objects[i]->SavePreviousPosition();
+    }
+
+    // Only the objects near the screen are updated every frame.
+    _update_sectors.Update(MapMode::CurrentInstance()->GetMapFrame().screen_edges);
+    ++_update_count;
+    _number_of_objects_updated = 0;
+    _number_of_objects_skipped = 0;
+
+    _UpdateObjects(_flat_ground_objects);
+    _UpdateObjects(_ground_objects);
 
     // Update map points animation and activeness.
     _UpdateMapPoints();
 
-    for(uint32_t i = 0; i < _pass_objects.size(); ++i)
-        _pass_objects[i]->Update();
-    for(uint32_t i = 0; i < _sky_objects.size(); ++i)
-        _sky_objects[i]->Update();
-    for(uint32_t i = 0; i < _halos.size(); ++i)
-        _halos[i]->Update();
-    for(uint32_t i = 0; i < _lights.size(); ++i)
-        _lights[i]->Update();
+    _UpdateObjects(_pass_objects);
+    _UpdateObjects(_sky_objects);
+    _UpdateObjects(_halos);
+    _UpdateObjects(_lights);
+
+    // The zones are always updated, as the enemy zones keep spawning enemies while off screen.
     for(uint32_t i = 0; i < _zones.size(); ++i)
         _zones[i]->Update();
 
     _UpdateAmbientSounds();
 }
 
+bool ObjectSupervisor::_ShouldUpdate(MapObject *object)
+{
+    bool update = true;
+    if(!object->IsAlwaysUpdated() && object != MapMode::CurrentInstance()->GetCamera()) {
+        switch(_update_sectors.GetActivity(object->GetXPosition(), object->GetYPosition())) {
+        case SECTOR_FULL_ACTIVITY:
+            break;
+        case SECTOR_REDUCED_ACTIVITY:
+            update = (_update_count + static_cast<uint32_t>(object->GetObjectID()))
+                     % MAP_SECTOR_REDUCED_UPDATE_PERIOD == 0;
+            if(!update) {
+                object->SetSkippedUpdateTime(object->GetSkippedUpdateTime()
+                                             + vt_system::SystemManager->GetUpdateTime());
+            }
+            break;
+        case SECTOR_NO_ACTIVITY:
+        default:
+            // The object is paused, and doesn't catch up once updated again.
+            update = false;
+            object->SetSkippedUpdateTime(0);
+            break;
+        }
+    }
+
+    if(update)
+        ++_number_of_objects_updated;
+    else
+        ++_number_of_objects_skipped;
+    return update;
+}
+
+void ObjectSupervisor::_UpdateObject(MapObject *object)
+{
+    // The object adds the time of the updates it skipped to its own update time,
+    // so that it keeps its pace.
+    object->Update();
+    object->SetSkippedUpdateTime(0);
+}
+
 void ObjectSupervisor::DrawMapPoints()
 {
     for(uint32_t i = 0; i < _save_points.size(); ++i) {
@@ -454,22 +647,6 @@ MapObject* ObjectSupervisor::_FindNearestMapPoint(const VirtualSprite* sprite)
     return nullptr;
 }
 
-std::vector<MapObject*>& ObjectSupervisor::_GetObjectsFromDrawLayer(MapObjectDrawLayer layer)
-{
-    switch(layer)
-    {
-    case FLATGROUND_OBJECT:
-        return _flat_ground_objects;
-    default:
-    case GROUND_OBJECT:
-        return _ground_objects;
-    case PASS_OBJECT:
-        return _pass_objects;
-    case SKY_OBJECT:
-        return _sky_objects;
-    }
-}
-
 MapObject *ObjectSupervisor::FindNearestInteractionObject(const VirtualSprite *sprite, float search_distance)
 {
     if(!sprite)
@@ -498,10 +675,11 @@ MapObject *ObjectSupervisor::FindNearestInteractionObject(const VirtualSprite *s
 
     // A vector to hold objects which are inside the search area (either partially or fully)
     std::vector<MapObject *> valid_objects;
-    // A pointer to the vector of objects to search
-    std::vector<MapObject *>* search_vector = &_GetObjectsFromDrawLayer(sprite->GetObjectDrawLayer());
+    // The objects near the search area
+    _spatial_query_objects.clear();
+    _spatial_hash.GetObjects(search_area, GetCollisionDrawLayer(sprite->GetObjectDrawLayer()), _spatial_query_objects);
 
-    for(std::vector<MapObject *>::iterator it = (*search_vector).begin(); it != (*search_vector).end(); ++it) {
+    for(std::vector<MapObject *>::iterator it = _spatial_query_objects.begin(); it != _spatial_query_objects.end(); ++it) {
         if(*it == sprite)  // Don't allow the sprite itself to be considered in the search
             continue;
 
@@ -634,20 +812,18 @@ COLLISION_TYPE ObjectSupervisor::DetectCollision(MapObject* object,
     if(object->GetObjectDrawLayer() != vt_map::SKY_OBJECT && object->GetCollisionMask() & WALL_COLLISION) {
         // Determine if the object's collision rectangle overlaps any unwalkable tiles
         // Note that because the sprite's collision rectangle was previously determined to be within the map bounds,
-        // the map grid tile indeces referenced in this loop are all valid entries and do not need to be checked for out-of-bounds conditions
-        for(uint32_t y = static_cast<uint32_t>(sprite_rect.top); y <= static_cast<uint32_t>(sprite_rect.bottom); ++y) {
-            for(uint32_t x = static_cast<uint32_t>(sprite_rect.left); x <= static_cast<uint32_t>(sprite_rect.right); ++x) {
-                // Checks the collision grid at the row-column at the object's current context
-                if(_collision_grid[y][x] > 0)
-                    return WALL_COLLISION;
-            }
-        }
+        // the map grid tile indeces referenced here are all valid entries and do not need to be checked for out-of-bounds conditions
+        if(_collision_grid.IsAreaSet(static_cast<uint32_t>(sprite_rect.left), static_cast<uint32_t>(sprite_rect.top),
+                                     static_cast<uint32_t>(sprite_rect.right), static_cast<uint32_t>(sprite_rect.bottom)))
+            return WALL_COLLISION;
     }
 
-    std::vector<MapObject *>* objects = &_GetObjectsFromDrawLayer(object->GetObjectDrawLayer());
+    // Only test the objects near the collision rectangle
+    _spatial_query_objects.clear();
+    _spatial_hash.GetObjects(sprite_rect, GetCollisionDrawLayer(object->GetObjectDrawLayer()), _spatial_query_objects);
 
     std::vector<vt_map::private_map::MapObject *>::const_iterator it, it_end;
-    for(it = objects->begin(), it_end = objects->end(); it != it_end; ++it) {
+    for(it = _spatial_query_objects.begin(), it_end = _spatial_query_objects.end(); it != it_end; ++it) {
         MapObject *collision_object = *it;
         // Check if the object exists and has the no_collision property enabled
         if(!collision_object || collision_object->GetCollisionMask() == NO_COLLISION)
@@ -679,10 +855,6 @@ COLLISION_TYPE ObjectSupervisor::DetectCollision(MapObject* object,
 
 Path ObjectSupervisor::FindPath(VirtualSprite *sprite, const Position2D& destination, uint32_t max_cost)
 {
-    // NOTE: Refer to the implementation of the A* algorithm to understand
-    // what all these lists and score values are for.
-    static const uint32_t basic_gcost = 10;
-
     // NOTE(bis): On the outer scope, we'll use float based positions,
     // but we still use integer positions for path finding.
     Path path;
@@ -702,155 +874,53 @@ Path ObjectSupervisor::FindPath(VirtualSprite *sprite, const Position2D& destina
     }
 
     // The starting node of this path discovery
-    PathNode source_node(static_cast<int16_t>(sprite->GetXPosition()), static_cast<int16_t>(sprite->GetYPosition()));
+    int32_t source_x = static_cast<int32_t>(sprite->GetXPosition());
+    int32_t source_y = static_cast<int32_t>(sprite->GetYPosition());
     // The ending node.
-    PathNode dest(static_cast<int16_t>(destination.x), static_cast<int16_t>(destination.y));
+    int32_t dest_x = static_cast<int32_t>(destination.x);
+    int32_t dest_y = static_cast<int32_t>(destination.y);
 
     // Check that the source node is not the same as the destination node
-    if(source_node == dest) {
+    if(source_x == dest_x && source_y == dest_y) {
         IF_PRINT_WARNING(MAP_DEBUG) << "source node coordinates are the same as the destination" << std::endl;
         // return an empty path.
         return path;
     }
 
-    std::vector<PathNode> open_list;
-    std::vector<PathNode> closed_list;
-
-    // The current "best node"
-    PathNode best_node;
-    // Used to hold the eight adjacent nodes
-    PathNode nodes[8];
-
-    // Temporary delta variables used in calculation of a node's heuristic (h score)
-    uint32_t x_delta, y_delta;
-    // The number to add to a node's g_score, depending on whether it is a lateral or diagonal movement
-    int16_t g_add;
-
-    open_list.push_back(source_node);
-
     // We will try to keep the original offset all along.
     float offset_x = vt_utils::GetFloatFraction(destination.x);
     float offset_y = vt_utils::GetFloatFraction(destination.y);
 
-    while(open_list.empty() == false) {
-        sort(open_list.begin(), open_list.end());
-        best_node = open_list.back();
-        open_list.pop_back();
-        closed_list.push_back(best_node);
-
-        // Check if destination has been reached, and break out of the loop if so
-        if(best_node == dest)
-            break;
-
-        // Setup the coordinates of the 8 adjacent nodes to the best node
-        nodes[0].tile_x = best_node.tile_x - 1;
-        nodes[0].tile_y = best_node.tile_y;
-        nodes[1].tile_x = best_node.tile_x + 1;
-        nodes[1].tile_y = best_node.tile_y;
-        nodes[2].tile_x = best_node.tile_x;
-        nodes[2].tile_y = best_node.tile_y - 1;
-        nodes[3].tile_x = best_node.tile_x;
-        nodes[3].tile_y = best_node.tile_y + 1;
-        nodes[4].tile_x = best_node.tile_x - 1;
-        nodes[4].tile_y = best_node.tile_y - 1;
-        nodes[5].tile_x = best_node.tile_x - 1;
-        nodes[5].tile_y = best_node.tile_y + 1;
-        nodes[6].tile_x = best_node.tile_x + 1;
-        nodes[6].tile_y = best_node.tile_y - 1;
-        nodes[7].tile_x = best_node.tile_x + 1;
-        nodes[7].tile_y = best_node.tile_y + 1;
-
-        // Check the eight adjacent nodes
-        for(uint8_t i = 0; i < 8; ++i) {
-            // ---------- (A): Check if all tiles are walkable
-            // Don't use 0.0f here for both since errors at the border between
-            // two positions may occure, especially when running.
-            COLLISION_TYPE collision_type = DetectCollision(sprite,
-                                            ((float)nodes[i].tile_x) + offset_x,
-                                            ((float)nodes[i].tile_y) + offset_y);
-
-            // Can't go through walls.
-            if(collision_type == WALL_COLLISION)
-                continue;
-
-            // ---------- (B): If this point has been reached, the node is valid for the sprite to move to
-            // If this is a lateral adjacent node, g_score is +10, otherwise diagonal adjacent node is +14
-            if(i < 4)
-                g_add = basic_gcost;
-            else
-                g_add = basic_gcost + 4;
-
-            // Add some g cost when there is another sprite there,
-            // so the NPC try to get around when possible,
-            // but will still go through it when there are no other choices.
-            if(collision_type == CHARACTER_COLLISION
-                    || collision_type == ENEMY_COLLISION)
-                g_add += basic_gcost * 2;
-
-            // If the path has reached the maximum length requested, we abort the path
-            if (max_cost > 0 && (uint32_t)(best_node.g_score + g_add) >= max_cost * basic_gcost)
-                return path;
-
-            // ---------- (C): Check if the node is already in the closed list
-            if(find(closed_list.begin(), closed_list.end(), nodes[i]) != closed_list.end())
-                continue;
-
-            // Set the node's parent and calculate its g_score
-            nodes[i].parent_x = best_node.tile_x;
-            nodes[i].parent_y = best_node.tile_y;
-            nodes[i].g_score = best_node.g_score + g_add;
-
-            // ---------- (D): Check to see if the node is already on the open list and update it if necessary
-            std::vector<PathNode>::iterator iter = std::find(open_list.begin(), open_list.end(), nodes[i]);
-            if(iter != open_list.end()) {
-                // If its G is higher, it means that the path we are on is better, so switch the parent
-                if(iter->g_score > nodes[i].g_score) {
-                    iter->g_score = nodes[i].g_score;
-                    iter->f_score = nodes[i].g_score + iter->h_score;
-                    iter->parent_x = nodes[i].parent_x;
-                    iter->parent_y = nodes[i].parent_y;
-                }
-            }
-            // ---------- (E): Add the new node to the open list
-            else {
-                // Calculate the H and F score of the new node (the heuristic used is diagonal)
-                x_delta = abs(dest.tile_x - nodes[i].tile_x);
-                y_delta = abs(dest.tile_y - nodes[i].tile_y);
-                if(x_delta > y_delta)
-                    nodes[i].h_score = 14 * y_delta + 10 * (x_delta - y_delta);
-                else
-                    nodes[i].h_score = 14 * x_delta + 10 * (y_delta - x_delta);
-
-                nodes[i].f_score = nodes[i].g_score + nodes[i].h_score;
-                open_list.push_back(nodes[i]);
-            }
-        } // for (uint8_t i = 0; i < 8; ++i)
-    } // while (open_list.empty() == false)
+    // Don't use 0.0f offsets for the collision checks since errors at the border between
+    // two positions may occure, especially when running.
+    PathFinder::NodeCostFunction node_cost = [this, sprite, offset_x, offset_y](int32_t x, int32_t y) -> int32_t {
+        COLLISION_TYPE collision_type = DetectCollision(sprite,
+                                                        static_cast<float>(x) + offset_x,
+                                                        static_cast<float>(y) + offset_y);
+        // Can't go through walls.
+        if(collision_type == WALL_COLLISION)
+            return PATH_NODE_BLOCKED;
+
+        // Add some cost when there is another sprite there,
+        // so the NPC try to get around when possible,
+        // but will still go through it when there are no other choices.
+        if(collision_type == CHARACTER_COLLISION || collision_type == ENEMY_COLLISION)
+            return PATH_LATERAL_COST * 2;
+        return 0;
+    };
 
-    if(open_list.empty()) {
+    std::vector<uint32_t> path_nodes;
+    if(!_path_finder.FindPath(source_x, source_y, dest_x, dest_y, node_cost, max_cost, path_nodes)) {
         IF_PRINT_WARNING(MAP_DEBUG) << "could not find path to destination" << std::endl;
         return path;
     }
 
-    // Add the destination node to the vector.
-    path.push_back(destination);
-
-    // Retain the last node parent, and remove it from the closed list
-    int16_t parent_x = best_node.parent_x;
-    int16_t parent_y = best_node.parent_y;
-    closed_list.pop_back();
-
-    // Go backwards through the closed list following the parent nodes to construct the path
-    for(std::vector<PathNode>::iterator iter = closed_list.end() - 1; iter != closed_list.begin(); --iter) {
-        if(iter->tile_y == parent_y && iter->tile_x == parent_x) {
-            Position2D next_pos(((float)iter->tile_x) + offset_x, ((float)iter->tile_y) + offset_y);
-            path.push_back(next_pos);
-
-            parent_x = iter->parent_x;
-            parent_y = iter->parent_y;
-        }
+    // The last node is the destination itself.
+    for(uint32_t i = 0; i + 1 < path_nodes.size(); ++i) {
+        path.push_back(Position2D(static_cast<float>(path_nodes[i] % _num_grid_x_axis) + offset_x,
+                                  static_cast<float>(path_nodes[i] / _num_grid_x_axis) + offset_y));
     }
-    std::reverse(path.begin(), path.end());
+    path.push_back(destination);
 
     return path;
 }
@@ -902,7 +972,7 @@ void ObjectSupervisor::DrawCollisionArea(const MapFrame *frame)
             x < static_cast<uint32_t>((frame->tile_x_start + frame->num_draw_x_axis) * 2); ++x) {
 
             // Draw the collision rectangle.
-            if (_collision_grid[y][x] > 0)
+            if (_collision_grid.Get(x, y))
                 vt_video::VideoManager->DrawRectangle(GRID_LENGTH, GRID_LENGTH,
                                                       vt_video::Color(1.0f, 0.0f, 0.0f, 0.6f));
 
@@ -922,8 +992,17 @@ bool ObjectSupervisor::IsStaticCollision(float x, float y)
     if (IsMapCollision(static_cast<uint32_t>(x), static_cast<uint32_t>(y)))
         return true;
 
+    // No static object collision rectangle touches this grid element
+    _UpdateStaticObjectGrid();
+    if (!_static_object_grid.Get(static_cast<uint32_t>(x), static_cast<uint32_t>(y)))
+        return false;
+
+    // Only test the ground objects near the position
+    _spatial_query_objects.clear();
+    _spatial_hash.GetObjects(Rectangle2D(x, x, y, y), GROUND_OBJECT, _spatial_query_objects);
+
     std::vector<vt_map::private_map::MapObject *>::const_iterator it, it_end;
-    for(it = _ground_objects.begin(), it_end = _ground_objects.end(); it != it_end; ++it) {
+    for(it = _spatial_query_objects.begin(), it_end = _spatial_query_objects.end(); it != it_end; ++it) {
         MapObject *collision_object = *it;
         // Check if the object exists and has the no_collision property enabled
         if(!collision_object || collision_object->GetCollisionMask() == NO_COLLISION)
@@ -943,6 +1022,26 @@ bool ObjectSupervisor::IsStaticCollision(float x, float y)
     return false;
 }
 
+void ObjectSupervisor::_UpdateStaticObjectGrid()
+{
+    if (!_static_object_grid_outdated)
+        return;
+
+    _static_object_grid.Clear();
+    for(uint32_t i = 0; i < _ground_objects.size(); ++i) {
+        MapObject *object = _ground_objects[i];
+        if(object->GetObjectType() != PHYSICAL_TYPE || object->GetCollisionMask() == NO_COLLISION)
+            continue;
+
+        // Set every grid element touched by the collision rectangle
+        Rectangle2D rect = object->GetGridCollisionRectangle();
+        _static_object_grid.SetArea(static_cast<int32_t>(std::floor(rect.left)), static_cast<int32_t>(std::floor(rect.top)),
+                                    static_cast<int32_t>(std::floor(rect.right)), static_cast<int32_t>(std::floor(rect.bottom)));
+    }
+
+    _static_object_grid_outdated = false;
+}
+
 void ObjectSupervisor::StopSoundObjects()
 {
     for (uint32_t i = 0; i < _sound_object_highest_volumes.size(); ++i) {
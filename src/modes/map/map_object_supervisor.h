@@ -12,6 +12,10 @@
 #define __MAP_OBJECT_SUPERVISOR_HEADER__
 
 #include "modes/map/map_objects/map_object.h"
+#include "modes/map/map_collision_grid.h"
+#include "modes/map/map_path_finder.h"
+#include "modes/map/map_spatial_hash.h"
+#include "modes/map/map_update_sectors.h"
 
 #include "script/script_read.h"
 
@@ -98,9 +102,38 @@ public:
     // Called by the Mazone constructor.
     void AddZone(MapZone* zone);
 
-    //! \brief Sorts objects on all three layers according to their draw order
+    /** \brief Sorts objects on all the layers according to their draw order
+    *** Static objects are only sorted again when one of them moved, and the sprites,
+    *** which keep nearly the same order between frames, are insertion sorted.
+    *** Both are then merged into the layer draw order.
+    **/
     void SortObjects();
 
+    //! \brief Debug: Returns the duration of the last objects sort, in milliseconds.
+    float GetLastSortDuration() const {
+        return _last_sort_duration;
+    }
+
+    /** \brief Sets the distances to the screen edges within which the objects are updated.
+    *** \param full_margin The distance within which the objects are updated every frame, in grid elements.
+    *** \param reduced_margin The distance within which the objects are updated every
+    *** MAP_SECTOR_REDUCED_UPDATE_PERIOD frames, over the time elapsed since their last update.
+    *** Farther objects are paused, unless they are always updated.
+    **/
+    void SetUpdateMargins(float full_margin, float reduced_margin) {
+        _update_sectors.SetMargins(full_margin, reduced_margin);
+    }
+
+    //! \brief Debug: Returns the number of objects updated during the last update.
+    uint32_t GetNumberOfObjectsUpdated() const {
+        return _number_of_objects_updated;
+    }
+
+    //! \brief Debug: Returns the number of objects skipped during the last update, as too far from the screen.
+    uint32_t GetNumberOfObjectsSkipped() const {
+        return _number_of_objects_skipped;
+    }
+
     /** \brief Loads the collision grid data and saved state of all map objects
     *** \param map_file A reference to the open map script file
     *** \return Whether the collision data loading was successful.
@@ -195,7 +228,7 @@ public:
     ***
     *** This algorithm uses the A* algorithm to find a path from a source to a destination.
     *** This function ignores the position of all other objects and only concerns itself with
-    *** which map grid elements are walkable.
+    *** which map grid elements are walkable. The search itself is done by the PathFinder.
     ***
     *** \note If an error is detected or a path could not be found, the function will empty the path vector before returning
     **/
@@ -253,7 +286,28 @@ public:
     //! \brief checks if the location on the grid has a simple map collision. This is different from
     //! IsStaticCollision, in that it DOES NOT check static objects, but only the collision value for the map
     bool IsMapCollision(uint32_t x, uint32_t y)
-    { return (_collision_grid[y][x] > 0); }
+    { return _collision_grid.Get(x, y); }
+
+    //! \brief Returns the map collision grid, without the objects.
+    const CollisionGrid& GetCollisionGrid() const
+    { return _collision_grid; }
+
+    /** \brief Returns the grid of the elements touched by static objects collision rectangles.
+    *** When an element is set, IsStaticCollision() must be used to know
+    *** whether a given position within it is actually colliding.
+    **/
+    const CollisionGrid& GetStaticObjectGrid()
+    { _UpdateStaticObjectGrid(); return _static_object_grid; }
+
+    /** \brief Updates the spatial index and static object grid after an object position,
+    *** collision size or collision mask changed. Objects of other maps are ignored.
+    **/
+    void UpdateObjectCollision(MapObject *object);
+
+    //! \brief Debug: Returns the spatial index, e.g.: to read its query counters.
+    SpatialHash &GetSpatialHash() {
+        return _spatial_hash;
+    }
 
     //! \brief returns a const reference to the ground objects in
     const std::vector<MapObject *>& GetGroundObjects() const
@@ -277,11 +331,51 @@ private:
     //! \brief Updates the ambient sounds volume according to the camera distance.
     void _UpdateAmbientSounds();
 
+    /** \brief Tells whether an object should be updated this frame, depending on its sector activity.
+    *** The objects of reduced activity sectors are updated in turn, depending on their id,
+    *** and keep the time of the updates they skip. The objects of inactive sectors are paused.
+    **/
+    bool _ShouldUpdate(MapObject *object);
+
+    //! \brief Updates an object over the time elapsed since its last update.
+    void _UpdateObject(MapObject *object);
+
+    //! \brief Updates the objects of a layer which should be updated this frame.
+    template <typename T>
+    void _UpdateObjects(const std::vector<T *> &objects) {
+        for(uint32_t i = 0; i < objects.size(); ++i) {
+            if(_ShouldUpdate(objects[i]))
+                _UpdateObject(objects[i]);
+        }
+    }
+
     //! \brief Debug: Draws the map zones in orange
     void _DrawMapZones();
 
-    //! \brief Returns the MapObject vector corresponding to the draw layer.
-    std::vector<MapObject*>& _GetObjectsFromDrawLayer(MapObjectDrawLayer layer);
+    //! \brief The objects of one draw layer, kept apart to sort them incrementally.
+    struct LayerDrawOrder {
+        LayerDrawOrder() :
+            static_objects_sorted(true)
+        {}
+
+        //! \brief The objects which aren't sprites, sorted by draw order.
+        std::vector<MapObject *> static_objects;
+
+        //! \brief The sprites, nearly sorted by draw order.
+        std::vector<MapObject *> dynamic_objects;
+
+        //! \brief The objects registered since the last sort, not yet classified.
+        std::vector<MapObject *> new_objects;
+
+        //! \brief Tells whether the static objects need to be sorted again.
+        bool static_objects_sorted;
+    };
+
+    //! \brief Updates the draw order of a layer, and stores it into the given layer objects vector.
+    void _SortLayerObjects(MapObjectDrawLayer layer, std::vector<MapObject *>& objects);
+
+    //! \brief Rasterizes the static objects into the static object grid, if needed.
+    void _UpdateStaticObjectGrid();
 
     /** \brief The number of rows and columns in the collision grid
     *** The number of collision grid rows and columns is always equal to twice
@@ -299,13 +393,41 @@ private:
     **/
     private_map::MapSprite* _visible_party_member;
 
-    /** \brief A 2D vector indicating which grid element on the map sprites may be occupied by objects.
-    *** Each bit of each element in this grid corresponds to a context. So all together this entire grid
-    *** stores the collision information for all 32 possible map contexts.
-    *** \Note A position in this member is stored like this:
-    *** _collision_grid[y][x]
+    //! \brief Indicates which grid elements on the map are unwalkable, one bit per element.
+    CollisionGrid _collision_grid;
+
+    /** \brief Indicates which grid elements are touched by the collision rectangles of the
+    *** static ground objects: i.e. the physical objects. Rebuilt when one of them changes.
     **/
-    std::vector<std::vector<uint32_t> > _collision_grid;
+    CollisionGrid _static_object_grid;
+
+    //! \brief Tells whether the static object grid needs to be rebuilt.
+    bool _static_object_grid_outdated;
+
+    //! \brief The A* path search on the collision grid, keeping its nodes between searches.
+    PathFinder _path_finder;
+
+    //! \brief The incremental draw order of each layer, but NO_LAYER_OBJECT.
+    LayerDrawOrder _draw_orders[NO_LAYER_OBJECT];
+
+    //! \brief Debug: The duration of the last objects sort, in milliseconds.
+    float _last_sort_duration;
+
+    //! \brief The spatial index of the objects, used by the collision and interaction queries.
+    SpatialHash _spatial_hash;
+
+    //! \brief The objects found by the last spatial index query, kept to avoid reallocations.
+    std::vector<MapObject *> _spatial_query_objects;
+
+    //! \brief The map sectors, telling how often the objects within them are updated.
+    UpdateSectors _update_sectors;
+
+    //! \brief The number of updates done, used to update the reduced activity objects in turn.
+    uint32_t _update_count;
+
+    //! \brief Debug: The number of objects updated and skipped during the last update.
+    uint32_t _number_of_objects_updated;
+    uint32_t _number_of_objects_skipped;
 
     /** \brief A map containing pointers to all of the sprites on a map.
     *** This map does not include a pointer to the _virtual_focus object. The
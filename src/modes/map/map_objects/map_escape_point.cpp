@@ -78,7 +78,7 @@ void EscapePoint::Update()
     if(!_animation || !_updatable)
         return;
 
-    _animation->Update();
+    _animation->Update(_GetUpdateTime());
 }
 
 void EscapePoint::Draw()
@@ -57,7 +57,7 @@ Halo* Halo::Create(const std::string& filename,
 void Halo::Update()
 {
     if(_updatable)
-        _animation.Update();
+        _animation.Update(_GetUpdateTime());
 }
 
 void Halo::Draw()
@@ -139,8 +139,8 @@ void Light::Update()
     if(!_updatable)
         return;
 
-    _main_animation.Update();
-    _secondary_animation.Update();
+    _main_animation.Update(_GetUpdateTime());
+    _secondary_animation.Update(_GetUpdateTime());
     _UpdateLightAngle();
 }
 
@@ -28,6 +28,7 @@ namespace private_map
 
 MapObject::MapObject(MapObjectDrawLayer layer) :
     _object_id(-1),
+    _previous_position_update(0),
     _img_pixel_half_width(0.0f),
     _img_pixel_height(0.0f),
     _img_screen_half_width(0.0f),
@@ -42,6 +43,8 @@ MapObject::MapObject(MapObjectDrawLayer layer) :
     _coll_grid_height(0.0f),
     _updatable(true),
     _visible(true),
+    _always_updated(false),
+    _skipped_update_time(0),
     _collision_mask(ALL_COLLISION),
     _draw_on_second_pass(false),
     _object_type(OBJECT_TYPE),
@@ -64,10 +67,31 @@ MapObject::~MapObject()
         delete _interaction_icon;
 }
 
+void MapObject::SavePreviousPosition()
+{
+    _previous_tile_position = _tile_position;
+    _previous_position_update = vt_system::SystemManager->GetUpdateCount();
+}
+
+Position2D MapObject::GetInterpolatedPosition() const
+{
+    float factor = vt_system::SystemManager->GetUpdateInterpolation();
+    if(factor >= 1.0f || _previous_position_update != vt_system::SystemManager->GetUpdateCount())
+        return _tile_position;
+
+    float x_move = _tile_position.x - _previous_tile_position.x;
+    float y_move = _tile_position.y - _previous_tile_position.y;
+    if(x_move * x_move + y_move * y_move > INTERPOLATION_TELEPORT_DISTANCE * INTERPOLATION_TELEPORT_DISTANCE)
+        return _tile_position;
+
+    return Position2D(_previous_tile_position.x + x_move * factor,
+                      _previous_tile_position.y + y_move * factor);
+}
+
 void MapObject::Update()
 {
     if (_interaction_icon)
-        _interaction_icon->Update();
+        _interaction_icon->Update(_GetUpdateTime());
 }
 
 bool MapObject::ShouldDraw()
@@ -82,14 +106,22 @@ bool MapObject::ShouldDraw()
         return false;
 
     // Move the drawing cursor to the appropriate coordinates for this sprite
-    float x_pos = MM->GetScreenXCoordinate(GetXPosition());
-    float y_pos = MM->GetScreenYCoordinate(GetYPosition());
+    Position2D position = GetInterpolatedPosition();
+    float x_pos = MM->GetScreenXCoordinate(position.x);
+    float y_pos = MM->GetScreenYCoordinate(position.y);
 
     vt_video::VideoManager->Move(x_pos, y_pos);
 
     return true;
 }
 
+void MapObject::_NotifyCollisionChanged()
+{
+    MapMode* map_mode = MapMode::CurrentInstance();
+    if(map_mode)
+        map_mode->GetObjectSupervisor()->UpdateObjectCollision(this);
+}
+
 Rectangle2D MapObject::GetGridCollisionRectangle() const
 {
     Rectangle2D rect;
@@ -185,7 +217,7 @@ void MapObject::_UpdateEmote()
     if(!_emote_animation)
         return;
 
-    _emote_time -= static_cast<int32_t>(vt_system::SystemManager->GetUpdateTime());
+    _emote_time -= static_cast<int32_t>(_GetUpdateTime());
 
     // Once the animation has reached its end, we dereference it
     if(_emote_time <= 0) {
@@ -195,7 +227,12 @@ void MapObject::_UpdateEmote()
     }
 
     // Otherwise, just update it
-    _emote_animation->Update();
+    _emote_animation->Update(_GetUpdateTime());
+}
+
+uint32_t MapObject::_GetUpdateTime() const
+{
+    return vt_system::SystemManager->GetUpdateTime() + _skipped_update_time;
 }
 
 void MapObject::_DrawEmote()
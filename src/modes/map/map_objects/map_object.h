@@ -56,6 +56,9 @@ namespace private_map
 // Update the alpha of the interaction icon according to its distance from the player sprite.
 const float INTERACTION_ICON_VISIBLE_RANGE = 10.0f;
 
+//! \brief Moves longer than this distance in one update, in tiles, are teleports and aren't interpolated.
+const float INTERPOLATION_TELEPORT_DISTANCE = 2.0f;
+
 class ContextZone;
 class MapSprite;
 class MapZone;
@@ -185,14 +188,17 @@ public:
     void SetPosition(float x, float y) {
         _tile_position.x = x;
         _tile_position.y = y;
+        _NotifyCollisionChanged();
     }
 
     void SetXPosition(float x) {
         _tile_position.x = x;
+        _NotifyCollisionChanged();
     }
 
     void SetYPosition(float y) {
         _tile_position.y = y;
+        _NotifyCollisionChanged();
     }
 
     //! \brief Set the object image half width (in pixels).
@@ -215,12 +221,14 @@ public:
         _coll_pixel_half_width = collision;
         _coll_screen_half_width = collision * MAP_ZOOM_RATIO;
         _coll_grid_half_width = collision / GRID_LENGTH * MAP_ZOOM_RATIO;
+        _NotifyCollisionChanged();
     }
 
     void SetCollPixelHeight(float collision) {
         _coll_pixel_height = collision;
         _coll_screen_height = collision * MAP_ZOOM_RATIO;
         _coll_grid_height = collision / GRID_LENGTH * MAP_ZOOM_RATIO;
+        _NotifyCollisionChanged();
     }
 
     void SetUpdatable(bool update) {
@@ -231,9 +239,17 @@ public:
         _visible = vis;
     }
 
+    /** \brief Makes the object updated every frame, whatever its distance to the screen.
+    *** Used for objects which must keep running while off screen, e.g.: scripted ones.
+    **/
+    void SetAlwaysUpdated(bool always_updated) {
+        _always_updated = always_updated;
+    }
+
     // Use a set of COLLISION_TYPE bitmask values
     void SetCollisionMask(uint32_t collision_types) {
         _collision_mask = collision_types;
+        _NotifyCollisionChanged();
     }
 
     void SetDrawOnSecondPass(bool pass) {
@@ -262,6 +278,16 @@ public:
         return _tile_position.y;
     }
 
+    //! \brief Stores the current position as the one before the current update, for interpolation.
+    void SavePreviousPosition();
+
+    /** \brief Get the object position in tiles, as it should be drawn.
+    *** The position is interpolated between the previous and current updates,
+    *** according to the system update interpolation factor. Objects not updated
+    *** during the last game update, e.g. when the map is paused, aren't interpolated.
+    **/
+    vt_common::Position2D GetInterpolatedPosition() const;
+
     float GetImgScreenHalfWidth() const {
         return _img_screen_half_width;
     }
@@ -286,6 +312,20 @@ public:
         return _visible;
     }
 
+    //! \brief Tells whether the object must be updated every frame, even far from the screen.
+    virtual bool IsAlwaysUpdated() const {
+        return _always_updated;
+    }
+
+    //! \brief Returns the time of the updates skipped since the last one, in milliseconds.
+    uint32_t GetSkippedUpdateTime() const {
+        return _skipped_update_time;
+    }
+
+    void SetSkippedUpdateTime(uint32_t skipped_update_time) {
+        _skipped_update_time = skipped_update_time;
+    }
+
     uint32_t GetCollisionMask() const {
         return _collision_mask;
     }
@@ -339,6 +379,12 @@ protected:
     **/
     vt_common::Position2D _tile_position;
 
+    //! \brief The object position before the last update, in tiles.
+    vt_common::Position2D _previous_tile_position;
+
+    //! \brief The system update count when the previous position was stored.
+    uint32_t _previous_position_update;
+
     //! \brief The originally desired half-width and height of the image, in pixels
     //! Used as a base value to later get the screen and tile corresponding values.
     float _img_pixel_half_width;
@@ -381,6 +427,12 @@ protected:
     //! \brief When false, the Draw() function will do nothing (default == true).
     bool _visible;
 
+    //! \brief When true, the object is updated every frame, even far from the screen (default == false).
+    bool _always_updated;
+
+    //! \brief The time of the updates skipped since the last one, caught up with on the next update.
+    uint32_t _skipped_update_time;
+
     //! \brief The collision mask indicating what the object will collide with. (i.e.: walls + objects, nothing, ...)
     //! \NOTE: COLLISION TYPE used as bitmask
     uint32_t _collision_mask;
@@ -420,8 +472,17 @@ protected:
     //! \brief Takes care of updating the emote animation and state.
     void _UpdateEmote();
 
+    /** \brief Returns the time to update the object over, in milliseconds.
+    *** This is the last game logic update time, plus the time of the updates skipped
+    *** before when the object is updated at a reduced rate.
+    **/
+    uint32_t _GetUpdateTime() const;
+
     //! \brief Takes care of drawing the emote animation.
     void _DrawEmote();
+
+    //! \brief Tells the object supervisor the collision rectangle of the object changed.
+    void _NotifyCollisionChanged();
 }; // class MapObject
 
 
@@ -28,8 +28,7 @@ ParticleObject::ParticleObject(const std::string& filename,
                                MapObjectDrawLayer layer):
     MapObject(layer)
 {
-    _tile_position.x = x;
-    _tile_position.y = y;
+    SetPosition(x, y);
 
     _object_type = PARTICLE_TYPE;
     _collision_mask = NO_COLLISION;
@@ -89,7 +88,7 @@ void ParticleObject::Update()
     if(!_particle_effect || !_updatable)
         return;
 
-    _particle_effect->Update();
+    _particle_effect->Update(static_cast<float>(_GetUpdateTime()) / 1000.0f);
 }
 
 void ParticleObject::Draw()
@@ -45,7 +45,7 @@ void PhysicalObject::Update()
 {
     MapObject::Update();
     if(!_animations.empty() && _updatable)
-        _animations[_current_animation_id].Update();
+        _animations[_current_animation_id].Update(_GetUpdateTime());
 }
 
 void PhysicalObject::Draw()
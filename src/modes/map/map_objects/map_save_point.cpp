@@ -79,7 +79,7 @@ void SavePoint::Update()
         return;
 
     for(uint32_t i = 0; i < _animations->size(); ++i)
-        _animations->at(i).Update();
+        _animations->at(i).Update(_GetUpdateTime());
 }
 
 
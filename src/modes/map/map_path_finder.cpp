@@ -0,0 +1,240 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_path_finder.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the A* path search on the map collision grid.
+*** ***************************************************************************/
+
+#include "modes/map/map_path_finder.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+PathFinder::PathFinder() :
+    _num_grid_x_axis(0),
+    _num_grid_y_axis(0),
+    _path_generation(0),
+    _expanded_nodes(0)
+{
+}
+
+void PathFinder::Initialize(uint32_t num_grid_x_axis, uint32_t num_grid_y_axis)
+{
+    _num_grid_x_axis = static_cast<int32_t>(num_grid_x_axis);
+    _num_grid_y_axis = static_cast<int32_t>(num_grid_y_axis);
+    _path_nodes.assign(num_grid_x_axis * num_grid_y_axis, PathNode());
+    _path_open_list.clear();
+    _path_generation = 0;
+}
+
+bool PathFinder::FindPath(int32_t source_x, int32_t source_y, int32_t dest_x, int32_t dest_y,
+                          const NodeCostFunction& node_cost, uint32_t max_cost,
+                          std::vector<uint32_t>& path)
+{
+    // NOTE: Refer to the implementation of the A* algorithm to understand
+    // what all these lists and score values are for.
+
+    // The grid offsets of the eight adjacent nodes: lateral ones first, then diagonal ones.
+    static const int32_t adjacent_x[8] = { -1, 1, 0, 0, -1, -1, 1, 1 };
+    static const int32_t adjacent_y[8] = { 0, 0, -1, 1, -1, 1, -1, 1 };
+
+    path.clear();
+    _expanded_nodes = 0;
+
+    // Start a new search generation, so that every node left from the previous searches
+    // is considered unvisited. The nodes are only cleared when the counter wraps.
+    ++_path_generation;
+    if(_path_generation == 0) {
+        _path_nodes.assign(_path_nodes.size(), PathNode());
+        _path_generation = 1;
+    }
+    _path_open_list.clear();
+
+    const uint32_t source_index = (source_y * _num_grid_x_axis) + source_x;
+    const uint32_t dest_index = (dest_y * _num_grid_x_axis) + dest_x;
+
+    PathNode& source_node = _path_nodes[source_index];
+    source_node.generation = _path_generation;
+    source_node.g_score = 0;
+    source_node.f_score = 0;
+    source_node.parent = source_index;
+    _PushOpenPathNode(source_index);
+
+    bool dest_reached = false;
+    while(!_path_open_list.empty()) {
+        // The current "best node"
+        uint32_t best_index = _PopOpenPathNode();
+        ++_expanded_nodes;
+
+        // Check if destination has been reached, and break out of the loop if so
+        if(best_index == dest_index) {
+            dest_reached = true;
+            break;
+        }
+
+        int32_t best_x = best_index % _num_grid_x_axis;
+        int32_t best_y = best_index / _num_grid_x_axis;
+        int32_t best_g_score = _path_nodes[best_index].g_score;
+
+        // Check the eight adjacent nodes
+        for(uint8_t i = 0; i < 8; ++i) {
+            int32_t node_x = best_x + adjacent_x[i];
+            int32_t node_y = best_y + adjacent_y[i];
+
+            // Nodes outside of the grid are never walkable.
+            if(node_x < 0 || node_y < 0 || node_x >= _num_grid_x_axis || node_y >= _num_grid_y_axis)
+                continue;
+
+            // ---------- (A): Check if the node is walkable
+            int32_t node_extra_cost = node_cost(node_x, node_y);
+            if(node_extra_cost == PATH_NODE_BLOCKED)
+                continue;
+
+            // ---------- (B): If this point has been reached, the node is valid for the sprite to move to
+            // If this is a lateral adjacent node, g_score is +10, otherwise diagonal adjacent node is +14
+            int32_t g_add = ((i < 4) ? PATH_LATERAL_COST : PATH_LATERAL_COST + 4) + node_extra_cost;
+
+            // If the path has reached the maximum length requested, we abort the path
+            if (max_cost > 0 && static_cast<uint32_t>(best_g_score + g_add) >= max_cost * PATH_LATERAL_COST)
+                return false;
+
+            uint32_t node_index = (node_y * _num_grid_x_axis) + node_x;
+            PathNode& node = _path_nodes[node_index];
+            int32_t g_score = best_g_score + g_add;
+
+            // ---------- (C): Check if the node is already in the closed list
+            if(node.generation == _path_generation) {
+                if(node.heap_position == PATH_NODE_CLOSED)
+                    continue;
+
+                // ---------- (D): The node is already on the open list, update it if necessary.
+                // If its G is higher, it means that the path we are on is better, so switch the parent
+                if(node.g_score > g_score) {
+                    node.f_score += g_score - node.g_score;
+                    node.g_score = g_score;
+                    node.parent = best_index;
+                    _SiftPathNodeUp(node.heap_position);
+                }
+                continue;
+            }
+
+            // ---------- (E): Add the new node to the open list
+            // Calculate the H and F score of the new node (the heuristic used is diagonal)
+            int32_t x_delta = std::abs(dest_x - node_x);
+            int32_t y_delta = std::abs(dest_y - node_y);
+            int32_t h_score;
+            if(x_delta > y_delta)
+                h_score = 14 * y_delta + 10 * (x_delta - y_delta);
+            else
+                h_score = 14 * x_delta + 10 * (y_delta - x_delta);
+
+            node.generation = _path_generation;
+            node.g_score = g_score;
+            node.f_score = g_score + h_score;
+            node.parent = best_index;
+            _PushOpenPathNode(node_index);
+        } // for (uint8_t i = 0; i < 8; ++i)
+    } // while (!_path_open_list.empty())
+
+    if(!dest_reached)
+        return false;
+
+    // Follow the parent nodes back to the source to construct the path
+    for(uint32_t index = dest_index; index != source_index; index = _path_nodes[index].parent)
+        path.push_back(index);
+    std::reverse(path.begin(), path.end());
+
+    return true;
+}
+
+bool PathFinder::_IsPathNodeBetter(uint32_t first_index, uint32_t second_index) const
+{
+    const PathNode& first = _path_nodes[first_index];
+    const PathNode& second = _path_nodes[second_index];
+
+    // On equal f scores, prefer the node nearest to the destination.
+    if(first.f_score != second.f_score)
+        return first.f_score < second.f_score;
+    return first.g_score > second.g_score;
+}
+
+void PathFinder::_SiftPathNodeUp(uint32_t heap_position)
+{
+    uint32_t node_index = _path_open_list[heap_position];
+
+    while(heap_position > 0) {
+        uint32_t parent_position = (heap_position - 1) / 2;
+        uint32_t parent_index = _path_open_list[parent_position];
+        if(!_IsPathNodeBetter(node_index, parent_index))
+            break;
+
+        _path_open_list[heap_position] = parent_index;
+        _path_nodes[parent_index].heap_position = heap_position;
+        heap_position = parent_position;
+    }
+
+    _path_open_list[heap_position] = node_index;
+    _path_nodes[node_index].heap_position = heap_position;
+}
+
+void PathFinder::_PushOpenPathNode(uint32_t node_index)
+{
+    _path_open_list.push_back(node_index);
+    _SiftPathNodeUp(_path_open_list.size() - 1);
+}
+
+uint32_t PathFinder::_PopOpenPathNode()
+{
+    uint32_t best_index = _path_open_list.front();
+    _path_nodes[best_index].heap_position = PATH_NODE_CLOSED;
+
+    uint32_t last_index = _path_open_list.back();
+    _path_open_list.pop_back();
+    if(_path_open_list.empty())
+        return best_index;
+
+    // Move the last node down from the top of the heap until its place is found.
+    uint32_t heap_size = _path_open_list.size();
+    uint32_t heap_position = 0;
+    while(true) {
+        uint32_t child_position = (heap_position * 2) + 1;
+        if(child_position >= heap_size)
+            break;
+
+        // Pick the best of the two children.
+        if(child_position + 1 < heap_size
+                && _IsPathNodeBetter(_path_open_list[child_position + 1], _path_open_list[child_position]))
+            ++child_position;
+
+        uint32_t child_index = _path_open_list[child_position];
+        if(!_IsPathNodeBetter(child_index, last_index))
+            break;
+
+        _path_open_list[heap_position] = child_index;
+        _path_nodes[child_index].heap_position = heap_position;
+        heap_position = child_position;
+    }
+
+    _path_open_list[heap_position] = last_index;
+    _path_nodes[last_index].heap_position = heap_position;
+
+    return best_index;
+}
+
+} // namespace private_map
+
+} // namespace vt_map
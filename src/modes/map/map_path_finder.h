@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_path_finder.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the A* path search on the map collision grid.
+***
+*** The search only knows about grid nodes: whether a node can be walked on,
+*** and at which cost, is told by the caller. It thus doesn't need a map mode,
+*** and is also run by the path finding benchmark.
+*** ***************************************************************************/
+
+#ifndef __MAP_PATH_FINDER_HEADER__
+#define __MAP_PATH_FINDER_HEADER__
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+/** ****************************************************************************
+*** \brief A node of the A* path search, one per collision grid element.
+***
+*** The nodes are kept between path searches. A node is only valid when its
+*** generation matches the current search generation, so that the nodes never
+*** need to be cleared.
+*** ***************************************************************************/
+class PathNode
+{
+public:
+    //! \brief The path search generation this node was last reached in.
+    uint32_t generation;
+
+    //! \name Path Scoring Members
+    //@{
+    //! \brief The total score for this node (f = g + h).
+    int32_t f_score;
+
+    //! \brief The score for this node relative to the source.
+    int32_t g_score;
+    //@}
+
+    //! \brief The collision grid index (y * width + x) of the parent of this node.
+    uint32_t parent;
+
+    /** \brief The position of this node in the open list heap,
+    *** or PATH_NODE_CLOSED once the node was removed from it.
+    **/
+    uint32_t heap_position;
+
+    // ---------- Methods
+
+    PathNode() : generation(0), f_score(0), g_score(0), parent(0), heap_position(0)
+    {}
+}; // class PathNode
+
+//! \brief The heap position of the path nodes which were removed from the open list.
+const uint32_t PATH_NODE_CLOSED = 0xFFFFFFFF;
+
+//! \brief The cost of a move to a lateral adjacent node. Diagonal moves cost 4 more.
+const int32_t PATH_LATERAL_COST = 10;
+
+//! \brief The node cost told for the nodes which can't be walked on.
+const int32_t PATH_NODE_BLOCKED = -1;
+
+/** ****************************************************************************
+*** \brief Finds paths on a grid with the A* algorithm.
+***
+*** The open list is a binary heap, and the nodes are kept in a grid reused
+*** between searches.
+*** ***************************************************************************/
+class PathFinder
+{
+public:
+    /** \brief Tells the additional cost to walk on the node at the given grid coordinates,
+    *** or PATH_NODE_BLOCKED when it can't be walked on.
+    **/
+    typedef std::function<int32_t(int32_t x, int32_t y)> NodeCostFunction;
+
+    PathFinder();
+
+    //! \brief Sets up the nodes for a grid of the given size.
+    void Initialize(uint32_t num_grid_x_axis, uint32_t num_grid_y_axis);
+
+    /** \brief Finds a path from a source node to a destination node.
+    *** \param node_cost Tells the cost of the nodes within the grid.
+    *** \param max_cost Aborts the search once a path would cost more than this number
+    *** of lateral moves. No limit when equal to 0.
+    *** \param path Set to the grid indices (y * width + x) of the path nodes, source
+    *** excluded and destination included.
+    *** \return false when no path was found, in which case the path is left empty.
+    **/
+    bool FindPath(int32_t source_x, int32_t source_y, int32_t dest_x, int32_t dest_y,
+                  const NodeCostFunction& node_cost, uint32_t max_cost,
+                  std::vector<uint32_t>& path);
+
+    //! \brief Debug: Returns the number of nodes expanded by the last search.
+    uint32_t GetNumberOfExpandedNodes() const {
+        return _expanded_nodes;
+    }
+
+private:
+    //! \brief The number of nodes on each axis.
+    int32_t _num_grid_x_axis, _num_grid_y_axis;
+
+    /** \brief The path finding node of each grid element, reused by every path search.
+    *** \Note A position in this member is stored like this:
+    *** _path_nodes[(y * _num_grid_x_axis) + x]
+    **/
+    std::vector<PathNode> _path_nodes;
+
+    //! \brief The open list of the current path search: a binary heap of path node indices.
+    std::vector<uint32_t> _path_open_list;
+
+    //! \brief The current path search generation. Path nodes of other generations are unvisited.
+    uint32_t _path_generation;
+
+    //! \brief The number of nodes expanded by the last search.
+    uint32_t _expanded_nodes;
+
+    //! \brief Tells whether the first path node should be expanded before the second one.
+    bool _IsPathNodeBetter(uint32_t first_index, uint32_t second_index) const;
+
+    //! \brief Moves an open path node up the open list heap until its place is found.
+    void _SiftPathNodeUp(uint32_t heap_position);
+
+    //! \brief Adds a path node to the open list heap.
+    void _PushOpenPathNode(uint32_t node_index);
+
+    //! \brief Removes and returns the best path node from the open list heap, marking it as closed.
+    uint32_t _PopOpenPathNode();
+};
+
+} // namespace private_map
+
+} // namespace vt_map
+
+#endif // __MAP_PATH_FINDER_HEADER__
@@ -0,0 +1,178 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_spatial_hash.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the map objects spatial index.
+*** ***************************************************************************/
+
+#include "modes/map/map_spatial_hash.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace vt_common;
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+//! \brief The number of draw layers indexed: every layer but NO_LAYER_OBJECT.
+const uint32_t NUM_INDEXED_LAYERS = NO_LAYER_OBJECT;
+
+SpatialHash::SpatialHash() :
+    _num_cell_x_axis(0),
+    _num_cell_y_axis(0),
+    _query_generation(0),
+    _number_of_cells_visited(0),
+    _number_of_objects_tested(0)
+{
+}
+
+void SpatialHash::Initialize(uint32_t num_grid_x_axis, uint32_t num_grid_y_axis)
+{
+    _num_cell_x_axis = (num_grid_x_axis + SPATIAL_HASH_CELL_LENGTH - 1) / SPATIAL_HASH_CELL_LENGTH;
+    _num_cell_y_axis = (num_grid_y_axis + SPATIAL_HASH_CELL_LENGTH - 1) / SPATIAL_HASH_CELL_LENGTH;
+
+    _cells.clear();
+    _cells.resize(NUM_INDEXED_LAYERS * _num_cell_x_axis * _num_cell_y_axis);
+    _object_cells.clear();
+    _object_query_generations.clear();
+    _query_generation = 0;
+}
+
+void SpatialHash::AddObject(MapObject *object)
+{
+    if(!_IsIndexed(object))
+        return;
+
+    uint32_t object_id = static_cast<uint32_t>(object->GetObjectID());
+    if(object_id >= _object_cells.size()) {
+        _object_cells.resize(object_id + 1);
+        _object_query_generations.resize(object_id + 1, 0);
+    }
+
+    CellRange &cells = _object_cells[object_id];
+    if(cells.indexed)
+        return;
+
+    cells = _GetCellRange(object->GetGridCollisionRectangle());
+    cells.indexed = true;
+
+    MapObjectDrawLayer layer = object->GetObjectDrawLayer();
+    for(uint32_t y = cells.top; y <= cells.bottom; ++y) {
+        for(uint32_t x = cells.left; x <= cells.right; ++x)
+            _GetCell(layer, x, y).push_back(object);
+    }
+}
+
+void SpatialHash::RemoveObject(MapObject *object)
+{
+    if(!_IsIndexed(object))
+        return;
+
+    uint32_t object_id = static_cast<uint32_t>(object->GetObjectID());
+    if(object_id >= _object_cells.size() || !_object_cells[object_id].indexed)
+        return;
+
+    CellRange &cells = _object_cells[object_id];
+    MapObjectDrawLayer layer = object->GetObjectDrawLayer();
+    for(uint32_t y = cells.top; y <= cells.bottom; ++y) {
+        for(uint32_t x = cells.left; x <= cells.right; ++x) {
+            std::vector<MapObject *> &cell = _GetCell(layer, x, y);
+            for(uint32_t i = 0; i < cell.size(); ++i) {
+                if(cell[i] == object) {
+                    // The order of the objects in a cell doesn't matter.
+                    cell[i] = cell.back();
+                    cell.pop_back();
+                    break;
+                }
+            }
+        }
+    }
+
+    cells.indexed = false;
+}
+
+void SpatialHash::UpdateObject(MapObject *object)
+{
+    if(!_IsIndexed(object))
+        return;
+
+    uint32_t object_id = static_cast<uint32_t>(object->GetObjectID());
+    if(object_id >= _object_cells.size() || !_object_cells[object_id].indexed)
+        return;
+
+    // Most moves stay within the same cells.
+    if(_GetCellRange(object->GetGridCollisionRectangle()) == _object_cells[object_id])
+        return;
+
+    RemoveObject(object);
+    AddObject(object);
+}
+
+void SpatialHash::GetObjects(const Rectangle2D &rect, MapObjectDrawLayer layer,
+                             std::vector<MapObject *> &objects)
+{
+    if(_cells.empty() || layer >= NO_LAYER_OBJECT)
+        return;
+
+    // Start a new query generation, and only clear the stamps when the counter wraps.
+    ++_query_generation;
+    if(_query_generation == 0) {
+        _object_query_generations.assign(_object_query_generations.size(), 0);
+        _query_generation = 1;
+    }
+
+    CellRange cells = _GetCellRange(rect);
+    for(uint32_t y = cells.top; y <= cells.bottom; ++y) {
+        for(uint32_t x = cells.left; x <= cells.right; ++x) {
+            ++_number_of_cells_visited;
+
+            const std::vector<MapObject *> &cell = _GetCell(layer, x, y);
+            for(uint32_t i = 0; i < cell.size(); ++i) {
+                uint32_t object_id = static_cast<uint32_t>(cell[i]->GetObjectID());
+                if(_object_query_generations[object_id] == _query_generation)
+                    continue;
+
+                _object_query_generations[object_id] = _query_generation;
+                objects.push_back(cell[i]);
+                ++_number_of_objects_tested;
+            }
+        }
+    }
+}
+
+SpatialHash::CellRange SpatialHash::_GetCellRange(const Rectangle2D &rect) const
+{
+    // Clamping keeps the objects outside of the map in the border cells,
+    // where the queries outside of the map will also look.
+    float max_x = static_cast<float>(_num_cell_x_axis - 1);
+    float max_y = static_cast<float>(_num_cell_y_axis - 1);
+
+    CellRange cells;
+    cells.left = static_cast<uint32_t>(std::min(std::max(std::floor(rect.left / SPATIAL_HASH_CELL_LENGTH), 0.0f), max_x));
+    cells.right = static_cast<uint32_t>(std::min(std::max(std::floor(rect.right / SPATIAL_HASH_CELL_LENGTH), 0.0f), max_x));
+    cells.top = static_cast<uint32_t>(std::min(std::max(std::floor(rect.top / SPATIAL_HASH_CELL_LENGTH), 0.0f), max_y));
+    cells.bottom = static_cast<uint32_t>(std::min(std::max(std::floor(rect.bottom / SPATIAL_HASH_CELL_LENGTH), 0.0f), max_y));
+    return cells;
+}
+
+bool SpatialHash::_IsIndexed(const MapObject *object) const
+{
+    return object && object->GetObjectID() > 0 && !_cells.empty()
+           && object->GetObjectDrawLayer() < NO_LAYER_OBJECT;
+}
+
+} // namespace private_map
+
+} // namespace vt_map
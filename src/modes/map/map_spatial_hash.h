@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_spatial_hash.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the map objects spatial index.
+***
+*** The map is divided into cells of SPATIAL_HASH_CELL_LENGTH collision grid
+*** elements on each axis. Every map object is referenced in each cell its
+*** collision rectangle overlaps, so that collision and interaction queries
+*** only need to test the objects found near the queried area.
+*** ***************************************************************************/
+
+#ifndef __MAP_SPATIAL_HASH_HEADER__
+#define __MAP_SPATIAL_HASH_HEADER__
+
+#include "modes/map/map_objects/map_object.h"
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+//! \brief The number of collision grid elements on each axis of a spatial hash cell.
+const uint32_t SPATIAL_HASH_CELL_LENGTH = 4;
+
+/** ****************************************************************************
+*** \brief A uniform grid of buckets referencing the map objects of each draw layer.
+***
+*** The objects are indexed using their collision rectangles, and must be
+*** updated whenever their position or collision size changes.
+*** ***************************************************************************/
+class SpatialHash
+{
+public:
+    SpatialHash();
+
+    /** \brief Sets up the cells for a map of the given collision grid size.
+    *** Any previously indexed object is removed.
+    **/
+    void Initialize(uint32_t num_grid_x_axis, uint32_t num_grid_y_axis);
+
+    //! \brief Adds an object into the cells its collision rectangle overlaps.
+    void AddObject(MapObject *object);
+
+    //! \brief Removes an object from the cells it was indexed in.
+    void RemoveObject(MapObject *object);
+
+    //! \brief Moves the object to the right cells after its collision rectangle changed.
+    void UpdateObject(MapObject *object);
+
+    /** \brief Gets the objects of a draw layer which might intersect with the given rectangle.
+    *** \param rect The area to look into, in collision grid coordinates.
+    *** \param layer The draw layer of the objects to look for.
+    *** \param objects The vector where the objects are added, each of them only once.
+    *** \note The objects found still need to be tested against the rectangle.
+    **/
+    void GetObjects(const vt_common::Rectangle2D &rect, MapObjectDrawLayer layer,
+                    std::vector<MapObject *> &objects);
+
+    //! \brief Debug: Returns the number of cells visited by the queries since the last reset.
+    uint32_t GetNumberOfCellsVisited() const {
+        return _number_of_cells_visited;
+    }
+
+    //! \brief Debug: Returns the number of objects returned by the queries since the last reset.
+    uint32_t GetNumberOfObjectsTested() const {
+        return _number_of_objects_tested;
+    }
+
+    //! \brief Debug: Resets the query counters.
+    void ResetCounters() {
+        _number_of_cells_visited = 0;
+        _number_of_objects_tested = 0;
+    }
+
+private:
+    //! \brief The cells an object is indexed in, bounds included.
+    struct CellRange {
+        CellRange() :
+            left(0), right(0), top(0), bottom(0), indexed(false)
+        {}
+
+        bool operator==(const CellRange &other) const {
+            return left == other.left && right == other.right
+                   && top == other.top && bottom == other.bottom;
+        }
+
+        uint32_t left, right, top, bottom;
+
+        //! \brief Whether the object is currently referenced in the cells.
+        bool indexed;
+    };
+
+    //! \brief Returns the cells overlapped by a rectangle, clamped to the map.
+    CellRange _GetCellRange(const vt_common::Rectangle2D &rect) const;
+
+    //! \brief Returns the cell vector of the given draw layer and cell coordinates.
+    std::vector<MapObject *> &_GetCell(MapObjectDrawLayer layer, uint32_t x, uint32_t y) {
+        return _cells[(layer * _num_cell_x_axis * _num_cell_y_axis) + (y * _num_cell_x_axis) + x];
+    }
+
+    //! \brief Tells whether the object draw layer is indexed.
+    bool _IsIndexed(const MapObject *object) const;
+
+    //! \brief The number of cells on each axis.
+    uint32_t _num_cell_x_axis, _num_cell_y_axis;
+
+    /** \brief The objects referenced in each cell of each draw layer.
+    *** \Note A position in this member is stored like this:
+    *** _cells[(layer * cells_per_layer) + (y * _num_cell_x_axis) + x]
+    **/
+    std::vector<std::vector<MapObject *> > _cells;
+
+    //! \brief The cells each object is indexed in, using the object id as key.
+    std::vector<CellRange> _object_cells;
+
+    /** \brief The query generation each object was last returned in, using the object id as key.
+    *** This permits to return objects overlapping several cells only once.
+    **/
+    std::vector<uint32_t> _object_query_generations;
+
+    //! \brief The current query generation.
+    uint32_t _query_generation;
+
+    //! \brief Debug: The query counters.
+    uint32_t _number_of_cells_visited;
+    uint32_t _number_of_objects_tested;
+};
+
+} // namespace private_map
+
+} // namespace vt_map
+
+#endif // __MAP_SPATIAL_HASH_HEADER__
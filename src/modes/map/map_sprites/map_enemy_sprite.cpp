@@ -107,7 +107,7 @@ void EnemySprite::Update()
     switch(_state) {
         // Gradually increase the alpha while the sprite is fading in during spawning
     case SPAWNING:
-        _time_elapsed += vt_system::SystemManager->GetUpdateTime();
+        _time_elapsed += _GetUpdateTime();
         if(_color.GetAlpha() < 1.0f) {
             _color.SetAlpha((_time_elapsed / static_cast<float>(_time_to_spawn)) * 1.0f);
         } else {
@@ -200,7 +200,7 @@ void EnemySprite::_HandleHostileUpdate()
 
         // Update the wait time until next path between two way points.
         if (!_use_path || !_moving)
-            _time_elapsed += vt_system::SystemManager->GetUpdateTime();
+            _time_elapsed += _GetUpdateTime();
 
         if (_path.empty() && _time_elapsed >= _time_before_new_destination) {
             if (!_SetPathToNextWayPoint()) {
@@ -227,7 +227,7 @@ void EnemySprite::_HandleHostileUpdate()
     // Determine standard monster behavior regarding its zone.
 
     // Update the wait time until two set destination.
-    _time_elapsed += vt_system::SystemManager->GetUpdateTime();
+    _time_elapsed += _GetUpdateTime();
 
     // Check whether the monster can get out of the zone.
     bool can_get_out_of_zone = true;
@@ -12,6 +12,7 @@
 #define __MAP_SPRITE_HEADER__
 
 #include "modes/map/map_sprites/map_virtual_sprite.h"
+#include "modes/map/map_sprites/map_sprite_animations.h"
 
 #include "utils/ustring.h"
 
@@ -258,6 +259,11 @@ protected:
     std::vector<vt_video::AnimatedImage> _walking_animations;
     std::vector<vt_video::AnimatedImage> _running_animations;
 
+    //! \brief The shared definitions the animations above were copied from, kept alive while in use.
+    std::shared_ptr<const SpriteAnimationDefinition> _standing_definition;
+    std::shared_ptr<const SpriteAnimationDefinition> _walking_definition;
+    std::shared_ptr<const SpriteAnimationDefinition> _running_definition;
+
     //! \brief A pointer to the current standard animation vector
     std::vector<vt_video::AnimatedImage>* _animation;
 
@@ -302,6 +308,14 @@ protected:
 
     //! \brief Draws debug information, used for pathfinding mostly.
     void _DrawDebugInfo();
+
+    /** \brief Copies the animations defined in the given file.
+    *** \param definition Set to the shared definition, or reset when the file couldn't be loaded.
+    *** \return false if the file couldn't be loaded, in which case the animations are left empty.
+    **/
+    bool _LoadAnimations(std::vector<vt_video::AnimatedImage>& animations,
+                         std::shared_ptr<const SpriteAnimationDefinition>& definition,
+                         const std::string& filename);
 };
 
 } // namespace private_map
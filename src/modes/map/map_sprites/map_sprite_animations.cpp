@@ -0,0 +1,219 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "modes/map/map_sprites/map_sprite_animations.h"
+
+#include "modes/map/map_utils.h"
+
+#include "engine/profiler.h"
+#include "script/script_read.h"
+
+#include "utils/utils_files.h"
+#include "utils/utils_numeric.h"
+
+#include <SDL2/SDL.h>
+
+#include <map>
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+//! \brief The loaded definitions, indexed by sprite animation filename.
+static std::map<std::string, std::weak_ptr<const SpriteAnimationDefinition> > _sprite_animation_definitions;
+
+//! \brief Sprite animation cache statistics.
+static uint32_t _sprite_animation_files_read = 0;
+static uint32_t _sprite_animation_definitions_shared = 0;
+
+//! \brief The time spent reading sprite animation files, in performance counter ticks.
+static uint64_t _sprite_animation_read_time = 0;
+
+//! \brief Reads the animations of each direction from a sprite animation file.
+static bool _ReadSpriteAnimations(std::vector<vt_video::AnimatedImage>& animations, const std::string& filename)
+{
+    // Prepare to add the animations for each directions.
+    animations.assign(NUM_ANIM_DIRECTIONS, vt_video::AnimatedImage());
+
+    vt_script::ReadScriptDescriptor animations_script;
+    if(!animations_script.OpenFile(filename))
+        return false;
+
+    if(!animations_script.DoesTableExist("sprite_animation")) {
+        PRINT_WARNING << "No 'sprite_animation' table in 4-direction animation script file: " << filename << std::endl;
+        animations_script.CloseFile();
+        return false;
+    }
+
+    animations_script.OpenTable("sprite_animation");
+
+    std::string image_filename = animations_script.ReadString("image_filename");
+    if(!vt_utils::DoesFileExist(image_filename)) {
+        PRINT_WARNING << "The image file doesn't exist: " << image_filename << std::endl;
+        animations_script.CloseTable();
+        animations_script.CloseFile();
+        return false;
+    }
+
+    bool blended_animation = false;
+    if (animations_script.DoesBoolExist("blended_animation")) {
+        blended_animation = animations_script.ReadBool("blended_animation");
+    }
+
+    uint32_t rows = animations_script.ReadUInt("rows");
+    uint32_t columns = animations_script.ReadUInt("columns");
+
+    if(!animations_script.DoesTableExist("frames")) {
+        animations_script.CloseAllTables();
+        animations_script.CloseFile();
+        PRINT_WARNING << "No frame table in file: " << filename << std::endl;
+        return false;
+    }
+
+    std::vector<vt_video::StillImage> image_frames;
+    // Load the image data
+    if(!vt_video::ImageDescriptor::LoadMultiImageFromElementGrid(image_frames, image_filename, rows, columns)) {
+        PRINT_WARNING << "Couldn't load elements from image file: " << image_filename
+                      << " (in file: " << filename << ")" << std::endl;
+        animations_script.CloseAllTables();
+        animations_script.CloseFile();
+        return false;
+    }
+
+    std::vector <uint32_t> frames_directions_ids;
+    animations_script.ReadTableKeys("frames", frames_directions_ids);
+
+    // open the frames table
+    animations_script.OpenTable("frames");
+
+    for(uint32_t i = 0; i < frames_directions_ids.size(); ++i) {
+        if(frames_directions_ids[i] >= NUM_ANIM_DIRECTIONS) {
+            PRINT_WARNING << "Invalid direction id(" << frames_directions_ids[i]
+                          << ") in file: " << filename << std::endl;
+            continue;
+        }
+
+        uint32_t anim_direction = frames_directions_ids[i];
+
+        // Opens frames[ANIM_DIRECTION]
+        animations_script.OpenTable(anim_direction);
+
+        // Loads the frames data
+        std::vector<uint32_t> frames_ids;
+        std::vector<uint32_t> frames_duration;
+
+        uint32_t num_frames = animations_script.GetTableSize();
+        for(uint32_t frames_table_id = 0;  frames_table_id < num_frames; ++frames_table_id) {
+            // Opens frames[ANIM_DIRECTION][frame_table_id]
+            animations_script.OpenTable(frames_table_id);
+
+            int32_t frame_id = animations_script.ReadInt("id");
+            int32_t frame_duration = animations_script.ReadInt("duration");
+
+            if(frame_id < 0 || frame_duration < 0 || frame_id >= (int32_t)image_frames.size()) {
+                PRINT_WARNING << "Invalid frame (" << frames_table_id << ") in file: "
+                              << filename << std::endl;
+                PRINT_WARNING << "Request for frame id: " << frame_id << ", duration: "
+                              << frame_duration << " is not possible." << std::endl;
+                continue;
+            }
+
+            frames_ids.push_back((uint32_t)frame_id);
+            frames_duration.push_back((uint32_t)frame_duration);
+
+            animations_script.CloseTable(); // frames[ANIM_DIRECTION][frame_table_id] table
+        }
+
+        // Actually create the animation data
+        animations[anim_direction].Clear();
+        animations[anim_direction].ResetAnimation();
+        animations[anim_direction].SetAnimationBlended(blended_animation);
+        for(uint32_t j = 0; j < frames_ids.size(); ++j) {
+            // Set the dimension of the requested frame
+            animations[anim_direction].AddFrame(image_frames[frames_ids[j]], frames_duration[j]);
+        }
+
+        // Closes frames[ANIM_DIRECTION]
+        animations_script.CloseTable();
+
+    } // for each directions
+
+    // Close the 'frames' table and set the dimensions
+    animations_script.CloseTable();
+
+    float frame_width = animations_script.ReadFloat("frame_width");
+    float frame_height = animations_script.ReadFloat("frame_height");
+
+    // Load requested dimensions
+    for(uint8_t i = 0; i < NUM_ANIM_DIRECTIONS; ++i) {
+        if(frame_width > 0.0f && frame_height > 0.0f) {
+            animations[i].SetDimensions(frame_width, frame_height);
+        } else if(vt_utils::IsFloatEqual(animations[i].GetWidth(), 0.0f)
+                  && vt_utils::IsFloatEqual(animations[i].GetHeight(), 0.0f)) {
+            // If the animation dimensions are not set, we're using the first frame size.
+            animations[i].SetDimensions(image_frames.begin()->GetWidth(), image_frames.begin()->GetHeight());
+        }
+
+        // Rescale to fit the map mode coordinates system.
+        ScaleToMapZoomRatio(animations[i]);
+    }
+
+    animations_script.CloseTable(); // sprite_animation table
+    animations_script.CloseFile();
+
+    return true;
+} // bool _ReadSpriteAnimations()
+
+std::shared_ptr<const SpriteAnimationDefinition> LoadSpriteAnimationDefinition(const std::string& filename)
+{
+    std::weak_ptr<const SpriteAnimationDefinition>& cached = _sprite_animation_definitions[filename];
+    std::shared_ptr<const SpriteAnimationDefinition> definition = cached.lock();
+    if(definition) {
+        ++_sprite_animation_definitions_shared;
+        return definition;
+    }
+
+    PROFILE_ZONE("LoadSpriteAnimationDefinition");
+    ++_sprite_animation_files_read;
+    uint64_t read_start = SDL_GetPerformanceCounter();
+    std::shared_ptr<SpriteAnimationDefinition> new_definition = std::make_shared<SpriteAnimationDefinition>();
+    bool read = _ReadSpriteAnimations(new_definition->animations, filename);
+    _sprite_animation_read_time += SDL_GetPerformanceCounter() - read_start;
+
+    if(!read) {
+        // Failures aren't cached, so that a fixed file can be loaded again.
+        _sprite_animation_definitions.erase(filename);
+        return nullptr;
+    }
+
+    cached = new_definition;
+    return new_definition;
+}
+
+uint32_t GetSpriteAnimationFilesRead()
+{
+    return _sprite_animation_files_read;
+}
+
+uint32_t GetSpriteAnimationDefinitionsShared()
+{
+    return _sprite_animation_definitions_shared;
+}
+
+float GetSpriteAnimationReadTime()
+{
+    return static_cast<float>(_sprite_animation_read_time) * 1000.0f
+           / static_cast<float>(SDL_GetPerformanceFrequency());
+}
+
+} // namespace private_map
+
+} // namespace vt_map
@@ -0,0 +1,59 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef __MAP_SPRITE_ANIMATIONS_HEADER__
+#define __MAP_SPRITE_ANIMATIONS_HEADER__
+
+#include "engine/video/image.h"
+
+#include <memory>
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+/** ****************************************************************************
+*** \brief The animations of a map sprite in each direction, read from a sprite animation file.
+***
+*** The frames refer to the loaded textures, already scaled to the map zoom ratio.
+*** A definition is never modified once loaded: the sprites copy its animations,
+*** which only adds texture references, and play their copies on their own.
+*** ***************************************************************************/
+struct SpriteAnimationDefinition {
+    //! \brief The animations, indexed by animation direction.
+    std::vector<vt_video::AnimatedImage> animations;
+};
+
+/** \brief Returns the sprite animations defined in the given file.
+*** \return nullptr if the file couldn't be loaded.
+***
+*** The definitions are shared by every sprite using the same file, and the file is
+*** only read again once no sprite refers to its definition anymore. This way, the
+*** textures of a map sprites are released along with the last map using them.
+**/
+std::shared_ptr<const SpriteAnimationDefinition> LoadSpriteAnimationDefinition(const std::string& filename);
+
+//! \brief Returns the number of sprite animation files read since the game started.
+uint32_t GetSpriteAnimationFilesRead();
+
+//! \brief Returns the number of sprite animation definitions shared instead of reading their file.
+uint32_t GetSpriteAnimationDefinitionsShared();
+
+/** \brief Returns the time spent reading sprite animation files since the game started, in milliseconds.
+*** Together with the number of files read, it tells the time saved by the shared definitions.
+**/
+float GetSpriteAnimationReadTime();
+
+} // namespace private_map
+
+} // namespace vt_map
+
+#endif // __MAP_SPRITE_ANIMATIONS_HEADER__
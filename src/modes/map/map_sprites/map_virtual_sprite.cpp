@@ -60,9 +60,23 @@ void VirtualSprite::Update()
     if(!_updatable || !_moving)
         return;
 
-    _SetNextPosition();
+    // When updated over several updates, e.g. at a reduced rate, the sprite moves
+    // by steps of a single update at most so that it can't jump across blocking areas.
+    uint32_t max_step_time = vt_system::SystemManager->GetUpdateTime();
+    for(uint32_t time_left = _GetUpdateTime(); time_left > 0 && _moving;) {
+        uint32_t step_time = std::min(time_left, max_step_time);
+        _SetNextPosition(step_time);
+        time_left -= step_time;
+    }
 } // void VirtualSprite::Update()
 
+bool VirtualSprite::IsAlwaysUpdated() const
+{
+    if(_always_updated)
+        return true;
+    return _control_event != nullptr && _control_event->GetEventType() != RANDOM_MOVE_SPRITE_EVENT;
+}
+
 bool VirtualSprite::_HandleWallEdges(float& next_pos_x,
                                      float& next_pos_y,
                                      float distance_moved,
@@ -164,13 +178,13 @@ bool VirtualSprite::_HandleWallEdges(float& next_pos_x,
     return true;
 }
 
-void VirtualSprite::_SetNextPosition()
+void VirtualSprite::_SetNextPosition(uint32_t step_time)
 {
 
     // Next sprite's position holders
     float next_pos_x = GetXPosition();
     float next_pos_y = GetYPosition();
-    float distance_moved = CalculateDistanceMoved();
+    float distance_moved = CalculateDistanceMoved(step_time);
 
     // Move the sprite the appropriate distance in the appropriate Y and X direction
     if(_direction & (NORTH | MOVING_NORTHWEST | MOVING_NORTHEAST))
@@ -493,9 +507,9 @@ void VirtualSprite::LookAt(const Position2D& pos)
     }
 }
 
-float VirtualSprite::CalculateDistanceMoved()
+float VirtualSprite::CalculateDistanceMoved(uint32_t update_time) const
 {
-    float distance_moved = static_cast<float>(vt_system::SystemManager->GetUpdateTime()) / _movement_speed;
+    float distance_moved = static_cast<float>(update_time) / _movement_speed;
 
     // Double the distance to move if the sprite is running
     if(_is_running)
@@ -79,7 +79,12 @@ public:
     *** \note This method does not check if the "moving" member is true but does factor in the "is_running"
     *** member in its calculation.
     **/
-    float CalculateDistanceMoved();
+    float CalculateDistanceMoved() {
+        return CalculateDistanceMoved(_GetUpdateTime());
+    }
+
+    //! \brief Calculates the distance the sprite moves in the given time, in milliseconds.
+    float CalculateDistanceMoved(uint32_t update_time) const;
 
     /** \brief Declares that an event is taking control over the sprite
     *** \param event The sprite event that is assuming control
@@ -107,6 +112,12 @@ public:
         return _control_event;
     }
 
+    /** \brief Sprites controlled by an event waiting for the sprite, such as a path move,
+    *** are always updated, so that the event can finish. Random moves end on their own,
+    *** so the sprites wandering around far from the screen are still paused.
+    **/
+    bool IsAlwaysUpdated() const override;
+
     /** \brief Saves the state of the sprite
     *** Attributes saved: direction, speed, moving state
     **/
@@ -203,8 +214,9 @@ protected:
     /** \brief Set the next sprite position, according to the current direction set.
     *** This function aims at finding the next correct position for the given sprite,
     *** and avoid the most possible to make it stop, except when walking against a wall.
+    *** \param step_time The time to move the sprite over, in milliseconds.
     **/
-    void _SetNextPosition();
+    void _SetNextPosition(uint32_t step_time);
 
     /** \brief Handles position corrections when the sprite is on the edge of
     *** physical obstacles. (NPC sprites, treasure, ... aren't considered here for playability purpose)
@@ -20,6 +20,10 @@
 #include "modes/map/map_mode.h"
 
 #include "engine/video/video.h"
+#include "engine/video/static_image_batch.h"
+#include "engine/profiler.h"
+
+#include <algorithm>
 
 using namespace vt_utils;
 using namespace vt_script;
@@ -31,6 +35,9 @@ namespace vt_map
 namespace private_map
 {
 
+//! \brief The number of tiles on each axis of a tile chunk.
+const uint32_t TILE_CHUNK_LENGTH = 16;
+
 //! \brief A helper function to convert a string to a layer type.
 static LAYER_TYPE StringToLayerType(const std::string& type)
 {
@@ -43,12 +50,25 @@ static LAYER_TYPE StringToLayerType(const std::string& type)
 
 TileSupervisor::TileSupervisor() :
     _num_tile_on_x_axis(0),
-    _num_tile_on_y_axis(0)
+    _num_tile_on_y_axis(0),
+    _num_chunk_on_x_axis(0),
+    _num_chunk_on_y_axis(0)
+{
+}
+
+TileChunk::~TileChunk()
 {
+    delete batch;
 }
 
 TileSupervisor::~TileSupervisor()
 {
+    for(uint32_t i = 0; i < _tile_chunks.size(); ++i) {
+        for(uint32_t j = 0; j < _tile_chunks[i].size(); ++j)
+            delete _tile_chunks[i][j];
+    }
+    _tile_chunks.clear();
+
     // Delete all objects in _tile_images but *not* _animated_tile_images.
     // This is because _animated_tile_images is a subset of _tile_images.
     for(uint32_t i = 0; i < _tile_images.size(); i++)
@@ -72,8 +92,13 @@ bool TileSupervisor::Load(ReadScriptDescriptor &map_file)
     // Temporarily retains all tile images loaded for each tileset. Each inner vector contains 256 StillImage objects
     std::vector<std::vector<StillImage> > tileset_images;
 
+    // Contains the tileset image filename of each tileset
+    std::vector<std::string> tileset_image_filenames;
+
     map_file.ReadStringVector("tileset_filenames", tileset_filenames);
 
+    // Read every tileset image filename first, so that all the tileset images
+    // are decoded in the background while the previous ones are being loaded.
     for(uint32_t i = 0; i < tileset_filenames.size(); i++) {
         std::string tileset_file = tileset_filenames[i];
 
@@ -89,9 +114,15 @@ bool TileSupervisor::Load(ReadScriptDescriptor &map_file)
             return false;
         }
 
-        std::string image_filename = tileset_script.ReadString("image");
+        tileset_image_filenames.push_back(tileset_script.ReadString("image"));
         tileset_script.CloseFile();
 
+        ImageDescriptor::PrefetchImage(tileset_image_filenames.back());
+    }
+
+    for(uint32_t i = 0; i < tileset_image_filenames.size(); i++) {
+        const std::string& image_filename = tileset_image_filenames[i];
+
         tileset_images.push_back(std::vector<StillImage>(TILES_PER_TILESET));
 
         // Each tileset image is 512x512 pixels, yielding 16 * 16 (== 256) 32x32 pixel tiles each
@@ -310,9 +341,84 @@ bool TileSupervisor::Load(ReadScriptDescriptor &map_file)
     // Remove all tileset images. Any tiles which were not added to _tile_images will no longer exist in memory
     tileset_images.clear();
 
+    _CreateTileChunks();
+
     return true;
 }
 
+void TileSupervisor::_CreateTileChunks()
+{
+    _num_chunk_on_x_axis = (_num_tile_on_x_axis + TILE_CHUNK_LENGTH - 1) / TILE_CHUNK_LENGTH;
+    _num_chunk_on_y_axis = (_num_tile_on_y_axis + TILE_CHUNK_LENGTH - 1) / TILE_CHUNK_LENGTH;
+
+    _tile_chunks.resize(_tile_grid.size());
+    for(uint32_t layer_id = 0; layer_id < _tile_grid.size(); ++layer_id) {
+        const Layer &layer = _tile_grid[layer_id];
+
+        // Skipped layers have no tiles.
+        if(layer.tiles.empty())
+            continue;
+
+        _tile_chunks[layer_id].resize(_num_chunk_on_x_axis * _num_chunk_on_y_axis, nullptr);
+
+        for(uint32_t chunk_y = 0; chunk_y < _num_chunk_on_y_axis; ++chunk_y) {
+            for(uint32_t chunk_x = 0; chunk_x < _num_chunk_on_x_axis; ++chunk_x) {
+                TileChunk *chunk = new TileChunk();
+                StaticImageBatch *batch = new StaticImageBatch();
+
+                uint32_t y_end = std::min<uint32_t>((chunk_y + 1) * TILE_CHUNK_LENGTH, _num_tile_on_y_axis);
+                uint32_t x_end = std::min<uint32_t>((chunk_x + 1) * TILE_CHUNK_LENGTH, _num_tile_on_x_axis);
+                for(uint32_t y = chunk_y * TILE_CHUNK_LENGTH; y < y_end; ++y) {
+                    for(uint32_t x = chunk_x * TILE_CHUNK_LENGTH; x < x_end; ++x) {
+                        if(layer.tiles[y][x] < 0)
+                            continue;
+
+                        // The tile position relative to the chunk top left corner.
+                        float x_position = static_cast<float>((x - chunk_x * TILE_CHUNK_LENGTH) * TILE_LENGTH);
+                        float y_position = static_cast<float>((y - chunk_y * TILE_CHUNK_LENGTH) * TILE_LENGTH);
+
+                        ImageDescriptor *tile_image = _tile_images[layer.tiles[y][x]];
+                        AnimatedImage *animated_tile = dynamic_cast<AnimatedImage *>(tile_image);
+
+                        bool added = (animated_tile != nullptr) ?
+                                     batch->AddImage(*animated_tile, x_position, y_position) :
+                                     batch->AddImage(*static_cast<StillImage *>(tile_image), x_position, y_position);
+                        if(!added) {
+                            // The tile is drawn on its own instead.
+                            TileChunk::FallbackTile fallback_tile;
+                            fallback_tile.image = tile_image;
+                            fallback_tile.x = x_position;
+                            fallback_tile.y = y_position;
+                            chunk->fallback_tiles.push_back(fallback_tile);
+                        }
+                    }
+                }
+
+                if(batch->IsEmpty()) {
+                    delete batch;
+                }
+                else {
+                    batch->Finalize();
+                    chunk->batch = batch;
+                }
+
+                if(chunk->IsEmpty()) {
+                    delete chunk;
+                    continue;
+                }
+
+                if(!chunk->fallback_tiles.empty()) {
+                    IF_PRINT_DEBUG(MAP_DEBUG) << chunk->fallback_tiles.size() << " tile(s) of the chunk at ("
+                                              << chunk_x << ", " << chunk_y << ") on layer " << layer_id
+                                              << " couldn't be baked, and are drawn one by one." << std::endl;
+                }
+
+                _tile_chunks[layer_id][(chunk_y * _num_chunk_on_x_axis) + chunk_x] = chunk;
+            }
+        }
+    }
+}
+
 void TileSupervisor::Update()
 {
     for(uint32_t i = 0; i < _animated_tile_images.size(); i++) {
@@ -322,36 +428,56 @@ void TileSupervisor::Update()
 
 void TileSupervisor::DrawLayers(const MapFrame *frame, const LAYER_TYPE &layer_type)
 {
+    PROFILE_ZONE("TileSupervisor::DrawLayers");
+
     // We'll use the top-left positions to render the tiles.
     VideoManager->SetDrawFlags(VIDEO_BLEND, VIDEO_X_LEFT, VIDEO_Y_TOP, 0);
 
     // Map frame ends
-    uint32_t y_end = static_cast<uint32_t>(frame->tile_y_start + frame->num_draw_y_axis);
-    uint32_t x_end = static_cast<uint32_t>(frame->tile_x_start + frame->num_draw_x_axis);
+    int32_t y_end = static_cast<int32_t>(frame->tile_y_start + frame->num_draw_y_axis);
+    int32_t x_end = static_cast<int32_t>(frame->tile_x_start + frame->num_draw_x_axis);
+
+    // The visible chunks
+    int32_t chunk_x_start = std::max<int32_t>(frame->tile_x_start, 0) / TILE_CHUNK_LENGTH;
+    int32_t chunk_y_start = std::max<int32_t>(frame->tile_y_start, 0) / TILE_CHUNK_LENGTH;
+    int32_t chunk_x_end = std::min<int32_t>((x_end + TILE_CHUNK_LENGTH - 1) / TILE_CHUNK_LENGTH, _num_chunk_on_x_axis);
+    int32_t chunk_y_end = std::min<int32_t>((y_end + TILE_CHUNK_LENGTH - 1) / TILE_CHUNK_LENGTH, _num_chunk_on_y_axis);
+
+    // We substract 0.5 horizontally and 1.0 vertically here
+    // because the video engine will display the map tiles using their
+    // top left coordinates to avoid a position computation flaw when specifying the tile
+    // coordinates from the bottom center point, as the engine does for everything else.
+    float x_origin = GRID_LENGTH * (frame->tile_offset.x - 1.0f);
+    float y_origin = GRID_LENGTH * (frame->tile_offset.y - 2.0f);
 
     uint32_t layer_number = _tile_grid.size();
     for(uint32_t layer_id = 0; layer_id < layer_number; ++layer_id) {
 
         const Layer &layer = _tile_grid.at(layer_id);
-        if(layer.layer_type != layer_type)
+        if(layer.layer_type != layer_type || _tile_chunks[layer_id].empty())
             continue;
 
-        // We substract 0.5 horizontally and 1.0 vertically here
-        // because the video engine will display the map tiles using their
-        // top left coordinates to avoid a position computation flaw when specifying the tile
-        // coordinates from the bottom center point, as the engine does for everything else.
-        VideoManager->Move(GRID_LENGTH * (frame->tile_offset.x - 1.0f),
-                           GRID_LENGTH * (frame->tile_offset.y - 2.0f));
-        for(uint32_t y = static_cast<uint32_t>(frame->tile_y_start); y < y_end; ++y) {
-            for(uint32_t x = static_cast<uint32_t>(frame->tile_x_start); x < x_end; ++x) {
-                // Draw a tile image if it exists at this location
-                if(layer.tiles[y][x] >= 0)
-                    _tile_images[ layer.tiles[y][x] ]->Draw();
-
-                VideoManager->MoveRelative(TILE_LENGTH, 0.0f);
-            } // x
-            VideoManager->MoveRelative(-static_cast<float>(frame->num_draw_x_axis) * TILE_LENGTH, TILE_LENGTH);
-        } // y
+        for(int32_t chunk_y = chunk_y_start; chunk_y < chunk_y_end; ++chunk_y) {
+            for(int32_t chunk_x = chunk_x_start; chunk_x < chunk_x_end; ++chunk_x) {
+                const TileChunk *chunk = _tile_chunks[layer_id][(chunk_y * _num_chunk_on_x_axis) + chunk_x];
+                if(chunk == nullptr)
+                    continue;
+
+                // Place the chunk top left corner relatively to the first visible tile.
+                float chunk_x_position = x_origin + (chunk_x * static_cast<int32_t>(TILE_CHUNK_LENGTH) - frame->tile_x_start) * TILE_LENGTH;
+                float chunk_y_position = y_origin + (chunk_y * static_cast<int32_t>(TILE_CHUNK_LENGTH) - frame->tile_y_start) * TILE_LENGTH;
+                if(chunk->batch) {
+                    VideoManager->Move(chunk_x_position, chunk_y_position);
+                    chunk->batch->Draw();
+                }
+
+                for(uint32_t i = 0; i < chunk->fallback_tiles.size(); ++i) {
+                    const TileChunk::FallbackTile &fallback_tile = chunk->fallback_tiles[i];
+                    VideoManager->Move(chunk_x_position + fallback_tile.x, chunk_y_position + fallback_tile.y);
+                    fallback_tile.image->Draw();
+                }
+            } // chunk_x
+        } // chunk_y
     } // layer_id
 
     // Restore the previous draw flags.
@@ -28,6 +28,7 @@
 namespace vt_video {
 class ImageDescriptor;
 class AnimatedImage;
+class StaticImageBatch;
 }
 
 namespace vt_map
@@ -57,6 +58,46 @@ public:
     {}
 };
 
+/** ****************************************************************************
+*** \brief The tiles of one layer within TILE_CHUNK_LENGTH * TILE_CHUNK_LENGTH tiles.
+***
+*** The tiles are baked into a static batch when possible. The ones the batch
+*** refuses, e.g.: animated tiles with frames on several texture sheets,
+*** are drawn one by one right after it.
+*** ***************************************************************************/
+class TileChunk
+{
+public:
+    TileChunk():
+        batch(nullptr)
+    {}
+
+    ~TileChunk();
+
+    //! \brief A tile which couldn't be baked, with its position relative to the chunk top left corner.
+    struct FallbackTile {
+        vt_video::ImageDescriptor *image;
+        float x;
+        float y;
+    };
+
+    //! \brief The baked tiles, or nullptr when none could be baked.
+    vt_video::StaticImageBatch *batch;
+
+    //! \brief The tiles which couldn't be baked, in the order they were added.
+    std::vector<FallbackTile> fallback_tiles;
+
+    bool IsEmpty() const {
+        return batch == nullptr && fallback_tiles.empty();
+    }
+
+private:
+    //! \brief The copy constructor and assignment operator are hidden by design,
+    //! as the chunk owns its batch.
+    TileChunk(const TileChunk& chunk);
+    TileChunk& operator=(const TileChunk& chunk);
+};
+
 /** ****************************************************************************
 *** \brief A helper class to MapMode responsible for all tile data and operations
 ***
@@ -121,6 +162,20 @@ private:
     *** _tile_images vector, which contains both still and animated images.
     **/
     std::vector<vt_video::AnimatedImage *> _animated_tile_images;
+
+    /** \brief The tile layers baked into chunks of TILE_CHUNK_LENGTH * TILE_CHUNK_LENGTH tiles.
+    *** i.e: _tile_chunks[layer_id][(chunk_y * _num_chunk_on_x_axis) + chunk_x]
+    *** Each chunk is stored on the GPU, so that drawing it only costs
+    *** one draw call per tileset used in it, plus one per tile which couldn't be baked.
+    **/
+    std::vector<std::vector<TileChunk *> > _tile_chunks;
+
+    //! \brief The number of tile chunk columns and rows of the map.
+    uint32_t _num_chunk_on_x_axis;
+    uint32_t _num_chunk_on_y_axis;
+
+    //! \brief Creates the tile chunks of every layer, once the tile images are loaded.
+    void _CreateTileChunks();
 }; // class TileSupervisor
 
 } // namespace private_map
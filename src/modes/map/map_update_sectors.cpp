@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_update_sectors.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the map sectors update activity.
+*** ***************************************************************************/
+
+#include "modes/map/map_update_sectors.h"
+
+#include "utils/utils_common.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace vt_common;
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+UpdateSectors::UpdateSectors() :
+    _num_sector_x_axis(0),
+    _num_sector_y_axis(0),
+    _full_margin(MAP_SECTOR_DEFAULT_FULL_MARGIN),
+    _reduced_margin(MAP_SECTOR_DEFAULT_REDUCED_MARGIN)
+{
+}
+
+void UpdateSectors::Initialize(uint32_t num_grid_x_axis, uint32_t num_grid_y_axis)
+{
+    _num_sector_x_axis = (num_grid_x_axis + MAP_SECTOR_LENGTH - 1) / MAP_SECTOR_LENGTH;
+    _num_sector_y_axis = (num_grid_y_axis + MAP_SECTOR_LENGTH - 1) / MAP_SECTOR_LENGTH;
+
+    // Until the first update, every object is updated.
+    _activities.assign(_num_sector_x_axis * _num_sector_y_axis, SECTOR_FULL_ACTIVITY);
+}
+
+void UpdateSectors::SetMargins(float full_margin, float reduced_margin)
+{
+    if(full_margin < 0.0f) {
+        PRINT_WARNING << "Invalid full update margin: " << full_margin << std::endl;
+        full_margin = 0.0f;
+    }
+    if(reduced_margin < full_margin) {
+        PRINT_WARNING << "The reduced update margin (" << reduced_margin
+                      << ") can't be smaller than the full update margin (" << full_margin << ")" << std::endl;
+        reduced_margin = full_margin;
+    }
+
+    _full_margin = full_margin;
+    _reduced_margin = reduced_margin;
+}
+
+void UpdateSectors::Update(const Rectangle2D &screen_edges)
+{
+    for(uint32_t y = 0; y < _num_sector_y_axis; ++y) {
+        float sector_top = static_cast<float>(y * MAP_SECTOR_LENGTH);
+        float sector_bottom = sector_top + MAP_SECTOR_LENGTH;
+
+        // The distance between the sector and the screen on each axis, zero when they overlap.
+        float y_distance = std::max(std::max(sector_top - screen_edges.bottom, screen_edges.top - sector_bottom), 0.0f);
+
+        for(uint32_t x = 0; x < _num_sector_x_axis; ++x) {
+            float sector_left = static_cast<float>(x * MAP_SECTOR_LENGTH);
+            float sector_right = sector_left + MAP_SECTOR_LENGTH;
+            float x_distance = std::max(std::max(sector_left - screen_edges.right, screen_edges.left - sector_right), 0.0f);
+
+            float distance = std::max(x_distance, y_distance);
+            SECTOR_ACTIVITY activity = SECTOR_NO_ACTIVITY;
+            if(distance <= _full_margin)
+                activity = SECTOR_FULL_ACTIVITY;
+            else if(distance <= _reduced_margin)
+                activity = SECTOR_REDUCED_ACTIVITY;
+
+            _activities[(y * _num_sector_x_axis) + x] = activity;
+        }
+    }
+}
+
+SECTOR_ACTIVITY UpdateSectors::GetActivity(float x, float y) const
+{
+    if(_activities.empty())
+        return SECTOR_FULL_ACTIVITY;
+
+    // Clamping keeps the objects outside of the map in the border sectors.
+    float max_x = static_cast<float>(_num_sector_x_axis - 1);
+    float max_y = static_cast<float>(_num_sector_y_axis - 1);
+    uint32_t sector_x = static_cast<uint32_t>(std::min(std::max(std::floor(x / MAP_SECTOR_LENGTH), 0.0f), max_x));
+    uint32_t sector_y = static_cast<uint32_t>(std::min(std::max(std::floor(y / MAP_SECTOR_LENGTH), 0.0f), max_y));
+    return _activities[(sector_y * _num_sector_x_axis) + sector_x];
+}
+
+} // namespace private_map
+
+} // namespace vt_map
@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2016 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See https://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_update_sectors.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the map sectors update activity.
+***
+*** The map is divided into sectors of MAP_SECTOR_LENGTH collision grid elements
+*** on each axis. Every frame, the sectors are given an activity depending on
+*** their distance to the screen, which tells how often the objects positioned
+*** within them are updated.
+*** ***************************************************************************/
+
+#ifndef __MAP_UPDATE_SECTORS_HEADER__
+#define __MAP_UPDATE_SECTORS_HEADER__
+
+#include "modes/map/map_utils.h"
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+//! \brief The number of collision grid elements on each axis of a sector.
+const uint32_t MAP_SECTOR_LENGTH = 16;
+
+/** \brief The number of frames between two updates of the objects in reduced activity sectors.
+*** Each of these updates covers the time elapsed since the previous one.
+**/
+const uint32_t MAP_SECTOR_REDUCED_UPDATE_PERIOD = 4;
+
+//! \brief The default distance to the screen edges of the sectors updated every frame, in grid elements.
+const float MAP_SECTOR_DEFAULT_FULL_MARGIN = HALF_SCREEN_GRID_X_LENGTH;
+
+//! \brief The default distance to the screen edges of the sectors updated at a reduced rate, in grid elements.
+const float MAP_SECTOR_DEFAULT_REDUCED_MARGIN = SCREEN_GRID_X_LENGTH * 2.0f;
+
+//! \brief How often the objects of a sector are updated.
+enum SECTOR_ACTIVITY {
+    //! Updated every frame.
+    SECTOR_FULL_ACTIVITY = 0,
+    //! Updated every MAP_SECTOR_REDUCED_UPDATE_PERIOD frames, over the frames skipped.
+    SECTOR_REDUCED_ACTIVITY = 1,
+    //! Not updated, i.e. paused.
+    SECTOR_NO_ACTIVITY = 2
+};
+
+/** ****************************************************************************
+*** \brief A uniform grid of sectors, telling how often the objects within them are updated.
+***
+*** The objects are looked up using their position only, so that big objects
+*** such as halos are only updated when their center is within the margins.
+*** ***************************************************************************/
+class UpdateSectors
+{
+public:
+    UpdateSectors();
+
+    //! \brief Sets up the sectors for a map of the given collision grid size.
+    void Initialize(uint32_t num_grid_x_axis, uint32_t num_grid_y_axis);
+
+    /** \brief Sets the distances to the screen edges within which the sectors are active.
+    *** \param full_margin The distance within which the objects are updated every frame.
+    *** \param reduced_margin The distance within which the objects are updated at a reduced rate.
+    *** It can't be smaller than the full margin.
+    **/
+    void SetMargins(float full_margin, float reduced_margin);
+
+    //! \brief Gives each sector its activity, depending on the screen edges in grid coordinates.
+    void Update(const vt_common::Rectangle2D &screen_edges);
+
+    //! \brief Returns the activity of the sector at the given grid position, clamped to the map.
+    SECTOR_ACTIVITY GetActivity(float x, float y) const;
+
+    float GetFullMargin() const {
+        return _full_margin;
+    }
+
+    float GetReducedMargin() const {
+        return _reduced_margin;
+    }
+
+private:
+    //! \brief The number of sectors on each axis.
+    uint32_t _num_sector_x_axis, _num_sector_y_axis;
+
+    /** \brief The activity of each sector.
+    *** \Note A position in this member is stored like this:
+    *** _activities[(y * _num_sector_x_axis) + x]
+    **/
+    std::vector<SECTOR_ACTIVITY> _activities;
+
+    //! \brief The distances to the screen edges of the active sectors, in grid elements.
+    float _full_margin;
+    float _reduced_margin;
+};
+
+} // namespace private_map
+
+} // namespace vt_map
+
+#endif // __MAP_UPDATE_SECTORS_HEADER__
@@ -253,63 +253,7 @@ public:
     vt_common::Rectangle2D screen_edges;
 }; // class MapFrame
 
-
-/** ****************************************************************************
-*** \brief A container class for node information in pathfinding.
-***
-*** This class is used in the MapMode#_FindPath function to find an optimal
-*** path from a given source to a destination. The path finding algorithm
-*** employed is A* and thus many members of this class are particular to the
-*** implementation of that algorithm.
-*** ***************************************************************************/
-class PathNode
-{
-public:
-    /** \brief The grid coordinates for this node
-    *** These coordinates correspond to the collision grid, where each element
-    *** is a 16x16 pixel space on the map.
-    **/
-    int16_t tile_x, tile_y;
-
-    //! \name Path Scoring Members
-    //@{
-    //! \brief The total score for this node (f = g + h).
-    int16_t f_score;
-
-    //! \brief The score for this node relative to the source.
-    int16_t g_score;
-
-    //! \brief The Manhattan distance from this node to the destination.
-    int16_t h_score;
-    //@}
-
-    //! \brief The grid coordinates for the parent of this node
-    int16_t parent_x, parent_y;
-
-    // ---------- Methods
-
-    PathNode() : tile_x(-1), tile_y(-1), f_score(0), g_score(0), h_score(0), parent_x(0), parent_y(0)
-    {}
-
-    PathNode(int16_t x_, int16_t y_) : tile_x(x_), tile_y(y_), f_score(0), g_score(0), h_score(0), parent_x(0), parent_y(0)
-    {}
-
-    //! \brief Overloaded comparison operator, only checks that the tile_x and tile_y members are equal
-    bool operator==(const PathNode &that) const {
-        return ((this->tile_x == that.tile_x) && (this->tile_y == that.tile_y));
-    }
-
-    //! \brief Overloaded comparison operator, only checks that the tile_x or tile_y members are unequal
-    bool operator!=(const PathNode &that) const {
-        return ((this->tile_x != that.tile_x) || (this->tile_y != that.tile_y));
-    }
-
-    //! \brief Overloaded comparison operator only used for path finding, compares the two f_scores
-    bool operator<(const PathNode &that) const {
-        return this->f_score > that.f_score;
-    }
-}; // class PathNode
-
+//! \brief A path of map positions, as found by ObjectSupervisor::FindPath().
 typedef std::vector<vt_common::Position2D> Path;
 
 } // namespace private_map
@@ -89,8 +89,9 @@ MenuMode::MenuMode() :
         _locale_graphic.SetDimensions(0, 0);
 
     // Save a copy of the current screen to use as the backdrop.
+    // The backdrop is blurred behind the menu windows.
     try {
-        _saved_screen = vt_video::VideoManager->CaptureScreen();
+        _saved_screen = vt_video::VideoManager->CaptureScreen(true);
     }
     catch (const vt_utils::Exception& e) {
         IF_PRINT_WARNING(MENU_DEBUG) << e.ToString() << std::endl;
@@ -101,6 +101,7 @@ void BindModeCode()
             .def("SetRunningEnabled", &MapMode::SetRunningEnabled)
 
             .def("DeleteMapObject", &MapMode::DeleteMapObject)
+            .def("SetObjectUpdateMargins", &MapMode::SetObjectUpdateMargins)
 
             .def("SetCamera", (void(MapMode:: *)(private_map::VirtualSprite *))&MapMode::SetCamera)
             .def("SetCamera", (void(MapMode:: *)(private_map::VirtualSprite *, uint32_t))&MapMode::SetCamera)
@@ -220,6 +221,7 @@ void BindModeCode()
             .def("SetCollPixelHeight", &MapObject::SetCollPixelHeight)
             .def("SetUpdatable", &MapObject::SetUpdatable)
             .def("SetVisible", &MapObject::SetVisible)
+            .def("SetAlwaysUpdated", &MapObject::SetAlwaysUpdated)
             .def("SetCollisionMask", &MapObject::SetCollisionMask)
             .def("SetDrawOnSecondPass", &MapObject::SetDrawOnSecondPass)
             .def("GetObjectID", &MapObject::GetObjectID)
@@ -231,6 +233,7 @@ void BindModeCode()
             .def("IsCollidingWith", &MapObject::IsCollidingWith)
             .def("IsUpdatable", &MapObject::IsUpdatable)
             .def("IsVisible", &MapObject::IsVisible)
+            .def("IsAlwaysUpdated", &MapObject::IsAlwaysUpdated)
             .def("GetCollisionMask", &MapObject::GetCollisionMask)
             .def("IsDrawOnSecondPass", &MapObject::IsDrawOnSecondPass)
             .def("Emote", &MapObject::Emote)
@@ -215,6 +215,11 @@ SaveMode::SaveMode(bool save_mode, uint32_t x_position, uint32_t y_position) :
 
     _window.Show();
 
+    // Update the slots once the pending autosaves are written.
+    GlobalManager->SetAutoSaveCallback([this](uint32_t slot_id, bool success) {
+        _OnAutoSaveWritten(slot_id, success);
+    });
+
     // Load the first slot data
     if(_file_list.GetSelection() > -1)
         _PreviewGame(_BuildSaveFilename(_file_list.GetSelection()));
@@ -222,6 +227,8 @@ SaveMode::SaveMode(bool save_mode, uint32_t x_position, uint32_t y_position) :
 
 SaveMode::~SaveMode()
 {
+    GlobalManager->SetAutoSaveCallback(SaveGameCallback());
+
     _window.Destroy();
 
     _left_window.Destroy();
@@ -281,7 +288,7 @@ void SaveMode::Update()
                 GlobalManager->GetMapData().SetSaveStamina(stamina);
 
                 // Attempt to save the game
-                if(GlobalManager->SaveGame(_BuildSaveFilename(id), id, _x_position, _y_position)) {
+                if(GlobalManager->SaveGame(GetSaveGameFilename(id), id, _x_position, _y_position)) {
                     _current_state = SAVE_MODE_SAVE_COMPLETE;
                     AudioManager->PlaySound("data/sounds/save_successful_nick_bowler_oga.wav");
                     // Remove the autosave in that case.
@@ -317,6 +324,10 @@ void SaveMode::Update()
             if(_file_list.GetSelection() > -1) {
                 // Check whether a more recent autosave file exists
                 uint32_t id = static_cast<uint32_t>(_file_list.GetSelection());
+                // Wait for the autosave being written to know which file to propose.
+                if (GlobalManager->IsAutoSaving(id))
+                    break;
+
                 if (_IsAutoSaveValid(id)) {
                     _current_state = SAVE_MODE_CONFIRM_AUTOSAVE;
                 }
@@ -543,29 +554,16 @@ bool SaveMode::_PreviewGame(const std::string& filename)
         return false;
     }
 
-    ReadScriptDescriptor file;
-
-    // Clear out the save data namespace to avoid loading false information
-    // when dealing with a save game that has an invalid namespace
-    ScriptManager->DropGlobalTable("save_game1");
-
-    if(!file.OpenFile(filename)) {
-        _ClearSaveData(true);
-        return false;
-    }
-
-    if(!file.DoesTableExist("save_game1")) {
-        file.CloseFile();
+    // Only the save game header is read for binary save games.
+    SaveGamePreview preview;
+    if(!GlobalManager->LoadGamePreview(filename, preview)) {
         _ClearSaveData(true);
         return false;
     }
 
-    // open the namespace that the save game is encapsulated in.
-    file.OpenTable("save_game1");
-
-    // The map file, tested after the save game is closed.
-    std::string map_script_filename = file.ReadString("map_script_filename");
-    std::string map_data_filename = file.ReadString("map_data_filename");
+    // The map file, tested after the save game is read.
+    std::string map_script_filename = preview.map_script_filename;
+    std::string map_data_filename = preview.map_data_filename;
 
     // DEPRECATED: Remove this after episode II release
     if (!vt_utils::DoesFileExist(map_data_filename)) {
@@ -577,80 +575,43 @@ bool SaveMode::_PreviewGame(const std::string& filename)
 
     // Check whether the map data file is available
     if (!vt_utils::DoesFileExist(map_data_filename)) {
-        file.CloseTable(); // save_game1
-        file.CloseFile();
         _ClearSaveData(true);
         return false;
     }
 
-    // Used to store temp data to populate text boxes
-    int32_t hours = file.ReadInt("play_hours");
-    int32_t minutes = file.ReadInt("play_minutes");
-    int32_t seconds = file.ReadInt("play_seconds");
-    int32_t drunes = file.ReadInt("drunes");
-
-    if(!file.DoesTableExist("characters")) {
-        file.CloseTable(); // save_game1
-        file.CloseFile();
-        _ClearSaveData(true);
-        return false;
-    }
-
-    // Read characters table content
-    file.OpenTable("characters");
-    std::vector<uint32_t> char_ids;
-    file.ReadUIntVector("order", char_ids);
-
     // Loads only up to the first four slots (Visible battle characters)
-    // i < char_ids.size() &&
     for(uint32_t i = 0; i < CHARACTERS_SHOWN_SLOTS; ++i) {
-        // Create a new GlobalCharacter object using the provided id
-        // This loads all of the character's "static" data, such as their name, etc.
-
         // Don't show characters when there are none
-        if (i >= char_ids.size() || !file.DoesTableExist(char_ids[i])) {
+        if (i >= preview.characters.size()) {
             _character_window[i].SetCharacter(nullptr);
             continue;
         }
 
-        file.OpenTable(char_ids[i]);
-
-        // Read in all of the character's stats data
-        GlobalCharacter character = GlobalCharacter(char_ids[i], false);
-        character.SetExperienceLevel(file.ReadUInt("experience_level"));
-        character.SetTotalExperiencePoints(file.ReadUInt("total_experience_points"));
-        character.SetUnspentExperiencePoints(file.ReadUInt("unspent_experience_points"));
-        character.AddExperienceForNextLevel(file.ReadUInt("experience_points_next"));
-
-        character.SetMaxHitPoints(file.ReadUInt("max_hit_points"));
-        character.SetHitPoints(file.ReadUInt("hit_points"));
-        character.SetMaxSkillPoints(file.ReadUInt("max_skill_points"));
-        character.SetSkillPoints(file.ReadUInt("skill_points"));
+        // Create a new GlobalCharacter object using the provided id
+        // This loads all of the character's "static" data, such as their name, etc.
+        const SaveCharacterPreview& character_preview = preview.characters[i];
+        GlobalCharacter character = GlobalCharacter(character_preview.id, false);
+        character.SetExperienceLevel(character_preview.experience_level);
+        character.SetTotalExperiencePoints(character_preview.total_experience_points);
+        character.SetUnspentExperiencePoints(character_preview.unspent_experience_points);
+        character.AddExperienceForNextLevel(character_preview.experience_points_next);
+
+        character.SetMaxHitPoints(character_preview.max_hit_points);
+        character.SetHitPoints(character_preview.hit_points);
+        character.SetMaxSkillPoints(character_preview.max_skill_points);
+        character.SetSkillPoints(character_preview.skill_points);
 
         _character_window[i].SetCharacter(&character);
-
-        file.CloseTable(); // character id
     }
-    file.CloseTable(); // characters
-
-    // Report any errors detected from the previous read operations
-    if(file.IsErrorDetected()) {
-        PRINT_WARNING << "One or more errors occurred while reading the save game file - they are listed below:"
-            << std::endl << file.GetErrorMessages() << std::endl;
-            file.ClearErrors();
-    }
-
-    file.CloseTable(); // save_game1
-    file.CloseFile();
 
     std::ostringstream time_text;
-    time_text << (hours < 10 ? "0" : "") << static_cast<uint32_t>(hours) << ":";
-    time_text << (minutes < 10 ? "0" : "") << static_cast<uint32_t>(minutes) << ":";
-    time_text << (seconds < 10 ? "0" : "") << static_cast<uint32_t>(seconds);
+    time_text << (preview.play_hours < 10 ? "0" : "") << static_cast<uint32_t>(preview.play_hours) << ":";
+    time_text << (preview.play_minutes < 10 ? "0" : "") << static_cast<uint32_t>(preview.play_minutes) << ":";
+    time_text << (preview.play_seconds < 10 ? "0" : "") << static_cast<uint32_t>(preview.play_seconds);
     _time_textbox.SetDisplayText(MakeUnicodeString(time_text.str()));
 
     std::ostringstream drunes_amount;
-    drunes_amount << drunes;
+    drunes_amount << preview.drunes;
     _drunes_textbox.SetDisplayText(MakeUnicodeString(drunes_amount.str()));
 
     // Test the map file
@@ -743,19 +704,39 @@ void SaveMode::_InitSaveSlots()
 
 std::string SaveMode::_BuildSaveFilename(uint32_t id, bool autosave)
 {
-    std::ostringstream file;
-    file << GetUserDataPath() + "saved_game_" << id;
-    if (autosave)
-        file << "_autosave.lua";
-    else
-        file << ".lua";
-    return file.str();
+    // Existing saves may still be Lua ones.
+    return FindSaveGameFilename(id, autosave);
 }
 
 void SaveMode::_DeleteAutoSave(uint32_t id)
 {
-    std::string filename = _BuildSaveFilename(id, true);
+    // Don't let a pending autosave be written afterwards.
+    GlobalManager->WaitForAutoSaves();
+
+    // Delete both the binary autosave and a potential older Lua one.
+    std::string filename = GetSaveGameFilename(id, true);
     vt_utils::DeleteAFile(filename.c_str());
+    // Once the binary one is deleted, this gives the Lua one when it exists.
+    filename = FindSaveGameFilename(id, true);
+    if (vt_utils::DoesFileExist(filename))
+        vt_utils::DeleteAFile(filename.c_str());
+}
+
+void SaveMode::_OnAutoSaveWritten(uint32_t id, bool success)
+{
+    if (!success || _save_mode || id >= _file_list.GetNumberOptions())
+        return;
+
+    // Add the key to the slot now it has a valid autosave.
+    if (!_file_list.GetEmbeddedImage(id) && _IsAutoSaveValid(id)) {
+        _file_list.AddOptionElementImage(id, GlobalManager->Media().GetKeyItemIcon());
+        _file_list.GetEmbeddedImage(id)->SetHeightKeepRatio(25);
+        _file_list.AddOptionElementPosition(id, 30);
+    }
+
+    // Checking the autosave changed the preview, so restore it.
+    if (_file_list.GetSelection() > -1)
+        _PreviewGame(_BuildSaveFilename(_file_list.GetSelection()));
 }
 
 } // namespace vt_save
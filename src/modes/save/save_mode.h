@@ -77,13 +77,16 @@ private:
     //! \brief Check whether there is a valid autosave file for the given slot.
     bool _IsAutoSaveValid(uint32_t id);
 
-    //! \brief Returns the corresponding save game filename (or autosave).
+    //! \brief Returns the corresponding existing save game filename (or autosave), binary or Lua.
     std::string _BuildSaveFilename(uint32_t id, bool autosave = false);
 
     //! \brief Delete a previous autosave.
     //! Used in the case the player loaded a regular autosave, or saved on a save point.
     void _DeleteAutoSave(uint32_t id);
 
+    //! \brief Updates the given load slot once its autosave was written in the background.
+    void _OnAutoSaveWritten(uint32_t id, bool success);
+
     //! \brief The MenuWindow for the backdrop
     vt_gui::MenuWindow _window;
 
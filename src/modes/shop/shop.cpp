@@ -1075,8 +1075,9 @@ ShopMode::ShopMode(const std::string& shop_id) :
     _dialogue_supervisor = new vt_common::DialogueSupervisor();
 
     // Save a copy of the current screen to use as the backdrop.
+    // The backdrop is blurred behind the shop windows.
     try {
-        _screen_backdrop = VideoManager->CaptureScreen();
+        _screen_backdrop = VideoManager->CaptureScreen(true);
     }
     catch (const Exception& e) {
         IF_PRINT_WARNING(SHOP_DEBUG) << e.ToString() << std::endl;